@@ -9,6 +9,7 @@
 #include "audio/IAudioAPI.h"
 #include "audio/IAudioInputAPI.h"
 #include "config/ActiveSettings.h"
+#include "config/LaunchSettings.h"
 #include "Cafe/TitleList/GameInfo.h"
 #include "Cafe/GraphicPack/GraphicPack2.h"
 #include "util/helpers/SystemException.h"
@@ -21,6 +22,7 @@
 #include "Cafe/OS/libs/snd_core/ax.h"
 #include "Cafe/OS/RPL/rpl.h"
 #include "Cafe/HW/Latte/Core/Latte.h"
+#include "Cafe/HW/Latte/Core/LatteCapture.h"
 #include "Cafe/Filesystem/FST/FST.h"
 #include "Common/FileStream.h"
 #include "GamePatch.h"
@@ -247,6 +249,8 @@ void InfoLog_PrintActiveSettings()
 	cemuLog_log(LogType::Force, "Load shared libraries: {}{}", ActiveSettings::LoadSharedLibrariesEnabled() ? "true" : "false", g_current_game_profile->ShouldLoadSharedLibraries().has_value() ? " (gameprofile)" : "");
 	cemuLog_log(LogType::Force, "Use precompiled shaders: {}{}", fmt::format("{}", ActiveSettings::GetPrecompiledShadersOption()), g_current_game_profile->GetPrecompiledShadersState().has_value() ? " (gameprofile)" : "");
 	cemuLog_log(LogType::Force, "Full sync at GX2DrawDone: {}", ActiveSettings::WaitForGX2DrawDoneEnabled() ? "true" : "false");
+	if (GetConfig().gpu_write_tracking.GetValue())
+		cemuLog_log(LogType::Force, "GPU memory write tracking: true");
 	cemuLog_log(LogType::Force, "Strict shader mul: {}", g_current_game_profile->GetAccurateShaderMul() == AccurateShaderMulOption::True ? "true" : "false");
 	if (ActiveSettings::GetGraphicsAPI() == GraphicAPI::kVulkan)
 	{
@@ -433,6 +437,7 @@ namespace CafeSystem
     static bool s_initialized = false;
 	static SystemImplementation* s_implementation{nullptr};
     bool sLaunchModeIsStandalone = false;
+	bool sLaunchModeIsCaptureReplay = false;
 	std::optional<std::vector<std::string>> s_overrideArgs;
 
 	bool sSystemRunning = false;
@@ -837,6 +842,20 @@ namespace CafeSystem
 		return STATUS_CODE::SUCCESS;
 	}
 
+	// replays a GPU capture created with LatteCapture_Request(). No title code is loaded or executed
+	STATUS_CODE PrepareForegroundTitleFromCapture(const fs::path& path)
+	{
+		uint64 titleId;
+		if (!LatteCaptureReplay_Open(path, titleId))
+			return STATUS_CODE::INVALID_RPX;
+		sLaunchModeIsStandalone = true;
+		sLaunchModeIsCaptureReplay = true;
+		sForegroundTitleId = titleId;
+		gameProfile_load();
+		SetupMemorySpace();
+		return STATUS_CODE::SUCCESS;
+	}
+
 	void _LaunchTitleThread()
 	{
 		for(auto& module : s_iosuModules)
@@ -855,6 +874,16 @@ namespace CafeSystem
 		// start system
 		sSystemRunning = true;
 		gui_notifyGameLoaded();
+		if (sLaunchModeIsCaptureReplay)
+		{
+			PPCTimer_start();
+			GraphicPack2::ActivateForCurrentTitle();
+			Latte_Start();
+			LatteCaptureReplay_Start();
+			return;
+		}
+		if (auto captureFrameCount = LaunchSettings::GetCaptureFrameCount())
+			LatteCapture_Request(*captureFrameCount);
 		std::thread t(_LaunchTitleThread);
 		t.detach();
 	}
@@ -986,6 +1015,17 @@ namespace CafeSystem
 	{
 		if(!sSystemRunning)
 			return;
+		if (sLaunchModeIsCaptureReplay)
+		{
+			LatteCaptureReplay_Stop();
+			Latte_Stop();
+			GX2::_GX2DriverReset();
+			GraphicPack2::Reset();
+			DestroyMemorySpace();
+			sLaunchModeIsCaptureReplay = false;
+			sSystemRunning = false;
+			return;
+		}
         coreinit::OSSchedulerEnd();
         Latte_Stop();
         // reset Cafe OS userspace modules
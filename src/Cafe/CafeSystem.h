@@ -29,6 +29,7 @@ namespace CafeSystem
 
 	STATUS_CODE PrepareForegroundTitle(TitleId titleId);
 	STATUS_CODE PrepareForegroundTitleFromStandaloneRPX(const fs::path& path);
+	STATUS_CODE PrepareForegroundTitleFromCapture(const fs::path& path);
 	void LaunchForegroundTitle();
 	bool IsTitleRunning();
 
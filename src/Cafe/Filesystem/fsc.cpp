@@ -72,6 +72,7 @@ std::recursive_mutex s_fscMutex;
 #define fscLeave() s_fscMutex.unlock();
 
 FSCMountPathNode* fsc_lookupPathVirtualNode(const char* path, sint32 priority = FSC_PRIORITY_BASE);
+void fsc_invalidateLookupCache();
 
 void fsc_reset()
 {
@@ -84,6 +85,7 @@ void fsc_reset()
 	// init root node for each priority
 	for (sint32 i = 0; i < FSC_PRIORITY_COUNT; i++)
 		s_fscRootNodePerPrio[i] = new FSCMountPathNode(nullptr);
+	fsc_invalidateLookupCache();
 }
 
 /*
@@ -161,6 +163,7 @@ sint32 fsc_mount(std::string_view mountPath, std::string_view targetPath, fscDev
 		return FSC_STATUS_INVALID_PATH;
 	}
     node->AssignDevice(fscDevice, ctx, targetPathWithSlash);
+	fsc_invalidateLookupCache();
 	fscLeave();
 	return FSC_STATUS_OK;
 }
@@ -187,6 +190,7 @@ bool fsc_unmount(std::string_view mountPath, sint32 priority)
 		delete mountPathNode;
 		mountPathNode = parent;
 	}
+	fsc_invalidateLookupCache();
 	fscLeave();
 	return true;
 }
@@ -199,9 +203,8 @@ void fsc_unmountAll()
 }
 
 // lookup virtual path and find mounted device and relative device directory
-bool fsc_lookupPath(const char* path, std::string& devicePathOut, fscDeviceC** fscDeviceOut, void** ctxOut, sint32 priority = FSC_PRIORITY_BASE)
+bool fsc_lookupPath(const FSCPath& parsedPath, std::string& devicePathOut, fscDeviceC** fscDeviceOut, void** ctxOut, sint32 priority = FSC_PRIORITY_BASE)
 {
-	FSCPath parsedPath(path);
 	FSCMountPathNode* nodeParent = s_fscRootNodePerPrio[priority];
 	size_t i;
 	fscEnter();
@@ -250,6 +253,98 @@ bool fsc_lookupPath(const char* path, std::string& devicePathOut, fscDeviceC** f
 	return false;
 }
 
+/*
+ * Lookup cache
+ * Resolving a path requires walking the mount tree and asking the device, which gets expensive when titles probe thousands of files
+ * For each priority we remember the device and device path a normalized virtual path resolves to. These entries stay valid until the mount tree changes
+ * For immutable devices we additionally remember which open modes failed with FILE_NOT_FOUND. Any FSC operation that can create, rename or remove files invalidates these negative results
+ */
+
+struct FSCLookupCacheEntry
+{
+	bool isMounted{}; // false if no device is mounted for this path
+	bool isImmutable{};
+	fscDeviceC* device{};
+	void* ctx{};
+	std::string devicePath;
+	// negative lookups
+	uint8 notFoundMask{}; // bit set for each combination of OPEN_FILE/OPEN_DIR that failed
+	uint32 notFoundGeneration{};
+};
+
+#define FSC_LOOKUP_CACHE_MAX_ENTRIES	(1024 * 64) // per priority
+
+std::unordered_map<std::string, FSCLookupCacheEntry> s_fscLookupCache[FSC_PRIORITY_COUNT];
+uint32 s_fscNegativeLookupGeneration = 0;
+
+// called whenever the mount tree changes
+void fsc_invalidateLookupCache()
+{
+	fscEnter();
+	for (auto& itr : s_fscLookupCache)
+		itr.clear();
+	fscLeave();
+}
+
+// called for any operation which may create or remove files
+void fsc_invalidateNegativeLookups()
+{
+	fscEnter();
+	s_fscNegativeLookupGeneration++;
+	fscLeave();
+}
+
+void fsc_getNormalizedPath(const FSCPath& parsedPath, std::string& normalizedPathOut)
+{
+	normalizedPathOut.clear();
+	for (size_t i = 0; i < parsedPath.GetNodeCount(); i++)
+	{
+		normalizedPathOut.push_back('/');
+		normalizedPathOut.append(parsedPath.GetNodeName(i));
+	}
+}
+
+// same as fsc_lookupPath but the result is cached. Caller must hold the FSC lock while accessing the returned entry
+FSCLookupCacheEntry* fsc_lookupPathCached(const FSCPath& parsedPath, const std::string& normalizedPath, sint32 priority)
+{
+	auto& cache = s_fscLookupCache[priority];
+	auto it = cache.find(normalizedPath);
+	if (it != cache.end())
+		return &it->second;
+	if (cache.size() >= FSC_LOOKUP_CACHE_MAX_ENTRIES)
+		cache.clear();
+	FSCLookupCacheEntry& entry = cache[normalizedPath];
+	entry.isMounted = fsc_lookupPath(parsedPath, entry.devicePath, &entry.device, &entry.ctx, priority);
+	if (entry.isMounted)
+		entry.isImmutable = entry.device->fscDeviceIsImmutable(entry.ctx);
+	return &entry;
+}
+
+uint8 fsc_getNotFoundBit(FSC_ACCESS_FLAG accessFlags)
+{
+	uint8 openMode = (HAS_FLAG(accessFlags, FSC_ACCESS_FLAG::OPEN_FILE) ? 1 : 0) | (HAS_FLAG(accessFlags, FSC_ACCESS_FLAG::OPEN_DIR) ? 2 : 0);
+	return 1 << openMode;
+}
+
+bool fsc_isKnownNotFound(FSCLookupCacheEntry* entry, FSC_ACCESS_FLAG accessFlags)
+{
+	if (!entry->isImmutable || entry->notFoundGeneration != s_fscNegativeLookupGeneration)
+		return false;
+	return (entry->notFoundMask & fsc_getNotFoundBit(accessFlags)) != 0;
+}
+
+void fsc_markNotFound(FSCLookupCacheEntry* entry, FSC_ACCESS_FLAG accessFlags)
+{
+	if (!entry->isImmutable)
+		return;
+	if (entry->notFoundGeneration != s_fscNegativeLookupGeneration)
+	{
+		entry->notFoundMask = 0;
+		entry->notFoundGeneration = s_fscNegativeLookupGeneration;
+	}
+	entry->notFoundMask |= fsc_getNotFoundBit(accessFlags);
+}
+
 // lookup path and find virtual device node
 FSCMountPathNode* fsc_lookupPathVirtualNode(const char* path, sint32 priority)
 {
@@ -380,16 +475,25 @@ FSCVirtualFile* fsc_open(const char* path, FSC_ACCESS_FLAG accessFlags, sint32*
 	cemu_assert_debug(HAS_FLAG(accessFlags, FSC_ACCESS_FLAG::OPEN_FILE) || HAS_FLAG(accessFlags, FSC_ACCESS_FLAG::OPEN_DIR)); // must open either file or directory
 	FSCVirtualFile* dirList[FSC_PRIORITY_COUNT];
 	uint8 dirListCount = 0;
-	std::string devicePath;
-	fscDeviceC* fscDevice = NULL;
 	*fscStatus = FSC_STATUS_UNDEFINED;
-	void* ctx;
+	FSCPath parsedPath(path);
+	std::string normalizedPath;
+	fsc_getNormalizedPath(parsedPath, normalizedPath);
+	// negative lookups can only be reused when the open operation cannot create a file
+	bool mayCreateFile = HAS_FLAG(accessFlags, FSC_ACCESS_FLAG::FILE_ALLOW_CREATE) || HAS_FLAG(accessFlags, FSC_ACCESS_FLAG::FILE_ALWAYS_CREATE);
 	fscEnter();
+	if (mayCreateFile)
+		fsc_invalidateNegativeLookups();
 	for (sint32 prio = maxPriority; prio >= 0; prio--)
 	{
-		if (fsc_lookupPath(path, devicePath, &fscDevice, &ctx, prio))
+		FSCLookupCacheEntry* lookupEntry = fsc_lookupPathCached(parsedPath, normalizedPath, prio);
+		if (lookupEntry->isMounted)
 		{
-			FSCVirtualFile* fscVirtualFile = fscDevice->fscDeviceOpenByPath(devicePath, accessFlags, ctx, fscStatus);
+			if (!mayCreateFile && fsc_isKnownNotFound(lookupEntry, accessFlags))
+				continue;
+			FSCVirtualFile* fscVirtualFile = lookupEntry->device->fscDeviceOpenByPath(lookupEntry->devicePath, accessFlags, lookupEntry->ctx, fscStatus);
+			if (!fscVirtualFile && *fscStatus == FSC_STATUS_FILE_NOT_FOUND && !mayCreateFile)
+				fsc_markNotFound(lookupEntry, accessFlags);
 			if (fscVirtualFile)
 			{
 				if (fscVirtualFile->fscGetType() == FSC_TYPE_DIRECTORY)
@@ -474,7 +578,8 @@ bool fsc_createDir(const char* path, sint32* fscStatus)
 	void* ctx;
 	std::string devicePath;
 	fscEnter();
-	if( fsc_lookupPath(path, devicePath, &fscDevice, &ctx) )
+	fsc_invalidateNegativeLookups();
+	if( fsc_lookupPath(FSCPath(path), devicePath, &fscDevice, &ctx) )
 	{
 		sint32 status = fscDevice->fscDeviceCreateDir(devicePath, ctx, fscStatus);
 		fscLeave();
@@ -496,11 +601,18 @@ bool fsc_rename(const char* srcPath, const char* dstPath, sint32* fscStatus)
 	fscDeviceC* fscSrcDevice = NULL;
 	fscDeviceC* fscDstDevice = NULL;
 	*fscStatus = FSC_STATUS_UNDEFINED;
-	if( fsc_lookupPath(srcPath, srcDevicePath, &fscSrcDevice, &srcCtx) && fsc_lookupPath(dstPath, dstDevicePath, &fscDstDevice, &dstCtx) )
+	fscEnter();
+	fsc_invalidateNegativeLookups();
+	if( fsc_lookupPath(FSCPath(srcPath), srcDevicePath, &fscSrcDevice, &srcCtx) && fsc_lookupPath(FSCPath(dstPath), dstDevicePath, &fscDstDevice, &dstCtx) )
 	{
-		if( fscSrcDevice == fscDstDevice )
-			return fscSrcDevice->fscDeviceRename(srcDevicePath, dstDevicePath, srcCtx, fscStatus);
+		if (fscSrcDevice == fscDstDevice)
+		{
+			bool r = fscSrcDevice->fscDeviceRename(srcDevicePath, dstDevicePath, srcCtx, fscStatus);
+			fscLeave();
+			return r;
+		}
 	}
+	fscLeave();
 	return false;
 }
 
@@ -513,10 +625,15 @@ bool fsc_remove(const char* path, sint32* fscStatus)
 	fscDeviceC* fscDevice = NULL;
 	*fscStatus = FSC_STATUS_UNDEFINED;
 	void* ctx;
-	if( fsc_lookupPath(path, devicePath, &fscDevice, &ctx) )
+	fscEnter();
+	fsc_invalidateNegativeLookups();
+	if( fsc_lookupPath(FSCPath(path), devicePath, &fscDevice, &ctx) )
 	{
-		return fscDevice->fscDeviceRemoveFileOrDir(devicePath, ctx, fscStatus);
+		bool r = fscDevice->fscDeviceRemoveFileOrDir(devicePath, ctx, fscStatus);
+		fscLeave();
+		return r;
 	}
+	fscLeave();
 	return false;
 }
 
@@ -84,6 +84,12 @@ public:
 		return false;
 	}
 
+	// return true if the content of the device can only change through FSC while it is mounted
+	// this allows FSC to remember failed lookups instead of asking the device again
+	virtual bool fscDeviceIsImmutable(void* ctx)
+	{
+		return false;
+	}
 };
 
 
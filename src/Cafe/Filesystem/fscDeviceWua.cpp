@@ -158,6 +158,11 @@ class fscDeviceWUAC : public fscDeviceC
 		return nullptr;
 	}
 
+	bool fscDeviceIsImmutable(void* ctx) override
+	{
+		return true;
+	}
+
 	// singleton
 public:
 	static fscDeviceWUAC& instance()
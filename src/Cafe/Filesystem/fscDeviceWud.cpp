@@ -147,6 +147,11 @@ class fscDeviceWUDC : public fscDeviceC
 		return nullptr;
 	}
 
+	bool fscDeviceIsImmutable(void* ctx) override
+	{
+		return true;
+	}
+
 	// singleton
 public:
 	static fscDeviceWUDC& instance()
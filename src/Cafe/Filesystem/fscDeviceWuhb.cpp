@@ -136,6 +136,11 @@ class fscDeviceWUHB : public fscDeviceC
 		return new FSCDeviceWuhbFileCtx(reader, table_offset, isFile ? FSC_TYPE_FILE : FSC_TYPE_DIRECTORY);
 	}
 
+	bool fscDeviceIsImmutable(void* ctx) override
+	{
+		return true;
+	}
+
 	// singleton
   public:
 	static fscDeviceWUHB& instance()
@@ -14,6 +14,15 @@ struct gx2GPUSharedArea_t
 	volatile uint32 swapInterval; // vsync swap interval (0 means vsync is deactivated)
 };
 
+// groups of registers which are part of the host pipeline state
+// the command processor sets the group bit in LatteGPUState.pipelineStateDirtyMask whenever a register of the group is written
+#define LATTE_PIPELINE_STATE_GROUP_VERTEX_LAYOUT	(1 << 0) // vertex buffer strides
+#define LATTE_PIPELINE_STATE_GROUP_PRIMITIVE		(1 << 1) // primitive type, streamout enable, rasterization kill
+#define LATTE_PIPELINE_STATE_GROUP_RASTER			(1 << 2) // clip and polygon mode control
+#define LATTE_PIPELINE_STATE_GROUP_BLEND			(1 << 3) // color control, target mask and blend control
+#define LATTE_PIPELINE_STATE_GROUP_DEPTH_STENCIL	(1 << 4) // depth control and stencil reference masks
+#define LATTE_PIPELINE_STATE_GROUP_ALL				((1 << 5) - 1)
+
 struct LatteGPUState_t
 {
 	union
@@ -60,6 +69,9 @@ struct LatteGPUState_t
 	bool activeShaderHasError; // if try, at least one currently bound shader stage has an error and cannot be used for drawing
 	bool repeatTextureInitialization; // if set during rendertarget or texture initialization, repeat the process (textures likely have been invalidated)
 	bool requiresTextureBarrier; // set if glTextureBarrier should be called
+	uint32 aluConstWriteCounterPS; // incremented whenever ALU constants (uniform registers) of the pixel stage are written
+	uint32 aluConstWriteCounterVS; // same for the vertex stage
+	uint32 pipelineStateDirtyMask; // LATTE_PIPELINE_STATE_GROUP_*, cleared by the renderer once it picked up the changes
 	// OSScreen
 	struct  
 	{
@@ -136,6 +148,8 @@ void LatteTextureReadback_StartTransfer(LatteTextureView* textureView);
 bool LatteTextureReadback_Update(bool forceStart = false);
 void LatteTextureReadback_NotifyTextureDeletion(LatteTexture* texture);
 void LatteTextureReadback_UpdateFinishedTransfers(bool forceFinish);
+bool LatteTextureReadback_FinishOldestTransfer();
+void LatteTextureReadback_WaitForPendingWrites();
 
 // query
 
@@ -161,6 +175,8 @@ void LatteTiming_HandleTimedVsync();
 // command processor
 
 void LatteCP_ProcessRingbuffer();
+void LatteCP_NotifyNewCommands(); // wakes up the GPU thread if it is sleeping while waiting for commands
+uint32 LatteCP_ReplayRegisterWrites(uint32be* cmdBuffer, uint32 sizeInDWords); // applies only the register write packets of a captured command buffer, used for benchmarking
 
 // buffer cache
 
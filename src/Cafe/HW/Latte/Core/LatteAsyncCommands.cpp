@@ -65,6 +65,7 @@ void LatteAsyncCommands_queueForceTextureReadback(MPTR physAddr, MPTR mipAddr, u
 	swl_gpuAsyncCommands.LockWrite();
 	LatteAsyncCommandQueue.push(asyncCommand);
 	swl_gpuAsyncCommands.UnlockWrite();
+	LatteCP_NotifyNewCommands();
 }
 
 void LatteAsyncCommands_queueDeleteShader(uint64 shaderBaseHash, uint64 shaderAuxHash, LatteConst::ShaderType shaderType)
@@ -80,6 +81,7 @@ void LatteAsyncCommands_queueDeleteShader(uint64 shaderBaseHash, uint64 shaderAu
 	swl_gpuAsyncCommands.LockWrite();
 	LatteAsyncCommandQueue.push(asyncCommand);
 	swl_gpuAsyncCommands.UnlockWrite();
+	LatteCP_NotifyNewCommands();
 }
 
 void LatteAsyncCommands_waitUntilAllProcessed()
@@ -125,6 +127,7 @@ void LatteAsyncCommands_checkAndExecute()
 		}
 		else if (asyncCommand.type == ASYNC_CMD_DELETE_SHADER)
 		{
+			LatteShaderCache_StopBackgroundLoading();
 			LatteSHRC_RemoveFromCacheByHash(asyncCommand.deleteShader.shaderBaseHash, asyncCommand.deleteShader.shaderAuxHash, asyncCommand.deleteShader.shaderType);
 		}
 		else
@@ -1,10 +1,13 @@
 #include "Cafe/HW/Latte/Renderer/Renderer.h"
+#include "Cafe/HW/Latte/Core/LatteBufferCacheHash.h"
+#include "Cafe/HW/MMU/WriteTracker.h"
+#include "Cafe/HW/Latte/Core/LatteCapture.h"
 #include "util/ChunkedHeap/ChunkedHeap.h"
 #include "util/helpers/fspinlock.h"
 #include "config/ActiveSettings.h"
+#include "Cafe/HW/Espresso/Const.h"
 
-#define CACHE_PAGE_SIZE		0x400
-#define CACHE_PAGE_SIZE_M1	(CACHE_PAGE_SIZE-1)
+#define PAGE_HASH_BATCH		(64)
 
 uint32 g_currentCacheChronon = 0;
 
@@ -269,6 +272,37 @@ std::unique_ptr<VHeap> g_gpuBufferHeap = nullptr;
 std::vector<uint8> s_pageUploadBuffer;
 std::vector<class BufferCacheNode*> s_allCacheNodes;
 
+// coarse map of which parts of the address space are covered by cache nodes
+// DC flushes to regions without any nodes can be dropped immediately since newly created nodes always sync from RAM
+#define CACHE_REGION_SHIFT	(20) // 1MB regions
+std::atomic<uint32> s_cacheNodeCountPerRegion[1 << (32 - CACHE_REGION_SHIFT)]{};
+
+void LatteBufferCache_trackNodeRange(MPTR rangeBegin, MPTR rangeEnd, bool isAdded)
+{
+	uint32 firstRegion = rangeBegin >> CACHE_REGION_SHIFT;
+	uint32 lastRegion = (rangeEnd - 1) >> CACHE_REGION_SHIFT;
+	for (uint32 i = firstRegion; i <= lastRegion; i++)
+	{
+		if (isAdded)
+			s_cacheNodeCountPerRegion[i].fetch_add(1);
+		else
+			s_cacheNodeCountPerRegion[i].fetch_sub(1);
+	}
+}
+
+// size must be non-zero and the range must not extend past the end of the address space
+bool LatteBufferCache_isRangeTracked(MPTR rangeBegin, uint32 size)
+{
+	uint32 firstRegion = rangeBegin >> CACHE_REGION_SHIFT;
+	uint32 lastRegion = (rangeBegin + size - 1) >> CACHE_REGION_SHIFT;
+	for (uint32 i = firstRegion; i <= lastRegion; i++)
+	{
+		if (s_cacheNodeCountPerRegion[i].load(std::memory_order_relaxed) != 0)
+			return true;
+	}
+	return false;
+}
+
 void LatteBufferCache_removeSingleNodeFromTree(BufferCacheNode* node);
 
 class BufferCacheNode
@@ -353,11 +387,18 @@ public:
 
 		sint32 basePageIndex = getPageIndexFromAddrAligned(rangeBegin);
 		sint32 numPages = getPageCountFromRangeAligned(rangeBegin, rangeEnd);
-		uint8* pagePtr = memory_getPointerFromPhysicalOffset(rangeBegin);
 		sint32 uploadPageBegin = -1;
 		CachePageInfo* pageInfo = m_pageInfo.data() + basePageIndex;
+		// re-arm write tracking before any page is read
+		uint64 writeTrackerStamp = WriteTracker::BeginSync(rangeBegin, rangeEnd - rangeBegin);
+		// page hashes are calculated in batches ahead of the comparison loop
+		uint64 pageHashes[PAGE_HASH_BATCH];
 		for (sint32 i = 0; i < numPages; i++)
 		{
+			if ((i % PAGE_HASH_BATCH) == 0)
+				hashPageBatch(rangeBegin + i * CACHE_PAGE_SIZE, pageInfo, std::min<sint32>(numPages - i, PAGE_HASH_BATCH), pageHashes);
+			uint64 pageHash = pageHashes[i % PAGE_HASH_BATCH];
+			pageInfo->writeTrackerStamp = writeTrackerStamp;
 			if (pageInfo->hasStreamoutData)
 			{
 				// first upload any pending sequence of pages
@@ -369,7 +410,6 @@ public:
 					uploadPageBegin = -1;
 				}
 				// check if hash changed
-				uint64 pageHash = hashPage(pagePtr);
 				if (pageInfo->hash != pageHash)
 				{
 					pageInfo->hash = pageHash;
@@ -378,13 +418,10 @@ public:
 					if (!uploadPageWithStreamoutFiltered(basePageIndex + i))
 						pageInfo->hasStreamoutData = false; // all streamout data was replaced
 				}
-				pagePtr += CACHE_PAGE_SIZE;
 				pageInfo++;
 				continue;
 			}
 
-			uint64 pageHash = hashPage(pagePtr);
-			pagePtr += CACHE_PAGE_SIZE;
 			if (pageInfo->hash != pageHash)
 			{
 				if (uploadPageBegin == -1)
@@ -516,9 +553,40 @@ private:
 	struct CachePageInfo
 	{
 		uint64 hash{ 0 };
+		uint64 writeTrackerStamp{ 0 }; // hash is known to match memory as of this write tracker stamp
 		bool hasStreamoutData{ false };
 	};
 
+	// hash a batch of consecutive pages
+	// pages which the write tracker reports as unmodified since their last check keep their current hash
+	void hashPageBatch(MPTR physAddr, const CachePageInfo* pageInfo, sint32 numPages, uint64* hashOut)
+	{
+		const uint8* pagePtr = memory_getPointerFromPhysicalOffset(physAddr);
+		if (!WriteTracker::IsEnabled())
+		{
+			LatteBufferCache_hashPages(pagePtr, numPages, hashOut);
+			return;
+		}
+		sint32 hashRunBegin = -1;
+		for (sint32 i = 0; i < numPages; i++)
+		{
+			if (WriteTracker::WasModified(physAddr + i * CACHE_PAGE_SIZE, CACHE_PAGE_SIZE, pageInfo[i].writeTrackerStamp))
+			{
+				if (hashRunBegin == -1)
+					hashRunBegin = i;
+				continue;
+			}
+			if (hashRunBegin != -1)
+			{
+				LatteBufferCache_hashPages(pagePtr + hashRunBegin * CACHE_PAGE_SIZE, i - hashRunBegin, hashOut + hashRunBegin);
+				hashRunBegin = -1;
+			}
+			hashOut[i] = pageInfo[i].hash;
+		}
+		if (hashRunBegin != -1)
+			LatteBufferCache_hashPages(pagePtr + hashRunBegin * CACHE_PAGE_SIZE, numPages - hashRunBegin, hashOut + hashRunBegin);
+	}
+
 	MPTR m_rangeBegin;
 	MPTR m_rangeEnd; // (exclusive)
 	bool m_hasCacheAlloc{ false };
@@ -545,10 +613,15 @@ private:
 		// append to array
 		m_arrayIndex = (uint32)s_allCacheNodes.size();
 		s_allCacheNodes.emplace_back(this);
+		// make the range visible to DC flush filtering before any data is read from RAM
+		LatteBufferCache_trackNodeRange(m_rangeBegin, m_rangeEnd, true);
+		WriteTracker::RegisterRange(m_rangeBegin, m_rangeEnd - m_rangeBegin);
 	};
 
 	~BufferCacheNode()
 	{
+		LatteBufferCache_trackNodeRange(m_rangeBegin, m_rangeEnd, false);
+		WriteTracker::UnregisterRange(m_rangeBegin, m_rangeEnd - m_rangeBegin);
 		if (m_hasCacheAlloc)
 			g_deallocateQueue.emplace_back(m_cacheOffset); // release after current drawcall
 		// remove from array
@@ -631,11 +704,11 @@ private:
 		uint32 numPages = lastPagePlusOne - firstPage;
 		if (s_pageUploadBuffer.size() < (numPages * CACHE_PAGE_SIZE))
 			s_pageUploadBuffer.resize(numPages * CACHE_PAGE_SIZE);
-		// todo - improve performance by merging memcpy + hashPage() ?
-		memcpy(s_pageUploadBuffer.data(), memory_getPointerFromPhysicalOffset(uploadRangeBegin), numPages * CACHE_PAGE_SIZE);
+		// copy and hash in a single pass
+		const uint8* pageData = memory_getPointerFromPhysicalOffset(uploadRangeBegin);
 		for (uint32 i = 0; i < numPages; i++)
 		{
-			m_pageInfo[firstPage + i].hash = hashPage(s_pageUploadBuffer.data() + i * CACHE_PAGE_SIZE);
+			m_pageInfo[firstPage + i].hash = LatteBufferCache_copyAndHashPage(s_pageUploadBuffer.data() + i * CACHE_PAGE_SIZE, pageData + i * CACHE_PAGE_SIZE);
 		}
 		g_renderer->bufferCache_upload(s_pageUploadBuffer.data(), uploadRangeEnd - uploadRangeBegin, getBufferOffset(uploadRangeBegin));
 	}
@@ -646,13 +719,12 @@ private:
 	sint32 uploadPageWithStreamoutFiltered(uint32 pageIndex)
 	{
 		uint8 pageCopy[CACHE_PAGE_SIZE];
-		memcpy(pageCopy, memory_getPointerFromPhysicalOffset(m_rangeBegin + pageIndex * CACHE_PAGE_SIZE), CACHE_PAGE_SIZE);
+		m_pageInfo[pageIndex].hash = LatteBufferCache_copyAndHashPage(pageCopy, memory_getPointerFromPhysicalOffset(m_rangeBegin + pageIndex * CACHE_PAGE_SIZE));
 
 		MPTR pageBase = m_rangeBegin + pageIndex * CACHE_PAGE_SIZE;
 
 		sint32 blockBegin = -1;
 		uint64* pagePtrU64 = (uint64*)pageCopy;
-		m_pageInfo[pageIndex].hash = hashPage(pageCopy);
 		bool hasStreamoutBlocks = false;
 		for (sint32 i = 0; i < CACHE_PAGE_SIZE / 16; i++)
 		{
@@ -691,42 +763,14 @@ private:
 		cemu_assert_debug(newRangeEnd >= m_rangeEnd);
 		cemu_assert_debug(newRangeEnd > m_rangeBegin);
 		assert_dbg(); // todo (resize page array)
+		LatteBufferCache_trackNodeRange(newRangeBegin, newRangeEnd, true);
+		LatteBufferCache_trackNodeRange(m_rangeBegin, m_rangeEnd, false);
+		WriteTracker::RegisterRange(newRangeBegin, newRangeEnd - newRangeBegin);
+		WriteTracker::UnregisterRange(m_rangeBegin, m_rangeEnd - m_rangeBegin);
 		m_rangeBegin = newRangeBegin;
 		m_rangeEnd = newRangeEnd;
 	}
 
-	static uint64 hashPage(uint8* mem)
-	{
-		static const uint64 k0 = 0x55F23EAD;
-		static const uint64 k1 = 0x185FDC6D;
-		static const uint64 k2 = 0xF7431F49;
-		static const uint64 k3 = 0xA4C7AE9D;
-
-		cemu_assert_debug((CACHE_PAGE_SIZE % 32) == 0);
-		const uint64* ptr = (const uint64*)mem;
-		const uint64* end = ptr + (CACHE_PAGE_SIZE / sizeof(uint64));
-
-		uint64 h0 = 0;
-		uint64 h1 = 0;
-		uint64 h2 = 0;
-		uint64 h3 = 0;
-		while (ptr < end)
-		{
-			h0 = std::rotr(h0, 7);
-			h1 = std::rotr(h1, 7);
-			h2 = std::rotr(h2, 7);
-			h3 = std::rotr(h3, 7);
-
-			h0 += ptr[0] * k0;
-			h1 += ptr[1] * k1;
-			h2 += ptr[2] * k2;
-			h3 += ptr[3] * k3;
-			ptr += 4;
-		}
-
-		return h0 + h1 + h2 + h3;
-	}
-
 	// flag page as having streamout data, also write streamout signatures to page memory
 	// also incrementally updates the page hash to include the written signatures, this prevents signature writes from triggering a data upload
 	void pageWriteStreamoutSignatures(uint32 pageIndex, MPTR rangeBegin, MPTR rangeEnd)
@@ -770,6 +814,7 @@ private:
 			pageMem += 2;
 		}
 		pageInfo->hash = 0; // reset hash
+		pageInfo->writeTrackerStamp = 0;
 	}
 
 	static uint64 genStreamoutPageHash()
@@ -783,7 +828,7 @@ private:
 			pageMemU64 += 2;
 		}
 
-		return hashPage(pageMem);
+		return LatteBufferCache_hashPage(pageMem);
 	}
 
 	static inline uint64 c_fullStreamoutPageHash = genStreamoutPageHash();
@@ -941,6 +986,9 @@ uint32 LatteBufferCache_retrieveDataInCache(MPTR physAddress, uint32 size)
 
 	range->checkAndSyncModificationsIfChrononChanged(physAddress, size);
 
+	if (LatteCapture_IsActive())
+		LatteCapture_RecordMemory(physAddress, size);
+
 	return range->getBufferOffset(physAddress);
 }
 
@@ -1064,21 +1112,114 @@ private:
 SparseBitset* s_DCFlushQueue = new SparseBitset();
 SparseBitset* s_DCFlushQueueAlternate = new SparseBitset();
 
+// DC flushes are first collected per emulated core as a short list of page ranges. Consecutive flushes (e.g. many small memcpys into the same buffer) are merged
+// The Latte thread drains all accumulators when it processes the flush queue. Only when an accumulator overflows its ranges are spilled into the page-granular s_DCFlushQueue
+class DCFlushRangeAccumulator
+{
+	static inline constexpr size_t MAX_RANGES = 16;
+
+public:
+	void Add(uint32 firstPage, uint32 endPage)
+	{
+		m_lock.lock();
+		// try to merge with an existing range. Check the most recent one first
+		for (sint32 i = (sint32)m_numRanges - 1; i >= 0; i--)
+		{
+			auto& range = m_ranges[i];
+			if (firstPage <= range.second && endPage >= range.first)
+			{
+				range.first = std::min(range.first, firstPage);
+				range.second = std::max(range.second, endPage);
+				m_lock.unlock();
+				return;
+			}
+		}
+		if (m_numRanges >= MAX_RANGES)
+		{
+			// spill everything into the global queue
+			g_spinlockDCFlushQueue.lock();
+			for (size_t i = 0; i < m_numRanges; i++)
+			{
+				for (uint32 page = m_ranges[i].first; page < m_ranges[i].second; page++)
+					s_DCFlushQueue->Set(page);
+			}
+			g_spinlockDCFlushQueue.unlock();
+			m_numRanges = 0;
+		}
+		m_ranges[m_numRanges] = { firstPage, endPage };
+		m_numRanges++;
+		m_hasRanges.store(true, std::memory_order_release);
+		m_lock.unlock();
+	}
+
+	template<typename TFunc>
+	void ForAllAndClear(TFunc callbackFunc)
+	{
+		if (!m_hasRanges.load(std::memory_order_acquire))
+			return;
+		std::array<std::pair<uint32, uint32>, MAX_RANGES> ranges;
+		m_lock.lock();
+		size_t numRanges = m_numRanges;
+		std::copy_n(m_ranges.begin(), numRanges, ranges.begin());
+		m_numRanges = 0;
+		m_hasRanges.store(false, std::memory_order_relaxed);
+		m_lock.unlock();
+		for (size_t i = 0; i < numRanges; i++)
+			callbackFunc(ranges[i].first, ranges[i].second);
+	}
+
+private:
+	FSpinlock m_lock;
+	std::atomic<bool> m_hasRanges{ false };
+	std::array<std::pair<uint32, uint32>, MAX_RANGES> m_ranges; // [firstPage, endPage)
+	size_t m_numRanges{ 0 };
+};
+
+// one accumulator per PPC core plus one shared by host threads (IOSU, DMA)
+DCFlushRangeAccumulator s_DCFlushAccumulator[Espresso::CORE_COUNT + 1];
+
 void LatteBufferCache_notifyDCFlush(MPTR address, uint32 size)
 {
 	if (address == 0 || size == 0xFFFFFFFF)
 		return; // global flushes are ignored for now
+	if (size == 0)
+		return;
+	// clamp ranges which extend past the end of the address space
+	size = (uint32)std::min<uint64>(size, 0x100000000ull - address);
+
+	// skip flushes of memory which is not cached by the GPU. Pairs with the node registration in the BufferCacheNode constructor
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (!LatteBufferCache_isRangeTracked(address, size))
+		return;
 
 	uint32 firstPage = address / CACHE_PAGE_SIZE;
 	uint32 lastPage = (address + size - 1) / CACHE_PAGE_SIZE;
-	g_spinlockDCFlushQueue.lock();
-	for (uint32 i = firstPage; i <= lastPage; i++)
-		s_DCFlushQueue->Set(i);
-	g_spinlockDCFlushQueue.unlock();
+	PPCInterpreter_t* hCPU = PPCInterpreter_getCurrentInstance();
+	uint32 accumulatorIndex = hCPU ? PPCInterpreter_getCoreIndex(hCPU) : Espresso::CORE_COUNT;
+	s_DCFlushAccumulator[accumulatorIndex].Add(firstPage, lastPage + 1);
+}
+
+void LatteBufferCache_invalidatePageRange(uint32 firstPage, uint32 endPage)
+{
+	uint32 page = firstPage;
+	while (page < endPage)
+	{
+		MPTR pageAddr = page * CACHE_PAGE_SIZE;
+		if (s_cacheNodeCountPerRegion[pageAddr >> CACHE_REGION_SHIFT].load(std::memory_order_relaxed) == 0)
+		{
+			// skip to next region
+			page = ((pageAddr >> CACHE_REGION_SHIFT) + 1) * ((1 << CACHE_REGION_SHIFT) / CACHE_PAGE_SIZE);
+			continue;
+		}
+		LatteBufferCache_invalidatePage(pageAddr);
+		page++;
+	}
 }
 
 void LatteBufferCache_processDCFlushQueue()
 {
+	for (auto& accumulator : s_DCFlushAccumulator)
+		accumulator.ForAllAndClear(LatteBufferCache_invalidatePageRange);
 	if (s_DCFlushQueue->Empty()) // quick check to avoid locking if there is no work to do
 		return;
 	g_spinlockDCFlushQueue.lock();
@@ -0,0 +1,194 @@
+#include "Cafe/HW/Latte/Core/LatteBufferCacheHash.h"
+#include "Common/cpu_features.h"
+
+/*
+ * Page hash layout
+ * A page is processed as 64 byte stripes which are fed into eight 64bit accumulators:
+ * x = data[i] ^ key[stripe][i]
+ * acc[i] += lo32(x) * hi32(x)
+ * acc[i^1] += data[i]
+ * Only 32x32->64 multiplies are used so each lane maps directly onto pmuludq and the SIMD kernels stay bit-identical to the scalar version
+ * The keys differ per stripe so moving data within a page changes the hash
+ */
+
+#define PAGE_HASH_LANES		(8)
+#define PAGE_HASH_STRIPES	(CACHE_PAGE_SIZE / (PAGE_HASH_LANES * sizeof(uint64)))
+
+static_assert((CACHE_PAGE_SIZE % (PAGE_HASH_LANES * sizeof(uint64))) == 0);
+
+struct PageHashKeys
+{
+	constexpr PageHashKeys()
+	{
+		// splitmix64
+		uint64 state = 0x3C6EF372FE94F82Bull;
+		for (auto& k : keys)
+		{
+			state += 0x9E3779B97F4A7C15ull;
+			uint64 z = state;
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+			k = z ^ (z >> 31);
+		}
+	}
+
+	alignas(64) uint64 keys[PAGE_HASH_STRIPES * PAGE_HASH_LANES]{};
+};
+
+// constant initialized, the buffer cache already hashes pages during static initialization
+static constexpr PageHashKeys s_pageHashKeys;
+
+static uint64 _PageHash_finalize(const uint64* acc)
+{
+	uint64 h = 0;
+	for (uint32 i = 0; i < PAGE_HASH_LANES; i++)
+	{
+		h = std::rotl(h, 23) ^ acc[i];
+		h *= 0x9E3779B97F4A7C15ull;
+	}
+	return h ^ (h >> 29);
+}
+
+template<bool TCopy>
+static uint64 _PageHash_scalar(uint8* dst, const uint8* src)
+{
+	uint64 acc[PAGE_HASH_LANES]{};
+	const uint64* key = s_pageHashKeys.keys;
+	for (uint32 s = 0; s < PAGE_HASH_STRIPES; s++)
+	{
+		uint64 data[PAGE_HASH_LANES];
+		memcpy(data, src, sizeof(data));
+		if constexpr (TCopy)
+			memcpy(dst, data, sizeof(data));
+		for (uint32 i = 0; i < PAGE_HASH_LANES; i++)
+		{
+			uint64 x = data[i] ^ key[i];
+			acc[i] += (x & 0xFFFFFFFF) * (x >> 32);
+			acc[i ^ 1] += data[i];
+		}
+		src += sizeof(data);
+		if constexpr (TCopy)
+			dst += sizeof(data);
+		key += PAGE_HASH_LANES;
+	}
+	return _PageHash_finalize(acc);
+}
+
+#if defined(ARCH_X86_64)
+template<bool TCopy>
+static uint64 _PageHash_SSE2(uint8* dst, const uint8* src)
+{
+	__m128i acc0 = _mm_setzero_si128();
+	__m128i acc1 = _mm_setzero_si128();
+	__m128i acc2 = _mm_setzero_si128();
+	__m128i acc3 = _mm_setzero_si128();
+	const __m128i* key = (const __m128i*)s_pageHashKeys.keys;
+	auto accumulate = [](__m128i& acc, __m128i data, __m128i key)
+	{
+		__m128i x = _mm_xor_si128(data, key);
+		acc = _mm_add_epi64(acc, _mm_mul_epu32(x, _mm_srli_epi64(x, 32)));
+		acc = _mm_add_epi64(acc, _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2)));
+	};
+	for (uint32 s = 0; s < PAGE_HASH_STRIPES; s++)
+	{
+		__m128i d0 = _mm_loadu_si128((const __m128i*)src + 0);
+		__m128i d1 = _mm_loadu_si128((const __m128i*)src + 1);
+		__m128i d2 = _mm_loadu_si128((const __m128i*)src + 2);
+		__m128i d3 = _mm_loadu_si128((const __m128i*)src + 3);
+		if constexpr (TCopy)
+		{
+			_mm_storeu_si128((__m128i*)dst + 0, d0);
+			_mm_storeu_si128((__m128i*)dst + 1, d1);
+			_mm_storeu_si128((__m128i*)dst + 2, d2);
+			_mm_storeu_si128((__m128i*)dst + 3, d3);
+		}
+		accumulate(acc0, d0, _mm_load_si128(key + 0));
+		accumulate(acc1, d1, _mm_load_si128(key + 1));
+		accumulate(acc2, d2, _mm_load_si128(key + 2));
+		accumulate(acc3, d3, _mm_load_si128(key + 3));
+		src += 64;
+		if constexpr (TCopy)
+			dst += 64;
+		key += 4;
+	}
+	alignas(16) uint64 acc[PAGE_HASH_LANES];
+	_mm_store_si128((__m128i*)acc + 0, acc0);
+	_mm_store_si128((__m128i*)acc + 1, acc1);
+	_mm_store_si128((__m128i*)acc + 2, acc2);
+	_mm_store_si128((__m128i*)acc + 3, acc3);
+	return _PageHash_finalize(acc);
+}
+
+template<bool TCopy>
+ATTRIBUTE_AVX2
+static uint64 _PageHash_AVX2(uint8* dst, const uint8* src)
+{
+	__m256i acc0 = _mm256_setzero_si256();
+	__m256i acc1 = _mm256_setzero_si256();
+	const __m256i* key = (const __m256i*)s_pageHashKeys.keys;
+	for (uint32 s = 0; s < PAGE_HASH_STRIPES; s++)
+	{
+		__m256i d0 = _mm256_loadu_si256((const __m256i*)src + 0);
+		__m256i d1 = _mm256_loadu_si256((const __m256i*)src + 1);
+		if constexpr (TCopy)
+		{
+			_mm256_storeu_si256((__m256i*)dst + 0, d0);
+			_mm256_storeu_si256((__m256i*)dst + 1, d1);
+		}
+		__m256i x0 = _mm256_xor_si256(d0, _mm256_load_si256(key + 0));
+		__m256i x1 = _mm256_xor_si256(d1, _mm256_load_si256(key + 1));
+		acc0 = _mm256_add_epi64(acc0, _mm256_mul_epu32(x0, _mm256_srli_epi64(x0, 32)));
+		acc1 = _mm256_add_epi64(acc1, _mm256_mul_epu32(x1, _mm256_srli_epi64(x1, 32)));
+		acc0 = _mm256_add_epi64(acc0, _mm256_shuffle_epi32(d0, _MM_SHUFFLE(1, 0, 3, 2)));
+		acc1 = _mm256_add_epi64(acc1, _mm256_shuffle_epi32(d1, _MM_SHUFFLE(1, 0, 3, 2)));
+		src += 64;
+		if constexpr (TCopy)
+			dst += 64;
+		key += 2;
+	}
+	alignas(32) uint64 acc[PAGE_HASH_LANES];
+	_mm256_store_si256((__m256i*)acc + 0, acc0);
+	_mm256_store_si256((__m256i*)acc + 1, acc1);
+	return _PageHash_finalize(acc);
+}
+#endif
+
+uint64 LatteBufferCache_hashPage(const uint8* mem)
+{
+#if defined(ARCH_X86_64)
+	if (g_CPUFeatures.x86.avx2)
+		return _PageHash_AVX2<false>(nullptr, mem);
+	return _PageHash_SSE2<false>(nullptr, mem);
+#else
+	return _PageHash_scalar<false>(nullptr, mem);
+#endif
+}
+
+void LatteBufferCache_hashPages(const uint8* mem, uint32 numPages, uint64* hashOut)
+{
+	uint64(*hashFunc)(uint8*, const uint8*);
+#if defined(ARCH_X86_64)
+	if (g_CPUFeatures.x86.avx2)
+		hashFunc = _PageHash_AVX2<false>;
+	else
+		hashFunc = _PageHash_SSE2<false>;
+#else
+	hashFunc = _PageHash_scalar<false>;
+#endif
+	for (uint32 i = 0; i < numPages; i++)
+	{
+		hashOut[i] = hashFunc(nullptr, mem);
+		mem += CACHE_PAGE_SIZE;
+	}
+}
+
+uint64 LatteBufferCache_copyAndHashPage(uint8* dst, const uint8* src)
+{
+#if defined(ARCH_X86_64)
+	if (g_CPUFeatures.x86.avx2)
+		return _PageHash_AVX2<true>(dst, src);
+	return _PageHash_SSE2<true>(dst, src);
+#else
+	return _PageHash_scalar<true>(dst, src);
+#endif
+}
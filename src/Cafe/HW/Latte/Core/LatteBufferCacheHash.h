@@ -0,0 +1,11 @@
+#pragma once
+
+#define CACHE_PAGE_SIZE		0x400
+#define CACHE_PAGE_SIZE_M1	(CACHE_PAGE_SIZE-1)
+
+// hashes are used by the buffer cache to detect modifications of guest memory
+// all implementations (scalar, SSE2, AVX2) produce identical results
+uint64 LatteBufferCache_hashPage(const uint8* mem);
+void LatteBufferCache_hashPages(const uint8* mem, uint32 numPages, uint64* hashOut);
+// copies a page and returns the hash of the copied data
+uint64 LatteBufferCache_copyAndHashPage(uint8* dst, const uint8* src);
@@ -9,6 +9,7 @@
 #include "Cafe/GameProfile/GameProfile.h"
 
 #include "Cafe/HW/Latte/Core/LatteBufferCache.h"
+#include "Cafe/HW/Latte/Core/LatteCapture.h"
 #include "Cafe/HW/Latte/Renderer/Vulkan/VulkanRenderer.h"
 
 template<int vectorLen>
@@ -115,6 +116,13 @@ void LatteBufferCache_LoadRemappedUniforms(LatteDecompilerShader* shader, float*
 				uint64* uniformEntrySrc = (uint64*)(uniformBase + it.indexOffset);
 				memcpy(regDest, uniformEntrySrc, 16);
 			}
+			if (LatteCapture_IsActive())
+			{
+				uint32 accessedSize = 0;
+				for (auto& it : bufferGroup.entries)
+					accessedSize = std::max<uint32>(accessedSize, it.indexOffset + 16);
+				LatteCapture_RecordMemory(physicalAddr, accessedSize);
+			}
 		}
 		else
 		{
@@ -197,7 +205,7 @@ bool LatteBufferCache_Sync(uint32 minIndex, uint32 maxIndex, uint32 baseInstance
 
 
 #if BOOST_OS_MACOS
-		if(bufferStride % 4 != 0)
+		if(bufferStride % 4 != 0 && g_renderer->GetType() == RendererAPI::Vulkan)
 		{
 			if (VulkanRenderer* vkRenderer = VulkanRenderer::GetInstance())
 			{
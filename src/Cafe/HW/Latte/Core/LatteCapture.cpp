@@ -0,0 +1,625 @@
+#include "Cafe/HW/Latte/Core/Latte.h"
+#include "Cafe/HW/Latte/Core/LatteCapture.h"
+#include "Cafe/HW/Latte/Core/LattePM4.h"
+#include "Cafe/HW/Latte/Core/LatteTexture.h"
+#include "Cafe/HW/Latte/ISA/RegDefines.h"
+#include "Cafe/OS/libs/gx2/GX2.h"
+#include "Cafe/OS/libs/gx2/GX2_Command.h"
+#include "Cafe/OS/libs/gx2/GX2_Misc.h"
+#include "Cafe/HW/MMU/MMU.h"
+#include "Cafe/CafeSystem.h"
+#include "Common/FileStream.h"
+#include "config/ActiveSettings.h"
+#include "config/LaunchSettings.h"
+#include "gui/guiWrapper.h"
+#include "util/helpers/Serializer.h"
+#include "util/helpers/helpers.h"
+#include "util/highresolutiontimer/HighResolutionTimer.h"
+#include <zstd.h>
+
+// File format (zstd compressed stream):
+// Header: magic, version, titleId, number of frames, register count, context registers and shadow addresses (host byte order), context control words, instance count
+// Followed by a list of chunks, each starting with a LATTE_CAPTURE_CHUNK byte:
+// MEMORY:		physAddr, size, data. Guest memory as seen by the GPU before the next packet is processed
+// PACKET:		number of words, PM4 packet including the header (big-endian)
+// FRAME_END:	end of a frame (follows the scanbuffer swap packet)
+// END:			end of the capture
+//
+// Limitations:
+// - State which only exists on the GPU side at the time the capture starts (render targets, streamout buffers, queries) is not part of the capture
+// - Memory which is only accessed through HLE copy/clear commands is not recorded
+// - Memory is recorded when the GPU reads it. Ranges which are modified by the CPU while a single packet (e.g. a display list) is processed only retain the last state
+
+#define LATTE_CAPTURE_MAGIC				(0x4C434150) // 'LCAP'
+#define LATTE_CAPTURE_VERSION			(1)
+#define LATTE_CAPTURE_FLUSH_SIZE		(16 * 1024 * 1024) // compress and write the chunk buffer once it reaches this size
+
+#define LATTE_REPLAY_MEMORY_PACKET_SIZE	(32 * 1024) // max bytes of memory data per replay packet
+#define LATTE_REPLAY_MAX_QUEUED_BYTES	(8 * 1024 * 1024) // how far the replay thread can run ahead of the command processor
+
+enum class LATTE_CAPTURE_CHUNK : uint8
+{
+	END = 0,
+	MEMORY = 1,
+	PACKET = 2,
+	FRAME_END = 3,
+};
+
+std::atomic_bool g_latteCaptureActive{false};
+
+struct LatteCaptureRange
+{
+	std::vector<uint8> data; // copy of the memory as it was last recorded
+	uint32 lastVerifiedFrame;
+};
+
+static struct
+{
+	// request from UI thread
+	std::mutex requestMutex;
+	bool hasRequest{};
+	fs::path requestedPath;
+	uint32 requestedFrames{};
+	// recording state, only accessed from the GPU thread
+	bool isRecording{};
+	uint32 numFrames{};
+	uint32 numRecordedFrames{};
+	fs::path path;
+	FileStream* file{};
+	ZSTD_CCtx* cctx{};
+	MemStreamWriter chunkWriter{0};
+	std::vector<uint8> flushBuffer;
+	std::vector<uint8> compressBuffer;
+	uint64 uncompressedSize{};
+	uint64 compressedSize{};
+	std::unordered_map<uint64, LatteCaptureRange> recordedRanges; // key is (physAddr << 32) | size
+	std::vector<uint32be> pendingPacket;
+	bool hasPendingPacket{};
+}s_capture;
+
+static void _LatteCapture_Flush(bool isEnd)
+{
+	s_capture.chunkWriter.getResultAndReset(s_capture.flushBuffer);
+	s_capture.uncompressedSize += s_capture.flushBuffer.size();
+	ZSTD_inBuffer input{ s_capture.flushBuffer.data(), s_capture.flushBuffer.size(), 0 };
+	while (true)
+	{
+		ZSTD_outBuffer output{ s_capture.compressBuffer.data(), s_capture.compressBuffer.size(), 0 };
+		size_t r = ZSTD_compressStream2(s_capture.cctx, &output, &input, isEnd ? ZSTD_e_end : ZSTD_e_continue);
+		if (ZSTD_isError(r))
+		{
+			cemuLog_log(LogType::Force, "GPU capture: Compression failed ({})", ZSTD_getErrorName(r));
+			break;
+		}
+		s_capture.file->writeData(s_capture.compressBuffer.data(), output.pos);
+		s_capture.compressedSize += output.pos;
+		if (isEnd ? (r == 0) : (input.pos == input.size))
+			break;
+	}
+}
+
+static void _LatteCapture_ChunkWritten()
+{
+	if (s_capture.chunkWriter.getResult().size() >= LATTE_CAPTURE_FLUSH_SIZE)
+		_LatteCapture_Flush(false);
+}
+
+static void _LatteCapture_WriteMemoryChunk(MPTR physAddr, const void* data, uint32 size)
+{
+	MemStreamWriter& writer = s_capture.chunkWriter;
+	writer.writeBE<uint8>((uint8)LATTE_CAPTURE_CHUNK::MEMORY);
+	writer.writeBE<uint32>(physAddr);
+	writer.writeBE<uint32>(size);
+	writer.writeData(data, size);
+	_LatteCapture_ChunkWritten();
+}
+
+static void _LatteCapture_Begin()
+{
+	{
+		std::unique_lock _l(s_capture.requestMutex);
+		if (!s_capture.hasRequest)
+			return;
+		s_capture.hasRequest = false;
+		s_capture.path = s_capture.requestedPath;
+		s_capture.numFrames = s_capture.requestedFrames;
+	}
+	s_capture.file = FileStream::createFile2(s_capture.path);
+	if (!s_capture.file)
+	{
+		cemuLog_log(LogType::Force, "GPU capture: Unable to create file {}", _pathToUtf8(s_capture.path));
+		g_latteCaptureActive = false;
+		return;
+	}
+	s_capture.cctx = ZSTD_createCCtx();
+	ZSTD_CCtx_setParameter(s_capture.cctx, ZSTD_c_compressionLevel, 3);
+	s_capture.compressBuffer.resize(ZSTD_CStreamOutSize());
+	s_capture.uncompressedSize = 0;
+	s_capture.compressedSize = 0;
+	s_capture.numRecordedFrames = 0;
+	s_capture.recordedRanges.clear();
+	s_capture.hasPendingPacket = false;
+	s_capture.isRecording = true;
+	// header and initial register state
+	MemStreamWriter& writer = s_capture.chunkWriter;
+	writer.writeBE<uint32>(LATTE_CAPTURE_MAGIC);
+	writer.writeBE<uint32>(LATTE_CAPTURE_VERSION);
+	writer.writeBE<uint64>(CafeSystem::GetForegroundTitleId());
+	writer.writeBE<uint32>(s_capture.numFrames);
+	writer.writeBE<uint32>(LATTE_MAX_REGISTER);
+	writer.writeData(LatteGPUState.contextRegister, sizeof(LatteGPUState.contextRegister));
+	writer.writeData(LatteGPUState.contextRegisterShadowAddr, sizeof(LatteGPUState.contextRegisterShadowAddr));
+	writer.writeBE<uint32>(LatteGPUState.contextControl0);
+	writer.writeBE<uint32>(LatteGPUState.contextControl1);
+	writer.writeBE<uint32>(LatteGPUState.drawContext.numInstances);
+	cemuLog_log(LogType::Force, "GPU capture: Recording {} frames to {}", s_capture.numFrames, _pathToUtf8(s_capture.path));
+}
+
+static void _LatteCapture_Finish()
+{
+	s_capture.chunkWriter.writeBE<uint8>((uint8)LATTE_CAPTURE_CHUNK::END);
+	_LatteCapture_Flush(true);
+	delete s_capture.file;
+	s_capture.file = nullptr;
+	ZSTD_freeCCtx(s_capture.cctx);
+	s_capture.cctx = nullptr;
+	s_capture.recordedRanges.clear();
+	s_capture.isRecording = false;
+	cemuLog_log(LogType::Force, "GPU capture: Recorded {} frames ({}MB, {}MB uncompressed)", s_capture.numRecordedFrames, s_capture.compressedSize / 1024 / 1024, s_capture.uncompressedSize / 1024 / 1024);
+	g_latteCaptureActive = false;
+}
+
+bool LatteCapture_Request(uint32 numFrames)
+{
+	std::unique_lock _l(s_capture.requestMutex);
+	if (g_latteCaptureActive || numFrames == 0)
+		return false;
+	fs::path path = ActiveSettings::GetUserDataPath("dump/capture/{:016x}_{}.lcap", CafeSystem::GetForegroundTitleId(), (uint32)time(nullptr));
+	std::error_code ec;
+	fs::create_directories(path.parent_path(), ec);
+	s_capture.requestedPath = path;
+	s_capture.requestedFrames = numFrames;
+	s_capture.hasRequest = true;
+	// recording starts with the next frame
+	g_latteCaptureActive = true;
+	return true;
+}
+
+// called from the GPU thread when it shuts down
+void LatteCapture_Stop()
+{
+	if (s_capture.isRecording)
+		_LatteCapture_Finish();
+	std::unique_lock _l(s_capture.requestMutex);
+	s_capture.hasRequest = false;
+	g_latteCaptureActive = false;
+}
+
+void LatteCapture_BeginPacket(uint32 itHeader, const uint32be* data, uint32 nWords)
+{
+	if (!s_capture.isRecording)
+		return;
+	uint32 itCode = (itHeader >> 8) & 0xFF;
+	// wrap around marks belong to the ring buffer layout of the recording session
+	if (itCode == IT_HLE_FIFO_WRAP_AROUND)
+		return;
+	s_capture.pendingPacket.resize(1 + nWords);
+	s_capture.pendingPacket[0] = itHeader;
+	std::copy(data, data + nWords, s_capture.pendingPacket.data() + 1);
+	s_capture.hasPendingPacket = true;
+}
+
+void LatteCapture_EndPacket(uint32 itHeader)
+{
+	uint32 itCode = (itHeader >> 8) & 0xFF;
+	if (!s_capture.isRecording)
+	{
+		if (itCode == IT_HLE_TRIGGER_SCANBUFFER_SWAP)
+			_LatteCapture_Begin();
+		return;
+	}
+	// memory recorded while the packet was processed has already been written and precedes the packet in the stream
+	if (s_capture.hasPendingPacket)
+	{
+		MemStreamWriter& writer = s_capture.chunkWriter;
+		writer.writeBE<uint8>((uint8)LATTE_CAPTURE_CHUNK::PACKET);
+		writer.writeBE<uint32>((uint32)s_capture.pendingPacket.size());
+		writer.writeData(s_capture.pendingPacket.data(), s_capture.pendingPacket.size() * sizeof(uint32be));
+		s_capture.hasPendingPacket = false;
+		_LatteCapture_ChunkWritten();
+	}
+	if (itCode == IT_HLE_TRIGGER_SCANBUFFER_SWAP)
+	{
+		s_capture.chunkWriter.writeBE<uint8>((uint8)LATTE_CAPTURE_CHUNK::FRAME_END);
+		s_capture.numRecordedFrames++;
+		if (s_capture.numRecordedFrames >= s_capture.numFrames)
+			_LatteCapture_Finish();
+	}
+}
+
+static void _LatteCapture_RecordMemory(MPTR physAddr, uint32 size, bool verifyOncePerFrame)
+{
+	if (physAddr == MPTR_NULL || size == 0)
+		return;
+	if (!memory_isAddressRangeAccessible(memory_physicalToVirtual(physAddr), size))
+		return;
+	const uint8* data = memory_getPointerFromPhysicalOffset(physAddr);
+	LatteCaptureRange& range = s_capture.recordedRanges[((uint64)physAddr << 32) | size];
+	if (!range.data.empty())
+	{
+		if (verifyOncePerFrame && range.lastVerifiedFrame == s_capture.numRecordedFrames)
+			return;
+		range.lastVerifiedFrame = s_capture.numRecordedFrames;
+		if (memcmp(range.data.data(), data, size) == 0)
+			return;
+	}
+	range.data.assign(data, data + size);
+	range.lastVerifiedFrame = s_capture.numRecordedFrames;
+	_LatteCapture_WriteMemoryChunk(physAddr, data, size);
+}
+
+void LatteCapture_RecordMemory(MPTR physAddr, uint32 size)
+{
+	if (!s_capture.isRecording)
+		return;
+	_LatteCapture_RecordMemory(physAddr, size, false);
+}
+
+// records the given value unconditionally, used for memory which is also written by the GPU (fences, semaphores)
+void LatteCapture_RecordMemoryData(MPTR physAddr, const void* data, uint32 size)
+{
+	if (!s_capture.isRecording)
+		return;
+	_LatteCapture_WriteMemoryChunk(physAddr, data, size);
+}
+
+void LatteCapture_RecordTexture(LatteTexture* texture)
+{
+	if (!s_capture.isRecording)
+		return;
+	// the content of textures which were modified by the GPU is not reflected in guest memory
+	if (texture->isUpdatedOnGPU)
+		return;
+	// textures are large, only compare them once per frame
+	MPTR baseBegin = 0xFFFFFFFF, baseEnd = 0;
+	MPTR mipBegin = 0xFFFFFFFF, mipEnd = 0;
+	for (sint32 i = 0; i < texture->GetSliceMipArraySize(); i++)
+	{
+		LatteTextureSliceMipInfo& sliceMipInfo = texture->sliceMipInfo[i];
+		if (sliceMipInfo.addrEnd <= sliceMipInfo.addrStart)
+			continue;
+		if (sliceMipInfo.mipIndex == 0)
+		{
+			baseBegin = std::min(baseBegin, sliceMipInfo.addrStart);
+			baseEnd = std::max(baseEnd, sliceMipInfo.addrEnd);
+		}
+		else
+		{
+			mipBegin = std::min(mipBegin, sliceMipInfo.addrStart);
+			mipEnd = std::max(mipEnd, sliceMipInfo.addrEnd);
+		}
+	}
+	if (baseEnd > baseBegin)
+		_LatteCapture_RecordMemory(baseBegin, baseEnd - baseBegin, true);
+	if (mipEnd > mipBegin)
+		_LatteCapture_RecordMemory(mipBegin, mipEnd - mipBegin, true);
+}
+
+void LatteCapture_RecordDrawState(uint32 count, MPTR physIndices)
+{
+	if (!s_capture.isRecording)
+		return;
+	const uint32 programRegisters[] = { mmSQ_PGM_START_FS, mmSQ_PGM_START_VS, mmSQ_PGM_START_GS, mmSQ_PGM_START_ES, mmSQ_PGM_START_PS };
+	for (uint32 reg : programRegisters)
+	{
+		MPTR programAddr = (LatteGPUState.contextRegister[reg] & 0xFFFFFF) << 8;
+		uint32 programSize = LatteGPUState.contextRegister[reg + 1] << 3;
+		_LatteCapture_RecordMemory(programAddr, programSize, false);
+	}
+	if (physIndices != MPTR_NULL)
+	{
+		auto indexType = LatteGPUState.contextNew.VGT_DMA_INDEX_TYPE.get_INDEX_TYPE();
+		bool is32Bit = indexType == Latte::LATTE_VGT_DMA_INDEX_TYPE::E_INDEX_TYPE::U32_LE || indexType == Latte::LATTE_VGT_DMA_INDEX_TYPE::E_INDEX_TYPE::U32_BE;
+		_LatteCapture_RecordMemory(physIndices, count * (is32Bit ? 4 : 2), false);
+	}
+}
+
+/* Replay */
+
+static struct
+{
+	std::vector<uint8> data; // decompressed capture
+	std::unique_ptr<MemStreamReader> reader; // positioned at the first chunk
+	uint32 numFrames{};
+	std::vector<uint32> contextRegister;
+	std::vector<uint32> contextRegisterShadowAddr;
+	uint32 contextControl0{};
+	uint32 contextControl1{};
+	uint32 numInstances{};
+	std::vector<uint32be> packetBuffer;
+	std::thread thread;
+	std::atomic_bool stopRequested{};
+	std::atomic_bool isActive{}; // memory writes from the command stream are only accepted while set
+}s_replay;
+
+bool LatteCaptureReplay_Open(const fs::path& path, uint64& titleId)
+{
+	auto compressedData = FileStream::LoadIntoMemory(path);
+	if (!compressedData)
+	{
+		cemuLog_log(LogType::Force, "GPU replay: Unable to open {}", _pathToUtf8(path));
+		return false;
+	}
+	s_replay.data.clear();
+	ZSTD_DCtx* dctx = ZSTD_createDCtx();
+	ZSTD_inBuffer input{ compressedData->data(), compressedData->size(), 0 };
+	bool hasError = false;
+	while (true)
+	{
+		size_t outputOffset = s_replay.data.size();
+		s_replay.data.resize(outputOffset + ZSTD_DStreamOutSize());
+		ZSTD_outBuffer output{ s_replay.data.data() + outputOffset, ZSTD_DStreamOutSize(), 0 };
+		size_t r = ZSTD_decompressStream(dctx, &output, &input);
+		s_replay.data.resize(outputOffset + output.pos);
+		if (ZSTD_isError(r))
+		{
+			hasError = true;
+			break;
+		}
+		if (r == 0 || (input.pos == input.size && output.pos == 0))
+			break;
+	}
+	ZSTD_freeDCtx(dctx);
+	if (hasError)
+	{
+		cemuLog_log(LogType::Force, "GPU replay: {} is corrupted", _pathToUtf8(path));
+		return false;
+	}
+	s_replay.reader = std::make_unique<MemStreamReader>(s_replay.data.data(), (sint32)s_replay.data.size());
+	MemStreamReader& reader = *s_replay.reader;
+	uint32 magic = reader.readBE<uint32>();
+	uint32 version = reader.readBE<uint32>();
+	if (magic != LATTE_CAPTURE_MAGIC || version != LATTE_CAPTURE_VERSION)
+	{
+		cemuLog_log(LogType::Force, "GPU replay: {} is not a supported capture file", _pathToUtf8(path));
+		return false;
+	}
+	titleId = reader.readBE<uint64>();
+	s_replay.numFrames = reader.readBE<uint32>();
+	uint32 numRegisters = reader.readBE<uint32>();
+	if (numRegisters != LATTE_MAX_REGISTER)
+	{
+		cemuLog_log(LogType::Force, "GPU replay: Register count mismatch");
+		return false;
+	}
+	s_replay.contextRegister.resize(numRegisters);
+	s_replay.contextRegisterShadowAddr.resize(numRegisters);
+	reader.readData(s_replay.contextRegister.data(), numRegisters * sizeof(uint32));
+	reader.readData(s_replay.contextRegisterShadowAddr.data(), numRegisters * sizeof(uint32));
+	s_replay.contextControl0 = reader.readBE<uint32>();
+	s_replay.contextControl1 = reader.readBE<uint32>();
+	s_replay.numInstances = reader.readBE<uint32>();
+	if (reader.hasError())
+	{
+		cemuLog_log(LogType::Force, "GPU replay: {} is truncated", _pathToUtf8(path));
+		return false;
+	}
+	cemuLog_log(LogType::Force, "GPU replay: Loaded {} ({} frames, title {:016x})", _pathToUtf8(path), s_replay.numFrames, titleId);
+	return true;
+}
+
+// writes already big-endian words into the ring buffer
+static bool _LatteCaptureReplay_Submit(const uint32be* data, uint32 numWords)
+{
+	// dont run too far ahead of the command processor
+	while (GX2::GX2WriteGather_getReadWriteDistance() >= LATTE_REPLAY_MAX_QUEUED_BYTES)
+	{
+		if (s_replay.stopRequested)
+			return false;
+		std::this_thread::yield();
+	}
+	uint8* ringBuffer = gx2WriteGatherPipe.gxRingBuffer;
+	uint8*& writePtr = gx2WriteGatherPipe.writeGatherPtrGxBuffer[GX2::sGX2MainCoreIndex];
+	if ((uint32)(writePtr - ringBuffer) >= (GX2_COMMAND_RING_BUFFER_SIZE * 3 / 5))
+	{
+		// same wrap around logic as GX2WriteGather_checkAndInsertWrapAroundMark
+		uint32be wrapAroundPacket[2];
+		wrapAroundPacket[0] = pm4HeaderType3(IT_HLE_FIFO_WRAP_AROUND, 1);
+		wrapAroundPacket[1] = 0;
+		memcpy(writePtr, wrapAroundPacket, sizeof(wrapAroundPacket));
+		std::atomic_ref<uint8*>(writePtr).store(ringBuffer, std::memory_order_release);
+	}
+	memcpy(writePtr, data, numWords * sizeof(uint32be));
+	std::atomic_ref<uint8*>(writePtr).store(writePtr + numWords * sizeof(uint32be), std::memory_order_release);
+	LatteCP_NotifyNewCommands();
+	return true;
+}
+
+static bool _LatteCaptureReplay_WriteMemory(MPTR physAddr, const uint8* data, uint32 size)
+{
+	std::vector<uint32be>& packet = s_replay.packetBuffer;
+	while (size > 0)
+	{
+		uint32 partSize = std::min<uint32>(size, LATTE_REPLAY_MEMORY_PACKET_SIZE);
+		uint32 numDataWords = (partSize + 3) / 4;
+		packet.resize(3 + numDataWords);
+		packet[0] = pm4HeaderType3(IT_HLE_REPLAY_WRITE_MEMORY, 2 + numDataWords);
+		packet[1] = physAddr;
+		packet[2] = partSize;
+		packet.back() = 0;
+		memcpy(packet.data() + 3, data, partSize);
+		if (!_LatteCaptureReplay_Submit(packet.data(), (uint32)packet.size()))
+			return false;
+		physAddr += partSize;
+		data += partSize;
+		size -= partSize;
+	}
+	return true;
+}
+
+static bool _LatteCaptureReplay_IsPacketSkipped(uint32 itCode)
+{
+	// signals to the PPC side are dropped since no title code is running
+	// waiting for flips is skipped so that frames are processed as fast as possible
+	return itCode == IT_HLE_BOTTOM_OF_PIPE_CB || itCode == IT_HLE_SET_CB_RETIREMENT_TIMESTAMP || itCode == IT_HLE_WAIT_FOR_FLIP || itCode == IT_HLE_FIFO_WRAP_AROUND;
+}
+
+static void _LatteCaptureReplay_ThreadFunc()
+{
+	SetThreadName("LatteReplay");
+	while (!g_isGPUInitFinished)
+	{
+		if (s_replay.stopRequested)
+			return;
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	// restore register state, the GPU thread does not touch the registers until GX2 is initialized
+	memcpy(LatteGPUState.contextRegister, s_replay.contextRegister.data(), sizeof(LatteGPUState.contextRegister));
+	memcpy(LatteGPUState.contextRegisterShadowAddr, s_replay.contextRegisterShadowAddr.data(), sizeof(LatteGPUState.contextRegisterShadowAddr));
+	LatteGPUState.contextControl0 = s_replay.contextControl0;
+	LatteGPUState.contextControl1 = s_replay.contextControl1;
+	LatteGPUState.drawContext.numInstances = s_replay.numInstances;
+	LatteGPUState.pipelineStateDirtyMask = LATTE_PIPELINE_STATE_GROUP_ALL;
+	GX2::GX2Init_writeGather();
+	LatteGPUState.gx2InitCalled++;
+
+	MemStreamReader& reader = *s_replay.reader;
+	HRTick startTick = HighResolutionTimer::now().getTick();
+	uint32 numFrames = 0;
+	bool isCorrupted = false;
+	while (!s_replay.stopRequested)
+	{
+		LATTE_CAPTURE_CHUNK chunkType = (LATTE_CAPTURE_CHUNK)reader.readBE<uint8>();
+		if (reader.hasError() || chunkType == LATTE_CAPTURE_CHUNK::END)
+			break;
+		if (chunkType == LATTE_CAPTURE_CHUNK::MEMORY)
+		{
+			MPTR physAddr = reader.readBE<uint32>();
+			uint32 size = reader.readBE<uint32>();
+			std::span<uint8> data = reader.readDataNoCopy(size);
+			if (reader.hasError() || !memory_isAddressRangeAccessible(memory_physicalToVirtual(physAddr), size))
+			{
+				isCorrupted = true;
+				break;
+			}
+			if (!_LatteCaptureReplay_WriteMemory(physAddr, data.data(), size))
+				break;
+		}
+		else if (chunkType == LATTE_CAPTURE_CHUNK::PACKET)
+		{
+			uint32 numWords = reader.readBE<uint32>();
+			std::span<uint8> data = reader.readDataNoCopy(numWords * sizeof(uint32be));
+			if (reader.hasError() || numWords == 0 || numWords > 0x4001)
+			{
+				isCorrupted = true;
+				break;
+			}
+			s_replay.packetBuffer.resize(numWords);
+			memcpy(s_replay.packetBuffer.data(), data.data(), numWords * sizeof(uint32be));
+			uint32 itCode = ((uint32)s_replay.packetBuffer[0] >> 8) & 0xFF;
+			if (_LatteCaptureReplay_IsPacketSkipped(itCode))
+				continue;
+			if (!_LatteCaptureReplay_Submit(s_replay.packetBuffer.data(), numWords))
+				break;
+		}
+		else if (chunkType == LATTE_CAPTURE_CHUNK::FRAME_END)
+		{
+			numFrames++;
+		}
+		else
+		{
+			isCorrupted = true;
+			break;
+		}
+	}
+	if (isCorrupted)
+		cemuLog_log(LogType::Force, "GPU replay: Capture data is corrupted");
+	// wait for the command processor to finish
+	while (!s_replay.stopRequested && GX2::GX2WriteGather_getReadWriteDistance() != 0)
+		std::this_thread::yield();
+	if (s_replay.stopRequested)
+		return;
+	const double elapsedMs = (double)HighResolutionTimer::ticksToMicroseconds(HighResolutionTimer::now().getTick() - startTick) / 1000.0;
+	std::string summary = fmt::format("GPU replay: {} frames in {:.1f}ms ({:.3f}ms per frame, {:.2f} fps)", numFrames, elapsedMs, elapsedMs / std::max<uint32>(numFrames, 1), elapsedMs > 0.0 ? (double)numFrames * 1000.0 / elapsedMs : 0.0);
+	cemuLog_log(LogType::Force, "{}", summary);
+	if (LaunchSettings::HeadlessModeEnabled())
+	{
+		fmt::print("{}\n", summary);
+		gui_requestExit();
+	}
+}
+
+void LatteCaptureReplay_Start()
+{
+	s_replay.stopRequested = false;
+	s_replay.isActive = true;
+	s_replay.thread = std::thread(_LatteCaptureReplay_ThreadFunc);
+}
+
+void LatteCaptureReplay_Stop()
+{
+	s_replay.stopRequested = true;
+	if (s_replay.thread.joinable())
+		s_replay.thread.join();
+	s_replay.isActive = false;
+	s_replay.reader.reset();
+	s_replay.data.clear();
+	s_replay.data.shrink_to_fit();
+}
+
+bool LatteCaptureReplay_IsActive()
+{
+	return s_replay.isActive.load(std::memory_order_relaxed);
+}
+
+// appends all packets of the opened capture to a single command stream without submitting them
+// display lists are inlined from the recorded memory, other memory chunks are dropped
+bool LatteCaptureReplay_ExtractCommandStream(std::vector<uint32be>& commandStream)
+{
+	if (!s_replay.reader)
+		return false;
+	MemStreamReader& reader = *s_replay.reader;
+	std::unordered_map<uint64, std::span<uint8>> recordedMemory; // key is (physAddr << 32) | size, same as for recording
+	while (true)
+	{
+		LATTE_CAPTURE_CHUNK chunkType = (LATTE_CAPTURE_CHUNK)reader.readBE<uint8>();
+		if (reader.hasError())
+			return false;
+		if (chunkType == LATTE_CAPTURE_CHUNK::END)
+			return true;
+		if (chunkType == LATTE_CAPTURE_CHUNK::MEMORY)
+		{
+			MPTR physAddr = reader.readBE<uint32>();
+			uint32 size = reader.readBE<uint32>();
+			std::span<uint8> data = reader.readDataNoCopy(size);
+			if (reader.hasError())
+				return false;
+			recordedMemory[((uint64)physAddr << 32) | size] = data;
+		}
+		else if (chunkType == LATTE_CAPTURE_CHUNK::PACKET)
+		{
+			uint32 numWords = reader.readBE<uint32>();
+			std::span<uint8> data = reader.readDataNoCopy(numWords * sizeof(uint32be));
+			if (reader.hasError() || numWords == 0 || numWords > 0x4001)
+				return false;
+			size_t packetOffset = commandStream.size();
+			commandStream.resize(packetOffset + numWords);
+			memcpy(commandStream.data() + packetOffset, data.data(), numWords * sizeof(uint32be));
+			uint32 itCode = ((uint32)commandStream[packetOffset] >> 8) & 0xFF;
+			if (itCode != IT_INDIRECT_BUFFER_PRIV || numWords != 4)
+				continue;
+			// the display list was recorded right before the packet or is unchanged since it was last recorded
+			MPTR physAddr = commandStream[packetOffset + 1];
+			uint32 displayListSize = (uint32)commandStream[packetOffset + 3] * 4;
+			auto it = recordedMemory.find(((uint64)physAddr << 32) | displayListSize);
+			if (it == recordedMemory.end())
+				continue;
+			commandStream.resize(packetOffset + displayListSize / 4);
+			memcpy(commandStream.data() + packetOffset, it->second.data(), displayListSize);
+		}
+		else if (chunkType != LATTE_CAPTURE_CHUNK::FRAME_END)
+		{
+			return false;
+		}
+	}
+}
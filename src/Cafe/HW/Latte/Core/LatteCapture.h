@@ -0,0 +1,34 @@
+#pragma once
+
+class LatteTexture;
+
+// GPU command stream capture
+// Records the top-level PM4 packets of the next N frames together with all guest memory the GPU reads while processing them
+// The resulting file can be replayed without running any PPC code (see LatteCaptureReplay_*)
+
+extern std::atomic_bool g_latteCaptureActive; // set while a capture is requested or being recorded
+
+inline bool LatteCapture_IsActive()
+{
+	return g_latteCaptureActive.load(std::memory_order_relaxed);
+}
+
+bool LatteCapture_Request(uint32 numFrames); // stored in dump/capture/
+void LatteCapture_Stop();
+
+// called by the command processor for every top-level type 3 packet
+void LatteCapture_BeginPacket(uint32 itHeader, const uint32be* data, uint32 nWords);
+void LatteCapture_EndPacket(uint32 itHeader);
+
+// guest memory accessed by the GPU
+void LatteCapture_RecordMemory(MPTR physAddr, uint32 size);
+void LatteCapture_RecordMemoryData(MPTR physAddr, const void* data, uint32 size);
+void LatteCapture_RecordTexture(LatteTexture* texture);
+void LatteCapture_RecordDrawState(uint32 count, MPTR physIndices);
+
+// replay
+bool LatteCaptureReplay_Open(const fs::path& path, uint64& titleId);
+void LatteCaptureReplay_Start();
+void LatteCaptureReplay_Stop();
+bool LatteCaptureReplay_IsActive();
+bool LatteCaptureReplay_ExtractCommandStream(std::vector<uint32be>& commandStream); // for benchmarking, call after LatteCaptureReplay_Open() instead of starting the replay
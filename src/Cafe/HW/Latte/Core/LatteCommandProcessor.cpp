@@ -11,11 +11,16 @@
 #include "Cafe/HW/Latte/Core/LatteIndices.h"
 #include "Cafe/HW/Latte/Core/LatteBufferCache.h"
 #include "Cafe/HW/Latte/Core/LattePM4.h"
+#include "Cafe/HW/Latte/Core/LatteCapture.h"
+#include "Cafe/HW/MMU/WriteTracker.h"
+#include "Common/cpu_features.h"
 
 #include "Cafe/OS/libs/coreinit/coreinit_Time.h"
 
 #include "Cafe/CafeSystem.h"
 
+#include "util/highresolutiontimer/HighResolutionTimer.h"
+
 #include <boost/container/small_vector.hpp>
 
 void LatteCP_DebugPrintCmdBuffer(uint32be* bufferPtr, uint32 size);
@@ -69,6 +74,8 @@ public:
 		uint32 numInstances = LatteGPUState.drawContext.numInstances;
 		if (numInstances == 0)
 			return;
+		if (LatteCapture_IsActive())
+			LatteCapture_RecordDrawState(count, isAutoIndex ? MPTR_NULL : physIndices);
 
 		/*
 		if (GetAsyncKeyState('B'))
@@ -141,6 +148,58 @@ private:
 
 void LatteCP_processCommandBuffer(DrawPassContext& drawPassCtx);
 
+#define CP_IDLE_YIELD_ROUNDS	64		// number of idle rounds in which the GPU thread only yields before it goes to sleep
+#define CP_IDLE_SLEEP_MAX_US	1000	// commands which are written without a flush are picked up after at most this time
+
+/*
+* When the ringbuffer runs dry the GPU thread first yields for a few rounds and then sleeps until GX2 signals new commands (flush, display list call, ring wrap)
+* The sleep never extends past the next timed vsync, so vsync events and async commands are still handled on time
+*/
+static std::atomic<bool> s_cpIsSleeping{false};
+static std::atomic<uint32> s_cpWakeupCounter{0};
+static std::mutex s_cpSleepMutex;
+static std::condition_variable s_cpSleepCondition;
+
+void LatteCP_NotifyNewCommands()
+{
+	s_cpWakeupCounter.fetch_add(1);
+	if (!s_cpIsSleeping.load())
+		return;
+	std::lock_guard _l(s_cpSleepMutex);
+	s_cpSleepCondition.notify_one();
+}
+
+static bool LatteCP_isCommandDataAvailable(sint32 numBytes)
+{
+	uint8* gxRingBufferWritePtr = std::atomic_ref<uint8*>(gx2WriteGatherPipe.writeGatherPtrGxBuffer[GX2::sGX2MainCoreIndex]).load();
+	sint32 readDistance = (sint32)(gxRingBufferWritePtr - gxRingBufferReadPtr);
+	return readDistance < 0 || readDistance >= numBytes; // negative distance means the writer wrapped around
+}
+
+static void LatteCP_waitForCommandData(sint32& idleRounds, sint32 numBytes)
+{
+	if (idleRounds < CP_IDLE_YIELD_ROUNDS)
+	{
+		idleRounds++;
+		std::this_thread::yield();
+		return;
+	}
+	HRTick sleepStart = HighResolutionTimer::now().getTick();
+	if (sleepStart >= LatteGPUState.timer_nextVSync)
+		return;
+	uint64 sleepTimeUs = std::min<uint64>(HighResolutionTimer::ticksToMicroseconds(LatteGPUState.timer_nextVSync - sleepStart), CP_IDLE_SLEEP_MAX_US);
+	// the counter is sampled before announcing the sleep so that a notification in between is never lost
+	uint32 wakeupCounter = s_cpWakeupCounter.load();
+	std::unique_lock _l(s_cpSleepMutex);
+	s_cpIsSleeping.store(true);
+	s_cpSleepCondition.wait_for(_l, std::chrono::microseconds(sleepTimeUs), [&]() {
+		return s_cpWakeupCounter.load() != wakeupCounter || LatteCP_isCommandDataAvailable(numBytes) || Latte_GetStopSignal();
+	});
+	s_cpIsSleeping.store(false);
+	_l.unlock();
+	performanceMonitor.cycle[performanceMonitor.cycleIndex].gpuSleepTime += HighResolutionTimer::ticksToMicroseconds(HighResolutionTimer::now().getTick() - sleepStart);
+}
+
 /*
 * Read a U32 from the command buffer
 * If no data is available then wait in a busy loop
@@ -150,6 +209,7 @@ uint32 LatteCP_readU32Deprc()
 	uint32 v;
 	uint8* gxRingBufferWritePtr;
 	sint32 readDistance;
+	sint32 idleRounds = 0;
 	// no display list active
 	while (true)
 	{
@@ -176,7 +236,7 @@ uint32 LatteCP_readU32Deprc()
 		// still no command data available, do some other tasks
 		LatteTiming_HandleTimedVsync();
 		LatteAsyncCommands_checkAndExecute();
-		std::this_thread::yield();
+		LatteCP_waitForCommandData(idleRounds, sizeof(uint32be));
 		performanceMonitor.gpuTime_idleTime.endMeasuring();
 	}
 	v = *(uint32*)gxRingBufferReadPtr;
@@ -195,6 +255,7 @@ void LatteCP_waitForNWords(uint32 numWords)
 	sint32 readDistance;
 	bool isFlushed = false;
 	sint32 waitDistance = numWords * sizeof(uint32be);
+	sint32 idleRounds = 0;
 	// no display list active
 	while (true)
 	{
@@ -223,7 +284,7 @@ void LatteCP_waitForNWords(uint32 numWords)
 		// still no command data available, do some other tasks
 		LatteTiming_HandleTimedVsync();
 		LatteAsyncCommands_checkAndExecute();
-		std::this_thread::yield();
+		LatteCP_waitForCommandData(idleRounds, waitDistance);
 		performanceMonitor.gpuTime_idleTime.endMeasuring();
 	}
 }
@@ -252,6 +313,7 @@ LatteCMDPtr LatteCP_itSurfaceSync(LatteCMDPtr cmd)
 	{
 		// invalidate uniform or attribute buffer
 		LatteBufferCache_invalidate(addressPhys, size);
+		LatteIndices_invalidate(memory_getPointerFromPhysicalOffset(addressPhys), size);
 	}
 	return cmd;
 }
@@ -271,6 +333,9 @@ void LatteCP_itIndirectBufferDepr(LatteCMDPtr cmd, uint32 nWords)
 		LatteCP_DebugPrintCmdBuffer(MEMPTR<uint32be>(physicalAddress), displayListSize);
 #endif
 
+	if (LatteCapture_IsActive())
+		LatteCapture_RecordMemory(physicalAddress, displayListSize);
+
 	uint32be* buf = MEMPTR<uint32be>(physicalAddress).GetPtr();
 	drawPassCtx.PushCurrentCommandQueuePos(buf, buf, buf + sizeInDWords);
 
@@ -289,6 +354,9 @@ void LatteCP_itIndirectBuffer(LatteCMDPtr cmd, uint32 nWords, DrawPassContext& d
 	uint32 displayListSize = sizeInDWords * 4;
 	cemu_assert_debug(displayListSize >= 4);
 
+	if (LatteCapture_IsActive())
+		LatteCapture_RecordMemory(physicalAddress, displayListSize);
+
 	uint32be* buf = MEMPTR<uint32be>(physicalAddress).GetPtr();
 	drawPassCtx.PushCurrentCommandQueuePos(buf, buf, buf + sizeInDWords);
 }
@@ -326,6 +394,85 @@ LatteCMDPtr LatteCP_itStreamoutBufferUpdate(LatteCMDPtr cmd, uint32 nWords)
 	return cmd;
 }
 
+// copy register values from the command buffer and convert them to little endian
+#if defined(ARCH_X86_64)
+ATTRIBUTE_SSSE3
+static void LatteCP_copyRegisterData_SSSE3(uint32* dst, const uint32be* src, uint32 count)
+{
+	const __m128i shuffleMask = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+	while (count >= 4)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i*)src);
+		_mm_storeu_si128((__m128i*)dst, _mm_shuffle_epi8(v, shuffleMask));
+		src += 4;
+		dst += 4;
+		count -= 4;
+	}
+	while (count--)
+		*dst++ = *src++;
+}
+
+ATTRIBUTE_AVX2
+static void LatteCP_copyRegisterData_AVX2(uint32* dst, const uint32be* src, uint32 count)
+{
+	const __m256i shuffleMask = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+	while (count >= 8)
+	{
+		__m256i v = _mm256_loadu_si256((const __m256i*)src);
+		_mm256_storeu_si256((__m256i*)dst, _mm256_shuffle_epi8(v, shuffleMask));
+		src += 8;
+		dst += 8;
+		count -= 8;
+	}
+	while (count--)
+		*dst++ = *src++;
+}
+#endif
+
+static void LatteCP_copyRegisterData(uint32* dst, const uint32be* src, uint32 count)
+{
+#if defined(ARCH_X86_64)
+	// most packets only set a few registers, the SIMD paths are only worth it for larger ranges (uniforms, texture and vertex buffer descriptors)
+	if (count >= 8)
+	{
+		if (g_CPUFeatures.x86.avx2)
+			return LatteCP_copyRegisterData_AVX2(dst, src, count);
+		if (g_CPUFeatures.x86.ssse3)
+			return LatteCP_copyRegisterData_SSSE3(dst, src, count);
+	}
+#endif
+	while (count--)
+		*dst++ = *src++;
+}
+
+// registers which need special handling when written
+// the first 256 ALU constants belong to the pixel shader, the next 256 to the vertex shader
+void LatteCP_notifyAluConstWrite(uint32 registerStartIndex, uint32 registerEndIndex)
+{
+	if (registerStartIndex < mmSQ_ALU_CONSTANT0_0 + 0x400)
+		LatteGPUState.aluConstWriteCounterPS++;
+	if (registerEndIndex > mmSQ_ALU_CONSTANT0_0 + 0x400)
+		LatteGPUState.aluConstWriteCounterVS++;
+}
+
+// flag pipeline state groups as dirty if any of their registers is within the written range
+void LatteCP_notifyPipelineStateWrite(uint32 registerStartIndex, uint32 registerEndIndex)
+{
+	auto overlaps = [&](uint32 firstRegister, uint32 lastRegister) { return registerStartIndex <= lastRegister && registerEndIndex > firstRegister; };
+	uint32 dirtyMask = 0;
+	if (overlaps(mmSQ_VTX_ATTRIBUTE_BLOCK_START, mmSQ_VTX_ATTRIBUTE_BLOCK_END - 1))
+		dirtyMask |= LATTE_PIPELINE_STATE_GROUP_VERTEX_LAYOUT;
+	if (overlaps(mmVGT_PRIMITIVE_TYPE, mmVGT_PRIMITIVE_TYPE) || overlaps(mmVGT_STRMOUT_EN, mmVGT_STRMOUT_EN) || overlaps(Latte::REGADDR::PA_CL_CLIP_CNTL, Latte::REGADDR::PA_CL_CLIP_CNTL))
+		dirtyMask |= LATTE_PIPELINE_STATE_GROUP_PRIMITIVE;
+	if (overlaps(Latte::REGADDR::PA_CL_CLIP_CNTL, Latte::REGADDR::PA_SU_SC_MODE_CNTL))
+		dirtyMask |= LATTE_PIPELINE_STATE_GROUP_RASTER;
+	if (overlaps(Latte::REGADDR::CB_TARGET_MASK, Latte::REGADDR::CB_TARGET_MASK) || overlaps(Latte::REGADDR::CB_BLEND0_CONTROL, Latte::REGADDR::CB_BLEND0_CONTROL + 7) || overlaps(Latte::REGADDR::CB_COLOR_CONTROL, Latte::REGADDR::CB_COLOR_CONTROL))
+		dirtyMask |= LATTE_PIPELINE_STATE_GROUP_BLEND;
+	if (overlaps(Latte::REGADDR::DB_DEPTH_CONTROL, Latte::REGADDR::DB_DEPTH_CONTROL) || overlaps(mmDB_STENCILREFMASK, mmDB_STENCILREFMASK_BF))
+		dirtyMask |= LATTE_PIPELINE_STATE_GROUP_DEPTH_STENCIL;
+	LatteGPUState.pipelineStateDirtyMask |= dirtyMask;
+}
+
 template<uint32 registerBaseMode>
 void LatteCP_itSetRegistersGeneric_handleSpecialRanges(uint32 registerStartIndex, uint32 registerEndIndex)
 {
@@ -339,44 +486,45 @@ void LatteCP_itSetRegistersGeneric_handleSpecialRanges(uint32 registerStartIndex
 			}
 		}
 	}
+	else if constexpr (registerBaseMode == LATTE_REG_BASE_CONTEXT || registerBaseMode == LATTE_REG_BASE_CONFIG || registerBaseMode == LATTE_REG_BASE_RESOURCE)
+	{
+		LatteCP_notifyPipelineStateWrite(registerStartIndex, registerEndIndex);
+	}
+	else if constexpr (registerBaseMode == LATTE_REG_BASE_ALU_CONST)
+	{
+		LatteCP_notifyAluConstWrite(registerStartIndex, registerEndIndex);
+	}
 }
 
-template<uint32 TRegisterBase>
-LatteCMDPtr LatteCP_itSetRegistersGeneric(LatteCMDPtr cmd, uint32 nWords)
+static LatteCMDPtr LatteCP_itSetRegistersGeneric_writeRegisters(LatteCMDPtr cmd, uint32 registerIndex, uint32 count)
 {
-	uint32 registerOffset = LatteReadCMD();
-	uint32 registerIndex = TRegisterBase + registerOffset;
-	uint32 registerStartIndex = registerIndex;
-	uint32 registerEndIndex = registerStartIndex + nWords;
-#ifdef CEMU_DEBUG_ASSERT
-	cemu_assert_debug((registerIndex + nWords) <= LATTE_MAX_REGISTER);
-#endif
 	uint32* outputReg = (uint32*)(LatteGPUState.contextRegister + registerIndex);
+	LatteCP_copyRegisterData(outputReg, cmd, count);
 	if (LatteGPUState.contextControl0 == 0x80000077)
 	{
 		// state shadowing enabled
 		uint32* shadowAddrs = LatteGPUState.contextRegisterShadowAddr + registerIndex;
-		sint32 indexCounter = 0;
-		while (--nWords)
+		for (uint32 i = 0; i < count; i++)
 		{
-			uint32 dataWord = LatteReadCMD();
-			MPTR regShadowAddr = shadowAddrs[indexCounter];
+			MPTR regShadowAddr = shadowAddrs[i];
 			if (regShadowAddr)
-				*(uint32*)(memory_base + regShadowAddr) = _swapEndianU32(dataWord);
-			outputReg[indexCounter] = dataWord;
-			indexCounter++;
-		}
-	}
-	else
-	{
-		// state shadowing disabled
-		sint32 indexCounter = 0;
-		while (--nWords)
-		{
-			*outputReg = LatteReadCMD();
-			outputReg++;
+				*(uint32*)(memory_base + regShadowAddr) = _swapEndianU32(outputReg[i]);
 		}
 	}
+	return cmd + count;
+}
+
+template<uint32 TRegisterBase>
+LatteCMDPtr LatteCP_itSetRegistersGeneric(LatteCMDPtr cmd, uint32 nWords)
+{
+	uint32 registerOffset = LatteReadCMD();
+	uint32 registerIndex = TRegisterBase + registerOffset;
+	uint32 registerStartIndex = registerIndex;
+	uint32 registerEndIndex = registerStartIndex + nWords;
+#ifdef CEMU_DEBUG_ASSERT
+	cemu_assert_debug((registerIndex + nWords) <= LATTE_MAX_REGISTER);
+#endif
+	cmd = LatteCP_itSetRegistersGeneric_writeRegisters(cmd, registerIndex, nWords - 1);
 	// some register writes trigger special behavior
 	LatteCP_itSetRegistersGeneric_handleSpecialRanges<TRegisterBase>(registerStartIndex, registerEndIndex);
 	return cmd;
@@ -393,37 +541,52 @@ LatteCMDPtr LatteCP_itSetRegistersGeneric(LatteCMDPtr cmd, uint32 nWords, TRegRa
 	cemu_assert_debug((registerIndex + nWords) <= LATTE_MAX_REGISTER);
 #endif
 	cbRegRange(registerStartIndex, registerEndIndex);
+	cmd = LatteCP_itSetRegistersGeneric_writeRegisters(cmd, registerIndex, nWords - 1);
+	// some register writes trigger special behavior
+	LatteCP_itSetRegistersGeneric_handleSpecialRanges<TRegisterBase>(registerStartIndex, registerEndIndex);
+	return cmd;
+}
 
-	uint32* outputReg = (uint32*)(LatteGPUState.contextRegister + registerIndex);
-	if (LatteGPUState.contextControl0 == 0x80000077)
+// classification of resource registers, used by the continuous draw pass to decide how a register update affects the current draw sequence
+enum class LATTE_CP_RESOURCE_REG_CLASS : uint8
+{
+	UNIFORM_BUFFER = 0,
+	VERTEX_BUFFER = 1,
+	TEXTURE = 2, // ends the draw pass
+};
+
+struct LatteCPResourceRegClassTable
+{
+	static constexpr uint32 NUM_REGISTERS = LATTE_REG_BASE_SAMPLER - LATTE_REG_BASE_RESOURCE;
+
+	constexpr LatteCPResourceRegClassTable()
 	{
-		// state shadowing enabled
-		uint32* shadowAddrs = LatteGPUState.contextRegisterShadowAddr + registerIndex;
-		sint32 indexCounter = 0;
-		while (--nWords)
+		for (uint32 i = 0; i < NUM_REGISTERS; i++)
 		{
-			uint32 dataWord = LatteReadCMD();
-			MPTR regShadowAddr = shadowAddrs[indexCounter];
-			if (regShadowAddr)
-				*(uint32*)(memory_base + regShadowAddr) = _swapEndianU32(dataWord);
-			outputReg[indexCounter] = dataWord;
-			indexCounter++;
+			uint32 reg = LATTE_REG_BASE_RESOURCE + i;
+			if ((reg >= Latte::REGADDR::SQ_TEX_RESOURCE_WORD0_N_PS && reg < (Latte::REGADDR::SQ_TEX_RESOURCE_WORD0_N_PS + Latte::GPU_LIMITS::NUM_TEXTURES_PER_STAGE * 7)) ||
+				(reg >= Latte::REGADDR::SQ_TEX_RESOURCE_WORD0_N_VS && reg < (Latte::REGADDR::SQ_TEX_RESOURCE_WORD0_N_VS + Latte::GPU_LIMITS::NUM_TEXTURES_PER_STAGE * 7)) ||
+				(reg >= Latte::REGADDR::SQ_TEX_RESOURCE_WORD0_N_GS && reg < (Latte::REGADDR::SQ_TEX_RESOURCE_WORD0_N_GS + Latte::GPU_LIMITS::NUM_TEXTURES_PER_STAGE * 7)))
+				regClass[i] = LATTE_CP_RESOURCE_REG_CLASS::TEXTURE;
+			else if (reg >= mmSQ_VTX_ATTRIBUTE_BLOCK_START && reg < mmSQ_VTX_ATTRIBUTE_BLOCK_END)
+				regClass[i] = LATTE_CP_RESOURCE_REG_CLASS::VERTEX_BUFFER;
+			else
+				regClass[i] = LATTE_CP_RESOURCE_REG_CLASS::UNIFORM_BUFFER;
 		}
 	}
-	else
+
+	LATTE_CP_RESOURCE_REG_CLASS Get(uint32 registerIndex) const
 	{
-		// state shadowing disabled
-		sint32 indexCounter = 0;
-		while (--nWords)
-		{
-			*outputReg = LatteReadCMD();
-			outputReg++;
-		}
+		uint32 index = registerIndex - LATTE_REG_BASE_RESOURCE;
+		if (index >= NUM_REGISTERS)
+			return LATTE_CP_RESOURCE_REG_CLASS::UNIFORM_BUFFER;
+		return regClass[index];
 	}
-	// some register writes trigger special behavior
-	LatteCP_itSetRegistersGeneric_handleSpecialRanges<TRegisterBase>(registerStartIndex, registerEndIndex);
-	return cmd;
-}
+
+	LATTE_CP_RESOURCE_REG_CLASS regClass[NUM_REGISTERS]{};
+};
+
+static constexpr LatteCPResourceRegClassTable s_resourceRegClassTable;
 
 LatteCMDPtr LatteCP_itIndexType(LatteCMDPtr cmd, uint32 nWords)
 {
@@ -526,6 +689,8 @@ LatteCMDPtr LatteCP_itWaitRegMem(LatteCMDPtr cmd, uint32 nWords)
 			LatteTiming_HandleTimedVsync();
 			LatteAsyncCommands_checkAndExecute();
 		}
+		if (LatteCapture_IsActive())
+			LatteCapture_RecordMemoryData(physAddr, fencePtr, sizeof(uint32));
 		performanceMonitor.gpuTime_fenceTime.endMeasuring();
 	}
 	else
@@ -606,7 +771,11 @@ LatteCMDPtr LatteCP_itMemSemaphore(LatteCMDPtr cmd, uint32 nWords)
 				continue;
 			}
 			if (semaphoreData->compare_exchange_strong(oldVal, oldVal - 1))
+			{
+				if (LatteCapture_IsActive())
+					LatteCapture_RecordMemoryData(semaphorePhysicalAddress, &oldVal, sizeof(oldVal));
 				break;
+			}
 		}
 	}
 	else
@@ -643,6 +812,12 @@ LatteCMDPtr LatteCP_itLoadReg(LatteCMDPtr cmd, uint32 nWords, uint32 regBase)
 		uint32 regCount = LatteReadCMD();
 		cemu_assert_debug(regCount != 0);
 		uint32 regAddr = regBase + regOffset;
+		if (LatteCapture_IsActive())
+			LatteCapture_RecordMemory(regShadowMemAddr, regCount * 4);
+		if (regBase == LATTE_REG_BASE_ALU_CONST)
+			LatteCP_notifyAluConstWrite(regAddr, regAddr + regCount);
+		else
+			LatteCP_notifyPipelineStateWrite(regAddr, regAddr + regCount);
 		for (uint32 f = 0; f < regCount; f++)
 		{
 			LatteGPUState.contextRegisterShadowAddr[regAddr] = regShadowMemAddr;
@@ -784,6 +959,34 @@ LatteCMDPtr LatteCP_itHLEFifoWrapAround(LatteCMDPtr cmd, uint32 nWords)
 	return cmd;
 }
 
+// writes guest memory recorded in a GPU capture, see LatteCapture.cpp
+LatteCMDPtr LatteCP_itHLEReplayWriteMemory(LatteCMDPtr cmd, uint32 nWords)
+{
+	cemu_assert_debug(nWords >= 2);
+	// only the capture replay is allowed to write memory through the command stream
+	if (nWords < 2 || !LatteCaptureReplay_IsActive())
+	{
+		cemuLog_logDebug(LogType::Force, "Ignoring HLE replay memory write outside of a capture replay");
+		LatteSkipCMD(nWords);
+		return cmd;
+	}
+	MPTR physAddr = LatteReadCMD();
+	uint32 size = LatteReadCMD();
+	if (size > (nWords - 2) * 4 || !memory_isAddressRangeAccessible(memory_physicalToVirtual(physAddr), size))
+	{
+		cemu_assert_debug(false);
+		LatteSkipCMD(nWords - 2);
+		return cmd;
+	}
+	uint8* dst = memory_getPointerFromPhysicalOffset(physAddr);
+	WriteTracker::BeginHostWrite(dst, size);
+	memcpy(dst, cmd, size);
+	WriteTracker::EndHostWrite(dst, size);
+	LatteBufferCache_notifyDCFlush(physAddr, size);
+	LatteSkipCMD(nWords - 2);
+	return cmd;
+}
+
 LatteCMDPtr LatteCP_itHLESampleTimer(LatteCMDPtr cmd, uint32 nWords)
 {
 	cemu_assert_debug(nWords == 1);
@@ -1040,11 +1243,10 @@ void LatteCP_processCommandBuffer_continuousDrawPass(DrawPassContext& drawPassCt
 				{
 					LatteCP_itSetRegistersGeneric<LATTE_REG_BASE_RESOURCE>(cmdData, nWords, [&drawPassCtx](uint32 registerStart, uint32 registerEnd)
 						{
-							if ((registerStart >= Latte::REGADDR::SQ_TEX_RESOURCE_WORD0_N_PS && registerStart < (Latte::REGADDR::SQ_TEX_RESOURCE_WORD0_N_PS + Latte::GPU_LIMITS::NUM_TEXTURES_PER_STAGE * 7)) ||
-								(registerStart >= Latte::REGADDR::SQ_TEX_RESOURCE_WORD0_N_VS && registerStart < (Latte::REGADDR::SQ_TEX_RESOURCE_WORD0_N_VS + Latte::GPU_LIMITS::NUM_TEXTURES_PER_STAGE * 7)) ||
-								(registerStart >= Latte::REGADDR::SQ_TEX_RESOURCE_WORD0_N_GS && registerStart < (Latte::REGADDR::SQ_TEX_RESOURCE_WORD0_N_GS + Latte::GPU_LIMITS::NUM_TEXTURES_PER_STAGE * 7)))
+							LATTE_CP_RESOURCE_REG_CLASS regClass = s_resourceRegClassTable.Get(registerStart);
+							if (regClass == LATTE_CP_RESOURCE_REG_CLASS::TEXTURE)
 								drawPassCtx.endDrawPass(); // texture updates end the current draw sequence
-							else if (registerStart >= mmSQ_VTX_ATTRIBUTE_BLOCK_START && registerEnd <= mmSQ_VTX_ATTRIBUTE_BLOCK_END)
+							else if (regClass == LATTE_CP_RESOURCE_REG_CLASS::VERTEX_BUFFER && registerEnd <= mmSQ_VTX_ATTRIBUTE_BLOCK_END)
 								drawPassCtx.notifyModifiedVertexBuffer();
 							else
 								drawPassCtx.notifyModifiedUniformBuffer();
@@ -1420,6 +1622,8 @@ void LatteCP_ProcessRingbuffer()
 			LatteCMDPtr cmd = (LatteCMDPtr)gxRingBufferReadPtr;
 			uint8* cmdEnd = gxRingBufferReadPtr + nWords * 4;
 			gxRingBufferReadPtr = cmdEnd;
+			if (LatteCapture_IsActive())
+				LatteCapture_BeginPacket(itHeader, cmd, nWords);
 			switch (itCode)
 			{
 			case IT_SURFACE_SYNC:
@@ -1670,9 +1874,17 @@ void LatteCP_ProcessRingbuffer()
 				LatteQuery_UpdateFinishedQueriesForceFinishAll();
 				break;
 			}
+			case IT_HLE_REPLAY_WRITE_MEMORY:
+			{
+				LatteCP_itHLEReplayWriteMemory(cmd, nWords);
+				timerRecheck += CP_TIMER_RECHECK / 64;
+				break;
+			}
 			default:
 				cemu_assert_debug(false);
 			}
+			if (LatteCapture_IsActive())
+				LatteCapture_EndPacket(itHeader);
 		}
 		else if (itHeaderType == 2)
 		{
@@ -1711,6 +1923,66 @@ void LatteCP_ProcessRingbuffer()
 	}
 }
 
+// replays the register write packets of a command buffer and skips everything else. Returns the number of processed packets
+uint32 LatteCP_ReplayRegisterWrites(uint32be* cmdBuffer, uint32 sizeInDWords)
+{
+	LatteCMDPtr cmd = cmdBuffer;
+	LatteCMDPtr cmdEnd = cmdBuffer + sizeInDWords;
+	uint32 numPackets = 0;
+	while (cmd < cmdEnd)
+	{
+		uint32 itHeader = LatteReadCMD();
+		uint32 itHeaderType = (itHeader >> 30) & 3;
+		if (itHeaderType != 3)
+			continue; // type 2 packets are filler
+		uint32 itCode = (itHeader >> 8) & 0xFF;
+		uint32 nWords = ((itHeader >> 16) & 0x3FFF) + 1;
+		if ((cmd + nWords) > cmdEnd)
+			break;
+		LatteCMDPtr cmdData = cmd;
+		cmd += nWords;
+		// captured data is not trusted, skip writes outside of the register file
+		auto isValidRange = [&](uint32 registerBase) { return ((uint64)registerBase + (uint32)cmdData[0] + nWords - 1) <= LATTE_MAX_REGISTER; };
+		switch (itCode)
+		{
+		case IT_SET_CONTEXT_REG:
+			if (!isValidRange(LATTE_REG_BASE_CONTEXT))
+				continue;
+			LatteCP_itSetRegistersGeneric<LATTE_REG_BASE_CONTEXT>(cmdData, nWords);
+			break;
+		case IT_SET_RESOURCE:
+			if (!isValidRange(LATTE_REG_BASE_RESOURCE))
+				continue;
+			LatteCP_itSetRegistersGeneric<LATTE_REG_BASE_RESOURCE>(cmdData, nWords);
+			break;
+		case IT_SET_ALU_CONST:
+			if (!isValidRange(LATTE_REG_BASE_ALU_CONST))
+				continue;
+			LatteCP_itSetRegistersGeneric<LATTE_REG_BASE_ALU_CONST>(cmdData, nWords);
+			break;
+		case IT_SET_CTL_CONST:
+			if (!isValidRange(mmSQ_VTX_BASE_VTX_LOC))
+				continue;
+			LatteCP_itSetRegistersGeneric<mmSQ_VTX_BASE_VTX_LOC>(cmdData, nWords);
+			break;
+		case IT_SET_SAMPLER:
+			if (!isValidRange(LATTE_REG_BASE_SAMPLER))
+				continue;
+			LatteCP_itSetRegistersGeneric<LATTE_REG_BASE_SAMPLER>(cmdData, nWords);
+			break;
+		case IT_SET_CONFIG_REG:
+			if (!isValidRange(LATTE_REG_BASE_CONFIG))
+				continue;
+			LatteCP_itSetRegistersGeneric<LATTE_REG_BASE_CONFIG>(cmdData, nWords);
+			break;
+		default:
+			continue;
+		}
+		numPackets++;
+	}
+	return numPackets;
+}
+
 #ifdef LATTE_CP_LOGGING
 void LatteCP_DebugPrintCmdBuffer(uint32be* bufferPtr, uint32 size)
 {
@@ -0,0 +1,179 @@
+#include "Cafe/HW/Latte/Core/Latte.h"
+#include "Cafe/HW/Latte/Core/LatteFramePacing.h"
+#include "config/CemuConfig.h"
+
+// smoothing factors of the running estimates
+#define PACING_PERIOD_SMOOTHING		(0.02)
+#define PACING_PHASE_SMOOTHING		(0.1)
+#define PACING_LATENCY_SMOOTHING	(0.1)
+// number of scanout samples required before guest vsync is shifted
+#define PACING_MIN_SAMPLES			(30)
+
+struct
+{
+	FramePacingMode mode{};
+	double ticksPerMs{};
+	double ticksPerSecond{};
+	// display model, in timer ticks
+	HRTick lastScanout{};
+	double displayPeriod{};
+	double scanoutPhase{}; // predicted time of the most recent scanout, all other scanouts are a multiple of displayPeriod away
+	double phaseJitter{};
+	uint32 numSamples{};
+	HRTick vsyncPeriod{};
+	// guest frame latency, in timer ticks
+	HRTick lastPresent{};
+	double flipToPresent{};
+	double flipToPresentDeviation{};
+	// stats since the last LatteFramePacing_GetStats() call
+	double frameTimeSum{};
+	double frameTimeMax{};
+	uint32 frameCount{};
+	double latencySum{};
+	uint32 latencyCount{};
+	double queueTimeSum{};
+	uint32 queueTimeCount{};
+}s_pacing;
+
+std::atomic<HRTick> s_pacingLastFlip{}; // signalled by the host vsync thread if vsync is host driven
+
+// wraps a tick difference into the range [-period/2, period/2]
+double _LatteFramePacing_wrapToPeriod(double diff, double period)
+{
+	diff = fmod(diff, period);
+	if (diff > period * 0.5)
+		diff -= period;
+	else if (diff < -period * 0.5)
+		diff += period;
+	return diff;
+}
+
+bool _LatteFramePacing_isSynced(HRTick currentTick)
+{
+	if (s_pacing.numSamples < PACING_MIN_SAMPLES || s_pacing.vsyncPeriod == 0)
+		return false;
+	// without recent samples the prediction drifts
+	if ((double)(currentTick - s_pacing.lastScanout) > s_pacing.ticksPerSecond)
+		return false;
+	// only a display which runs at the guest refresh rate can be followed
+	if (std::abs(s_pacing.displayPeriod - (double)s_pacing.vsyncPeriod) > (double)s_pacing.vsyncPeriod * 0.02)
+		return false;
+	return s_pacing.phaseJitter < s_pacing.displayPeriod * 0.1;
+}
+
+void LatteFramePacing_Init()
+{
+	s_pacing = {};
+	s_pacing.mode = (FramePacingMode)GetConfig().frame_pacing_mode.GetValue();
+	s_pacing.ticksPerSecond = (double)HighResolutionTimer::getFrequency();
+	s_pacing.ticksPerMs = s_pacing.ticksPerSecond / 1000.0;
+	s_pacing.displayPeriod = s_pacing.ticksPerSecond / 60.0;
+	s_pacingLastFlip = 0;
+}
+
+void LatteFramePacing_NotifyPresentWait(HRTick waitBegin, HRTick waitEnd)
+{
+	// if the frame was already displayed the wait returns immediately and the time of scanout is unknown
+	if ((double)(waitEnd - waitBegin) < s_pacing.ticksPerMs * 0.25)
+		return;
+	HRTick scanoutTick = waitEnd;
+	double delta = (double)(scanoutTick - s_pacing.lastScanout);
+	s_pacing.lastScanout = scanoutTick;
+	if (s_pacing.numSamples == 0 || delta > s_pacing.ticksPerSecond)
+	{
+		// first sample or long stall (loading, window moved), start over
+		s_pacing.scanoutPhase = (double)scanoutTick;
+		s_pacing.phaseJitter = 0.0;
+		s_pacing.numSamples = 1;
+		return;
+	}
+	// frames may skip scanouts, refine the duration of a single refresh from short gaps only
+	sint32 numPeriods = (sint32)(delta / s_pacing.displayPeriod + 0.5);
+	if (numPeriods >= 1 && numPeriods <= 8)
+		s_pacing.displayPeriod += (delta / (double)numPeriods - s_pacing.displayPeriod) * PACING_PERIOD_SMOOTHING;
+	double phaseError = _LatteFramePacing_wrapToPeriod((double)scanoutTick - s_pacing.scanoutPhase, s_pacing.displayPeriod);
+	// anchor the prediction at the newest scanout so that errors in displayPeriod are not multiplied by the number of periods since the first sample
+	s_pacing.scanoutPhase = (double)scanoutTick - phaseError * (1.0 - PACING_PHASE_SMOOTHING);
+	s_pacing.phaseJitter += (std::abs(phaseError) - s_pacing.phaseJitter) * PACING_PHASE_SMOOTHING;
+	s_pacing.numSamples++;
+}
+
+void LatteFramePacing_NotifyPresent(HRTick presentTick)
+{
+	if (s_pacing.lastPresent != 0)
+	{
+		double frameTime = (double)(presentTick - s_pacing.lastPresent) / s_pacing.ticksPerMs;
+		s_pacing.frameTimeSum += frameTime;
+		s_pacing.frameTimeMax = std::max(s_pacing.frameTimeMax, frameTime);
+		s_pacing.frameCount++;
+	}
+	s_pacing.lastPresent = presentTick;
+	// time the guest needed to produce the frame after the preceding flip
+	HRTick flipTick = s_pacingLastFlip.load();
+	if (flipTick != 0 && presentTick > flipTick)
+	{
+		double latency = (double)(presentTick - flipTick);
+		if (latency < s_pacing.displayPeriod * 4.0)
+		{
+			s_pacing.flipToPresentDeviation += (std::abs(latency - s_pacing.flipToPresent) - s_pacing.flipToPresentDeviation) * PACING_LATENCY_SMOOTHING;
+			s_pacing.flipToPresent += (latency - s_pacing.flipToPresent) * PACING_LATENCY_SMOOTHING;
+			s_pacing.latencySum += latency / s_pacing.ticksPerMs;
+			s_pacing.latencyCount++;
+		}
+	}
+	if (_LatteFramePacing_isSynced(presentTick))
+	{
+		double untilScanout = _LatteFramePacing_wrapToPeriod(s_pacing.scanoutPhase - (double)presentTick, s_pacing.displayPeriod);
+		if (untilScanout < 0.0)
+			untilScanout += s_pacing.displayPeriod;
+		s_pacing.queueTimeSum += untilScanout / s_pacing.ticksPerMs;
+		s_pacing.queueTimeCount++;
+	}
+}
+
+void LatteFramePacing_NotifyFlip(HRTick flipTick)
+{
+	s_pacingLastFlip.store(flipTick);
+}
+
+sint64 LatteFramePacing_GetVSyncCorrection(HRTick nextVSync, HRTick vsyncPeriod)
+{
+	s_pacing.vsyncPeriod = vsyncPeriod;
+	if (s_pacing.mode == FramePacingMode::Disabled || !_LatteFramePacing_isSynced(HighResolutionTimer::now().getTick()))
+		return 0;
+	// how long before scanout the vsync should happen so that the following frame is presented in time
+	// in low latency mode the flip is additionally delayed, see LatteFramePacing_GetFrameStartDelay()
+	double lead = s_pacing.flipToPresent + s_pacing.displayPeriod * 0.5;
+	double error = _LatteFramePacing_wrapToPeriod(s_pacing.scanoutPhase - lead - (double)nextVSync, s_pacing.displayPeriod);
+	// move gradually so that guest frame timing stays regular
+	double maxStep = (double)vsyncPeriod / 16.0;
+	return (sint64)std::clamp(error * 0.25, -maxStep, maxStep);
+}
+
+HRTick LatteFramePacing_GetFrameStartDelay()
+{
+	if (s_pacing.mode != FramePacingMode::LowLatency || !_LatteFramePacing_isSynced(HighResolutionTimer::now().getTick()))
+		return 0;
+	// guest vsync keeps half a refresh period of margin, shrink it to what the measured variance of the frame latency requires
+	double margin = std::max(s_pacing.flipToPresentDeviation * 2.0 + s_pacing.phaseJitter, s_pacing.ticksPerMs * 1.0);
+	double delay = s_pacing.displayPeriod * 0.5 - margin;
+	if (delay <= 0.0)
+		return 0;
+	return (HRTick)delay;
+}
+
+void LatteFramePacing_GetStats(LatteFramePacingStats& stats)
+{
+	stats.frameTimeAvg = s_pacing.frameCount ? s_pacing.frameTimeSum / s_pacing.frameCount : 0.0;
+	stats.frameTimeMax = s_pacing.frameTimeMax;
+	stats.latency = s_pacing.latencyCount ? s_pacing.latencySum / s_pacing.latencyCount : 0.0;
+	stats.queueTime = s_pacing.queueTimeCount ? s_pacing.queueTimeSum / s_pacing.queueTimeCount : 0.0;
+	stats.isSynced = s_pacing.mode != FramePacingMode::Disabled && _LatteFramePacing_isSynced(HighResolutionTimer::now().getTick());
+	s_pacing.frameTimeSum = 0.0;
+	s_pacing.frameTimeMax = 0.0;
+	s_pacing.frameCount = 0;
+	s_pacing.latencySum = 0.0;
+	s_pacing.latencyCount = 0;
+	s_pacing.queueTimeSum = 0.0;
+	s_pacing.queueTimeCount = 0;
+}
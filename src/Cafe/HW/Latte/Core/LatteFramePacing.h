@@ -0,0 +1,40 @@
+#pragma once
+
+#include "util/highresolutiontimer/HighResolutionTimer.h"
+
+// Frame pacing
+// Estimates the host display's scanout phase from measured present timestamps and shifts the timer driven guest vsync towards it
+// so that frames are finished shortly before they are displayed instead of waiting in the swapchain queue
+
+enum class FramePacingMode : sint32
+{
+	Disabled = 0,
+	DisplaySync = 1, // align guest vsync to the display, keep a safety margin of half a refresh period
+	LowLatency = 2, // additionally delay the guest frame start so that the frame is presented just before scanout
+};
+
+struct LatteFramePacingStats
+{
+	double frameTimeAvg{}; // time between presented TV frames in ms
+	double frameTimeMax{};
+	double latency{}; // guest flip until the frame was handed to the host in ms
+	double queueTime{}; // time between present and the predicted scanout in ms, only available while synced
+	bool isSynced{}; // guest vsync is aligned to the measured display timing
+};
+
+void LatteFramePacing_Init();
+
+// renderer waited for a TV frame to be displayed. Only called by renderers which can measure this (Vulkan with present_wait)
+void LatteFramePacing_NotifyPresentWait(HRTick waitBegin, HRTick waitEnd);
+// a TV frame was handed to the host
+void LatteFramePacing_NotifyPresent(HRTick presentTick);
+// guest flip was executed and the next frame can start
+void LatteFramePacing_NotifyFlip(HRTick flipTick);
+
+// returns the adjustment for the next timer driven guest vsync
+sint64 LatteFramePacing_GetVSyncCorrection(HRTick nextVSync, HRTick vsyncPeriod);
+// returns how long the flip of a timer driven guest vsync is held back so that the guest starts the next frame later. Non-zero only in low latency mode
+HRTick LatteFramePacing_GetFrameStartDelay();
+
+// returns the stats accumulated since the last call
+void LatteFramePacing_GetStats(LatteFramePacingStats& stats);
@@ -1,5 +1,6 @@
 #include "Cafe/HW/Latte/Core/LatteConst.h"
 #include "Cafe/HW/Latte/Renderer/Renderer.h"
+#include "Cafe/HW/Latte/Core/LattePerformanceMonitor.h"
 #include "Cafe/HW/Latte/ISA/RegDefines.h"
 #include "Common/cpu_features.h"
 
@@ -7,12 +8,22 @@
 #include <immintrin.h>
 #endif
 
-struct  
+// small LRU cache of recently decoded index buffers
+// entries stay valid until the index ring buffer is recycled (LatteIndices_invalidateAll) or the guest range is invalidated
+#define INDEX_CACHE_ENTRIES	(16)
+
+struct LatteIndexCacheEntry
 {
-	const void* lastPtr;
-	uint32 lastCount;
-	LattePrimitiveMode lastPrimitiveMode;
-	LatteIndexType lastIndexType;
+	// key
+	const void* ptr;
+	uint32 count;
+	LattePrimitiveMode primitiveMode;
+	LatteIndexType indexType;
+	uint32 primitiveRestartIndex;
+	// validation
+	uint32 dataSize; // size of guest index data in bytes
+	uint64 dataHash;
+	uint32 lastUse; // for LRU replacement
 	// output
 	uint32 indexMin;
 	uint32 indexMax;
@@ -20,21 +31,84 @@ struct
 	uint32 outputCount;
 	uint32 indexBufferOffset;
 	uint32 indexBufferIndex;
+};
+
+struct  
+{
+	LatteIndexCacheEntry entries[INDEX_CACHE_ENTRIES];
+	uint32 useCounter;
 }LatteIndexCache{};
 
 void LatteIndices_invalidate(const void* memPtr, uint32 size)
 {
-	if (LatteIndexCache.lastPtr >= memPtr && (LatteIndexCache.lastPtr < ((uint8*)memPtr + size)) )
+	const uint8* rangeBegin = (const uint8*)memPtr;
+	const uint8* rangeEnd = rangeBegin + size;
+	for (auto& entry : LatteIndexCache.entries)
 	{
-		LatteIndexCache.lastPtr = nullptr;
-		LatteIndexCache.lastCount = 0;
+		if (entry.ptr == nullptr)
+			continue;
+		const uint8* entryBegin = (const uint8*)entry.ptr;
+		const uint8* entryEnd = entryBegin + std::max<uint32>(entry.dataSize, 1);
+		if (entryBegin < rangeEnd && entryEnd > rangeBegin)
+			entry.ptr = nullptr;
 	}
 }
 
 void LatteIndices_invalidateAll()
 {
-	LatteIndexCache.lastPtr = nullptr;
-	LatteIndexCache.lastCount = 0;
+	for (auto& entry : LatteIndexCache.entries)
+		entry.ptr = nullptr;
+}
+
+uint32 LatteIndices_getIndexDataSize(LatteIndexType indexType, uint32 count)
+{
+	if (indexType == LatteIndexType::U16_BE || indexType == LatteIndexType::U16_LE)
+		return count * sizeof(uint16);
+	if (indexType == LatteIndexType::U32_BE || indexType == LatteIndexType::U32_LE)
+		return count * sizeof(uint32);
+	return 0; // AUTO indices are generated and don't read guest memory
+}
+
+// same multiply-rotate scheme as the buffer cache page hash, but for arbitrary sizes
+uint64 LatteIndices_hashIndexData(const void* indexData, uint32 size)
+{
+	static const uint64 k0 = 0x55F23EAD;
+	static const uint64 k1 = 0x185FDC6D;
+	static const uint64 k2 = 0xF7431F49;
+	static const uint64 k3 = 0xA4C7AE9D;
+
+	const uint8* ptr = (const uint8*)indexData;
+	const uint8* end = ptr + (size & ~31);
+	uint64 h0 = size;
+	uint64 h1 = 0;
+	uint64 h2 = 0;
+	uint64 h3 = 0;
+	while (ptr < end)
+	{
+		uint64 v[4];
+		memcpy(v, ptr, sizeof(v));
+		h0 = std::rotr(h0, 7);
+		h1 = std::rotr(h1, 7);
+		h2 = std::rotr(h2, 7);
+		h3 = std::rotr(h3, 7);
+		h0 += v[0] * k0;
+		h1 += v[1] * k1;
+		h2 += v[2] * k2;
+		h3 += v[3] * k3;
+		ptr += 32;
+	}
+	// remaining bytes
+	uint32 remainingSize = size & 31;
+	if (remainingSize)
+	{
+		uint64 v[4]{};
+		memcpy(v, ptr, remainingSize);
+		h0 = std::rotr(h0, 7) + v[0] * k0;
+		h1 = std::rotr(h1, 7) + v[1] * k1;
+		h2 = std::rotr(h2, 7) + v[2] * k2;
+		h3 = std::rotr(h3, 7) + v[3] * k3;
+	}
+	return h0 + h1 + h2 + h3;
 }
 
 uint32 LatteIndices_calculateIndexOutputSize(LattePrimitiveMode primitiveMode, LatteIndexType indexType, uint32 count)
@@ -539,22 +613,47 @@ void LatteIndices_decode(const void* indexData, LatteIndexType indexType, uint32
 	// [x] unpack QUAD indices to triangle indices
 	// [x] calculate min and max index, be careful about primitive restart index
 	// [x] decode data directly into coherent memory buffer?
-	// [ ] better cache implementation, allow to cache across frames
+	// [x] better cache implementation (multiple entries with LRU replacement)
+	// [ ] allow to cache across frames
+
+	uint32 primitiveRestartIndex = LatteGPUState.contextNew.VGT_MULTI_PRIM_IB_RESET_INDX.get_RESTART_INDEX();
+	uint32 indexDataSize = LatteIndices_getIndexDataSize(indexType, count);
 
 	// reuse from cache if data didn't change
-	if (LatteIndexCache.lastPtr == indexData &&
-		LatteIndexCache.lastCount == count &&
-		LatteIndexCache.lastPrimitiveMode == primitiveMode &&
-		LatteIndexCache.lastIndexType == indexType)
-	{
-		indexMin = LatteIndexCache.indexMin;
-		indexMax = LatteIndexCache.indexMax;
-		renderIndexType = LatteIndexCache.renderIndexType;
-		outputCount = LatteIndexCache.outputCount;
-		indexBufferOffset = LatteIndexCache.indexBufferOffset;
-		indexBufferIndex = LatteIndexCache.indexBufferIndex;
+	LatteIndexCache.useCounter++;
+	uint64 indexDataHash = 0;
+	bool hasDataHash = false;
+	LatteIndexCacheEntry* cacheEntry = nullptr;
+	for (auto& entry : LatteIndexCache.entries)
+	{
+		if (entry.ptr != indexData ||
+			entry.count != count ||
+			entry.primitiveMode != primitiveMode ||
+			entry.indexType != indexType ||
+			entry.primitiveRestartIndex != primitiveRestartIndex)
+			continue;
+		if (indexDataSize != 0)
+		{
+			indexDataHash = LatteIndices_hashIndexData(indexData, indexDataSize);
+			hasDataHash = true;
+			if (entry.dataHash != indexDataHash)
+			{
+				entry.ptr = nullptr; // data was modified, reuse this slot for the new result
+				cacheEntry = &entry;
+				break;
+			}
+		}
+		entry.lastUse = LatteIndexCache.useCounter;
+		indexMin = entry.indexMin;
+		indexMax = entry.indexMax;
+		renderIndexType = entry.renderIndexType;
+		outputCount = entry.outputCount;
+		indexBufferOffset = entry.indexBufferOffset;
+		indexBufferIndex = entry.indexBufferIndex;
+		performanceMonitor.cycle[performanceMonitor.cycleIndex].indexCacheHits++;
 		return;
 	}
+	performanceMonitor.cycle[performanceMonitor.cycleIndex].indexCacheMisses++;
 
 	outputCount = 0;
 	if (indexType == LatteIndexType::AUTO)
@@ -566,8 +665,6 @@ void LatteIndices_decode(const void* indexData, LatteIndexType indexType, uint32
 	else
 		cemu_assert_debug(false);
 
-	uint32 primitiveRestartIndex = LatteGPUState.contextNew.VGT_MULTI_PRIM_IB_RESET_INDX.get_RESTART_INDEX();
-
 	// calculate index output size
 	uint32 indexOutputSize = LatteIndices_calculateIndexOutputSize(primitiveMode, indexType, count);
 	if (indexOutputSize == 0)
@@ -705,15 +802,35 @@ void LatteIndices_decode(const void* indexData, LatteIndexType indexType, uint32
 		LatteIndices_alternativeCalculateIndexMinMax(indexData, indexType, count, indexMin, indexMax);
 	}
 	g_renderer->indexData_uploadIndexMemory(indexBufferOffset, indexOutputSize);
-	// update cache
-	LatteIndexCache.lastPtr = indexData;
-	LatteIndexCache.lastCount = count;
-	LatteIndexCache.lastPrimitiveMode = primitiveMode;
-	LatteIndexCache.lastIndexType = indexType;
-	LatteIndexCache.indexMin = indexMin;
-	LatteIndexCache.indexMax = indexMax;
-	LatteIndexCache.renderIndexType = renderIndexType;
-	LatteIndexCache.outputCount = outputCount;
-	LatteIndexCache.indexBufferOffset = indexBufferOffset;
-	LatteIndexCache.indexBufferIndex = indexBufferIndex;
+	// update cache, replace the least recently used entry
+	if (!cacheEntry)
+	{
+		cacheEntry = LatteIndexCache.entries + 0;
+		for (auto& entry : LatteIndexCache.entries)
+		{
+			if (entry.ptr == nullptr)
+			{
+				cacheEntry = &entry;
+				break;
+			}
+			if (entry.lastUse < cacheEntry->lastUse)
+				cacheEntry = &entry;
+		}
+	}
+	if (indexDataSize != 0 && !hasDataHash)
+		indexDataHash = LatteIndices_hashIndexData(indexData, indexDataSize);
+	cacheEntry->ptr = indexData;
+	cacheEntry->count = count;
+	cacheEntry->primitiveMode = primitiveMode;
+	cacheEntry->indexType = indexType;
+	cacheEntry->primitiveRestartIndex = primitiveRestartIndex;
+	cacheEntry->dataSize = indexDataSize;
+	cacheEntry->dataHash = indexDataHash;
+	cacheEntry->lastUse = LatteIndexCache.useCounter;
+	cacheEntry->indexMin = indexMin;
+	cacheEntry->indexMax = indexMax;
+	cacheEntry->renderIndexType = renderIndexType;
+	cacheEntry->outputCount = outputCount;
+	cacheEntry->indexBufferOffset = indexBufferOffset;
+	cacheEntry->indexBufferIndex = indexBufferIndex;
 }
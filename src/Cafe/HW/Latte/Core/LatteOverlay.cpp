@@ -1,5 +1,6 @@
 #include "Cafe/HW/Latte/Core/LatteOverlay.h"
 #include "Cafe/HW/Latte/Core/LattePerformanceMonitor.h"
+#include "Cafe/HW/Latte/Core/LatteFramePacing.h"
 #include "gui/guiWrapper.h"
 
 #include "config/CemuConfig.h"
@@ -27,11 +28,18 @@ struct OverlayStats
 	double fps{};
 	uint32 draw_calls_per_frame{};
 	uint32 fast_draw_calls_per_frame{};
+	uint32 index_cache_lookups_per_frame{};
+	double index_cache_hit_rate{}; // in %
+	uint32 gx2_cmd_words_per_frame{};
+	uint32 gx2_cmd_writes_per_frame{};
 	float cpu_usage{}; // cemu cpu usage in %
+	double gpu_sleep_rate{}; // share of time the GPU thread was sleeping instead of waiting in a busy loop, in %
 	std::vector<float> cpu_per_core; // global cpu usage in % per core
 	uint32 ram_usage{}; // ram usage in MB
 
 	int vramUsage{}, vramTotal{}; // vram usage in mb
+
+	LatteFramePacingStats frame_pacing{};
 } g_state{};
 
 extern std::atomic_int g_compiled_shaders_total;
@@ -77,7 +85,7 @@ void LatteOverlay_renderOverlay(ImVec2& position, ImVec2& pivot, sint32 directio
 	const ImVec4 color = ImGui::ColorConvertU32ToFloat4(config.overlay.text_color);
 	ImGui::PushStyleColor(ImGuiCol_Text, color);
 	// stats overlay
-	if (config.overlay.fps || config.overlay.drawcalls || config.overlay.cpu_usage || config.overlay.cpu_per_core_usage || config.overlay.ram_usage)
+	if (config.overlay.fps || config.overlay.drawcalls || config.overlay.cpu_usage || config.overlay.cpu_per_core_usage || config.overlay.ram_usage || config.overlay.frame_pacing)
 	{
 		ImGui::SetNextWindowPos(position, ImGuiCond_Always, pivot);
 		ImGui::SetNextWindowBgAlpha(kBackgroundAlpha);
@@ -87,10 +95,18 @@ void LatteOverlay_renderOverlay(ImVec2& position, ImVec2& pivot, sint32 directio
 				ImGui::Text("FPS: %.2lf", g_state.fps);
 
 			if (config.overlay.drawcalls)
+			{
 				ImGui::Text("Draws/f: %d (fast: %d)", g_state.draw_calls_per_frame, g_state.fast_draw_calls_per_frame);
+				if (g_state.index_cache_lookups_per_frame != 0)
+					ImGui::Text("Index cache/f: %d (hit: %.1lf%%)", g_state.index_cache_lookups_per_frame, g_state.index_cache_hit_rate);
+				ImGui::Text("GX2 cmd/f: %d words (%d writes)", g_state.gx2_cmd_words_per_frame, g_state.gx2_cmd_writes_per_frame);
+			}
 
 			if (config.overlay.cpu_usage)
+			{
 				ImGui::Text("CPU: %.2lf%%", g_state.cpu_usage);
+				ImGui::Text("GPU thread asleep: %.1lf%%", g_state.gpu_sleep_rate);
+			}
 
 			if (config.overlay.cpu_per_core_usage)
 			{
@@ -106,6 +122,15 @@ void LatteOverlay_renderOverlay(ImVec2& position, ImVec2& pivot, sint32 directio
 			if(config.overlay.vram_usage && g_state.vramUsage != -1 && g_state.vramTotal != -1)
 				ImGui::Text("VRAM: %dMB / %dMB", g_state.vramUsage, g_state.vramTotal);
 
+			if (config.overlay.frame_pacing)
+			{
+				ImGui::Text("Frametime: %.2lfms (max: %.2lfms)", g_state.frame_pacing.frameTimeAvg, g_state.frame_pacing.frameTimeMax);
+				if (g_state.frame_pacing.isSynced)
+					ImGui::Text("Latency: %.1lfms Queued: %.1lfms", g_state.frame_pacing.latency, g_state.frame_pacing.queueTime);
+				else
+					ImGui::Text("Latency: %.1lfms (not synced)", g_state.frame_pacing.latency);
+			}
+
 			if (config.overlay.debug)
 				g_renderer->AppendOverlayDebugInfo();
 
@@ -589,7 +614,7 @@ static void UpdateStats_CpuPerCore()
 	}
 }
 
-void LatteOverlay_updateStats(double fps, sint32 drawcalls, sint32 fastDrawcalls)
+void LatteOverlay_updateStats(double fps, sint32 drawcalls, sint32 fastDrawcalls, uint32 indexCacheLookups, double indexCacheHitRate, double gpuSleepRate, uint32 gx2CmdWords, uint32 gx2CmdWrites)
 {
 	if (GetConfig().overlay.position == ScreenPosition::kDisabled)
 		return;
@@ -597,6 +622,12 @@ void LatteOverlay_updateStats(double fps, sint32 drawcalls, sint32 fastDrawcalls
 	g_state.fps = fps;
 	g_state.draw_calls_per_frame = drawcalls;
 	g_state.fast_draw_calls_per_frame = fastDrawcalls;
+	g_state.index_cache_lookups_per_frame = indexCacheLookups;
+	g_state.index_cache_hit_rate = indexCacheHitRate;
+	g_state.gpu_sleep_rate = gpuSleepRate;
+	g_state.gx2_cmd_words_per_frame = gx2CmdWords;
+	g_state.gx2_cmd_writes_per_frame = gx2CmdWrites;
+	LatteFramePacing_GetStats(g_state.frame_pacing);
 	UpdateStats_CemuCpu();
 	UpdateStats_CpuPerCore();
 
@@ -2,6 +2,6 @@
 
 void LatteOverlay_init();
 void LatteOverlay_render(bool pad_view);
-void LatteOverlay_updateStats(double fps, sint32 drawcalls, sint32 fastDrawcalls);
+void LatteOverlay_updateStats(double fps, sint32 drawcalls, sint32 fastDrawcalls, uint32 indexCacheLookups, double indexCacheHitRate, double gpuSleepRate, uint32 gx2CmdWords, uint32 gx2CmdWrites);
 
 void LatteOverlay_pushNotification(const std::string& text, sint32 duration);
\ No newline at end of file
@@ -49,6 +49,7 @@
 #define IT_HLE_COPY_COLORBUFFER_TO_SCANBUFFER	0xF3
 #define IT_HLE_FIFO_WRAP_AROUND					0xF4
 #define IT_HLE_CLEAR_COLOR_DEPTH_STENCIL		0xF5
+#define IT_HLE_REPLAY_WRITE_MEMORY				0xF6 // only used by GPU capture replay
 #define IT_HLE_SAMPLE_TIMER						0xF7
 #define IT_HLE_TRIGGER_SCANBUFFER_SWAP			0xF8
 #define IT_HLE_SPECIAL_STATE					0xF9
@@ -36,6 +36,11 @@ void LattePerformanceMonitor_frameEnd()
 		uint64 uniformBankUploadedCount = 0;
 		uint64 indexDataUploaded = 0;
 		uint64 indexDataCached = 0;
+		uint32 indexCacheHits = 0;
+		uint32 indexCacheMisses = 0;
+		uint64 gpuSleepTime = 0;
+		uint64 gx2CmdWords = 0;
+		uint64 gx2CmdWrites = 0;
 		uint32 frameCounter = 0;
 		uint32 drawCallCounter = 0;
 		uint32 fastDrawCallCounter = 0;
@@ -52,6 +57,11 @@ void LattePerformanceMonitor_frameEnd()
 			uniformBankUploadedCount += performanceMonitor.cycle[i].uniformBankUploadedCount;
 			indexDataUploaded += performanceMonitor.cycle[i].indexDataUploaded;
 			indexDataCached += performanceMonitor.cycle[i].indexDataCached;
+			indexCacheHits += performanceMonitor.cycle[i].indexCacheHits;
+			indexCacheMisses += performanceMonitor.cycle[i].indexCacheMisses;
+			gpuSleepTime += performanceMonitor.cycle[i].gpuSleepTime;
+			gx2CmdWords += performanceMonitor.cycle[i].gx2CmdWords;
+			gx2CmdWrites += performanceMonitor.cycle[i].gx2CmdWrites;
 			frameCounter += performanceMonitor.cycle[i].frameCounter;
 			drawCallCounter += performanceMonitor.cycle[i].drawCallCounter;
 			fastDrawCallCounter += performanceMonitor.cycle[i].fastDrawCallCounter;
@@ -75,6 +85,12 @@ void LattePerformanceMonitor_frameEnd()
 		uint32 uniformBankCountUploadedPerFrame = (uint32)(uniformBankUploadedCount / (uint64)elapsedFrames);
 		uint64 indexDataUploadPerFrame = (indexDataUploaded / (uint64)elapsedFrames);
 		indexDataUploadPerFrame /= 1024ULL;
+		uint32 indexCacheLookupsPerFrame = (indexCacheHits + indexCacheMisses) / elapsedFrames;
+		uint32 gx2CmdWordsPerFrame = (uint32)(gx2CmdWords / (uint64)elapsedFrames);
+		uint32 gx2CmdWritesPerFrame = (uint32)(gx2CmdWrites / (uint64)elapsedFrames);
+		double indexCacheHitRate = (indexCacheHits + indexCacheMisses) != 0 ? ((double)indexCacheHits * 100.0 / (double)(indexCacheHits + indexCacheMisses)) : 0.0;
+		// share of time in which the GPU thread did not occupy a host core
+		double gpuSleepRate = std::min((double)gpuSleepTime / 10.0 / (double)std::max<uint32>(totalElapsedTime, 1), 100.0);
 
 		double fps = (double)elapsedFrames2S * 1000.0 / (double)totalElapsedTimeFPS;
 		uint32 shaderBindsPerFrame = shaderBindCounter / elapsedFrames;
@@ -97,6 +113,11 @@ void LattePerformanceMonitor_frameEnd()
 		performanceMonitor.cycle[nextCycleIndex].uniformBankUploadedCount = 0;
 		performanceMonitor.cycle[nextCycleIndex].indexDataUploaded = 0;
 		performanceMonitor.cycle[nextCycleIndex].indexDataCached = 0;
+		performanceMonitor.cycle[nextCycleIndex].indexCacheHits = 0;
+		performanceMonitor.cycle[nextCycleIndex].indexCacheMisses = 0;
+		performanceMonitor.cycle[nextCycleIndex].gpuSleepTime = 0;
+		performanceMonitor.cycle[nextCycleIndex].gx2CmdWords = 0;
+		performanceMonitor.cycle[nextCycleIndex].gx2CmdWrites = 0;
 		performanceMonitor.cycle[nextCycleIndex].recompilerLeaveCount = 0;
 		performanceMonitor.cycle[nextCycleIndex].threadLeaveCount = 0;
 		performanceMonitor.cycleIndex = nextCycleIndex;
@@ -106,12 +127,12 @@ void LattePerformanceMonitor_frameEnd()
 
 		if (isFirstUpdate)
 		{
-			LatteOverlay_updateStats(0.0, 0, 0);
+			LatteOverlay_updateStats(0.0, 0, 0, 0, 0.0, 0.0, 0, 0);
 			gui_updateWindowTitles(false, false, 0.0);
 		}
 		else
 		{
-			LatteOverlay_updateStats(fps, drawCallCounter / elapsedFrames, fastDrawCallCounter / elapsedFrames);
+			LatteOverlay_updateStats(fps, drawCallCounter / elapsedFrames, fastDrawCallCounter / elapsedFrames, indexCacheLookupsPerFrame, indexCacheHitRate, gpuSleepRate, gx2CmdWordsPerFrame, gx2CmdWritesPerFrame);
 			gui_updateWindowTitles(false, false, fps);
 		}
 	}
@@ -121,4 +142,7 @@ void LattePerformanceMonitor_frameBegin()
 {
 	performanceMonitor.vk.numDrawBarriersPerFrame.reset();
 	performanceMonitor.vk.numBeginRenderpassPerFrame.reset();
+	performanceMonitor.vk.numUniformUploadsPerFrame.reset();
+	performanceMonitor.vk.numUniformUploadsSkippedPerFrame.reset();
+	performanceMonitor.vk.numDescriptorSetsReusedPerFrame.reset();
 }
@@ -23,6 +23,7 @@ public:
 	void frameFinished()
 	{
 		previousFrame = currentSum;
+		total += currentSum;
 		currentSum = 0;
 	}
 
@@ -31,9 +32,16 @@ public:
 		return previousFrame;
 	}
 
+	// accumulated over all finished frames
+	uint64 getTotal()
+	{
+		return total;
+	}
+
 private:
 	uint64 currentSum{};
 	uint64 previousFrame{};
+	uint64 total{};
 	uint64 timerStart{};
 };
 
@@ -92,6 +100,11 @@ typedef struct
 		uint64 uniformBankUploadedCount; // number of separate uploads for uniformBankDataUploaded
 		uint64 indexDataUploaded;
 		uint64 indexDataCached;
+		uint32 indexCacheHits; // number of draws which reused previously decoded index data
+		uint32 indexCacheMisses;
+		uint64 gpuSleepTime; // time in microseconds the GPU thread spent sleeping while waiting for commands
+		uint64 gx2CmdWords; // number of words written to the GX2 command buffer or display lists
+		uint32 gx2CmdWrites; // number of write-gather reservations the words were written with
 	}cycle[PERFORMANCE_MONITOR_TRACK_CYCLES];
 	sint32 cycleIndex;
 	// new stats
@@ -130,6 +143,9 @@ typedef struct
 		// per frame
 		LattePerfStatCounter numDrawBarriersPerFrame;
 		LattePerfStatCounter numBeginRenderpassPerFrame;
+		LattePerfStatCounter numUniformUploadsPerFrame;
+		LattePerfStatCounter numUniformUploadsSkippedPerFrame; // uniform data was unchanged and the previous upload was reused
+		LattePerfStatCounter numDescriptorSetsReusedPerFrame;
 	}vk;
 }performanceMonitor_t;
 
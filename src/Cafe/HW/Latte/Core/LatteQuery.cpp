@@ -4,6 +4,7 @@
 
 #include "Cafe/HW/Latte/Core/LatteQueryObject.h"
 #include "Cafe/HW/Latte/Renderer/Renderer.h"
+#include "config/CemuConfig.h"
 
 #define GPU7_QUERY_TYPE_OCCLUSION	(1)
 
@@ -16,10 +17,15 @@ struct LatteGX2QueryInformation
 	uint64 queryEventEnd;
 	uint64 sampleSum;
 	bool queryEnded;
+	bool isResolvedEarly; // the previous result was already reported, the actual result is only remembered for the next use
 };
 
 std::vector<LatteGX2QueryInformation*> list_activeGX2Queries2;
 
+// one frame latency mode. Syncs don't wait for pending queries and report the last result of the same query memory instead
+bool sQueryLatencyMode = false;
+std::unordered_map<MPTR, uint64> sPreviousQueryResults;
+
 std::vector<LatteQueryObject*> list_queriesInFlight;
 
 uint64 latestQueryFinishedEventId = 0;
@@ -52,17 +58,49 @@ LatteQueryObject* LatteQuery_createSamplePassedQuery()
 	return g_renderer->occlusionQuery_create();
 }
 
-void LatteQuery_finishGX2Query(LatteGX2QueryInformation* gx2Query)
+void LatteQuery_writeGX2QueryResult(MPTR queryMPTR, uint64 sampleSum)
 {
-	uint32* queryObjectData = (uint32*)memory_getPointerFromVirtualOffset(gx2Query->queryMPTR);
+	uint32* queryObjectData = (uint32*)memory_getPointerFromVirtualOffset(queryMPTR);
 	*(uint64*)(queryObjectData + 0) = 0;
-	*(uint64*)(queryObjectData + 2) = gx2Query->sampleSum;
+	*(uint64*)(queryObjectData + 2) = sampleSum;
 	*(uint64*)(queryObjectData + 4) = 0;
 	*(uint64*)(queryObjectData + 6) = 0;
 
 	*(uint64*)(queryObjectData + 8) = 0; // overwrites the 'OCPU' magic constant letting GX2QueryGetOcclusionResult know that the query is finished (for CPU queries)
 }
 
+void LatteQuery_finishGX2Query(LatteGX2QueryInformation* gx2Query)
+{
+	if (!gx2Query->isResolvedEarly)
+		LatteQuery_writeGX2QueryResult(gx2Query->queryMPTR, gx2Query->sampleSum);
+	if (sQueryLatencyMode)
+		sPreviousQueryResults[gx2Query->queryMPTR] = gx2Query->sampleSum;
+}
+
+/*
+ * Reports the previous result for all ended GX2 queries which are still waiting on the GPU
+ * Returns false if a query has no previous result, in which case the caller has to wait
+ */
+bool LatteQuery_resolvePendingQueriesEarly()
+{
+	bool allResolved = true;
+	for (auto& gx2Query : list_activeGX2Queries2)
+	{
+		if (!gx2Query->queryEnded || gx2Query->isResolvedEarly)
+			continue;
+		auto it = sPreviousQueryResults.find(gx2Query->queryMPTR);
+		if (it == sPreviousQueryResults.end())
+		{
+			allResolved = false;
+			continue;
+		}
+		// the query stays active until its actual result is known
+		LatteQuery_writeGX2QueryResult(gx2Query->queryMPTR, it->second);
+		gx2Query->isResolvedEarly = true;
+	}
+	return allResolved;
+}
+
 void LatteQuery_UpdateFinishedQueries()
 {
 	g_renderer->occlusionQuery_updateState();
@@ -108,6 +146,12 @@ void LatteQuery_UpdateFinishedQueries()
 void LatteQuery_UpdateFinishedQueriesForceFinishAll()
 {
 	cemu_assert_debug(_currentlyActiveRendererQuery == nullptr);
+	if (sQueryLatencyMode)
+	{
+		LatteQuery_UpdateFinishedQueries();
+		if (LatteQuery_resolvePendingQueriesEarly())
+			return;
+	}
 	g_renderer->occlusionQuery_flush(); // guarantees that all query commands have been submitted and finished processing
 	while (true)
 	{
@@ -143,7 +187,7 @@ void LatteQuery_BeginOcclusionQuery(MPTR queryMPTR)
 
 	for(auto& it : list_activeGX2Queries2)
 	{
-		if (it->queryMPTR == queryMPTR)
+		if (it->queryMPTR == queryMPTR && !it->isResolvedEarly)
 		{
 			debug_printf("itHLEBeginOcclusionQuery: Query 0x%08x is already active\n", queryMPTR);
 			return;
@@ -172,7 +216,7 @@ void LatteQuery_EndOcclusionQuery(MPTR queryMPTR)
 	// mark query binding as ended
 	for(auto& it : list_activeGX2Queries2)
 	{
-		if (it->queryMPTR == queryMPTR)
+		if (it->queryMPTR == queryMPTR && !it->isResolvedEarly)
 		{
 			it->queryEventEnd = currentEventId;
 			it->queryEnded = true;
@@ -209,4 +253,6 @@ void LatteQuery_CancelActiveGPU7Queries()
 
 void LatteQuery_Init()
 {
+	sQueryLatencyMode = GetConfig().occlusion_query_latency;
+	sPreviousQueryResults.clear();
 }
\ No newline at end of file
@@ -9,6 +9,8 @@
 #include "Cafe/HW/Latte/Core/LatteCachedFBO.h"
 #include "Cafe/HW/Latte/Renderer/Renderer.h"
 #include "Cafe/HW/Latte/Core/LattePerformanceMonitor.h"
+#include "Cafe/HW/Latte/Core/LatteFramePacing.h"
+#include "Cafe/HW/MMU/WriteTracker.h"
 #include "Cafe/GraphicPack/GraphicPack2.h"
 #include "config/ActiveSettings.h"
 #include "Cafe/HW/Latte/Renderer/Vulkan/VulkanRenderer.h"
@@ -697,7 +699,9 @@ void LatteRenderTarget_itHLESwapScanBuffer()
 		performanceMonitor.gpuTime_frameTime.endMeasuring();
 	LattePerformanceMonitor_frameEnd();
 	LatteGPUState.frameCounter++;
+	WriteTracker::AdvanceEpoch();
 	g_renderer->SwapBuffers(true, true);
+	LatteFramePacing_NotifyPresent(HighResolutionTimer::now().getTick());
 
 	catchOpenGLError();
 	performanceMonitor.gpuTime_frameTime.beginMeasuring();
@@ -934,7 +938,7 @@ void LatteRenderTarget_copyToBackbuffer(LatteTextureView* textureView, bool isPa
 	{
 		sint32 scaling_filter = downscaling ? GetConfig().downscale_filter : GetConfig().upscale_filter;
 		
-		if (g_renderer->GetType() == RendererAPI::Vulkan)
+		if (g_renderer->GetType() != RendererAPI::OpenGL)
 		{
 			// force linear or nearest neighbor filter
 			if(scaling_filter != kLinearFilter && scaling_filter != kNearestNeighborFilter)
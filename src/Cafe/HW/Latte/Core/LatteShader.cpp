@@ -44,6 +44,9 @@ using SHRC_CACHE_TYPE = ska::flat_hash_map<uint64, LatteDecompilerShader*>;
 SHRC_CACHE_TYPE sVertexShaders(512);
 SHRC_CACHE_TYPE sGeometryShaders(512);
 SHRC_CACHE_TYPE sPixelShaders(512);
+// the caches are only modified by the GPU thread (and the shader cache loader before boot) but are also searched by the pipeline cache compile threads
+// modifications and lookups from other threads lock this, lookups by the modifying thread itself don't need to
+std::shared_mutex sShaderCacheMutex;
 
 uint64 _shaderBaseHash_vs;
 uint64 _shaderBaseHash_gs;
@@ -138,14 +141,24 @@ void LatteSHRC_ResetCachedShaderHash()
 }
 
 LatteShaderPSInputTable _activePSImportTable;
+thread_local LatteShaderPSInputTable* _threadPSImportTable = nullptr;
 
 LatteShaderPSInputTable* LatteSHRC_GetPSInputTable()
 {
+	if (_threadPSImportTable)
+		return _threadPSImportTable;
 	return &_activePSImportTable;
 }
 
+// threads which decompile shaders independently of the GPU state (shader cache loading) use their own PS input table
+void LatteSHRC_SetThreadPSInputTable(LatteShaderPSInputTable* psInputTable)
+{
+	_threadPSImportTable = psInputTable;
+}
+
 void LatteSHRC_RemoveFromCache(LatteDecompilerShader* shader)
 {
+	std::unique_lock _l(sShaderCacheMutex);
 	bool removed = false;
 	auto& cache = LatteSHRC_GetCacheByType(shader->shaderType);
 	// remove from hashtable
@@ -209,6 +222,7 @@ void LatteShader_free(LatteDecompilerShader* shader)
 // we prepare the PS import info in advance
 void LatteShader_UpdatePSInputs(uint32* contextRegisters)
 {
+	LatteShaderPSInputTable& psInputTable = *LatteSHRC_GetPSInputTable();
 	// PS control
 	uint32 psControl0 = contextRegisters[mmSPI_PS_IN_CONTROL_0];
 	uint32 spi0_positionEnable = (psControl0 >> 8) & 1;
@@ -238,12 +252,12 @@ void LatteShader_UpdatePSInputs(uint32* contextRegisters)
 	{
 		key += std::rotr<uint64>(spi0_paramGen, 7);
 		key += std::rotr<uint64>(spi0_paramGenAddr, 3);
-		_activePSImportTable.paramGen = spi0_paramGen;
-		_activePSImportTable.paramGenGPR = spi0_paramGenAddr;
+		psInputTable.paramGen = spi0_paramGen;
+		psInputTable.paramGenGPR = spi0_paramGenAddr;
 	}
 	else
 	{
-		_activePSImportTable.paramGen = 0;
+		psInputTable.paramGen = 0;
 	}
 
 	// semantic imports from vertex shader
@@ -277,9 +291,9 @@ void LatteShader_UpdatePSInputs(uint32* contextRegisters)
 		key = std::rotl<uint64>(key, 7);
 		if (spi0_positionEnable && f == spi0_positionAddr)
 		{
-			_activePSImportTable.import[f].semanticId = LATTE_ANALYZER_IMPORT_INDEX_SPIPOSITION;
-			_activePSImportTable.import[f].isFlat = false;
-			_activePSImportTable.import[f].isNoPerspective = false;
+			psInputTable.import[f].semanticId = LATTE_ANALYZER_IMPORT_INDEX_SPIPOSITION;
+			psInputTable.import[f].isFlat = false;
+			psInputTable.import[f].isNoPerspective = false;
 			key += (uint64)0x33;
 		}
 		else
@@ -292,13 +306,13 @@ void LatteShader_UpdatePSInputs(uint32* contextRegisters)
 			semanticMask[psSemanticId >> 3] |= (1 << (psSemanticId & 7));
 #endif
 
-			_activePSImportTable.import[f].semanticId = psSemanticId;
-			_activePSImportTable.import[f].isFlat = (psInputControl&(1 << 10)) != 0;
-			_activePSImportTable.import[f].isNoPerspective = (psInputControl&(1 << 12)) != 0;
+			psInputTable.import[f].semanticId = psSemanticId;
+			psInputTable.import[f].isFlat = (psInputControl&(1 << 10)) != 0;
+			psInputTable.import[f].isNoPerspective = (psInputControl&(1 << 12)) != 0;
 		}
 	}
-	_activePSImportTable.key = key;
-	_activePSImportTable.count = numPSInputs;
+	psInputTable.key = key;
+	psInputTable.count = numPSInputs;
 }
 
 void LatteShader_CreateRendererShader(LatteDecompilerShader* shader, bool compileAsync)
@@ -372,6 +386,7 @@ void LatteShader_FinishCompilation(LatteDecompilerShader* shader)
 
 void LatteSHRC_RegisterShader(LatteDecompilerShader* shader, uint64 baseHash, uint64 auxHash)
 {
+	std::unique_lock _l(sShaderCacheMutex);
 	auto& cache = LatteSHRC_GetCacheByType(shader->shaderType);
 	shader->baseHash = baseHash;
 	shader->auxHash = auxHash;
@@ -398,6 +413,7 @@ LatteDecompilerShader* LatteSHRC_GetFromChain(LatteDecompilerShader* baseShader,
 
 LatteDecompilerShader* LatteSHRC_Get(SHRC_CACHE_TYPE& cache, uint64 baseHash, uint64 auxHash)
 {
+	std::shared_lock _l(sShaderCacheMutex);
 	auto it = cache.find(baseHash);
 	if (it == cache.end())
 		return nullptr;
@@ -717,6 +733,10 @@ LatteDecompilerShader* LatteShader_CompileSeparableVertexShader2(uint64 baseHash
 	// debug output (before register allocation)
 	irDebugPrinter.setShowPhysicalRegisters(false);
 	irDebugPrinter.debugPrint(irObj);
+	// optimize
+	ZirPass::PassManager passManager(irObj);
+	passManager.addOptimizationPasses();
+	passManager.run();
 	// register allocation
 	ZirPass::RegisterAllocatorForGLSL ra(irObj);
 	ra.applyPass();
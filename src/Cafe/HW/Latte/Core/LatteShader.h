@@ -86,6 +86,7 @@ struct LatteShaderPSInputTable
 
 void LatteShader_UpdatePSInputs(uint32* contextRegisters);
 LatteShaderPSInputTable* LatteSHRC_GetPSInputTable();
+void LatteSHRC_SetThreadPSInputTable(LatteShaderPSInputTable* psInputTable);
 
 void LatteShader_free(LatteDecompilerShader* shader);
 void LatteSHRC_RemoveFromCacheByHash(uint64 shader_base_hash, uint64 shader_aux_hash, LatteConst::ShaderType type);
@@ -120,6 +121,7 @@ void LatteShader_DumpRawShader(uint64 baseHash, uint64 auxHash, uint32 type, uin
 // shader cache file
 void LatteShaderCache_Load();
 void LatteShaderCache_Close();
+void LatteShaderCache_StopBackgroundLoading(); // must be called before shaders referenced by cached pipelines are deleted
 
 void LatteShaderCache_writeSeparableVertexShader(uint64 shaderBaseHash, uint64 shaderAuxHash, uint8* fetchShader, uint32 fetchShaderSize, uint8* vertexShader, uint32 vertexShaderSize, uint32* contextRegisters, bool usesGeometryShader);
 void LatteShaderCache_writeSeparableGeometryShader(uint64 shaderBaseHash, uint64 shaderAuxHash, uint8* geometryShader, uint32 geometryShaderSize, uint8* gsCopyShader, uint32 gsCopyShaderSize, uint32* contextRegisters, uint32* hleSpecialState, uint32 vsRingParameterCount);
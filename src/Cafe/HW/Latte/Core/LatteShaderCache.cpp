@@ -17,12 +17,16 @@
 #include "imgui/imgui_extension.h"
 
 #include "config/ActiveSettings.h"
+#include "config/CemuConfig.h"
 #include "Cafe/TitleList/GameInfo.h"
 
 #include "util/helpers/SystemException.h"
 #include "Cafe/HW/Latte/Common/RegisterSerializer.h"
 #include "Cafe/HW/Latte/Common/ShaderSerializer.h"
 #include "util/helpers/Serializer.h"
+#include "util/highresolutiontimer/HighResolutionTimer.h"
+#include "util/helpers/StringBuf.h"
+#include "util/crypto/crc32.h"
 
 #include <wx/msgdlg.h>
 
@@ -57,11 +61,26 @@ FileCache* s_shaderCacheGeneric = nullptr;	// contains hardware and version inde
 
 #define SHADER_CACHE_GENERIC_EXTRA_VERSION		2 // changing this constant will invalidate all hardware-independent cache files
 
+FileCache* s_shaderCacheDecompiled = nullptr; // optional, contains decompiler output (GLSL and metadata) for the active renderer
+
+#define SHADER_CACHE_DECOMPILED_EXTRA_VERSION	1 // changing this constant will invalidate all decompiled cache files
+
 #define SHADER_CACHE_TYPE_VERTEX				(0)
 #define SHADER_CACHE_TYPE_GEOMETRY				(1)
 #define SHADER_CACHE_TYPE_PIXEL					(2)
 
-bool LatteShaderCache_readSeparableShader(uint8* shaderInfoData, sint32 shaderInfoSize);
+struct LatteShaderCacheDecodedShader
+{
+	LatteDecompilerShader* shader{};
+	uint64 baseHash{};
+	uint64 auxHash{};
+	uint32 dumpType{};
+	std::vector<uint8> programData; // needed for raw shader dumps
+};
+
+bool LatteShaderCache_decodeSeparableShader(uint8* shaderInfoData, sint32 shaderInfoSize, LatteShaderCacheDecodedShader& decodedShader);
+void LatteShaderCache_openDecompiledCache(uint64 cacheTitleId);
+void LatteShaderCache_registerDecodedShader(LatteShaderCacheDecodedShader& decodedShader);
 void LatteShaderCache_LoadVulkanPipelineCache(uint64 cacheTitleId);
 bool LatteShaderCache_updatePipelineLoadingProgress();
 void LatteShaderCache_ShowProgress(const std::function <bool(void)>& loadUpdateFunc, bool isPipelines);
@@ -216,6 +235,129 @@ void LatteShaderCache_drawBackgroundImage(ImTextureID texture, int width, int he
 	ImGui::PopStyleVar(2);
 }
 
+/*
+ * Reading and decompiling shader cache entries is independent of the GPU state, so this is done on worker threads
+ * The GPU thread picks up the results in file order, which keeps shader registration and compilation order identical to serial loading
+ */
+class LatteShaderCacheDecodeWorkers
+{
+public:
+	enum class ENTRY_STATE : uint8
+	{
+		PENDING,
+		EMPTY, // no file at this index
+		INVALID,
+		DECODED,
+	};
+
+	struct Entry
+	{
+		std::atomic<ENTRY_STATE> state{ENTRY_STATE::PENDING};
+		uint64 name1{};
+		uint64 name2{};
+		LatteShaderCacheDecodedShader decodedShader;
+	};
+
+	LatteShaderCacheDecodeWorkers(FileCache* fileCache, uint32 entryCount) : m_fileCache(fileCache), m_entryCount(entryCount)
+	{
+		m_entries = std::make_unique<Entry[]>(entryCount);
+		// the GPU thread is busy with driver compilation so leave one core for it
+		uint32 workerCount = std::max<uint32>(std::thread::hardware_concurrency(), 2) - 1;
+		workerCount = std::min<uint32>(workerCount, std::max<uint32>(entryCount, 1));
+		for (uint32 i = 0; i < workerCount; i++)
+			m_workers.emplace_back(&LatteShaderCacheDecodeWorkers::WorkerThread, this);
+	}
+
+	~LatteShaderCacheDecodeWorkers()
+	{
+		m_stopRequested.store(true);
+		for (auto& worker : m_workers)
+			worker.join();
+		// free shaders which were decoded but never registered (loading was cancelled)
+		for (uint32 i = 0; i < m_entryCount; i++)
+		{
+			if (m_entries[i].decodedShader.shader)
+				LatteShader_free(m_entries[i].decodedShader.shader);
+		}
+	}
+
+	// returns nullptr if the entry did not finish decoding within the timeout
+	Entry* WaitForEntry(uint32 index, std::chrono::milliseconds timeout)
+	{
+		Entry& entry = m_entries[index];
+		if (entry.state.load(std::memory_order_acquire) != ENTRY_STATE::PENDING)
+			return &entry;
+		std::unique_lock _l(m_mutex);
+		if (!m_entryDecodedCondVar.wait_for(_l, timeout, [&]() { return entry.state.load(std::memory_order_acquire) != ENTRY_STATE::PENDING; }))
+			return nullptr;
+		return &entry;
+	}
+
+	uint32 GetWorkerCount() const
+	{
+		return (uint32)m_workers.size();
+	}
+
+	// accumulated time spent decoding and decompiling across all workers
+	uint64 GetDecodeTimeMS() const
+	{
+		return HighResolutionTimer::ticksToMicroseconds(m_decodeTicks.load()) / 1000;
+	}
+
+	// wall time from construction until the last entry was decoded
+	uint64 GetWallTimeMS() const
+	{
+		return HighResolutionTimer::ticksToMicroseconds(m_lastFinishTick.load() - m_startTick) / 1000;
+	}
+
+private:
+	void WorkerThread()
+	{
+		SetThreadName("ShaderCacheLoad");
+		LatteShaderPSInputTable psInputTable{};
+		LatteSHRC_SetThreadPSInputTable(&psInputTable);
+		std::vector<uint8> fileData;
+		while (!m_stopRequested.load(std::memory_order_relaxed))
+		{
+			uint32 index = m_nextIndex.fetch_add(1);
+			if (index >= m_entryCount)
+				break;
+			Entry& entry = m_entries[index];
+			HRTick startTick = HighResolutionTimer::now().getTick();
+			ENTRY_STATE newState;
+			if (!m_fileCache->GetFileByIndex(index, &entry.name1, &entry.name2, fileData))
+				newState = ENTRY_STATE::EMPTY;
+			else if (LatteShaderCache_decodeSeparableShader(fileData.data(), fileData.size(), entry.decodedShader))
+				newState = ENTRY_STATE::DECODED;
+			else
+				newState = ENTRY_STATE::INVALID;
+			HRTick endTick = HighResolutionTimer::now().getTick();
+			m_decodeTicks.fetch_add(endTick - startTick);
+			HRTick prevFinishTick = m_lastFinishTick.load();
+			while (prevFinishTick < endTick && !m_lastFinishTick.compare_exchange_weak(prevFinishTick, endTick)) {}
+			{
+				std::unique_lock _l(m_mutex);
+				entry.state.store(newState, std::memory_order_release);
+			}
+			m_entryDecodedCondVar.notify_all();
+		}
+		LatteSHRC_SetThreadPSInputTable(nullptr);
+	}
+
+	FileCache* m_fileCache;
+	uint32 m_entryCount;
+	std::unique_ptr<Entry[]> m_entries;
+	std::vector<std::thread> m_workers;
+	std::atomic_uint32_t m_nextIndex{0};
+	std::atomic_bool m_stopRequested{false};
+	std::mutex m_mutex;
+	std::condition_variable m_entryDecodedCondVar;
+	// stats
+	HRTick m_startTick{HighResolutionTimer::now().getTick()};
+	std::atomic<HRTick> m_lastFinishTick{m_startTick};
+	std::atomic<HRTick> m_decodeTicks{0};
+};
+
 void LatteShaderCache_Load()
 {
 	shaderCacheScreenStats.compiledShaderCount = 0;
@@ -243,6 +385,7 @@ void LatteShaderCache_Load()
 		RendererShaderVk::ShaderCacheLoading_begin(cacheTitleId);
 	else if (g_renderer->GetType() == RendererAPI::OpenGL)
 		RendererShaderGL::ShaderCacheLoading_begin(cacheTitleId);
+	LatteShaderCache_openDecompiledCache(cacheTitleId);
 	// get cache file name
 	const auto pathGeneric = ActiveSettings::GetCachePath("shaderCache/transferable/{:016x}_shaders.bin", cacheTitleId);
 	const auto pathGenericPre1_25_0 = ActiveSettings::GetCachePath("shaderCache/transferable/{:016x}.bin", cacheTitleId); // before 1.25.0
@@ -301,35 +444,55 @@ void LatteShaderCache_Load()
 
 	sint32 numLoadedShaders = 0;
 	uint32 loadIndex = 0;
+	std::vector<FileCache::FileName> invalidEntries;
+	HRTick driverCompileTicks = 0;
+	auto decodeWorkers = std::make_unique<LatteShaderCacheDecodeWorkers>(s_shaderCacheGeneric, (uint32)entryCount);
 
 	auto LoadShadersUpdate = [&]() -> bool
 	{
-		if (loadIndex >= (uint32)s_shaderCacheGeneric->GetMaximumFileIndex())
+		if (loadIndex >= (uint32)entryCount)
 			return false;
+		HRTick compileStartTick = HighResolutionTimer::now().getTick();
 		LatteShaderCache_updateCompileQueue(SHADER_CACHE_COMPILE_QUEUE_SIZE - 2);
-		uint64 name1;
-		uint64 name2;
-		std::vector<uint8> fileData;
-		if (!s_shaderCacheGeneric->GetFileByIndex(loadIndex, &name1, &name2, fileData))
-		{
-			loadIndex++;
+		driverCompileTicks += HighResolutionTimer::now().getTick() - compileStartTick;
+		// dont block for long so the progress screen keeps updating
+		auto entry = decodeWorkers->WaitForEntry(loadIndex, std::chrono::milliseconds(5));
+		if (!entry)
+			return true;
+		loadIndex++;
+		if (entry->state == LatteShaderCacheDecodeWorkers::ENTRY_STATE::EMPTY)
 			return true;
-		}
 		g_shaderCacheLoaderState.loadedShaderFiles++;
-		if (LatteShaderCache_readSeparableShader(fileData.data(), fileData.size()) == false)
+		if (entry->state == LatteShaderCacheDecodeWorkers::ENTRY_STATE::INVALID)
 		{
 			// something is wrong with the stored shader, remove entry from shader cache files
-			cemuLog_log(LogType::Force, "Shader cache entry {} invalid, deleting...", loadIndex);
-			s_shaderCacheGeneric->DeleteFile({name1, name2 });
+			// deletion is delayed until the workers no longer access the cache file
+			cemuLog_log(LogType::Force, "Shader cache entry {} invalid, deleting...", loadIndex - 1);
+			invalidEntries.push_back({ entry->name1, entry->name2 });
+		}
+		else
+		{
+			compileStartTick = HighResolutionTimer::now().getTick();
+			LatteShaderCache_registerDecodedShader(entry->decodedShader);
+			driverCompileTicks += HighResolutionTimer::now().getTick() - compileStartTick;
 		}
 		numLoadedShaders++;
-		loadIndex++;
 		return true;
 	};
 
 	LatteShaderCache_ShowProgress(LoadShadersUpdate, false);
-	
+
+	uint32 decodeWorkerCount = decodeWorkers->GetWorkerCount();
+	uint64 decodeWallTime = decodeWorkers->GetWallTimeMS();
+	uint64 decodeThreadTime = decodeWorkers->GetDecodeTimeMS();
+	decodeWorkers.reset();
+	for (auto& name : invalidEntries)
+		s_shaderCacheGeneric->DeleteFile(std::move(name));
+
+	HRTick compileStartTick = HighResolutionTimer::now().getTick();
 	LatteShaderCache_updateCompileQueue(0);
+	driverCompileTicks += HighResolutionTimer::now().getTick() - compileStartTick;
+	cemuLog_log(LogType::Force, "Shader cache: Decompiled {} shaders in {}ms using {} threads ({}ms thread time). Driver compilation took {}ms", numLoadedShaders, decodeWallTime, decodeWorkerCount, decodeThreadTime, HighResolutionTimer::ticksToMicroseconds(driverCompileTicks) / 1000);
 	// write load time and RAM usage to log file (in dev build)
 #if BOOST_OS_WINDOWS
 	const auto timeLoadEnd = now_cached();
@@ -618,7 +781,172 @@ void LatteShaderCache_loadOrCompileSeparableShader(LatteDecompilerShader* shader
 	LatteShaderCache_addToCompileQueue(shader);
 }
 
-bool LatteShaderCache_readSeparableVertexShader(MemStreamReader& streamReader, uint8 version)
+/*
+ * Decompiled cache
+ * Stores the GLSL source and the metadata generated by the decompiler for entries of the transferable cache, so that loading does not have to run the decompiler
+ * Entries use the same names as the transferable cache and are validated against a hash of the transferable entry
+ * The decompiler output depends on the decompiler version, the renderer and some settings. All of these are part of the extra version so the file is recreated whenever one of them changes
+ */
+void LatteShaderCache_openDecompiledCache(uint64 cacheTitleId)
+{
+	if (s_shaderCacheDecompiled)
+	{
+		delete s_shaderCacheDecompiled;
+		s_shaderCacheDecompiled = nullptr;
+	}
+	if (!GetConfig().shader_cache_decompiled)
+		return;
+	// shader dumps are generated during decompilation
+	if (ActiveSettings::DumpShadersEnabled())
+		return;
+	LatteDecompilerOptions options;
+	LatteShader_GetDecompilerOptions(options, LatteConst::ShaderType::Vertex, false);
+	const uint32 versionData[] =
+	{
+		SHADER_CACHE_DECOMPILED_EXTRA_VERSION,
+		LATTE_DECOMPILER_VERSION,
+		RendererShader::GeneratePrecompiledCacheId(),
+		(uint32)g_renderer->GetType(),
+		g_renderer->GetType() == RendererAPI::OpenGL ? LatteGPUState.glVendor : 0,
+		options.strictMul ? 1u : 0u,
+		options.useTFViaSSBO ? 1u : 0u,
+		options.spirvInstrinsics.hasRoundingModeRTEFloat32 ? 1u : 0u,
+		ActiveSettings::ShaderPreventInfiniteLoopsEnabled() ? 1u : 0u,
+		ActiveSettings::ForceSamplerRoundToPrecision() ? 1u : 0u,
+	};
+	uint32 extraVersion = crc32_calc(versionData, sizeof(versionData));
+	const char* rendererSuffix = "gl";
+	if (g_renderer->GetType() == RendererAPI::Vulkan)
+		rendererSuffix = "vk";
+	else if (g_renderer->GetType() == RendererAPI::Null)
+		rendererSuffix = "null";
+	const std::string cacheFilename = fmt::format("{:016x}_decompiled_{}.bin", cacheTitleId, rendererSuffix);
+	const fs::path cachePath = ActiveSettings::GetCachePath("shaderCache/precompiled/{}", cacheFilename);
+	s_shaderCacheDecompiled = FileCache::Open(cachePath, true, extraVersion);
+	if (!s_shaderCacheDecompiled)
+	{
+		cemuLog_log(LogType::Force, "Unable to open decompiled shader cache {}", cacheFilename);
+		return;
+	}
+	s_shaderCacheDecompiled->UseCompression(false);
+}
+
+static_assert(std::is_trivially_copyable_v<LatteDecompilerOutputUniformOffsets>);
+static_assert(std::is_trivially_copyable_v<LatteDecompilerShaderResourceMapping>);
+
+void LatteShaderCache_storeDecompiledShader(uint64 shaderCacheName, uint64 shaderAuxHash, uint32 sourceHash, LatteDecompilerOutput_t& decompilerOutput)
+{
+	if (!s_shaderCacheDecompiled)
+		return;
+	LatteDecompilerShader* shader = decompilerOutput.shader;
+	MemStreamWriter streamWriter(32 * 1024);
+	streamWriter.writeBE<uint32>(sourceHash);
+	streamWriter.writeBE<uint8>((uint8)shader->shaderType);
+	// shader metadata
+	streamWriter.writeBE<uint8>(shader->hasError ? 1 : 0);
+	streamWriter.writeBE<uint8>(shader->uniformMode);
+	streamWriter.writePODVector(shader->list_remappedUniformEntries);
+	streamWriter.writeBE<uint8>((uint8)shader->list_quickBufferList.size());
+	for (auto& it : shader->list_quickBufferList)
+		streamWriter.writeBE<uint32>(it.index | (it.size << 8));
+	streamWriter.writeBE<uint8>(shader->textureUnitListCount);
+	streamWriter.writeData(shader->textureUnitList, sizeof(shader->textureUnitList));
+	streamWriter.writeData(shader->textureUnitDim, sizeof(shader->textureUnitDim));
+	streamWriter.writeData(shader->textureIsIntegerFormat, sizeof(shader->textureIsIntegerFormat));
+	streamWriter.writeData(shader->textureUnitSamplerAssignment, sizeof(shader->textureUnitSamplerAssignment));
+	streamWriter.writeData(shader->textureUsesDepthCompare, sizeof(shader->textureUsesDepthCompare));
+	streamWriter.writeBE<uint32>(shader->pixelColorOutputMask);
+	streamWriter.writeBE<uint32>(shader->ringParameterCount);
+	streamWriter.writeBE<uint32>(shader->ringParameterCountFromPrevStage);
+	streamWriter.writeBE<uint32>(shader->outputParameterMask);
+	// decompiler output
+	streamWriter.writeBE<uint32>((uint32)decompilerOutput.textureUnitMask.to_ulong());
+	streamWriter.writeBE<uint8>((uint8)decompilerOutput.streamoutBufferWriteMask.to_ulong());
+	streamWriter.writeData(decompilerOutput.streamoutBufferStride, sizeof(decompilerOutput.streamoutBufferStride));
+	streamWriter.writeData(&decompilerOutput.uniformOffsetsGL, sizeof(LatteDecompilerOutputUniformOffsets));
+	streamWriter.writeData(&decompilerOutput.uniformOffsetsVK, sizeof(LatteDecompilerOutputUniformOffsets));
+	streamWriter.writeData(&decompilerOutput.resourceMappingGL, sizeof(LatteDecompilerShaderResourceMapping));
+	streamWriter.writeData(&decompilerOutput.resourceMappingVK, sizeof(LatteDecompilerShaderResourceMapping));
+	// GLSL source (not generated for shaders with errors)
+	if (shader->strBuf_shaderSource)
+	{
+		streamWriter.writeBE<uint32>(shader->strBuf_shaderSource->getLen());
+		streamWriter.writeData(shader->strBuf_shaderSource->c_str(), shader->strBuf_shaderSource->getLen());
+	}
+	else
+		streamWriter.writeBE<uint32>(0);
+	std::span<uint8> dataBlob = streamWriter.getResult();
+	s_shaderCacheDecompiled->AddFileAsync({ shaderCacheName, shaderAuxHash }, dataBlob.data(), dataBlob.size());
+}
+
+// on success the decompiler output and a new shader are filled in the same way LatteDecompiler_Decompile*Shader() would
+bool LatteShaderCache_loadDecompiledShader(uint64 shaderCacheName, uint64 shaderAuxHash, uint32 sourceHash, LatteConst::ShaderType shaderType, LatteDecompilerOutput_t& decompilerOutput)
+{
+	if (!s_shaderCacheDecompiled)
+		return false;
+	std::vector<uint8> fileData;
+	if (!s_shaderCacheDecompiled->GetFile({ shaderCacheName, shaderAuxHash }, fileData))
+		return false;
+	MemStreamReader streamReader(fileData.data(), (sint32)fileData.size());
+	if (streamReader.readBE<uint32>() != sourceHash)
+		return false; // transferable entry was replaced, the decompiled entry gets overwritten afterwards
+	if (streamReader.readBE<uint8>() != (uint8)shaderType)
+		return false;
+	auto shader = std::make_unique<LatteDecompilerShader>(shaderType);
+	// shader metadata
+	shader->hasError = streamReader.readBE<uint8>() != 0;
+	shader->uniformMode = streamReader.readBE<uint8>();
+	shader->list_remappedUniformEntries = streamReader.readPODVector<LatteDecompilerRemappedUniformEntry_t>();
+	uint8 quickBufferCount = streamReader.readBE<uint8>();
+	if (quickBufferCount > LATTE_NUM_MAX_UNIFORM_BUFFERS)
+		return false;
+	for (uint8 i = 0; i < quickBufferCount; i++)
+	{
+		uint32 v = streamReader.readBE<uint32>();
+		LatteDecompilerShader::QuickBufferEntry entry;
+		entry.index = v & 0xFF;
+		entry.size = v >> 8;
+		shader->list_quickBufferList.push_back(entry);
+	}
+	shader->textureUnitListCount = streamReader.readBE<uint8>();
+	if (shader->textureUnitListCount > LATTE_NUM_MAX_TEX_UNITS)
+		return false;
+	streamReader.readData(shader->textureUnitList, sizeof(shader->textureUnitList));
+	streamReader.readData(shader->textureUnitDim, sizeof(shader->textureUnitDim));
+	streamReader.readData(shader->textureIsIntegerFormat, sizeof(shader->textureIsIntegerFormat));
+	streamReader.readData(shader->textureUnitSamplerAssignment, sizeof(shader->textureUnitSamplerAssignment));
+	streamReader.readData(shader->textureUsesDepthCompare, sizeof(shader->textureUsesDepthCompare));
+	shader->pixelColorOutputMask = streamReader.readBE<uint32>();
+	shader->ringParameterCount = streamReader.readBE<uint32>();
+	shader->ringParameterCountFromPrevStage = streamReader.readBE<uint32>();
+	shader->outputParameterMask = streamReader.readBE<uint32>();
+	// decompiler output
+	decompilerOutput.textureUnitMask = std::bitset<LATTE_NUM_MAX_TEX_UNITS>(streamReader.readBE<uint32>());
+	decompilerOutput.streamoutBufferWriteMask = std::bitset<LATTE_NUM_STREAMOUT_BUFFER>(streamReader.readBE<uint8>());
+	streamReader.readData(decompilerOutput.streamoutBufferStride, sizeof(decompilerOutput.streamoutBufferStride));
+	streamReader.readData(&decompilerOutput.uniformOffsetsGL, sizeof(LatteDecompilerOutputUniformOffsets));
+	streamReader.readData(&decompilerOutput.uniformOffsetsVK, sizeof(LatteDecompilerOutputUniformOffsets));
+	streamReader.readData(&decompilerOutput.resourceMappingGL, sizeof(LatteDecompilerShaderResourceMapping));
+	streamReader.readData(&decompilerOutput.resourceMappingVK, sizeof(LatteDecompilerShaderResourceMapping));
+	// GLSL source
+	uint32 sourceLength = streamReader.readBE<uint32>();
+	std::span<uint8> shaderSource = streamReader.readDataNoCopy(sourceLength);
+	if (streamReader.hasError() || !streamReader.isEndOfStream())
+		return false;
+	if (sourceLength == 0 && !shader->hasError)
+		return false;
+	if (sourceLength != 0)
+	{
+		shader->strBuf_shaderSource = new StringBuf(sourceLength);
+		shader->strBuf_shaderSource->add(std::string_view((const char*)shaderSource.data(), shaderSource.size()));
+	}
+	LatteDecompiler_GenerateDataForFastAccess(shader.get());
+	decompilerOutput.shaderType = shaderType;
+	decompilerOutput.shader = shader.release();
+	return true;
+}
+
+bool LatteShaderCache_decodeSeparableVertexShader(MemStreamReader& streamReader, uint8 version, uint32 sourceHash, LatteShaderCacheDecodedShader& decodedShader)
 {
 	auto lcr = std::make_unique<LatteContextRegister>();
 	if (version != 1)
@@ -655,17 +983,25 @@ bool LatteShaderCache_readSeparableVertexShader(MemStreamReader& streamReader, u
 	LatteShader_GetDecompilerOptions(options, LatteConst::ShaderType::Vertex, usesGeometryShader);
 	// decompile vertex shader
 	LatteDecompilerOutput_t decompilerOutput{};
-	LatteDecompiler_DecompileVertexShader(shaderBaseHash, lcr->GetRawView(), vertexShaderData.data(), vertexShaderData.size(), fetchShader, options, &decompilerOutput);
-	LatteDecompilerShader* vertexShader = LatteShader_CreateShaderFromDecompilerOutput(decompilerOutput, shaderBaseHash, false, shaderAuxHash, lcr->GetRawView());
-	// compile
-	LatteShader_DumpShader(shaderBaseHash, shaderAuxHash, vertexShader);
-	LatteShader_DumpRawShader(shaderBaseHash, shaderAuxHash, SHADER_DUMP_TYPE_VERTEX, vertexShaderData.data(), vertexShaderData.size());
-	LatteShaderCache_loadOrCompileSeparableShader(vertexShader, shaderBaseHash, shaderAuxHash);
-	LatteSHRC_RegisterShader(vertexShader, shaderBaseHash, shaderAuxHash);
+	uint64 shaderCacheName = LatteShaderCache_getShaderNameInTransferableCache(shaderBaseHash, SHADER_CACHE_TYPE_VERTEX);
+	if (LatteShaderCache_loadDecompiledShader(shaderCacheName, shaderAuxHash, sourceHash, LatteConst::ShaderType::Vertex, decompilerOutput))
+	{
+		decompilerOutput.shader->compatibleFetchShader = fetchShader;
+	}
+	else
+	{
+		LatteDecompiler_DecompileVertexShader(shaderBaseHash, lcr->GetRawView(), vertexShaderData.data(), vertexShaderData.size(), fetchShader, options, &decompilerOutput);
+		LatteShaderCache_storeDecompiledShader(shaderCacheName, shaderAuxHash, sourceHash, decompilerOutput);
+	}
+	decodedShader.shader = LatteShader_CreateShaderFromDecompilerOutput(decompilerOutput, shaderBaseHash, false, shaderAuxHash, lcr->GetRawView());
+	decodedShader.baseHash = shaderBaseHash;
+	decodedShader.auxHash = shaderAuxHash;
+	decodedShader.dumpType = SHADER_DUMP_TYPE_VERTEX;
+	decodedShader.programData = std::move(vertexShaderData);
 	return true;
 }
 
-bool LatteShaderCache_readSeparableGeometryShader(MemStreamReader& streamReader, uint8 version)
+bool LatteShaderCache_decodeSeparableGeometryShader(MemStreamReader& streamReader, uint8 version, uint32 sourceHash, LatteShaderCacheDecodedShader& decodedShader)
 {
 	if (version != 1)
 		return false;
@@ -697,17 +1033,21 @@ bool LatteShaderCache_readSeparableGeometryShader(MemStreamReader& streamReader,
 	LatteShader_GetDecompilerOptions(options, LatteConst::ShaderType::Geometry, true);
 	// decompile geometry shader
 	LatteDecompilerOutput_t decompilerOutput{};
-	LatteDecompiler_DecompileGeometryShader(shaderBaseHash, lcr->GetRawView(), geometryShaderData.data(), geometryShaderData.size(), geometryCopyShaderData.data(), geometryCopyShaderData.size(), vsRingParameterCount, options, &decompilerOutput);
-	LatteDecompilerShader* geometryShader = LatteShader_CreateShaderFromDecompilerOutput(decompilerOutput, shaderBaseHash, false, shaderAuxHash, lcr->GetRawView());
-	// compile
-	LatteShader_DumpShader(shaderBaseHash, shaderAuxHash, geometryShader);
-	LatteShader_DumpRawShader(shaderBaseHash, shaderAuxHash, SHADER_DUMP_TYPE_GEOMETRY, geometryShaderData.data(), geometryShaderData.size());
-	LatteShaderCache_loadOrCompileSeparableShader(geometryShader, shaderBaseHash, shaderAuxHash);
-	LatteSHRC_RegisterShader(geometryShader, shaderBaseHash, shaderAuxHash);
+	uint64 shaderCacheName = LatteShaderCache_getShaderNameInTransferableCache(shaderBaseHash, SHADER_CACHE_TYPE_GEOMETRY);
+	if (!LatteShaderCache_loadDecompiledShader(shaderCacheName, shaderAuxHash, sourceHash, LatteConst::ShaderType::Geometry, decompilerOutput))
+	{
+		LatteDecompiler_DecompileGeometryShader(shaderBaseHash, lcr->GetRawView(), geometryShaderData.data(), geometryShaderData.size(), geometryCopyShaderData.data(), geometryCopyShaderData.size(), vsRingParameterCount, options, &decompilerOutput);
+		LatteShaderCache_storeDecompiledShader(shaderCacheName, shaderAuxHash, sourceHash, decompilerOutput);
+	}
+	decodedShader.shader = LatteShader_CreateShaderFromDecompilerOutput(decompilerOutput, shaderBaseHash, false, shaderAuxHash, lcr->GetRawView());
+	decodedShader.baseHash = shaderBaseHash;
+	decodedShader.auxHash = shaderAuxHash;
+	decodedShader.dumpType = SHADER_DUMP_TYPE_GEOMETRY;
+	decodedShader.programData = std::move(geometryShaderData);
 	return true;
 }
 
-bool LatteShaderCache_readSeparablePixelShader(MemStreamReader& streamReader, uint8 version)
+bool LatteShaderCache_decodeSeparablePixelShader(MemStreamReader& streamReader, uint8 version, uint32 sourceHash, LatteShaderCacheDecodedShader& decodedShader)
 {
 	if (version != 1)
 		return false;
@@ -735,18 +1075,23 @@ bool LatteShaderCache_readSeparablePixelShader(MemStreamReader& streamReader, ui
 	LatteShader_GetDecompilerOptions(options, LatteConst::ShaderType::Pixel, usesGeometryShader);
 	// decompile pixel shader
 	LatteDecompilerOutput_t decompilerOutput{};
-	LatteDecompiler_DecompilePixelShader(shaderBaseHash, lcr->GetRawView(), pixelShaderData.data(), pixelShaderData.size(), options, &decompilerOutput);
-	LatteDecompilerShader* pixelShader = LatteShader_CreateShaderFromDecompilerOutput(decompilerOutput, shaderBaseHash, false, shaderAuxHash, lcr->GetRawView());
-	// compile
-	LatteShader_DumpShader(shaderBaseHash, shaderAuxHash, pixelShader);
-	LatteShader_DumpRawShader(shaderBaseHash, shaderAuxHash, SHADER_DUMP_TYPE_PIXEL, pixelShaderData.data(), pixelShaderData.size());
-	LatteShaderCache_loadOrCompileSeparableShader(pixelShader, shaderBaseHash, shaderAuxHash);
-	LatteSHRC_RegisterShader(pixelShader, shaderBaseHash, shaderAuxHash);
+	uint64 shaderCacheName = LatteShaderCache_getShaderNameInTransferableCache(shaderBaseHash, SHADER_CACHE_TYPE_PIXEL);
+	if (!LatteShaderCache_loadDecompiledShader(shaderCacheName, shaderAuxHash, sourceHash, LatteConst::ShaderType::Pixel, decompilerOutput))
+	{
+		LatteDecompiler_DecompilePixelShader(shaderBaseHash, lcr->GetRawView(), pixelShaderData.data(), pixelShaderData.size(), options, &decompilerOutput);
+		LatteShaderCache_storeDecompiledShader(shaderCacheName, shaderAuxHash, sourceHash, decompilerOutput);
+	}
+	decodedShader.shader = LatteShader_CreateShaderFromDecompilerOutput(decompilerOutput, shaderBaseHash, false, shaderAuxHash, lcr->GetRawView());
+	decodedShader.baseHash = shaderBaseHash;
+	decodedShader.auxHash = shaderAuxHash;
+	decodedShader.dumpType = SHADER_DUMP_TYPE_PIXEL;
+	decodedShader.programData = std::move(pixelShaderData);
 	return true;
 }
 
-// read shader info from shader cache
-bool LatteShaderCache_readSeparableShader(uint8* shaderInfoData, sint32 shaderInfoSize)
+// read shader info from shader cache and decompile it
+// does not access the renderer or the runtime shader cache and can be called from any thread
+bool LatteShaderCache_decodeSeparableShader(uint8* shaderInfoData, sint32 shaderInfoSize, LatteShaderCacheDecodedShader& decodedShader)
 {
 	if (shaderInfoSize < 8)
 		return false;
@@ -754,15 +1099,35 @@ bool LatteShaderCache_readSeparableShader(uint8* shaderInfoData, sint32 shaderIn
 	uint8 versionAndType = streamReader.readBE<uint8>();
 	uint8 version = versionAndType & 0xF;
 	uint8 type = (versionAndType >> 4) & 0xF;
+	// identifies the source of entries in the decompiled cache
+	uint32 sourceHash = s_shaderCacheDecompiled ? crc32_calc(shaderInfoData, shaderInfoSize) : 0;
 	if (type == SHADER_CACHE_TYPE_VERTEX)
-		return LatteShaderCache_readSeparableVertexShader(streamReader, version);
+		return LatteShaderCache_decodeSeparableVertexShader(streamReader, version, sourceHash, decodedShader);
 	else if (type == SHADER_CACHE_TYPE_GEOMETRY)
-		return LatteShaderCache_readSeparableGeometryShader(streamReader, version);
+		return LatteShaderCache_decodeSeparableGeometryShader(streamReader, version, sourceHash, decodedShader);
 	else if (type == SHADER_CACHE_TYPE_PIXEL)
-		return LatteShaderCache_readSeparablePixelShader(streamReader, version);
+		return LatteShaderCache_decodeSeparablePixelShader(streamReader, version, sourceHash, decodedShader);
 	return false;
 }
 
+// queue a decoded shader for compilation and register it in the runtime shader cache. Must be called from the GPU thread
+void LatteShaderCache_registerDecodedShader(LatteShaderCacheDecodedShader& decodedShader)
+{
+	LatteDecompilerShader* shader = decodedShader.shader;
+	decodedShader.shader = nullptr;
+	LatteShader_DumpShader(decodedShader.baseHash, decodedShader.auxHash, shader);
+	LatteShader_DumpRawShader(decodedShader.baseHash, decodedShader.auxHash, decodedShader.dumpType, decodedShader.programData.data(), decodedShader.programData.size());
+	LatteShaderCache_loadOrCompileSeparableShader(shader, decodedShader.baseHash, decodedShader.auxHash);
+	LatteSHRC_RegisterShader(shader, decodedShader.baseHash, decodedShader.auxHash);
+}
+
+void LatteShaderCache_StopBackgroundLoading()
+{
+    // cached pipelines which are compiled in the background look up their shaders in the runtime shader cache
+    if (g_renderer && g_renderer->GetType() == RendererAPI::Vulkan)
+        VulkanPipelineStableCache::GetInstance().StopLoading();
+}
+
 void LatteShaderCache_Close()
 {
     if(s_shaderCacheGeneric)
@@ -770,14 +1135,20 @@ void LatteShaderCache_Close()
         delete s_shaderCacheGeneric;
         s_shaderCacheGeneric = nullptr;
     }
+    if (s_shaderCacheDecompiled)
+    {
+        delete s_shaderCacheDecompiled;
+        s_shaderCacheDecompiled = nullptr;
+    }
+    // if Vulkan then also close pipeline cache
+    // this also waits for pipelines which are still being compiled in the background
+    if (g_renderer->GetType() == RendererAPI::Vulkan)
+        VulkanPipelineStableCache::GetInstance().Close();
+
     if (g_renderer->GetType() == RendererAPI::Vulkan)
         RendererShaderVk::ShaderCacheLoading_Close();
     else if (g_renderer->GetType() == RendererAPI::OpenGL)
         RendererShaderGL::ShaderCacheLoading_Close();
-
-    // if Vulkan then also close pipeline cache
-    if (g_renderer->GetType() == RendererAPI::Vulkan)
-        VulkanPipelineStableCache::GetInstance().Close();
 }
 
 #include <wx/msgdlg.h>
@@ -149,9 +149,14 @@ public:
 	MPTR texDataPtrLow{};
 	MPTR texDataPtrHigh{};
 	uint32 texDataHash2{};
+	// range registered with the write tracker (if enabled)
+	MPTR writeTrackedBegin{};
+	MPTR writeTrackedEnd{};
+	uint64 writeTrackerStamp{};
 	// state
 	bool isUpdatedOnGPU{ false }; // set if any GPU-side operation modified this texture and strict one-way RAM->VRAM memory mirroring no longer applies
 	bool enableReadback{ false }; // if true, texture will be mirrored back to CPU RAM under specific circumstances
+	uint32 pendingReadbackWrites{}; // number of readbacks of this texture which are not yet retired. RAM may be written by the readback worker while non-zero
 	// invalidation
 	bool forceInvalidate{};
 	// cache control
@@ -2,6 +2,7 @@
 #include "Cafe/HW/Latte/Core/LatteDraw.h"
 #include "Cafe/HW/Latte/Core/LatteTexture.h"
 #include "Cafe/HW/Latte/Renderer/Renderer.h"
+#include "Cafe/HW/MMU/WriteTracker.h"
 #include "Common/cpu_features.h"
 
 std::unordered_set<LatteTexture*> g_allTextures;
@@ -19,6 +20,33 @@ void LatteTC_RegisterTexture(LatteTexture* tex)
 void LatteTC_UnregisterTexture(LatteTexture* tex)
 {
 	g_allTextures.erase(tex);
+	if (tex->writeTrackedEnd != tex->writeTrackedBegin)
+	{
+		WriteTracker::UnregisterRange(tex->writeTrackedBegin, tex->writeTrackedEnd - tex->writeTrackedBegin);
+		tex->writeTrackedBegin = tex->writeTrackedEnd = MPTR_NULL;
+	}
+}
+
+// re-arm write tracking for the texture data range
+// returns false if the write tracker guarantees that texture data was not written since the previous call
+bool _LatteTC_SyncWriteTracker(LatteTexture* hostTexture)
+{
+	if (!WriteTracker::IsEnabled())
+		return true;
+	if (hostTexture->writeTrackedBegin != hostTexture->texDataPtrLow || hostTexture->writeTrackedEnd != hostTexture->texDataPtrHigh)
+	{
+		// data range was not registered yet or changed
+		if (hostTexture->writeTrackedEnd != hostTexture->writeTrackedBegin)
+			WriteTracker::UnregisterRange(hostTexture->writeTrackedBegin, hostTexture->writeTrackedEnd - hostTexture->writeTrackedBegin);
+		hostTexture->writeTrackedBegin = hostTexture->texDataPtrLow;
+		hostTexture->writeTrackedEnd = hostTexture->texDataPtrHigh;
+		hostTexture->writeTrackerStamp = 0;
+		if (hostTexture->writeTrackedEnd != hostTexture->writeTrackedBegin)
+			WriteTracker::RegisterRange(hostTexture->writeTrackedBegin, hostTexture->writeTrackedEnd - hostTexture->writeTrackedBegin);
+	}
+	if (hostTexture->writeTrackedEnd == hostTexture->writeTrackedBegin)
+		return true;
+	return WriteTracker::SyncRange(hostTexture->writeTrackedBegin, hostTexture->writeTrackedEnd - hostTexture->writeTrackedBegin, hostTexture->writeTrackerStamp);
 }
 
 // sample few uint64s uniformly over memory range
@@ -200,6 +228,9 @@ uint64 _botwLargeTexHax = 0;
 
 bool LatteTC_HasTextureChanged(LatteTexture* hostTexture, bool force)
 {
+	// the readback worker may still be writing this texture's data to RAM. The hash is updated once the readback is retired
+	if (hostTexture->pendingReadbackWrites != 0)
+		return false;
 	if (hostTexture->forceInvalidate)
 	{
 		force = true;
@@ -224,9 +255,11 @@ bool LatteTC_HasTextureChanged(LatteTexture* hostTexture, bool force)
 		// todo - remove this or find a better way to handle excluded texture invalidation checks (maybe via game profile?)
 		return false;
 	}
+	// skip hashing if the write tracker saw no CPU writes to the texture data. Forced checks still hash to establish a new baseline
+	bool mayBeModified = _LatteTC_SyncWriteTracker(hostTexture);
 	// workaround for corrupted terrain texture in BotW after video playback
 	// probably would be fixed if we added support for invalidating individual slices/mips of a texture
-	uint32 texDataHash = LatteTexture_CalculateTextureDataHash(hostTexture);
+	uint32 texDataHash = (mayBeModified || force) ? LatteTexture_CalculateTextureDataHash(hostTexture) : hostTexture->texDataHash2;
 	if( texDataHash != hostTexture->texDataHash2 )
 	{
 		hostTexture->texDataHash2 = texDataHash;
@@ -1,6 +1,7 @@
 #include "Cafe/HW/Latte/ISA/RegDefines.h"
 #include "Cafe/HW/Latte/Core/Latte.h"
 #include "Cafe/HW/Latte/Core/LatteShader.h"
+#include "Cafe/HW/Latte/Core/LatteCapture.h"
 
 #include "Cafe/HW/Latte/Renderer/Renderer.h"
 
@@ -265,6 +266,8 @@ void LatteTexture_updateTexturesForStage(LatteDecompilerShader* shaderContext, u
 			swizzleChanged = true;
 			cemu_assert_debug(physMipAddr != MPTR_NULL);
 		}
+		if (LatteCapture_IsActive())
+			LatteCapture_RecordTexture(textureView->baseTexture);
 		// check for changes
 		if (LatteTC_HasTextureChanged(textureView->baseTexture) || swizzleChanged)
 		{
@@ -2,14 +2,150 @@
 #include "Cafe/HW/Latte/LatteAddrLib/LatteAddrLib.h"
 #include "config/ActiveSettings.h"
 #include "Cafe/CafeSystem.h"
+#include "util/helpers/helpers.h"
 
 //#define BENCHMARK_TEXTURE_DECODING		// if defined, time it takes to decode textures will be measured and logged to log.txt
 
 #ifdef BENCHMARK_TEXTURE_DECODING
+#include "util/highresolutiontimer/HighResolutionTimer.h"
+
 uint64 textureDecodeBenchmark_perFormatSum[0x40] = { 0 }; // duration sum per texture format (hw format) - in microseconds
+uint64 textureDecodeBenchmark_perFormatCount[0x40] = { 0 }; // number of decoded slices per texture format
+uint64 textureDecodeBenchmark_perFormatBytes[0x40] = { 0 }; // size of decoded data per texture format
+uint64 textureDecodeBenchmark_perFormatParallelCount[0x40] = { 0 }; // number of slices which were decoded on multiple threads
 uint64 textureDecodeBenchmark_totalSum = 0;
 #endif
 
+// slices which decode to at least this many bytes are split into bands of rows and decoded on multiple threads
+#define TEXTURE_DECODE_PARALLEL_MIN_SIZE	(512 * 1024)
+
+// decodes a slice in bands of rows on a few worker threads
+// the calling thread decodes bands too and only returns once the whole slice is decoded
+class LatteTextureDecodeWorkers
+{
+public:
+	LatteTextureDecodeWorkers()
+	{
+		// leave cores for the CPU and GPU threads
+		m_workerCount = std::clamp<sint32>((sint32)std::thread::hardware_concurrency() - 2, 0, 4);
+		for (sint32 i = 0; i < m_workerCount; i++)
+			std::thread(&LatteTextureDecodeWorkers::WorkerThread, this).detach();
+	}
+
+	sint32 GetWorkerCount() const
+	{
+		return m_workerCount;
+	}
+
+	void Decode(TextureDecoder* texDecoder, LatteTextureLoaderCtx* textureLoader, uint8* outputData, sint32 bandHeight)
+	{
+		std::unique_lock _l(m_mutex);
+		m_job.decoder = texDecoder;
+		m_job.textureLoader = textureLoader;
+		m_job.outputData = outputData;
+		m_job.bandHeight = bandHeight;
+		m_job.bandCount = (textureLoader->height + bandHeight - 1) / bandHeight;
+		m_nextBand = 0;
+		m_bandsRemaining = m_job.bandCount;
+		m_jobGeneration++;
+		m_job.generation = m_jobGeneration;
+		DecodeJob job = m_job;
+		_l.unlock();
+		m_workAvailable.notify_all();
+		while (DecodeNextBand(job)) ;
+		// wait until all bands are done and every worker which picked up the job has left it
+		_l.lock();
+		m_workDone.wait(_l, [this]() { return m_bandsRemaining == 0 && m_activeWorkers == 0; });
+	}
+
+private:
+	struct DecodeJob
+	{
+		TextureDecoder* decoder;
+		LatteTextureLoaderCtx* textureLoader;
+		uint8* outputData;
+		sint32 bandHeight;
+		sint32 bandCount;
+		uint32 generation;
+	};
+
+	void WorkerThread()
+	{
+		SetThreadName("TexDecode");
+		uint32 lastJobGeneration = 0;
+		while (true)
+		{
+			std::unique_lock _l(m_mutex);
+			m_workAvailable.wait(_l, [&]() { return m_jobGeneration != lastJobGeneration; });
+			lastJobGeneration = m_jobGeneration;
+			DecodeJob job = m_job;
+			m_activeWorkers++;
+			_l.unlock();
+			while (DecodeNextBand(job)) ;
+			_l.lock();
+			m_activeWorkers--;
+			if (m_activeWorkers == 0)
+				m_workDone.notify_all();
+		}
+	}
+
+	bool DecodeNextBand(const DecodeJob& job)
+	{
+		// a worker may wake up only after the job it saw has finished. Claims are tied to the job generation so that it can never take a band of the next job
+		std::unique_lock _l(m_mutex);
+		if (job.generation != m_jobGeneration || m_nextBand >= job.bandCount)
+			return false;
+		sint32 bandIndex = m_nextBand++;
+		_l.unlock();
+		LatteTextureLoaderCtx bandCtx = *job.textureLoader;
+		bandCtx.decodeBeginY = bandIndex * job.bandHeight;
+		bandCtx.decodeEndY = std::min(bandCtx.decodeBeginY + job.bandHeight, job.textureLoader->height);
+		job.decoder->decode(&bandCtx, job.outputData);
+		_l.lock();
+		m_bandsRemaining--;
+		if (m_bandsRemaining == 0)
+			m_workDone.notify_all();
+		return true;
+	}
+
+	sint32 m_workerCount;
+	std::mutex m_mutex;
+	std::condition_variable m_workAvailable;
+	std::condition_variable m_workDone;
+	DecodeJob m_job{};
+	uint32 m_jobGeneration{0};
+	sint32 m_activeWorkers{0};
+	sint32 m_nextBand{0};
+	sint32 m_bandsRemaining{0};
+};
+
+LatteTextureDecodeWorkers* LatteTextureLoader_GetDecodeWorkers()
+{
+	static LatteTextureDecodeWorkers* s_decodeWorkers = new LatteTextureDecodeWorkers(); // never freed since the worker threads are detached
+	return s_decodeWorkers;
+}
+
+// returns true if the slice was decoded on multiple threads
+bool LatteTextureLoader_decodeSlice(TextureDecoder* texDecoder, LatteTextureLoaderCtx* textureLoader, uint8* outputData, uint32 imageSize)
+{
+	LatteTextureDecodeWorkers* decodeWorkers = nullptr;
+	if (imageSize >= TEXTURE_DECODE_PARALLEL_MIN_SIZE && texDecoder->canDecodeRowRange())
+		decodeWorkers = LatteTextureLoader_GetDecodeWorkers();
+	// bands are multiples of 8 texel rows so they never split a micro tile
+	sint32 bandAlignment = 8 * textureLoader->stepY;
+	if (!decodeWorkers || decodeWorkers->GetWorkerCount() == 0 || textureLoader->height < bandAlignment * 2)
+	{
+		texDecoder->decode(textureLoader, outputData);
+		return false;
+	}
+	// use a few bands per thread to balance uneven decode cost
+	sint32 bandCount = (decodeWorkers->GetWorkerCount() + 1) * 4;
+	sint32 bandHeight = (textureLoader->height + bandCount - 1) / bandCount;
+	bandHeight = (bandHeight + bandAlignment - 1) / bandAlignment * bandAlignment;
+	decodeWorkers->Decode(texDecoder, textureLoader, outputData, bandHeight);
+	return true;
+}
+
 void LatteTextureLoader_begin(LatteTextureLoaderCtx* textureLoader, uint32 sliceIndex, uint32 mipIndex, MPTR physImagePtr, MPTR physMipPtr, Latte::E_GX2SURFFMT format, Latte::E_DIM dim, uint32 width, uint32 height, uint32 depth, uint32 mipLevels, uint32 pitch, Latte::E_HWTILEMODE tileMode, uint32 swizzle)
 {
 	textureLoader->physAddress = physImagePtr;
@@ -80,6 +216,8 @@ void LatteTextureLoader_begin(LatteTextureLoaderCtx* textureLoader, uint32 slice
 	textureLoader->width = std::max(textureLoader->width, 1);
 	textureLoader->height = height >> (mipIndex);
 	textureLoader->height = std::max(textureLoader->height, 1);
+	textureLoader->decodeBeginY = 0;
+	textureLoader->decodeEndY = textureLoader->height;
 
 	textureLoader->pitch = surfaceInfo.pitch;
 	// calculate start address
@@ -646,22 +784,26 @@ void LatteTextureLoader_UpdateTextureSliceData(LatteTexture* tex, uint32 sliceIn
 	uint8* pixelData = (uint8*)g_renderer->texture_acquireTextureUploadBuffer(imageSize);
 	// decode texture (if data is required)
 #ifdef BENCHMARK_TEXTURE_DECODING
-	LARGE_INTEGER benchmark_begin;
-	LARGE_INTEGER benchmark_end;
-	LARGE_INTEGER benchmark_freq;
-	QueryPerformanceCounter(&benchmark_begin);
+	BenchmarkTimer benchmarkTimer;
+	benchmarkTimer.Start();
 #endif
+	bool decodedInParallel = false;
 	if (tex->overwriteInfo.hasFormatOverwrite == false && tex->overwriteInfo.hasResolutionOverwrite == false)
 	{
-		texDecoder->decode(&textureLoader, pixelData);
+		decodedInParallel = LatteTextureLoader_decodeSlice(texDecoder, &textureLoader, pixelData, imageSize);
 	}
 #ifdef BENCHMARK_TEXTURE_DECODING
-	QueryPerformanceCounter(&benchmark_end);
-	QueryPerformanceFrequency(&benchmark_freq);
-	uint64 benchmarkResultMicroSeconds = (benchmark_end.QuadPart - benchmark_begin.QuadPart) * 1000000ULL / benchmark_freq.QuadPart;
-	textureDecodeBenchmark_perFormatSum[(int)tex->format & 0x3F] += benchmarkResultMicroSeconds;
+	benchmarkTimer.Stop();
+	uint64 benchmarkResultMicroSeconds = (uint64)(benchmarkTimer.GetElapsedMilliseconds() * 1000.0);
+	uint32 benchmarkFormatIndex = (uint32)tex->format & 0x3F;
+	textureDecodeBenchmark_perFormatSum[benchmarkFormatIndex] += benchmarkResultMicroSeconds;
+	textureDecodeBenchmark_perFormatCount[benchmarkFormatIndex]++;
+	textureDecodeBenchmark_perFormatBytes[benchmarkFormatIndex] += imageSize;
+	if (decodedInParallel)
+		textureDecodeBenchmark_perFormatParallelCount[benchmarkFormatIndex]++;
 	textureDecodeBenchmark_totalSum += benchmarkResultMicroSeconds;
-	cemuLog_log(LogType::Force, "TexDecode {:04}x{:04}x{:04} Fmt {:04x} Dim {} TileMode {:02x} Took {:03}.{:03}ms Sum(format) {:06}ms Sum(total) {:06}ms", textureLoader.width, textureLoader.height, textureLoader.surfaceInfoDepth, (int)tex->format, (int)tex->dim, textureLoader.tileMode, (uint32)(benchmarkResultMicroSeconds / 1000ULL), (uint32)(benchmarkResultMicroSeconds % 1000ULL), (uint32)(textureDecodeBenchmark_perFormatSum[tex->gx2Format & 0x3F] / 1000ULL), (uint32)(textureDecodeBenchmark_totalSum / 1000ULL));
+	double formatThroughputMBs = (double)textureDecodeBenchmark_perFormatBytes[benchmarkFormatIndex] / (double)std::max<uint64>(textureDecodeBenchmark_perFormatSum[benchmarkFormatIndex], 1);
+	cemuLog_log(LogType::Force, "TexDecode {:04}x{:04}x{:04} Fmt {:04x} Dim {} TileMode {:02x} Took {:03}.{:03}ms{} Sum(format) {:06}ms Count(format) {} ({} parallel) Throughput(format) {:.1f}MB/s Sum(total) {:06}ms", textureLoader.width, textureLoader.height, textureLoader.surfaceInfoDepth, (int)tex->format, (int)tex->dim, textureLoader.tileMode, (uint32)(benchmarkResultMicroSeconds / 1000ULL), (uint32)(benchmarkResultMicroSeconds % 1000ULL), decodedInParallel ? " (parallel)" : "", (uint32)(textureDecodeBenchmark_perFormatSum[benchmarkFormatIndex] / 1000ULL), textureDecodeBenchmark_perFormatCount[benchmarkFormatIndex], textureDecodeBenchmark_perFormatParallelCount[benchmarkFormatIndex], formatThroughputMBs, (uint32)(textureDecodeBenchmark_totalSum / 1000ULL));
 #endif
 
 	// convert texture to RGBA when dumping is enabled
@@ -29,6 +29,9 @@ struct LatteTextureLoaderCtx
 	// info for decoded texture
 	sint32 decodedTexelCountX;
 	sint32 decodedTexelCountY;
+	// range of pixel rows processed by TextureDecoder::decode(). Allows large slices to be decoded in bands on multiple threads
+	sint32 decodeBeginY;
+	sint32 decodeEndY;
 	// decoder
 	LatteAddrLib::CachedSurfaceAddrInfo computeAddrInfo;
 	// debug dump texture
@@ -47,6 +50,17 @@ void decodeBC4Block_UNORM(uint8* blockStorage, float* rOutput);
 void decodeBC5Block_UNORM(uint8* blockStorage, float* rgOutput);
 void decodeBC5Block_SNORM(uint8* blockStorage, float* rgOutput);
 
+// integer decoders for UNORM formats. Decode blockCount consecutive blocks into 4 rows of RGBA8/R8/RG8 pixels
+void decodeBC1Blocks_RGBA8(const uint8* blockData, sint32 blockCount, uint8* output, uint32 outputPitch);
+void decodeBC2Blocks_RGBA8(const uint8* blockData, sint32 blockCount, uint8* output, uint32 outputPitch);
+void decodeBC3Blocks_RGBA8(const uint8* blockData, sint32 blockCount, uint8* output, uint32 outputPitch);
+void decodeBC4Blocks_R8(const uint8* blockData, sint32 blockCount, uint8* output, uint32 outputPitch);
+void decodeBC5Blocks_RG8(const uint8* blockData, sint32 blockCount, uint8* output, uint32 outputPitch);
+
+using BCnBlockRowDecodeFunc = void(*)(const uint8* blockData, sint32 blockCount, uint8* output, uint32 outputPitch);
+void LatteTextureLoader_decodeBCnBlockRows(LatteTextureLoaderCtx* textureLoader, uint8* outputData, BCnBlockRowDecodeFunc decodeFunc, sint32 blockSize, sint32 bytesPerPixel);
+bool LatteTextureLoader_TestBCnDecoders();
+
 inline void BC1_GetPixel(uint8* inputData, sint32 x, sint32 y, uint8 rgba[4])
 {
 	// read colors
@@ -122,6 +136,12 @@ public:
 	// decode loop
 	virtual void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) = 0;
 
+	// returns false if decode() ignores decodeBeginY/decodeEndY and always processes the whole slice
+	virtual bool canDecodeRowRange()
+	{
+		return true;
+	}
+
 	virtual void decodePixelToRGBA(uint8* blockData, uint8* outputPixel, uint8 blockOffsetX, uint8 blockOffsetY) = 0;
 };
 
@@ -398,7 +418,7 @@ public:
 		// note - before 1.15.4 this format was implemented as big-endian
 		//optimizedDecodeLoops<uint64, 2, false>(textureLoader, outputData);
 
-		for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
+		for (sint32 y = textureLoader->decodeBeginY; y < textureLoader->decodeEndY; y += textureLoader->stepY)
 		{
 			sint32 yc = y;
 			for (sint32 x = 0; x < textureLoader->width; x += textureLoader->stepX)
@@ -436,7 +456,7 @@ public:
 		// note - before 1.15.4 this format was implemented as big-endian
 		//optimizedDecodeLoops<uint64, 1, false>(textureLoader, outputData);
 
-		for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
+		for (sint32 y = textureLoader->decodeBeginY; y < textureLoader->decodeEndY; y += textureLoader->stepY)
 		{
 			sint32 yc = y;
 			for (sint32 x = 0; x < textureLoader->width; x += textureLoader->stepX)
@@ -494,7 +514,7 @@ public:
 
 	void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
 	{
-		for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
+		for (sint32 y = textureLoader->decodeBeginY; y < textureLoader->decodeEndY; y += textureLoader->stepY)
 		{
 			sint32 yc = y;
 			for (sint32 x = 0; x < textureLoader->width; x += textureLoader->stepX)
@@ -521,7 +541,7 @@ public:
 
 	void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
 	{
-		for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
+		for (sint32 y = textureLoader->decodeBeginY; y < textureLoader->decodeEndY; y += textureLoader->stepY)
 		{
 			sint32 yc = y;
 			for (sint32 x = 0; x < textureLoader->width; x += textureLoader->stepX)
@@ -566,7 +586,7 @@ public:
 
 	void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
 	{
-		for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
+		for (sint32 y = textureLoader->decodeBeginY; y < textureLoader->decodeEndY; y += textureLoader->stepY)
 		{
 			sint32 yc = y;
 			for (sint32 x = 0; x < textureLoader->width; x += textureLoader->stepX)
@@ -604,7 +624,7 @@ public:
 
 	void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
 	{
-		for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
+		for (sint32 y = textureLoader->decodeBeginY; y < textureLoader->decodeEndY; y += textureLoader->stepY)
 		{
 			sint32 yc = y;
 			for (sint32 x = 0; x < textureLoader->width; x += textureLoader->stepX)
@@ -642,7 +662,7 @@ public:
 
 	void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
 	{
-		for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
+		for (sint32 y = textureLoader->decodeBeginY; y < textureLoader->decodeEndY; y += textureLoader->stepY)
 		{
 			sint32 yc = y;
 			for (sint32 x = 0; x < textureLoader->width; x += textureLoader->stepX)
@@ -689,7 +709,7 @@ public:
 
 	void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
 	{
-		for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
+		for (sint32 y = textureLoader->decodeBeginY; y < textureLoader->decodeEndY; y += textureLoader->stepY)
 		{
 			sint32 yc = y;
 			for (sint32 x = 0; x < textureLoader->width; x += textureLoader->stepX)
@@ -734,7 +754,7 @@ public:
 
 	void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
 	{
-		for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
+		for (sint32 y = textureLoader->decodeBeginY; y < textureLoader->decodeEndY; y += textureLoader->stepY)
 		{
 			sint32 yc = y;
 			for (sint32 x = 0; x < textureLoader->width; x += textureLoader->stepX)
@@ -843,6 +863,11 @@ public:
 		memset(outputData, 0, sizeof(uint32) * getTexelCountX(textureLoader) * getTexelCountY(textureLoader));
 	}
 
+	bool canDecodeRowRange() override
+	{
+		return false;
+	}
+
 	void decodePixelToRGBA(uint8* blockData, uint8* outputPixel, uint8 blockOffsetX, uint8 blockOffsetY) override
 	{
 	}
@@ -861,6 +886,11 @@ public:
 		memset(outputData, 0, sizeof(uint64) * getTexelCountX(textureLoader) * getTexelCountY(textureLoader));
 	}
 
+	bool canDecodeRowRange() override
+	{
+		return false;
+	}
+
 	void decodePixelToRGBA(uint8* blockData, uint8* outputPixel, uint8 blockOffsetX, uint8 blockOffsetY) override
 	{
 	}
@@ -1039,7 +1069,7 @@ public:
 
 	void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
 	{
-		for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
+		for (sint32 y = textureLoader->decodeBeginY; y < textureLoader->decodeEndY; y += textureLoader->stepY)
 		{
 			sint32 yc = y;
 			for (sint32 x = 0; x < textureLoader->width; x += textureLoader->stepX)
@@ -1095,7 +1125,7 @@ public:
 
 	void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
 	{
-		for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
+		for (sint32 y = textureLoader->decodeBeginY; y < textureLoader->decodeEndY; y += textureLoader->stepY)
 		{
 			sint32 yc = y;
 			for (sint32 x = 0; x < textureLoader->width; x += textureLoader->stepX)
@@ -1214,7 +1244,7 @@ public:
 
     void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
     {
-        for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
+        for (sint32 y = textureLoader->decodeBeginY; y < textureLoader->decodeEndY; y += textureLoader->stepY)
         {
             sint32 yc = y;
             for (sint32 x = 0; x < textureLoader->width; x += textureLoader->stepX)
@@ -1335,7 +1365,7 @@ public:
 
 	void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
 	{
-		for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
+		for (sint32 y = textureLoader->decodeBeginY; y < textureLoader->decodeEndY; y += textureLoader->stepY)
 		{
 			sint32 yc = y;
 			for (sint32 x = 0; x < textureLoader->width; x += textureLoader->stepX)
@@ -1378,7 +1408,7 @@ public:
 
     void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
     {
-        for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
+        for (sint32 y = textureLoader->decodeBeginY; y < textureLoader->decodeEndY; y += textureLoader->stepY)
         {
             sint32 yc = y;
             for (sint32 x = 0; x < textureLoader->width; x += textureLoader->stepX)
@@ -1456,7 +1486,7 @@ public:
 	void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
 	{
 		// todo - implement
-		for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
+		for (sint32 y = textureLoader->decodeBeginY; y < textureLoader->decodeEndY; y += textureLoader->stepY)
 		{
 			sint32 yc = y;
 			sint32 pixelOffset = (yc * textureLoader->width) * (2 * 4);
@@ -1501,7 +1531,7 @@ public:
 	void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
 	{
 		// todo - implement
-		for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
+		for (sint32 y = textureLoader->decodeBeginY; y < textureLoader->decodeEndY; y += textureLoader->stepY)
 		{
 			sint32 yc = y;
 			sint32 pixelOffset = (yc * textureLoader->width) * (2 * 4);
@@ -1559,39 +1589,12 @@ class TextureDecoder_BC1_UNORM_uncompress_generic : public TextureDecoder
 public:
 	sint32 getBytesPerTexel(LatteTextureLoaderCtx* textureLoader) override
 	{
-		return 4 * 4;
+		return 4;
 	}
 
 	void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
 	{
-		for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
-		{
-			for (sint32 x = 0; x < textureLoader->width; x += textureLoader->stepX)
-			{
-				uint8* blockData = LatteTextureLoader_GetInput(textureLoader, x, y);
-				sint32 blockSizeX = (std::min)(4, textureLoader->width - x);
-				sint32 blockSizeY = (std::min)(4, textureLoader->height - y);
-				// decode 4x4 pixels at once
-				float rgbaBlock[4 * 4 * 4];
-				decodeBC1Block(blockData, rgbaBlock);
-				for (sint32 py = 0; py < blockSizeY; py++)
-				{
-					sint32 yc = y + py;
-					for (sint32 px = 0; px < blockSizeX; px++)
-					{
-						sint32 pixelOffset = (x + px + yc * textureLoader->width) * 16; // write to target buffer
-						float red = rgbaBlock[(px + py * 4) * 4 + 0];
-						float green = rgbaBlock[(px + py * 4) * 4 + 1];
-						float blue = rgbaBlock[(px + py * 4) * 4 + 2];
-						float alpha = rgbaBlock[(px + py * 4) * 4 + 3];
-						*(float*)(outputData + pixelOffset + 0) = red;
-						*(float*)(outputData + pixelOffset + 4) = green;
-						*(float*)(outputData + pixelOffset + 8) = blue;
-						*(float*)(outputData + pixelOffset + 12) = alpha;
-					}
-				}
-			}
-		}
+		LatteTextureLoader_decodeBCnBlockRows(textureLoader, outputData, decodeBC1Blocks_RGBA8, 8, 4);
 	}
 
 	void decodePixelToRGBA(uint8* blockData, uint8* outputPixel, uint8 blockOffsetX, uint8 blockOffsetY) override
@@ -1685,39 +1688,12 @@ public:
 
 	sint32 getBytesPerTexel(LatteTextureLoaderCtx* textureLoader) override
 	{
-		return 4 * 4;
+		return 4;
 	}
 
 	void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
 	{
-		for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
-		{
-			for (sint32 x = 0; x < textureLoader->width; x += textureLoader->stepX)
-			{
-				uint8* blockData = LatteTextureLoader_GetInput(textureLoader, x, y);
-				sint32 blockSizeX = (std::min)(4, textureLoader->width - x);
-				sint32 blockSizeY = (std::min)(4, textureLoader->height - y);
-				// decode 4x4 pixels at once
-				float rgbaBlock[4 * 4 * 4];
-				decodeBC2Block_UNORM(blockData, rgbaBlock);
-				for (sint32 py = 0; py < blockSizeY; py++)
-				{
-					sint32 yc = y + py;
-					for (sint32 px = 0; px < blockSizeX; px++)
-					{
-						sint32 pixelOffset = (x + px + yc * textureLoader->width) * 16; // write to target buffer
-						float red = rgbaBlock[(px + py * 4) * 4 + 0];
-						float green = rgbaBlock[(px + py * 4) * 4 + 1];
-						float blue = rgbaBlock[(px + py * 4) * 4 + 2];
-						float alpha = rgbaBlock[(px + py * 4) * 4 + 3];
-						*(float*)(outputData + pixelOffset + 0) = red;
-						*(float*)(outputData + pixelOffset + 4) = green;
-						*(float*)(outputData + pixelOffset + 8) = blue;
-						*(float*)(outputData + pixelOffset + 12) = alpha;
-					}
-				}
-			}
-		}
+		LatteTextureLoader_decodeBCnBlockRows(textureLoader, outputData, decodeBC2Blocks_RGBA8, 16, 4);
 	}
 
 	void decodePixelToRGBA(uint8* blockData, uint8* outputPixel, uint8 blockOffsetX, uint8 blockOffsetY) override
@@ -1741,40 +1717,13 @@ public:
 
 	sint32 getBytesPerTexel(LatteTextureLoaderCtx* textureLoader) override
 	{
-		return 4 * 4;
+		return 4;
 	}
 
 	void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
 	{
 		// todo - apply srgb conversion
-		for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
-		{
-			for (sint32 x = 0; x < textureLoader->width; x += textureLoader->stepX)
-			{
-				uint8* blockData = LatteTextureLoader_GetInput(textureLoader, x, y);
-				sint32 blockSizeX = (std::min)(4, textureLoader->width - x);
-				sint32 blockSizeY = (std::min)(4, textureLoader->height - y);
-				// decode 4x4 pixels at once
-				float rgbaBlock[4 * 4 * 4];
-				decodeBC2Block_UNORM(blockData, rgbaBlock);
-				for (sint32 py = 0; py < blockSizeY; py++)
-				{
-					sint32 yc = y + py;
-					for (sint32 px = 0; px < blockSizeX; px++)
-					{
-						sint32 pixelOffset = (x + px + yc * textureLoader->width) * 16; // write to target buffer
-						float red = rgbaBlock[(px + py * 4) * 4 + 0];
-						float green = rgbaBlock[(px + py * 4) * 4 + 1];
-						float blue = rgbaBlock[(px + py * 4) * 4 + 2];
-						float alpha = rgbaBlock[(px + py * 4) * 4 + 3];
-						*(float*)(outputData + pixelOffset + 0) = red;
-						*(float*)(outputData + pixelOffset + 4) = green;
-						*(float*)(outputData + pixelOffset + 8) = blue;
-						*(float*)(outputData + pixelOffset + 12) = alpha;
-					}
-				}
-			}
-		}
+		LatteTextureLoader_decodeBCnBlockRows(textureLoader, outputData, decodeBC2Blocks_RGBA8, 16, 4);
 	}
 
 	void decodePixelToRGBA(uint8* blockData, uint8* outputPixel, uint8 blockOffsetX, uint8 blockOffsetY) override
@@ -1799,39 +1748,12 @@ public:
 
 	sint32 getBytesPerTexel(LatteTextureLoaderCtx* textureLoader) override
 	{
-		return 4 * 4;
+		return 4;
 	}
 
 	void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
 	{
-		for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
-		{
-			for (sint32 x = 0; x < textureLoader->width; x += textureLoader->stepX)
-			{
-				uint8* blockData = LatteTextureLoader_GetInput(textureLoader, x, y);
-				sint32 blockSizeX = (std::min)(4, textureLoader->width - x);
-				sint32 blockSizeY = (std::min)(4, textureLoader->height - y);
-				// decode 4x4 pixels at once
-				float rgbaBlock[4 * 4 * 4];
-				decodeBC3Block_UNORM(blockData, rgbaBlock);
-				for (sint32 py = 0; py < blockSizeY; py++)
-				{
-					sint32 yc = y + py;
-					for (sint32 px = 0; px < blockSizeX; px++)
-					{
-						sint32 pixelOffset = (x + px + yc * textureLoader->width) * 16; // write to target buffer
-						float red = rgbaBlock[(px + py * 4) * 4 + 0];
-						float green = rgbaBlock[(px + py * 4) * 4 + 1];
-						float blue = rgbaBlock[(px + py * 4) * 4 + 2];
-						float alpha = rgbaBlock[(px + py * 4) * 4 + 3];
-						*(float*)(outputData + pixelOffset + 0) = red;
-						*(float*)(outputData + pixelOffset + 4) = green;
-						*(float*)(outputData + pixelOffset + 8) = blue;
-						*(float*)(outputData + pixelOffset + 12) = alpha;
-					}
-				}
-			}
-		}
+		LatteTextureLoader_decodeBCnBlockRows(textureLoader, outputData, decodeBC3Blocks_RGBA8, 16, 4);
 	}
 
 	void decodePixelToRGBA(uint8* blockData, uint8* outputPixel, uint8 blockOffsetX, uint8 blockOffsetY) override
@@ -1904,35 +1826,12 @@ public:
 
 	sint32 getBytesPerTexel(LatteTextureLoaderCtx* textureLoader) override
 	{
-		return 2 * 4;
+		return 1;
 	}
 
 	void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
 	{
-		for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
-		{
-			for (sint32 x = 0; x < textureLoader->width; x += textureLoader->stepX)
-			{
-				uint8* blockData = LatteTextureLoader_GetInput(textureLoader, x, y);
-				sint32 blockSizeX = (std::min)(4, textureLoader->width - x);
-				sint32 blockSizeY = (std::min)(4, textureLoader->height - y);
-				// decode 4x4 pixels at once
-				float rBlock[4 * 4 * 1];
-				decodeBC4Block_UNORM(blockData, rBlock);
-
-				for (sint32 py = 0; py < blockSizeY; py++)
-				{
-					sint32 yc = y + py;
-					for (sint32 px = 0; px < blockSizeX; px++)
-					{
-						sint32 pixelOffset = (x + px + yc * textureLoader->width) * 8; // write to target buffer
-						float red = rBlock[(px + py * 4) * 1 + 0];
-						*(float*)(outputData + pixelOffset + 0) = red;
-						*(float*)(outputData + pixelOffset + 4) = 0.0f;
-					}
-				}
-			}
-		}
+		LatteTextureLoader_decodeBCnBlockRows(textureLoader, outputData, decodeBC4Blocks_R8, 8, 1);
 	}
 
 	void decodePixelToRGBA(uint8* blockData, uint8* outputPixel, uint8 blockOffsetX, uint8 blockOffsetY) override
@@ -1989,36 +1888,12 @@ public:
 
 	sint32 getBytesPerTexel(LatteTextureLoaderCtx* textureLoader) override
 	{
-		return 2 * 4;
+		return 2;
 	}
 
 	void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
 	{
-		for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
-		{
-			for (sint32 x = 0; x < textureLoader->width; x += textureLoader->stepX)
-			{
-				uint8* blockData = LatteTextureLoader_GetInput(textureLoader, x, y);
-				sint32 blockSizeX = (std::min)(4, textureLoader->width - x);
-				sint32 blockSizeY = (std::min)(4, textureLoader->height - y);
-				// decode 4x4 pixels at once
-				float rgBlock[4 * 4 * 2];
-				decodeBC5Block_UNORM(blockData, rgBlock);
-
-				for (sint32 py = 0; py < blockSizeY; py++)
-				{
-					sint32 yc = y + py;
-					for (sint32 px = 0; px < blockSizeX; px++)
-					{
-						sint32 pixelOffset = (x + px + yc * textureLoader->width) * 8; // write to target buffer
-						float red = rgBlock[(px + py * 4) * 2 + 0];
-						float green = rgBlock[(px + py * 4) * 2 + 1];
-						*(float*)(outputData + pixelOffset + 0) = red;
-						*(float*)(outputData + pixelOffset + 4) = green;
-					}
-				}
-			}
-		}
+		LatteTextureLoader_decodeBCnBlockRows(textureLoader, outputData, decodeBC5Blocks_RG8, 16, 2);
 	}
 
 	void decodePixelToRGBA(uint8* blockData, uint8* outputPixel, uint8 blockOffsetX, uint8 blockOffsetY) override
@@ -2045,7 +1920,7 @@ public:
 
 	void decode(LatteTextureLoaderCtx* textureLoader, uint8* outputData) override
 	{
-		for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
+		for (sint32 y = textureLoader->decodeBeginY; y < textureLoader->decodeEndY; y += textureLoader->stepY)
 		{
 			for (sint32 x = 0; x < textureLoader->width; x += textureLoader->stepX)
 			{
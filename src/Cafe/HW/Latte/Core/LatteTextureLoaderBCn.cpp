@@ -0,0 +1,539 @@
+#include "Cafe/HW/Latte/Core/LatteTextureLoader.h"
+#include "Common/cpu_features.h"
+#include "util/highresolutiontimer/HighResolutionTimer.h"
+
+#include <random>
+
+/*
+ * Integer BC1-BC5 decoders
+ * These decode rows of 4x4 blocks straight into RGBA8/RG8/R8 pixels. The palettes are derived from the same math as the float decoders (decodeBC*Block)
+ * and the output is identical to their result after conversion to UNORM8 via BCn_FloatToUNORM8()
+ */
+
+static uint8 BCn_FloatToUNORM8(float v)
+{
+	return (uint8)(v * 255.0f + 0.5f);
+}
+
+struct BCnDecodeLUT
+{
+	BCnDecodeLUT()
+	{
+		// use the exact float expressions of decodeBC1Block / decodeBC3Block_UNORM so rounding matches
+		for (uint32 a = 0; a < 32; a++)
+		{
+			float fa = (float)a / 31.0f;
+			expand5[a] = BCn_FloatToUNORM8(fa);
+			for (uint32 b = 0; b < 32; b++)
+			{
+				float fb = (float)b / 31.0f;
+				third5[a * 32 + b] = BCn_FloatToUNORM8((fa * 2.0f + fb) / 3.0f);
+				half5[a * 32 + b] = BCn_FloatToUNORM8((fa + fb) / 2.0f);
+			}
+		}
+		for (uint32 a = 0; a < 64; a++)
+		{
+			float fa = (float)a / 63.0f;
+			expand6[a] = BCn_FloatToUNORM8(fa);
+			for (uint32 b = 0; b < 64; b++)
+			{
+				float fb = (float)b / 63.0f;
+				third6[a * 64 + b] = BCn_FloatToUNORM8((fa * 2.0f + fb) / 3.0f);
+				half6[a * 64 + b] = BCn_FloatToUNORM8((fa + fb) / 2.0f);
+			}
+		}
+		// shuffle masks which expand one byte of 2-bit color indices into 4 RGBA8 pixels
+		for (uint32 i = 0; i < 256; i++)
+		{
+			for (uint32 px = 0; px < 4; px++)
+			{
+				uint8 colorIndex = (i >> (px * 2)) & 3;
+				for (uint32 c = 0; c < 4; c++)
+					colorRowShuffle[i][px * 4 + c] = colorIndex * 4 + c;
+			}
+		}
+	}
+
+	uint8 expand5[32];
+	uint8 expand6[64];
+	uint8 third5[32 * 32]; // (2*a+b)/3
+	uint8 third6[64 * 64];
+	uint8 half5[32 * 32]; // (a+b)/2
+	uint8 half6[64 * 64];
+	alignas(16) uint8 colorRowShuffle[256][16];
+};
+
+static BCnDecodeLUT s_bcnLUT;
+
+static inline uint32 BCn_PackRGBA8(uint32 r, uint32 g, uint32 b, uint32 a)
+{
+	return r | (g << 8) | (b << 16) | (a << 24);
+}
+
+// BC1 style color palette, alpha is set to 255 (or 0 for the transparent entry)
+static inline void BCn_DecodeColorPalette(const uint8* colorData, uint32 palette[4], bool allowPunchThrough)
+{
+	uint16 c0 = *(uint16*)(colorData + 0);
+	uint16 c1 = *(uint16*)(colorData + 2);
+	uint32 r0 = (c0 >> 11) & 0x1F;
+	uint32 g0 = (c0 >> 5) & 0x3F;
+	uint32 b0 = (c0 >> 0) & 0x1F;
+	uint32 r1 = (c1 >> 11) & 0x1F;
+	uint32 g1 = (c1 >> 5) & 0x3F;
+	uint32 b1 = (c1 >> 0) & 0x1F;
+	palette[0] = BCn_PackRGBA8(s_bcnLUT.expand5[r0], s_bcnLUT.expand6[g0], s_bcnLUT.expand5[b0], 0xFF);
+	palette[1] = BCn_PackRGBA8(s_bcnLUT.expand5[r1], s_bcnLUT.expand6[g1], s_bcnLUT.expand5[b1], 0xFF);
+	if (!allowPunchThrough || c0 > c1)
+	{
+		palette[2] = BCn_PackRGBA8(s_bcnLUT.third5[r0 * 32 + r1], s_bcnLUT.third6[g0 * 64 + g1], s_bcnLUT.third5[b0 * 32 + b1], 0xFF);
+		palette[3] = BCn_PackRGBA8(s_bcnLUT.third5[r1 * 32 + r0], s_bcnLUT.third6[g1 * 64 + g0], s_bcnLUT.third5[b1 * 32 + b0], 0xFF);
+	}
+	else
+	{
+		palette[2] = BCn_PackRGBA8(s_bcnLUT.half5[r0 * 32 + r1], s_bcnLUT.half6[g0 * 64 + g1], s_bcnLUT.half5[b0 * 32 + b1], 0xFF);
+		palette[3] = 0;
+	}
+}
+
+// BC3 alpha / BC4 / BC5 UNORM palette, returns the 8 palette entries packed into bytes (entry 0 in the lowest byte)
+static inline uint64 BCn_DecodeAlphaPalette(uint8 e0, uint8 e1)
+{
+	uint64 palette = (uint64)e0 | ((uint64)e1 << 8);
+	if (e0 > e1)
+	{
+		// 6 interpolated values, rounded to nearest
+		for (uint32 i = 1; i <= 6; i++)
+			palette |= (uint64)((((7 - i) * e0 + i * e1) * 2 + 7) / 14) << ((1 + i) * 8);
+	}
+	else
+	{
+		// 4 interpolated values, entry 6 is 0x00 and entry 7 is 0xFF
+		for (uint32 i = 1; i <= 4; i++)
+			palette |= (uint64)((((5 - i) * e0 + i * e1) * 2 + 5) / 10) << ((1 + i) * 8);
+		palette |= 0xFFull << 56;
+	}
+	return palette;
+}
+
+// 16 3-bit indices stored in bytes 2-7 of the block
+static inline uint64 BCn_GetAlphaIndexBits(const uint8* blockData)
+{
+	uint64 bits = 0;
+	for (sint32 i = 0; i < 6; i++)
+		bits |= ((uint64)blockData[2 + i] << (i * 8));
+	return bits;
+}
+
+/* scalar implementations */
+
+static void _decodeColorBlocks_RGBA8(const uint8* blockData, sint32 blockCount, uint8* output, uint32 outputPitch, uint32 blockSize, uint32 colorOffset, bool allowPunchThrough)
+{
+	for (sint32 i = 0; i < blockCount; i++)
+	{
+		uint32 palette[4];
+		BCn_DecodeColorPalette(blockData + colorOffset, palette, allowPunchThrough);
+		uint32 colorIndices = *(uint32*)(blockData + colorOffset + 4);
+		for (sint32 py = 0; py < 4; py++)
+		{
+			uint32* rowOutput = (uint32*)(output + py * outputPitch);
+			for (sint32 px = 0; px < 4; px++)
+				rowOutput[px] = palette[(colorIndices >> (2 * (px + 4 * py))) & 3];
+		}
+		blockData += blockSize;
+		output += 4 * 4;
+	}
+}
+
+static void _decodeBC2Alpha_RGBA8(const uint8* blockData, sint32 blockCount, uint8* output, uint32 outputPitch)
+{
+	for (sint32 i = 0; i < blockCount; i++)
+	{
+		uint64 alphaBits = *(uint64*)blockData;
+		for (sint32 py = 0; py < 4; py++)
+		{
+			uint8* rowOutput = output + py * outputPitch;
+			for (sint32 px = 0; px < 4; px++)
+				rowOutput[px * 4 + 3] = (uint8)(((alphaBits >> (4 * (px + 4 * py))) & 0xF) * 0x11);
+		}
+		blockData += 16;
+		output += 4 * 4;
+	}
+}
+
+static void _decodeAlphaBlocks(const uint8* blockData, sint32 blockCount, uint8* output, uint32 outputPitch, uint32 blockSize, uint32 pixelStride)
+{
+	for (sint32 i = 0; i < blockCount; i++)
+	{
+		uint64 palette = BCn_DecodeAlphaPalette(blockData[0], blockData[1]);
+		uint64 indexBits = BCn_GetAlphaIndexBits(blockData);
+		for (sint32 py = 0; py < 4; py++)
+		{
+			uint8* rowOutput = output + py * outputPitch;
+			for (sint32 px = 0; px < 4; px++)
+				rowOutput[px * pixelStride] = (uint8)(palette >> (((indexBits >> (3 * (px + 4 * py))) & 7) * 8));
+		}
+		blockData += blockSize;
+		output += 4 * pixelStride;
+	}
+}
+
+static void _decodeBC1Blocks_RGBA8_Scalar(const uint8* blockData, sint32 blockCount, uint8* output, uint32 outputPitch)
+{
+	_decodeColorBlocks_RGBA8(blockData, blockCount, output, outputPitch, 8, 0, true);
+}
+
+static void _decodeBC2Blocks_RGBA8_Scalar(const uint8* blockData, sint32 blockCount, uint8* output, uint32 outputPitch)
+{
+	_decodeColorBlocks_RGBA8(blockData, blockCount, output, outputPitch, 16, 8, false);
+	_decodeBC2Alpha_RGBA8(blockData, blockCount, output, outputPitch);
+}
+
+static void _decodeBC3Blocks_RGBA8_Scalar(const uint8* blockData, sint32 blockCount, uint8* output, uint32 outputPitch)
+{
+	_decodeColorBlocks_RGBA8(blockData, blockCount, output, outputPitch, 16, 8, false);
+	_decodeAlphaBlocks(blockData, blockCount, output + 3, outputPitch, 16, 4);
+}
+
+static void _decodeBC4Blocks_R8_Scalar(const uint8* blockData, sint32 blockCount, uint8* output, uint32 outputPitch)
+{
+	_decodeAlphaBlocks(blockData, blockCount, output, outputPitch, 8, 1);
+}
+
+static void _decodeBC5Blocks_RG8_Scalar(const uint8* blockData, sint32 blockCount, uint8* output, uint32 outputPitch)
+{
+	_decodeAlphaBlocks(blockData, blockCount, output + 0, outputPitch, 16, 2);
+	_decodeAlphaBlocks(blockData + 8, blockCount, output + 1, outputPitch, 16, 2);
+}
+
+#if defined(ARCH_X86_64)
+
+/* SSE4.1 implementations, the palettes are expanded with pshufb */
+
+// expand the 16 3-bit indices into bytes. Each 32bit lane holds 8 indices, the multiplication moves index i to the top bits
+ATTRIBUTE_SSE41
+static inline __m128i BCn_GetAlphaIndexVector(const uint8* blockData)
+{
+	uint64 indexBits = BCn_GetAlphaIndexBits(blockData);
+	const __m128i shift0 = _mm_setr_epi32(1 << 29, 1 << 26, 1 << 23, 1 << 20);
+	const __m128i shift1 = _mm_setr_epi32(1 << 17, 1 << 14, 1 << 11, 1 << 8);
+	__m128i bitsLow = _mm_set1_epi32((sint32)(indexBits & 0xFFFFFF));
+	__m128i bitsHigh = _mm_set1_epi32((sint32)(indexBits >> 24));
+	__m128i i0 = _mm_srli_epi32(_mm_mullo_epi32(bitsLow, shift0), 29);
+	__m128i i1 = _mm_srli_epi32(_mm_mullo_epi32(bitsLow, shift1), 29);
+	__m128i i2 = _mm_srli_epi32(_mm_mullo_epi32(bitsHigh, shift0), 29);
+	__m128i i3 = _mm_srli_epi32(_mm_mullo_epi32(bitsHigh, shift1), 29);
+	return _mm_packus_epi16(_mm_packus_epi32(i0, i1), _mm_packus_epi32(i2, i3));
+}
+
+// returns the 16 alpha/red values of a BC4 style block in pixel order
+ATTRIBUTE_SSE41
+static inline __m128i BCn_DecodeAlphaBlockVector(const uint8* blockData)
+{
+	__m128i palette = _mm_cvtsi64_si128((long long)BCn_DecodeAlphaPalette(blockData[0], blockData[1]));
+	return _mm_shuffle_epi8(palette, BCn_GetAlphaIndexVector(blockData));
+}
+
+ATTRIBUTE_SSE41
+static inline __m128i BCn_DecodeColorRow(__m128i palette, const uint8* colorIndexData, sint32 row)
+{
+	return _mm_shuffle_epi8(palette, _mm_load_si128((const __m128i*)s_bcnLUT.colorRowShuffle[colorIndexData[row]]));
+}
+
+// move 4 consecutive bytes of a 16 byte vector into the alpha channel of 4 RGBA8 pixels
+ATTRIBUTE_SSE41
+static inline __m128i BCn_AlphaRowMask(sint32 row)
+{
+	char b = (char)(row * 4);
+	return _mm_setr_epi8(-1, -1, -1, b, -1, -1, -1, b + 1, -1, -1, -1, b + 2, -1, -1, -1, b + 3);
+}
+
+ATTRIBUTE_SSE41
+static void _decodeBC1Blocks_RGBA8_SSE41(const uint8* blockData, sint32 blockCount, uint8* output, uint32 outputPitch)
+{
+	for (sint32 i = 0; i < blockCount; i++)
+	{
+		uint32 palette[4];
+		BCn_DecodeColorPalette(blockData, palette, true);
+		__m128i paletteVec = _mm_setr_epi32(palette[0], palette[1], palette[2], palette[3]);
+		for (sint32 py = 0; py < 4; py++)
+			_mm_storeu_si128((__m128i*)(output + py * outputPitch), BCn_DecodeColorRow(paletteVec, blockData + 4, py));
+		blockData += 8;
+		output += 4 * 4;
+	}
+}
+
+ATTRIBUTE_SSE41
+static void _decodeBC2Blocks_RGBA8_SSE41(const uint8* blockData, sint32 blockCount, uint8* output, uint32 outputPitch)
+{
+	const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+	const __m128i alphaClearMask = _mm_set1_epi32(0x00FFFFFF);
+	for (sint32 i = 0; i < blockCount; i++)
+	{
+		uint32 palette[4];
+		BCn_DecodeColorPalette(blockData + 8, palette, false);
+		__m128i paletteVec = _mm_and_si128(_mm_setr_epi32(palette[0], palette[1], palette[2], palette[3]), alphaClearMask);
+		// unpack 4-bit alpha into bytes in pixel order and expand to 8 bit
+		__m128i alphaPacked = _mm_loadl_epi64((const __m128i*)blockData);
+		__m128i alphaLow = _mm_and_si128(alphaPacked, nibbleMask);
+		__m128i alphaHigh = _mm_and_si128(_mm_srli_epi16(alphaPacked, 4), nibbleMask);
+		__m128i alpha = _mm_unpacklo_epi8(alphaLow, alphaHigh);
+		alpha = _mm_or_si128(alpha, _mm_slli_epi16(alpha, 4));
+		for (sint32 py = 0; py < 4; py++)
+		{
+			__m128i row = _mm_or_si128(BCn_DecodeColorRow(paletteVec, blockData + 12, py), _mm_shuffle_epi8(alpha, BCn_AlphaRowMask(py)));
+			_mm_storeu_si128((__m128i*)(output + py * outputPitch), row);
+		}
+		blockData += 16;
+		output += 4 * 4;
+	}
+}
+
+ATTRIBUTE_SSE41
+static void _decodeBC3Blocks_RGBA8_SSE41(const uint8* blockData, sint32 blockCount, uint8* output, uint32 outputPitch)
+{
+	const __m128i alphaClearMask = _mm_set1_epi32(0x00FFFFFF);
+	for (sint32 i = 0; i < blockCount; i++)
+	{
+		uint32 palette[4];
+		BCn_DecodeColorPalette(blockData + 8, palette, false);
+		__m128i paletteVec = _mm_and_si128(_mm_setr_epi32(palette[0], palette[1], palette[2], palette[3]), alphaClearMask);
+		__m128i alpha = BCn_DecodeAlphaBlockVector(blockData);
+		for (sint32 py = 0; py < 4; py++)
+		{
+			__m128i row = _mm_or_si128(BCn_DecodeColorRow(paletteVec, blockData + 12, py), _mm_shuffle_epi8(alpha, BCn_AlphaRowMask(py)));
+			_mm_storeu_si128((__m128i*)(output + py * outputPitch), row);
+		}
+		blockData += 16;
+		output += 4 * 4;
+	}
+}
+
+ATTRIBUTE_SSE41
+static void _decodeBC4Blocks_R8_SSE41(const uint8* blockData, sint32 blockCount, uint8* output, uint32 outputPitch)
+{
+	for (sint32 i = 0; i < blockCount; i++)
+	{
+		__m128i red = BCn_DecodeAlphaBlockVector(blockData);
+		*(uint32*)(output + 0 * outputPitch) = (uint32)_mm_extract_epi32(red, 0);
+		*(uint32*)(output + 1 * outputPitch) = (uint32)_mm_extract_epi32(red, 1);
+		*(uint32*)(output + 2 * outputPitch) = (uint32)_mm_extract_epi32(red, 2);
+		*(uint32*)(output + 3 * outputPitch) = (uint32)_mm_extract_epi32(red, 3);
+		blockData += 8;
+		output += 4;
+	}
+}
+
+ATTRIBUTE_SSE41
+static void _decodeBC5Blocks_RG8_SSE41(const uint8* blockData, sint32 blockCount, uint8* output, uint32 outputPitch)
+{
+	for (sint32 i = 0; i < blockCount; i++)
+	{
+		__m128i red = BCn_DecodeAlphaBlockVector(blockData);
+		__m128i green = BCn_DecodeAlphaBlockVector(blockData + 8);
+		__m128i rows01 = _mm_unpacklo_epi8(red, green);
+		__m128i rows23 = _mm_unpackhi_epi8(red, green);
+		_mm_storel_epi64((__m128i*)(output + 0 * outputPitch), rows01);
+		_mm_storel_epi64((__m128i*)(output + 1 * outputPitch), _mm_unpackhi_epi64(rows01, rows01));
+		_mm_storel_epi64((__m128i*)(output + 2 * outputPitch), rows23);
+		_mm_storel_epi64((__m128i*)(output + 3 * outputPitch), _mm_unpackhi_epi64(rows23, rows23));
+		blockData += 16;
+		output += 4 * 2;
+	}
+}
+
+#endif
+
+void decodeBC1Blocks_RGBA8(const uint8* blockData, sint32 blockCount, uint8* output, uint32 outputPitch)
+{
+#if defined(ARCH_X86_64)
+	if (g_CPUFeatures.x86.sse4_1)
+	{
+		_decodeBC1Blocks_RGBA8_SSE41(blockData, blockCount, output, outputPitch);
+		return;
+	}
+#endif
+	_decodeBC1Blocks_RGBA8_Scalar(blockData, blockCount, output, outputPitch);
+}
+
+void decodeBC2Blocks_RGBA8(const uint8* blockData, sint32 blockCount, uint8* output, uint32 outputPitch)
+{
+#if defined(ARCH_X86_64)
+	if (g_CPUFeatures.x86.sse4_1)
+	{
+		_decodeBC2Blocks_RGBA8_SSE41(blockData, blockCount, output, outputPitch);
+		return;
+	}
+#endif
+	_decodeBC2Blocks_RGBA8_Scalar(blockData, blockCount, output, outputPitch);
+}
+
+void decodeBC3Blocks_RGBA8(const uint8* blockData, sint32 blockCount, uint8* output, uint32 outputPitch)
+{
+#if defined(ARCH_X86_64)
+	if (g_CPUFeatures.x86.sse4_1)
+	{
+		_decodeBC3Blocks_RGBA8_SSE41(blockData, blockCount, output, outputPitch);
+		return;
+	}
+#endif
+	_decodeBC3Blocks_RGBA8_Scalar(blockData, blockCount, output, outputPitch);
+}
+
+void decodeBC4Blocks_R8(const uint8* blockData, sint32 blockCount, uint8* output, uint32 outputPitch)
+{
+#if defined(ARCH_X86_64)
+	if (g_CPUFeatures.x86.sse4_1)
+	{
+		_decodeBC4Blocks_R8_SSE41(blockData, blockCount, output, outputPitch);
+		return;
+	}
+#endif
+	_decodeBC4Blocks_R8_Scalar(blockData, blockCount, output, outputPitch);
+}
+
+void decodeBC5Blocks_RG8(const uint8* blockData, sint32 blockCount, uint8* output, uint32 outputPitch)
+{
+#if defined(ARCH_X86_64)
+	if (g_CPUFeatures.x86.sse4_1)
+	{
+		_decodeBC5Blocks_RG8_SSE41(blockData, blockCount, output, outputPitch);
+		return;
+	}
+#endif
+	_decodeBC5Blocks_RG8_Scalar(blockData, blockCount, output, outputPitch);
+}
+
+// gathers rows of blocks from the (tiled) input and decodes them with one call per chunk
+void LatteTextureLoader_decodeBCnBlockRows(LatteTextureLoaderCtx* textureLoader, uint8* outputData, BCnBlockRowDecodeFunc decodeFunc, sint32 blockSize, sint32 bytesPerPixel)
+{
+	constexpr sint32 BLOCKS_PER_CHUNK = 64;
+	uint8 blockBuffer[BLOCKS_PER_CHUNK * 16];
+	uint8 rowBuffer[4 * BLOCKS_PER_CHUNK * 4 * 4];
+	uint32 outputPitch = textureLoader->width * bytesPerPixel;
+	for (sint32 y = textureLoader->decodeBeginY; y < textureLoader->decodeEndY; y += textureLoader->stepY)
+	{
+		sint32 rowCount = std::min(4, textureLoader->height - y);
+		for (sint32 x = 0; x < textureLoader->width; x += BLOCKS_PER_CHUNK * textureLoader->stepX)
+		{
+			sint32 blockCount = std::min(BLOCKS_PER_CHUNK, (textureLoader->width - x + textureLoader->stepX - 1) / textureLoader->stepX);
+			for (sint32 i = 0; i < blockCount; i++)
+				memcpy(blockBuffer + i * blockSize, LatteTextureLoader_GetInput(textureLoader, x + i * textureLoader->stepX, y), blockSize);
+			sint32 pixelCount = std::min(blockCount * 4, textureLoader->width - x);
+			uint8* output = outputData + (y * textureLoader->width + x) * bytesPerPixel;
+			if (rowCount == 4 && pixelCount == blockCount * 4)
+			{
+				decodeFunc(blockBuffer, blockCount, output, outputPitch);
+				continue;
+			}
+			// partial blocks at the right or bottom border
+			uint32 rowBufferPitch = blockCount * 4 * bytesPerPixel;
+			decodeFunc(blockBuffer, blockCount, rowBuffer, rowBufferPitch);
+			for (sint32 py = 0; py < rowCount; py++)
+				memcpy(output + py * outputPitch, rowBuffer + py * rowBufferPitch, pixelCount * bytesPerPixel);
+		}
+	}
+}
+
+// compares the integer decoders against the float decoders and measures throughput. Returns false on any mismatch
+bool LatteTextureLoader_TestBCnDecoders()
+{
+	struct
+	{
+		const char* name;
+		sint32 blockSize;
+		sint32 channelCount;
+		BCnBlockRowDecodeFunc decodeFunc[2]; // SIMD (nullptr if not supported by the CPU), scalar
+		void(*referenceFunc)(uint8* blockData, float* output);
+	}formatList[] = {
+		{ "BC1", 8, 4, { nullptr, _decodeBC1Blocks_RGBA8_Scalar }, decodeBC1Block },
+		{ "BC2", 16, 4, { nullptr, _decodeBC2Blocks_RGBA8_Scalar }, decodeBC2Block_UNORM },
+		{ "BC3", 16, 4, { nullptr, _decodeBC3Blocks_RGBA8_Scalar }, decodeBC3Block_UNORM },
+		{ "BC4", 8, 1, { nullptr, _decodeBC4Blocks_R8_Scalar }, decodeBC4Block_UNORM },
+		{ "BC5", 16, 2, { nullptr, _decodeBC5Blocks_RG8_Scalar }, decodeBC5Block_UNORM },
+	};
+#if defined(ARCH_X86_64)
+	if (g_CPUFeatures.x86.sse4_1)
+	{
+		formatList[0].decodeFunc[0] = _decodeBC1Blocks_RGBA8_SSE41;
+		formatList[1].decodeFunc[0] = _decodeBC2Blocks_RGBA8_SSE41;
+		formatList[2].decodeFunc[0] = _decodeBC3Blocks_RGBA8_SSE41;
+		formatList[3].decodeFunc[0] = _decodeBC4Blocks_R8_SSE41;
+		formatList[4].decodeFunc[0] = _decodeBC5Blocks_RG8_SSE41;
+	}
+#endif
+	constexpr sint32 BLOCK_COUNT = 64 * 1024;
+	constexpr sint32 BENCHMARK_REPEAT = 16;
+	std::vector<uint8> blockData(BLOCK_COUNT * 16);
+	std::mt19937 rng(1234);
+	for (auto& it : blockData)
+		it = (uint8)rng();
+	// cover all endpoint combinations of the BC3 alpha and BC5 channels (and both palette modes)
+	for (sint32 i = 0; i < BLOCK_COUNT; i++)
+	{
+		blockData[i * 16 + 0] = (uint8)(i >> 8);
+		blockData[i * 16 + 1] = (uint8)i;
+		blockData[i * 16 + 8] = (uint8)i;
+		blockData[i * 16 + 9] = (uint8)(i >> 8);
+	}
+	bool success = true;
+	for (auto& format : formatList)
+	{
+		sint32 rowPitch = BLOCK_COUNT * 4 * format.channelCount;
+		std::vector<uint8> output(rowPitch * 4);
+		uint32 mismatchCount = 0;
+		double throughput[3]{};
+		for (sint32 pass = 0; pass < 2; pass++)
+		{
+			// pass 0 tests the SIMD path, pass 1 the scalar fallback
+			BCnBlockRowDecodeFunc decodeFunc = format.decodeFunc[pass];
+			if (!decodeFunc)
+				continue;
+			decodeFunc(blockData.data(), BLOCK_COUNT, output.data(), rowPitch);
+			for (sint32 b = 0; b < BLOCK_COUNT; b++)
+			{
+				float referenceBlock[4 * 4 * 4];
+				format.referenceFunc(blockData.data() + b * format.blockSize, referenceBlock);
+				for (sint32 py = 0; py < 4; py++)
+				{
+					for (sint32 px = 0; px < 4; px++)
+					{
+						for (sint32 c = 0; c < format.channelCount; c++)
+						{
+							uint8 expected = BCn_FloatToUNORM8(referenceBlock[(px + py * 4) * format.channelCount + c]);
+							if (output[py * rowPitch + (b * 4 + px) * format.channelCount + c] != expected)
+								mismatchCount++;
+						}
+					}
+				}
+			}
+			// measure throughput with rows of 64 blocks, same as LatteTextureLoader_decodeBCnBlockRows
+			BenchmarkTimer timer;
+			timer.Start();
+			for (sint32 r = 0; r < BENCHMARK_REPEAT; r++)
+			{
+				for (sint32 b = 0; b < BLOCK_COUNT; b += 64)
+					decodeFunc(blockData.data() + b * format.blockSize, 64, output.data(), 64 * 4 * format.channelCount);
+			}
+			timer.Stop();
+			throughput[pass] = timer.GetElapsedMilliseconds();
+		}
+		// float decoder for comparison
+		BenchmarkTimer timer;
+		timer.Start();
+		for (sint32 r = 0; r < BENCHMARK_REPEAT; r++)
+		{
+			for (sint32 b = 0; b < BLOCK_COUNT; b++)
+				format.referenceFunc(blockData.data() + b * format.blockSize, (float*)output.data() + (b & 63) * 4 * 4 * 4);
+		}
+		timer.Stop();
+		throughput[2] = timer.GetElapsedMilliseconds();
+		double megabytes = (double)(BLOCK_COUNT * format.blockSize * BENCHMARK_REPEAT) / (1024.0 * 1024.0);
+		for (auto& it : throughput)
+			it = megabytes / (std::max(it, 0.001) * 0.001);
+		std::string simdThroughput = format.decodeFunc[0] ? fmt::format("{:.1f}MB/s", throughput[0]) : "unsupported";
+		fmt::print("BCn decoder test {}: {} mismatches, SIMD {}, scalar {:.1f}MB/s, float {:.1f}MB/s\n", format.name, mismatchCount, simdThroughput, throughput[1], throughput[2]);
+		if (mismatchCount != 0)
+			success = false;
+	}
+	return success;
+}
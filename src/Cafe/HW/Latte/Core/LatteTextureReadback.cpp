@@ -7,6 +7,7 @@
 #include "Cafe/HW/Latte/Renderer/Renderer.h"
 #include "Cafe/HW/Latte/Core/LatteTexture.h"
 #include "Cafe/HW/Latte/Renderer/OpenGL/LatteTextureViewGL.h"
+#include "util/helpers/helpers.h"
 
 #define LOG_READBACK_TIME
 
@@ -18,7 +19,76 @@ struct LatteTextureReadbackQueueEntry
 };
 
 std::vector<LatteTextureReadbackQueueEntry> sTextureScheduledReadbacks; // readbacks that have been queued but the actual transfer has not yet been started
-std::queue<LatteTextureReadbackInfo*> sTextureActiveReadbackQueue; // readbacks in flight
+std::deque<LatteTextureReadbackInfo*> sTextureActiveReadbackQueue; // readbacks in flight. Retired in order once the data has been written to RAM
+
+// writes the pixel data of finished readbacks to RAM (re-tiling) so the GPU thread does not have to
+class LatteTextureReadbackWriter
+{
+public:
+	LatteTextureReadbackWriter()
+	{
+		std::thread(&LatteTextureReadbackWriter::WorkerThread, this).detach();
+	}
+
+	void Queue(LatteTextureReadbackInfo* readbackInfo, uint8* pixelData)
+	{
+		std::unique_lock _l(m_mutex);
+		m_jobs.push({ readbackInfo, pixelData });
+		_l.unlock();
+		m_workAvailable.notify_one();
+	}
+
+	void WaitForWrite(LatteTextureReadbackInfo* readbackInfo)
+	{
+		std::unique_lock _l(m_mutex);
+		m_workDone.wait(_l, [&]() { return readbackInfo->isWrittenToRAM.load(); });
+	}
+
+	void WaitForIdle()
+	{
+		std::unique_lock _l(m_mutex);
+		m_workDone.wait(_l, [this]() { return m_jobs.empty() && !m_isBusy; });
+	}
+
+private:
+	struct WriteJob
+	{
+		LatteTextureReadbackInfo* readbackInfo;
+		uint8* pixelData;
+	};
+
+	void WorkerThread()
+	{
+		SetThreadName("TexReadback");
+		while (true)
+		{
+			std::unique_lock _l(m_mutex);
+			m_workAvailable.wait(_l, [this]() { return !m_jobs.empty(); });
+			WriteJob job = m_jobs.front();
+			m_jobs.pop();
+			m_isBusy = true;
+			_l.unlock();
+			LatteTextureLoader_writeReadbackTextureToMemory(&job.readbackInfo->hostTextureCopy, 0, 0, job.pixelData);
+			_l.lock();
+			job.readbackInfo->isWrittenToRAM = true;
+			m_isBusy = false;
+			_l.unlock();
+			m_workDone.notify_all();
+		}
+	}
+
+	std::mutex m_mutex;
+	std::condition_variable m_workAvailable;
+	std::condition_variable m_workDone;
+	std::queue<WriteJob> m_jobs;
+	bool m_isBusy{ false };
+};
+
+LatteTextureReadbackWriter* LatteTextureReadback_GetWriter()
+{
+	static LatteTextureReadbackWriter* s_writer = new LatteTextureReadbackWriter(); // never freed since the worker thread is detached
+	return s_writer;
+}
 
 void LatteTextureReadback_StartTransfer(LatteTextureView* textureView)
 {
@@ -26,7 +96,7 @@ void LatteTextureReadback_StartTransfer(LatteTextureView* textureView)
 	HRTick currentTick = HighResolutionTimer().now().getTick();
 	// create info entry and store in ordered linked list
 	LatteTextureReadbackInfo* readbackInfo = g_renderer->texture_createReadback(textureView);
-	sTextureActiveReadbackQueue.push(readbackInfo);
+	sTextureActiveReadbackQueue.push_back(readbackInfo);
 	readbackInfo->StartTransfer();
 	readbackInfo->transferStartTime = currentTick;
 }
@@ -74,6 +144,12 @@ void LatteTextureReadback_NotifyTextureDeletion(LatteTexture* texture)
 			break;
 		}
 	}
+	// the data of in-flight readbacks is still written to RAM, but the texture no longer needs to be notified
+	for (auto& readbackInfo : sTextureActiveReadbackQueue)
+	{
+		if (readbackInfo->pendingWriteTexture == texture)
+			readbackInfo->pendingWriteTexture = nullptr;
+	}
 }
 
 void LatteTextureReadback_Initate(LatteTextureView* textureView)
@@ -102,63 +178,156 @@ void LatteTextureReadback_Initate(LatteTextureView* textureView)
 	sTextureScheduledReadbacks.emplace_back(queueEntry);
 }
 
-void LatteTextureReadback_UpdateFinishedTransfers(bool forceFinish)
+// called once the GPU transfer has finished
+void LatteTextureReadback_QueueWrite(LatteTextureReadbackInfo* readbackInfo)
 {
-	if (forceFinish)
+	cemu_assert_debug(!readbackInfo->isWriteQueued);
+	readbackInfo->isWriteQueued = true;
+	if (!readbackInfo->SupportsAsyncWrite())
 	{
-		// start any delayed transfers
-		LatteTextureReadback_Update(true);
+		uint8* pixelData = readbackInfo->GetData();
+		LatteTextureLoader_writeReadbackTextureToMemory(&readbackInfo->hostTextureCopy, 0, 0, pixelData);
+		readbackInfo->ReleaseData();
+		readbackInfo->isWrittenToRAM = true;
+		return;
 	}
-	performanceMonitor.gpuTime_waitForAsync.beginMeasuring();
-	while (!sTextureActiveReadbackQueue.empty())
+	// suspend change tracking of the original texture while its RAM is being written
+	LatteTextureView* origTexView = LatteTextureViewLookupCache::lookupSlice(readbackInfo->hostTextureCopy.physAddress, readbackInfo->hostTextureCopy.width, readbackInfo->hostTextureCopy.height, readbackInfo->hostTextureCopy.pitch, 0, 0, readbackInfo->hostTextureCopy.format);
+	if (origTexView)
 	{
-		LatteTextureReadbackInfo* readbackInfo = sTextureActiveReadbackQueue.front();
-		if (forceFinish)
+		readbackInfo->pendingWriteTexture = origTexView->baseTexture;
+		readbackInfo->pendingWriteTexture->pendingReadbackWrites++;
+	}
+	LatteTextureReadback_GetWriter()->Queue(readbackInfo, readbackInfo->GetData());
+}
+
+/*
+ * Hands all readbacks with a finished GPU transfer to the writer
+ * Transfers finish in submission order so we can stop at the first unfinished one
+ */
+void LatteTextureReadback_QueueFinishedWrites()
+{
+	for (auto& readbackInfo : sTextureActiveReadbackQueue)
+	{
+		if (readbackInfo->isWriteQueued)
+			continue;
+		if (!readbackInfo->IsFinished())
+			break;
+		readbackInfo->waitStartTime = HighResolutionTimer().now().getTick();
+		LatteTextureReadback_QueueWrite(readbackInfo);
+	}
+}
+
+/*
+ * Retires the oldest active readback
+ * Returns false if it is not finished yet and forceFinish is not set
+ * If forceFinish is set this may return without retiring the readback, in which case the caller has to check the queue again
+ */
+bool LatteTextureReadback_RetireOldest(bool forceFinish)
+{
+	LatteTextureReadbackInfo* readbackInfo = sTextureActiveReadbackQueue.front();
+	if (!readbackInfo->isWriteQueued)
+	{
+		if (!readbackInfo->IsFinished())
 		{
-			if (!readbackInfo->IsFinished())
-			{
-				readbackInfo->waitStartTime = HighResolutionTimer().now().getTick();
+			if (!forceFinish)
+				return false;
+			readbackInfo->waitStartTime = HighResolutionTimer().now().getTick();
 #ifdef LOG_READBACK_TIME
-				if (cemuLog_isLoggingEnabled(LogType::TextureReadback))
-				{
-					double elapsedSecondsTransfer = HighResolutionTimer::getTimeDiff(readbackInfo->transferStartTime, HighResolutionTimer().now().getTick());
-					cemuLog_log(LogType::TextureReadback, "[Texture-Readback] Force-finish: {:08x} Res {:}/{:} TM {:} FMT {:04x} Transfer time so far: {:.4}ms", readbackInfo->hostTextureCopy.physAddress, readbackInfo->hostTextureCopy.width, readbackInfo->hostTextureCopy.height, readbackInfo->hostTextureCopy.tileMode, (uint32)readbackInfo->hostTextureCopy.format, elapsedSecondsTransfer * 1000.0);
-				}
-#endif
-				readbackInfo->forceFinish = true;
-				readbackInfo->ForceFinish();
-				// rerun logic since ->ForceFinish() can recurively call this function and thus modify the queue
-				continue;
+			if (cemuLog_isLoggingEnabled(LogType::TextureReadback))
+			{
+				double elapsedSecondsTransfer = HighResolutionTimer::getTimeDiff(readbackInfo->transferStartTime, HighResolutionTimer().now().getTick());
+				cemuLog_log(LogType::TextureReadback, "[Texture-Readback] Force-finish: {:08x} Res {:}/{:} TM {:} FMT {:04x} Transfer time so far: {:.4}ms", readbackInfo->hostTextureCopy.physAddress, readbackInfo->hostTextureCopy.width, readbackInfo->hostTextureCopy.height, readbackInfo->hostTextureCopy.tileMode, (uint32)readbackInfo->hostTextureCopy.format, elapsedSecondsTransfer * 1000.0);
 			}
+#endif
+			readbackInfo->forceFinish = true;
+			readbackInfo->ForceFinish();
+			// ->ForceFinish() can recursively call LatteTextureReadback_UpdateFinishedTransfers() and thus modify the queue
+			return true;
 		}
-		else
-		{
-			if (!readbackInfo->IsFinished())
-				break;
-			readbackInfo->waitStartTime = HighResolutionTimer().now().getTick();
-		}
-		// performance testing
+		readbackInfo->waitStartTime = HighResolutionTimer().now().getTick();
+		LatteTextureReadback_QueueWrite(readbackInfo);
+	}
+	if (!readbackInfo->isWrittenToRAM)
+	{
+		if (!forceFinish)
+			return false;
+		LatteTextureReadback_GetWriter()->WaitForWrite(readbackInfo);
+	}
+	// performance testing
 #ifdef LOG_READBACK_TIME
-		if (cemuLog_isLoggingEnabled(LogType::TextureReadback))
-		{
-			HRTick currentTick = HighResolutionTimer().now().getTick();
-			double elapsedSecondsTransfer = HighResolutionTimer::getTimeDiff(readbackInfo->transferStartTime, currentTick);
-			double elapsedSecondsWaiting = HighResolutionTimer::getTimeDiff(readbackInfo->waitStartTime, currentTick);
-			cemuLog_log(LogType::TextureReadback, "[Texture-Readback] {:08x} Res {}/{} TM {} FMT {:04x} ReadbackLatency: {:6.3}ms WaitTime: {:6.3}ms ForcedWait {}", readbackInfo->hostTextureCopy.physAddress, readbackInfo->hostTextureCopy.width, readbackInfo->hostTextureCopy.height, readbackInfo->hostTextureCopy.tileMode, (uint32)readbackInfo->hostTextureCopy.format, elapsedSecondsTransfer * 1000.0, elapsedSecondsWaiting * 1000.0, readbackInfo->forceFinish ? "yes" : "no");
-		}
+	if (cemuLog_isLoggingEnabled(LogType::TextureReadback))
+	{
+		HRTick currentTick = HighResolutionTimer().now().getTick();
+		double elapsedSecondsTransfer = HighResolutionTimer::getTimeDiff(readbackInfo->transferStartTime, currentTick);
+		double elapsedSecondsWaiting = HighResolutionTimer::getTimeDiff(readbackInfo->waitStartTime, currentTick);
+		cemuLog_log(LogType::TextureReadback, "[Texture-Readback] {:08x} Res {}/{} TM {} FMT {:04x} ReadbackLatency: {:6.3}ms WaitTime: {:6.3}ms ForcedWait {}", readbackInfo->hostTextureCopy.physAddress, readbackInfo->hostTextureCopy.width, readbackInfo->hostTextureCopy.height, readbackInfo->hostTextureCopy.tileMode, (uint32)readbackInfo->hostTextureCopy.format, elapsedSecondsTransfer * 1000.0, elapsedSecondsWaiting * 1000.0, readbackInfo->forceFinish ? "yes" : "no");
+	}
 #endif
-		uint8* pixelData = readbackInfo->GetData();
-		LatteTextureLoader_writeReadbackTextureToMemory(&readbackInfo->hostTextureCopy, 0, 0, pixelData);
+	if (readbackInfo->SupportsAsyncWrite())
 		readbackInfo->ReleaseData();
-		// get the original texture if it still exists and invalidate the current data hash
-		LatteTextureView* origTexView = LatteTextureViewLookupCache::lookupSlice(readbackInfo->hostTextureCopy.physAddress, readbackInfo->hostTextureCopy.width, readbackInfo->hostTextureCopy.height, readbackInfo->hostTextureCopy.pitch, 0, 0, readbackInfo->hostTextureCopy.format);
-		if (origTexView)
-			LatteTC_ResetTextureChangeTracker(origTexView->baseTexture, true);
-		delete readbackInfo;
-		// remove from queue
-		cemu_assert_debug(!sTextureActiveReadbackQueue.empty());
-		cemu_assert_debug(readbackInfo == sTextureActiveReadbackQueue.front());
-		sTextureActiveReadbackQueue.pop();
+	if (readbackInfo->pendingWriteTexture)
+	{
+		cemu_assert_debug(readbackInfo->pendingWriteTexture->pendingReadbackWrites > 0);
+		readbackInfo->pendingWriteTexture->pendingReadbackWrites--;
+	}
+	// get the original texture if it still exists and invalidate the current data hash
+	LatteTextureView* origTexView = LatteTextureViewLookupCache::lookupSlice(readbackInfo->hostTextureCopy.physAddress, readbackInfo->hostTextureCopy.width, readbackInfo->hostTextureCopy.height, readbackInfo->hostTextureCopy.pitch, 0, 0, readbackInfo->hostTextureCopy.format);
+	if (origTexView)
+		LatteTC_ResetTextureChangeTracker(origTexView->baseTexture, true);
+	// remove from queue
+	cemu_assert_debug(!sTextureActiveReadbackQueue.empty());
+	cemu_assert_debug(readbackInfo == sTextureActiveReadbackQueue.front());
+	sTextureActiveReadbackQueue.pop_front();
+	delete readbackInfo;
+	return true;
+}
+
+void LatteTextureReadback_UpdateFinishedTransfers(bool forceFinish)
+{
+	if (forceFinish)
+	{
+		// start any delayed transfers
+		LatteTextureReadback_Update(true);
+	}
+	performanceMonitor.gpuTime_waitForAsync.beginMeasuring();
+	LatteTextureReadback_QueueFinishedWrites();
+	while (!sTextureActiveReadbackQueue.empty())
+	{
+		if (!LatteTextureReadback_RetireOldest(forceFinish))
+			break;
 	}
 	performanceMonitor.gpuTime_waitForAsync.endMeasuring();
 }
+
+/*
+ * Waits for the oldest readback and retires it. Used by renderers to free up staging memory
+ * Returns false if there are no readbacks in flight
+ */
+bool LatteTextureReadback_FinishOldestTransfer()
+{
+	if (sTextureActiveReadbackQueue.empty())
+		return false;
+	LatteTextureReadbackInfo* readbackInfo = sTextureActiveReadbackQueue.front();
+	performanceMonitor.gpuTime_waitForAsync.beginMeasuring();
+	while (!sTextureActiveReadbackQueue.empty() && sTextureActiveReadbackQueue.front() == readbackInfo)
+		LatteTextureReadback_RetireOldest(true);
+	performanceMonitor.gpuTime_waitForAsync.endMeasuring();
+	return true;
+}
+
+/*
+ * Called on shutdown before the renderer is destroyed
+ * Makes sure the writer no longer accesses any staging memory
+ */
+void LatteTextureReadback_WaitForPendingWrites()
+{
+	for (auto& readbackInfo : sTextureActiveReadbackQueue)
+	{
+		if (readbackInfo->isWriteQueued && readbackInfo->SupportsAsyncWrite())
+		{
+			LatteTextureReadback_GetWriter()->WaitForIdle();
+			break;
+		}
+	}
+}
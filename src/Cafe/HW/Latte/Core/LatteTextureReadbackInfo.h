@@ -18,10 +18,17 @@ public:
 
 	virtual uint8* GetData() = 0;
 	virtual void ReleaseData() {};
+	// return true if the memory returned by GetData() stays valid until ReleaseData() and may be accessed from any thread
+	// only then is the data written to RAM on the readback worker thread, otherwise it happens synchronously on the GPU thread
+	virtual bool SupportsAsyncWrite() { return false; }
 
 	HRTick transferStartTime;
 	HRTick waitStartTime;
 	bool forceFinish{ false }; // set to true if not finished in time for dependent operation
+	// completion state. A readback is retired after the GPU transfer has finished and the data was written to RAM
+	bool isWriteQueued{ false };
+	std::atomic_bool isWrittenToRAM{ false };
+	LatteTexture* pendingWriteTexture{}; // original texture, its change tracking is suspended until the readback is retired
 	// texture info
 	LatteTextureDefinition hostTextureCopy{};
 
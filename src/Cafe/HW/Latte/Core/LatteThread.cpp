@@ -9,6 +9,8 @@
 #include "gui/guiWrapper.h"
 
 #include "Cafe/HW/Latte/Core/LatteBufferCache.h"
+#include "Cafe/HW/Latte/Core/LatteCapture.h"
+#include "Cafe/HW/MMU/WriteTracker.h"
 
 #include "Cafe/HW/Latte/Renderer/Renderer.h"
 #include "Cafe/HW/Latte/Core/LatteTexture.h"
@@ -16,6 +18,7 @@
 
 #include <imgui.h>
 #include "config/ActiveSettings.h"
+#include "config/CemuConfig.h"
 
 #include "Cafe/CafeSystem.h"
 
@@ -32,6 +35,7 @@ void Latte_LoadInitialRegisters()
 	LatteGPUState.contextNew.VGT_MULTI_PRIM_IB_RESET_INDX.set_RESTART_INDEX(0xFFFFFFFF);
 	LatteGPUState.contextRegister[Latte::REGADDR::PA_CL_CLIP_CNTL] = 0;
 	*(float*)&LatteGPUState.contextRegister[mmDB_DEPTH_CLEAR] = 1.0f;
+	LatteGPUState.pipelineStateDirtyMask = LATTE_PIPELINE_STATE_GROUP_ALL;
 }
 
 extern bool gx2WriteGatherInited;
@@ -123,6 +127,8 @@ int Latte_ThreadEntry()
 
 	LatteTiming_Init();
 	LatteTexture_init();
+	if (GetConfig().gpu_write_tracking)
+		WriteTracker::Enable();
 	LatteTC_Init();
 	LatteBufferCache_init(164 * 1024 * 1024);
 	LatteQuery_Init();
@@ -237,6 +243,7 @@ void Latte_Stop()
 	std::unique_lock _lock(sLatteThreadStateMutex);
 	sLatteThreadRunning = false;
 	_lock.unlock();
+	LatteCP_NotifyNewCommands();
 	sLatteThread.join();
 }
 
@@ -247,12 +254,20 @@ bool Latte_GetStopSignal()
 
 void LatteThread_Exit()
 {
+	// finish any capture in progress so the file remains usable
+	LatteCapture_Stop();
+	// readback staging memory is released by the renderer
+	LatteTextureReadback_WaitForPendingWrites();
+	// pipelines compiled in the background use the renderer and the runtime shaders
+	LatteShaderCache_StopBackgroundLoading();
 	if (g_renderer)
 		g_renderer->Shutdown();
     // clean up vertex/uniform cache
     LatteBufferCache_UnloadAll();
 	// clean up texture cache
 	LatteTC_UnloadAllTextures();
+	// all tracked ranges are released at this point
+	WriteTracker::Disable();
 	// clean up runtime shader cache
     LatteSHRC_UnloadAll();
     // close disk cache
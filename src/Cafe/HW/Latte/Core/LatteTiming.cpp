@@ -1,4 +1,5 @@
 #include "Cafe/HW/Latte/Core/Latte.h"
+#include "Cafe/HW/Latte/Core/LatteFramePacing.h"
 #include "Cafe/OS/libs/gx2/GX2_Event.h"
 #include "Cafe/HW/Latte/Renderer/Vulkan/VsyncDriver.h"
 #include "util/highresolutiontimer/HighResolutionTimer.h"
@@ -64,11 +65,50 @@ bool LatteTiming_IsUsingHostDrivenVSync()
 	return s_usingHostDrivenVSync;
 }
 
+static HRTick s_delayedFlipTick = 0; // if set, the flip of the last vsync is executed at this time
+
 void LatteTiming_Init()
 {
 	LatteGPUState.timer_frequency = HighResolutionTimer::getFrequency();
 	LatteGPUState.timer_bootUp = HighResolutionTimer::now().getTick();
 	LatteGPUState.timer_nextVSync = LatteGPUState.timer_bootUp + LatteTime_CalculateTimeBetweenVSync();
+	s_delayedFlipTick = 0; // drop a flip left pending by the previous session
+	LatteFramePacing_Init();
+}
+
+static void LatteTiming_executeFlip()
+{
+	if (LatteGPUState.sharedArea)
+	{
+		// hack/workaround - only execute flip if GX2SwapScanBuffers() isn't lagging behind
+		uint64 currentTitleId = CafeSystem::GetForegroundTitleId();
+		if (currentTitleId == 0x00050000101c9500 || currentTitleId == 0x00050000101c9400 || currentTitleId == 0x0005000e101c9300)
+		{
+			uint32 currentFlipRequestCount = _swapEndianU32(LatteGPUState.sharedArea->flipRequestCountBE);
+			uint32 currentFlipExecuteCount = _swapEndianU32(LatteGPUState.sharedArea->flipExecuteCountBE);
+
+			if ((currentFlipRequestCount >= currentFlipExecuteCount) || (currentFlipExecuteCount - currentFlipRequestCount < 4))
+			{
+				LatteGPUState.sharedArea->flipExecuteCountBE = _swapEndianU32(_swapEndianU32(LatteGPUState.sharedArea->flipExecuteCountBE) + 1);
+				LatteFramePacing_NotifyFlip(HighResolutionTimer::now().getTick());
+			}
+
+			LatteGPUState.flipCounter++;
+
+		}
+		else
+		{
+			// old code for all other games
+			if (LatteGPUState.flipRequestCount > 0)
+			{
+				LatteGPUState.flipRequestCount.fetch_sub(1);
+				LatteGPUState.sharedArea->flipExecuteCountBE = _swapEndianU32(_swapEndianU32(LatteGPUState.sharedArea->flipExecuteCountBE) + 1);
+				LatteFramePacing_NotifyFlip(HighResolutionTimer::now().getTick());
+			}
+
+		}
+	}
+	GX2::__GX2NotifyEvent(GX2::GX2CallbackEventType::FLIP);
 }
 
 void LatteTiming_signalVsync()
@@ -82,38 +122,21 @@ void LatteTiming_signalVsync()
 	if (LatteGPUState.sharedArea)
 		swapInterval = LatteGPUState.sharedArea->swapInterval;
 
+	// a flip which is still held back from the previous vsync is executed first
+	if (s_delayedFlipTick != 0)
+	{
+		s_delayedFlipTick = 0;
+		LatteTiming_executeFlip();
+	}
 	// flip
 	if (s_vsyncIntervalCounter >= swapInterval)
 	{
-		if (LatteGPUState.sharedArea)
-		{
-			// hack/workaround - only execute flip if GX2SwapScanBuffers() isn't lagging behind
-			uint64 currentTitleId = CafeSystem::GetForegroundTitleId();
-			if (currentTitleId == 0x00050000101c9500 || currentTitleId == 0x00050000101c9400 || currentTitleId == 0x0005000e101c9300)
-			{
-				uint32 currentFlipRequestCount = _swapEndianU32(LatteGPUState.sharedArea->flipRequestCountBE);
-				uint32 currentFlipExecuteCount = _swapEndianU32(LatteGPUState.sharedArea->flipExecuteCountBE);
-
-				if ((currentFlipRequestCount >= currentFlipExecuteCount) || (currentFlipExecuteCount - currentFlipRequestCount < 4))
-				{
-					LatteGPUState.sharedArea->flipExecuteCountBE = _swapEndianU32(_swapEndianU32(LatteGPUState.sharedArea->flipExecuteCountBE) + 1);
-				}
-
-				LatteGPUState.flipCounter++;
-
-			}
-			else
-			{
-				// old code for all other games
-				if (LatteGPUState.flipRequestCount > 0)
-				{
-					LatteGPUState.flipRequestCount.fetch_sub(1);
-					LatteGPUState.sharedArea->flipExecuteCountBE = _swapEndianU32(_swapEndianU32(LatteGPUState.sharedArea->flipExecuteCountBE) + 1);
-				}
-
-			}
-		}
-		GX2::__GX2NotifyEvent(GX2::GX2CallbackEventType::FLIP);
+		// in low latency frame pacing mode the guest starts its next frame later than vsync
+		HRTick frameStartDelay = LatteTiming_IsUsingHostDrivenVSync() ? 0 : LatteFramePacing_GetFrameStartDelay();
+		if (frameStartDelay != 0)
+			s_delayedFlipTick = HighResolutionTimer::now().getTick() + frameStartDelay;
+		else
+			LatteTiming_executeFlip();
 		s_vsyncIntervalCounter = 0;
 	}
 	// vsync
@@ -153,6 +176,11 @@ void LatteTiming_HandleTimedVsync()
 {
 	// simulate VSync
 	uint64 currentTimer = HighResolutionTimer::now().getTick();
+	if (s_delayedFlipTick != 0 && currentTimer >= s_delayedFlipTick)
+	{
+		s_delayedFlipTick = 0;
+		LatteTiming_executeFlip();
+	}
 	if( currentTimer >= LatteGPUState.timer_nextVSync )
 	{
 		if(!LatteTiming_IsUsingHostDrivenVSync())
@@ -169,5 +197,8 @@ void LatteTiming_HandleTimedVsync()
 		}
 		else	
 			LatteGPUState.timer_nextVSync += vsyncTime;
+		// align the timer with the host display
+		if (!LatteTiming_IsUsingHostDrivenVSync())
+			LatteGPUState.timer_nextVSync += LatteFramePacing_GetVSyncCorrection(LatteGPUState.timer_nextVSync, vsyncTime);
 	}
 }
\ No newline at end of file
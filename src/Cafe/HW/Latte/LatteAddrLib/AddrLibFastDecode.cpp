@@ -0,0 +1,117 @@
+#include "Cafe/HW/Latte/LatteAddrLib/LatteAddrLib.h"
+#include "Cafe/HW/Latte/Core/LatteTextureLoader.h"
+#include "Common/cpu_features.h"
+
+/*
+ * Micro tile layouts of TM_2D_TILED_THIN1 with microTileType 0 (see _ComputePixelIndexWithinMicroTile)
+ * 16bpp: The 8 rows are stored one after another, 16 bytes each
+ * 32/64/128bpp: Each pair of rows is stored together as interleaved 16 byte chunks (row0 chunk0, row1 chunk0, row0 chunk1, row1 chunk1, ...)
+ * Micro tiles larger than 256 bytes are split into 256 byte groups which are 2048 bytes apart in memory
+ */
+
+#if defined(ARCH_X86_64)
+static uint32 _MicroTileSeparateGroupBytes(uint32 offset)
+{
+	return (offset & 0xFF) | ((offset & ~0xFF) << 3);
+}
+
+// offset of a texel relative to the start of the micro tile, derived from the layout described above
+static uint32 _MicroTileExpectedOffset(uint32 x, uint32 y, uint32 bytesPerElement)
+{
+	if (bytesPerElement == 2)
+		return y * 16 + x * 2;
+	uint32 rowBytes = 8 * bytesPerElement;
+	uint32 xBytes = x * bytesPerElement;
+	uint32 offset = (y >> 1) * rowBytes * 2 + (xBytes / 16) * 32 + (y & 1) * 16 + (xBytes % 16);
+	return _MicroTileSeparateGroupBytes(offset);
+}
+
+// copy 16 byte rows
+static void _DetileMicroTile_16bpp_SSE2(const uint8* microTileData, uint8* output, uint32 outputPitch)
+{
+	for (sint32 y = 0; y < 8; y++)
+	{
+		__m128i row = _mm_loadu_si128((const __m128i*)(microTileData + y * 16));
+		_mm_storeu_si128((__m128i*)(output + y * outputPitch), row);
+	}
+}
+
+// split interleaved row pairs with 16 byte moves
+template<uint32 bytesPerElement>
+static void _DetileMicroTile_interleaved_SSE2(const uint8* microTileData, uint8* output, uint32 outputPitch)
+{
+	constexpr uint32 rowBytes = 8 * bytesPerElement;
+	for (uint32 p = 0; p < 4; p++)
+	{
+		const uint8* pairData = microTileData + _MicroTileSeparateGroupBytes(p * rowBytes * 2);
+		uint8* row0 = output + (p * 2 + 0) * outputPitch;
+		uint8* row1 = output + (p * 2 + 1) * outputPitch;
+		for (uint32 c = 0; c < rowBytes / 16; c++)
+		{
+			__m128i chunk0 = _mm_loadu_si128((const __m128i*)(pairData + c * 32 + 0));
+			__m128i chunk1 = _mm_loadu_si128((const __m128i*)(pairData + c * 32 + 16));
+			_mm_storeu_si128((__m128i*)(row0 + c * 16), chunk0);
+			_mm_storeu_si128((__m128i*)(row1 + c * 16), chunk1);
+		}
+	}
+}
+
+// split interleaved row pairs by recombining the 128bit lanes of two 32 byte loads
+template<uint32 bytesPerElement>
+ATTRIBUTE_AVX2
+static void _DetileMicroTile_interleaved_AVX2(const uint8* microTileData, uint8* output, uint32 outputPitch)
+{
+	constexpr uint32 rowBytes = 8 * bytesPerElement;
+	for (uint32 p = 0; p < 4; p++)
+	{
+		const uint8* pairData = microTileData + _MicroTileSeparateGroupBytes(p * rowBytes * 2);
+		uint8* row0 = output + (p * 2 + 0) * outputPitch;
+		uint8* row1 = output + (p * 2 + 1) * outputPitch;
+		for (uint32 c = 0; c < rowBytes / 32; c++)
+		{
+			__m256i a = _mm256_loadu_si256((const __m256i*)(pairData + c * 64 + 0));
+			__m256i b = _mm256_loadu_si256((const __m256i*)(pairData + c * 64 + 32));
+			_mm256_storeu_si256((__m256i*)(row0 + c * 32), _mm256_permute2x128_si256(a, b, 0x20));
+			_mm256_storeu_si256((__m256i*)(row1 + c * 32), _mm256_permute2x128_si256(a, b, 0x31));
+		}
+	}
+}
+#endif
+
+AddrLibFastDecode_MicroTileDetileFunc AddrLibFastDecode_GetMicroTileDetileFunc(const LatteAddrLib::CachedSurfaceAddrInfo* info, uint32 bytesPerElement, bool allowAVX2)
+{
+#if defined(ARCH_X86_64)
+	if (info->tileMode != Latte::E_HWTILEMODE::TM_2D_TILED_THIN1 || info->numSamples != 1 || info->microTileType != 0)
+		return nullptr;
+	if (bytesPerElement != 2 && bytesPerElement != 4 && bytesPerElement != 8 && bytesPerElement != 16)
+		return nullptr;
+	// the kernels hardcode the micro tile layout, make sure it matches the pixel index table
+	const uint16* tableBase = info->microTilePixelIndexTable + ((info->slice & 7) << 6);
+	for (uint32 y = 0; y < 8; y++)
+	{
+		for (uint32 x = 0; x < 8; x++)
+		{
+			uint32 tableOffset = _MicroTileSeparateGroupBytes((uint32)tableBase[x + y * 8] * bytesPerElement);
+			if (tableOffset != _MicroTileExpectedOffset(x, y, bytesPerElement))
+				return nullptr;
+		}
+	}
+	if (bytesPerElement == 2)
+		return _DetileMicroTile_16bpp_SSE2;
+	if (allowAVX2 && g_CPUFeatures.x86.avx2)
+	{
+		if (bytesPerElement == 4)
+			return _DetileMicroTile_interleaved_AVX2<4>;
+		if (bytesPerElement == 8)
+			return _DetileMicroTile_interleaved_AVX2<8>;
+		return _DetileMicroTile_interleaved_AVX2<16>;
+	}
+	if (bytesPerElement == 4)
+		return _DetileMicroTile_interleaved_SSE2<4>;
+	if (bytesPerElement == 8)
+		return _DetileMicroTile_interleaved_SSE2<8>;
+	return _DetileMicroTile_interleaved_SSE2<16>;
+#else
+	return nullptr;
+#endif
+}
@@ -1,11 +1,33 @@
 #pragma once
 #include "Cafe/HW/Latte/LatteAddrLib/LatteAddrLib.h"
 
+// detiles a single 8x8 micro tile into 8 rows of the output, outputPitch is in bytes
+using AddrLibFastDecode_MicroTileDetileFunc = void(*)(const uint8* microTileData, uint8* output, uint32 outputPitch);
+
+// returns a SIMD kernel matching the micro tile layout of the surface or nullptr if there is none for this format/CPU
+// allowAVX2 selects between the AVX2 and SSE2 kernels, it is only honored if the CPU supports AVX2
+AddrLibFastDecode_MicroTileDetileFunc AddrLibFastDecode_GetMicroTileDetileFunc(const LatteAddrLib::CachedSurfaceAddrInfo* info, uint32 bytesPerElement, bool allowAVX2);
+
+// decode full 8x8 micro tiles with a SIMD kernel (see AddrLibFastDecode_GetMicroTileDetileFunc)
+inline void optimizedDecodeLoop_tm04_numSamples1_8x8_kernel(LatteTextureLoaderCtx* textureLoader, uint8* outputData, sint32 texelCountX, sint32 texelBeginY, sint32 texelEndY, uint32 bytesPerElement, AddrLibFastDecode_MicroTileDetileFunc detileFunc)
+{
+	uint32 outputPitch = textureLoader->decodedTexelCountX * bytesPerElement;
+	for (sint32 yt = texelBeginY; yt < texelEndY; yt += 8)
+	{
+		uint8* rowOutput = outputData + yt * outputPitch;
+		for (sint32 xt = 0; xt < texelCountX; xt += 8)
+		{
+			sint32 baseOffset = LatteAddrLib::ComputeSurfaceAddrFromCoordMacroTiledCached_tm04_sample1(xt, yt, &textureLoader->computeAddrInfo);
+			detileFunc(textureLoader->inputData + baseOffset, rowOutput + xt * bytesPerElement, outputPitch);
+		}
+	}
+}
+
 template<typename texelBaseType, int texelBaseTypeCount, bool isEncodeDirection, bool isCompressed>
-void optimizedDecodeLoop_tm04_numSamples1_8x8(LatteTextureLoaderCtx* textureLoader, uint8* outputData, sint32 texelCountX, sint32 texelCountY)
+void optimizedDecodeLoop_tm04_numSamples1_8x8(LatteTextureLoaderCtx* textureLoader, uint8* outputData, sint32 texelCountX, sint32 texelBeginY, sint32 texelEndY)
 {
 	uint16* tableBase = textureLoader->computeAddrInfo.microTilePixelIndexTable + ((textureLoader->computeAddrInfo.slice & 7) << 6);
-	for (sint32 yt = 0; yt < texelCountY; yt += 8)
+	for (sint32 yt = texelBeginY; yt < texelEndY; yt += 8)
 	{
 		for (sint32 xt = 0; xt < texelCountX; xt += 8)
 		{
@@ -64,10 +86,10 @@ void optimizedDecodeLoop_tm04_numSamples1_8x8(LatteTextureLoaderCtx* textureLoad
 }
 
 template<typename texelBaseType, int texelBaseTypeCount, bool isEncodeDirection, bool isCompressed>
-void optimizedDecodeLoop_tm04_numSamples1_8x8_optimizedRowCopy(LatteTextureLoaderCtx* textureLoader, uint8* outputData, sint32 texelCountX, sint32 texelCountY)
+void optimizedDecodeLoop_tm04_numSamples1_8x8_optimizedRowCopy(LatteTextureLoaderCtx* textureLoader, uint8* outputData, sint32 texelCountX, sint32 texelBeginY, sint32 texelEndY)
 {
 	uint16* tableBase = textureLoader->computeAddrInfo.microTilePixelIndexTable + ((textureLoader->computeAddrInfo.slice & 7) << 6);
-	for (sint32 yt = 0; yt < texelCountY; yt += 8)
+	for (sint32 yt = texelBeginY; yt < texelEndY; yt += 8)
 	{
 		for (sint32 xt = 0; xt < texelCountX; xt += 8)
 		{
@@ -198,15 +220,22 @@ void optimizedDecodeLoops(LatteTextureLoaderCtx* textureLoader, uint8* outputDat
 {
 	sint32 texelCountX;
 	sint32 texelCountY;
+	// range of texel rows to process, see decodeBeginY and decodeEndY
+	sint32 texelBeginY;
+	sint32 texelEndY;
 	if (isCompressed)
 	{
 		texelCountX = (textureLoader->width + 3) / 4;
 		texelCountY = (textureLoader->height + 3) / 4;
+		texelBeginY = textureLoader->decodeBeginY / 4;
+		texelEndY = std::min((textureLoader->decodeEndY + 3) / 4, texelCountY);
 	}
 	else
 	{
 		texelCountX = textureLoader->width;
 		texelCountY = textureLoader->height;
+		texelBeginY = textureLoader->decodeBeginY;
+		texelEndY = std::min(textureLoader->decodeEndY, texelCountY);
 	}
 
 	if (textureLoader->tileMode == Latte::E_HWTILEMODE::TM_2D_TILED_THIN1 && textureLoader->computeAddrInfo.numSamples == 1)
@@ -219,26 +248,34 @@ void optimizedDecodeLoops(LatteTextureLoaderCtx* textureLoader, uint8* outputDat
 		// only recalculate tile related offset at the beginning of each block
 		// calculate offsets in loop
 
+		AddrLibFastDecode_MicroTileDetileFunc detileFunc = nullptr;
+		// texel types with a custom assignment operator convert the data while copying and cannot use the raw copy kernels
+		if (!isEncodeDirection && std::is_trivially_copy_assignable_v<texelBaseType>)
+			detileFunc = AddrLibFastDecode_GetMicroTileDetileFunc(&textureLoader->computeAddrInfo, sizeof(texelBaseType)*texelBaseTypeCount, true);
+		if (detileFunc)
+		{
+			optimizedDecodeLoop_tm04_numSamples1_8x8_kernel(textureLoader, outputData, texelCountX, texelBeginY, std::min(texelEndY, texelCountY), sizeof(texelBaseType)*texelBaseTypeCount, detileFunc);
+		}
 		// unsure if this variant is faster:
-		if (textureLoader->computeAddrInfo.microTileType == 0 && (sizeof(texelBaseType)*texelBaseTypeCount) == 8)
+		else if (textureLoader->computeAddrInfo.microTileType == 0 && (sizeof(texelBaseType)*texelBaseTypeCount) == 8)
 		{
-			optimizedDecodeLoop_tm04_numSamples1_8x8_optimizedRowCopy<texelBaseType, texelBaseTypeCount, isEncodeDirection, isCompressed>(textureLoader, outputData, texelCountX, texelCountY);
+			optimizedDecodeLoop_tm04_numSamples1_8x8_optimizedRowCopy<texelBaseType, texelBaseTypeCount, isEncodeDirection, isCompressed>(textureLoader, outputData, texelCountX, texelBeginY, std::min(texelEndY, texelCountY));
 		}
 		else if (textureLoader->computeAddrInfo.microTileType == 0 && (sizeof(texelBaseType)*texelBaseTypeCount) == 4)
 		{
-			optimizedDecodeLoop_tm04_numSamples1_8x8_optimizedRowCopy<texelBaseType, texelBaseTypeCount, isEncodeDirection, isCompressed>(textureLoader, outputData, texelCountX, texelCountY);
+			optimizedDecodeLoop_tm04_numSamples1_8x8_optimizedRowCopy<texelBaseType, texelBaseTypeCount, isEncodeDirection, isCompressed>(textureLoader, outputData, texelCountX, texelBeginY, std::min(texelEndY, texelCountY));
 		}
 		else if (textureLoader->computeAddrInfo.microTileType == 0 && (sizeof(texelBaseType)*texelBaseTypeCount) == 1)
 		{
-			optimizedDecodeLoop_tm04_numSamples1_8x8_optimizedRowCopy<texelBaseType, texelBaseTypeCount, isEncodeDirection, isCompressed>(textureLoader, outputData, texelCountX, texelCountY);
+			optimizedDecodeLoop_tm04_numSamples1_8x8_optimizedRowCopy<texelBaseType, texelBaseTypeCount, isEncodeDirection, isCompressed>(textureLoader, outputData, texelCountX, texelBeginY, std::min(texelEndY, texelCountY));
 		}
 		else
 		{
-			optimizedDecodeLoop_tm04_numSamples1_8x8<texelBaseType, texelBaseTypeCount, isEncodeDirection, isCompressed>(textureLoader, outputData, texelCountX, texelCountY);
+			optimizedDecodeLoop_tm04_numSamples1_8x8<texelBaseType, texelBaseTypeCount, isEncodeDirection, isCompressed>(textureLoader, outputData, texelCountX, texelBeginY, std::min(texelEndY, texelCountY));
 		}
 		// the above code only handles full 8x8 pixel blocks, for uneven sizes we need to process the remaining pixels here
 		// right border
-		for (sint32 yt = 0; yt < texelCountY; yt++)
+		for (sint32 yt = texelBeginY; yt < std::min(texelEndY, texelCountY); yt++)
 		{
 			sint32 pixelOffset = (yt*textureLoader->decodedTexelCountX + texelCountX) * (sizeof(texelBaseType)*texelBaseTypeCount);
 			texelBaseType* blockOutput = (texelBaseType*)(outputData + pixelOffset);
@@ -272,7 +309,7 @@ void optimizedDecodeLoops(LatteTextureLoaderCtx* textureLoader, uint8* outputDat
 			}
 		}
 		// bottom border (with bottom right corner)
-		for (sint32 yt = texelCountY; yt < texelCountOrigY; yt++)
+		for (sint32 yt = std::max(texelBeginY, texelCountY); yt < texelEndY; yt++)
 		{
 			sint32 pixelOffset = (yt*textureLoader->decodedTexelCountX) * (sizeof(texelBaseType)*texelBaseTypeCount);
 			texelBaseType* blockOutput = (texelBaseType*)(outputData + pixelOffset);
@@ -310,7 +347,7 @@ void optimizedDecodeLoops(LatteTextureLoaderCtx* textureLoader, uint8* outputDat
 	{
 		// optimized handler for linear textures
 		uint32 sliceOffset = textureLoader->sliceIndex * textureLoader->height * textureLoader->pitch;
-		for (sint32 y = 0; y < texelCountY; y++)
+		for (sint32 y = texelBeginY; y < texelEndY; y++)
 		{
 			sint32 pixelOffset = (y*textureLoader->decodedTexelCountX) * (sizeof(texelBaseType)*texelBaseTypeCount);
 			texelBaseType* blockOutput = (texelBaseType*)(outputData + pixelOffset);
@@ -348,7 +385,7 @@ void optimizedDecodeLoops(LatteTextureLoaderCtx* textureLoader, uint8* outputDat
 	else
 	{
 		// generic handler
-		for (sint32 y = 0; y < textureLoader->height; y += textureLoader->stepY)
+		for (sint32 y = textureLoader->decodeBeginY; y < textureLoader->decodeEndY; y += textureLoader->stepY)
 		{
 			sint32 pixelOffset = ((y / textureLoader->stepY)*textureLoader->decodedTexelCountX) * (sizeof(texelBaseType)*texelBaseTypeCount);
 			texelBaseType* blockOutput = (texelBaseType*)(outputData + pixelOffset);
@@ -1017,7 +1017,7 @@ void LatteDecompiler_ParseClauses(LatteDecompilerShaderContext* shaderContext, u
 	}
 }
 
-void _LatteDecompiler_GenerateDataForFastAccess(LatteDecompilerShader* shader)
+void LatteDecompiler_GenerateDataForFastAccess(LatteDecompilerShader* shader)
 {
 	if (shader->hasError)
 		return;
@@ -1069,7 +1069,7 @@ void _LatteDecompiler_Process(LatteDecompilerShaderContext* shaderContext, uint8
 		LatteDecompiler_emitGLSLShader(shaderContext, shaderContext->shader);
 	LatteDecompiler_cleanup(shaderContext);
 	// fast access 
-	_LatteDecompiler_GenerateDataForFastAccess(shaderContext->shader);
+	LatteDecompiler_GenerateDataForFastAccess(shaderContext->shader);
 }
 
 void LatteDecompiler_InitContext(LatteDecompilerShaderContext& dCtx, const LatteDecompilerOptions& options, LatteDecompilerOutput_t* output, LatteConst::ShaderType shaderType, uint64 shaderBaseHash, uint32* contextRegisters)
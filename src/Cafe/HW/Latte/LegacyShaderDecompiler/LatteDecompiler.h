@@ -14,6 +14,10 @@ namespace LatteDecompiler
 	};
 };
 
+// version of the decompiler output, needs to be incremented whenever a change affects the generated GLSL or shader metadata
+// used to invalidate caches which store decompiled shaders
+#define LATTE_DECOMPILER_VERSION	(1)
+
 // decompiler shader types
 
 typedef struct
@@ -293,6 +297,8 @@ struct LatteDecompilerSubroutineInfo;
 void LatteDecompiler_DecompileVertexShader(uint64 shaderBaseHash, uint32* contextRegisters, uint8* programData, uint32 programSize, struct LatteFetchShader* fetchShader, LatteDecompilerOptions& options, LatteDecompilerOutput_t* output);
 void LatteDecompiler_DecompileGeometryShader(uint64 shaderBaseHash, uint32* contextRegisters, uint8* programData, uint32 programSize, uint8* gsCopyProgramData, uint32 gsCopyProgramSize, uint32 vsRingParameterCount, LatteDecompilerOptions& options, LatteDecompilerOutput_t* output);
 void LatteDecompiler_DecompilePixelShader(uint64 shaderBaseHash, uint32* contextRegisters, uint8* programData, uint32 programSize, LatteDecompilerOptions& options, LatteDecompilerOutput_t* output);
+// builds the fast access uniform lists from list_remappedUniformEntries
+void LatteDecompiler_GenerateDataForFastAccess(LatteDecompilerShader* shader);
 
 // specialized shader parsers
 
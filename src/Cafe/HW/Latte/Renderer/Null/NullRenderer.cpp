@@ -0,0 +1,312 @@
+#include "Cafe/HW/Latte/Renderer/Null/NullRenderer.h"
+#include "Cafe/HW/Latte/Renderer/OpenGL/OpenGLRenderer.h"
+#include "Cafe/HW/Latte/Renderer/RendererShader.h"
+#include "Cafe/HW/Latte/Core/Latte.h"
+#include "Cafe/HW/Latte/Core/LatteShader.h"
+#include "Cafe/HW/Latte/Core/LatteIndices.h"
+#include "Cafe/HW/Latte/Core/LatteTexture.h"
+#include "Cafe/HW/Latte/Core/LatteTextureView.h"
+#include "Cafe/HW/Latte/Core/LatteTextureReadbackInfo.h"
+#include "Cafe/HW/Latte/Core/LatteCachedFBO.h"
+#include "Cafe/HW/Latte/Core/LatteQueryObject.h"
+#include "Cafe/HW/Latte/Core/LattePerformanceMonitor.h"
+#include "config/LaunchSettings.h"
+#include "gui/guiWrapper.h"
+
+#include "util/highresolutiontimer/HighResolutionTimer.h"
+
+extern bool hasValidFramebufferAttached;
+
+class LatteTextureNull : public LatteTexture
+{
+public:
+	LatteTextureNull(Latte::E_DIM dim, MPTR physAddress, MPTR physMipAddress, Latte::E_GX2SURFFMT format, uint32 width, uint32 height, uint32 depth, uint32 pitch, uint32 mipLevels, uint32 swizzle, Latte::E_HWTILEMODE tileMode, bool isDepth)
+		: LatteTexture(dim, physAddress, physMipAddress, format, width, height, depth, pitch, mipLevels, swizzle, tileMode, isDepth) {}
+
+	void AllocateOnHost() override {}
+
+protected:
+	LatteTextureView* CreateView(Latte::E_DIM dim, Latte::E_GX2SURFFMT format, sint32 firstMip, sint32 mipCount, sint32 firstSlice, sint32 sliceCount) override
+	{
+		return new LatteTextureView(this, firstMip, mipCount, firstSlice, sliceCount, dim, format);
+	}
+};
+
+class RendererShaderNull : public RendererShader
+{
+public:
+	RendererShaderNull(ShaderType type, uint64 baseHash, uint64 auxHash, bool isGameShader, bool isGfxPackShader)
+		: RendererShader(type, baseHash, auxHash, isGameShader, isGfxPackShader) {}
+
+	void PreponeCompilation(bool isRenderThread) override {}
+	bool IsCompiled() override { return true; }
+	bool WaitForCompiled() override { return true; }
+
+	sint32 GetUniformLocation(const char* name) override { return -1; }
+	void SetUniform2fv(sint32 location, void* data, sint32 count) override {}
+	void SetUniform4iv(sint32 location, void* data, sint32 count) override {}
+};
+
+class CachedFBONull : public LatteCachedFBO
+{
+public:
+	CachedFBONull(uint64 key) : LatteCachedFBO(key) {}
+};
+
+// there is no host copy of the texture data, readbacks finish immediately and write zeros
+class LatteTextureReadbackInfoNull : public LatteTextureReadbackInfo
+{
+public:
+	LatteTextureReadbackInfoNull(LatteTextureView* textureView)
+		: LatteTextureReadbackInfo(textureView)
+	{
+		// large enough for the widest format (RGBA32F)
+		m_image_size = textureView->baseTexture->width * textureView->baseTexture->height * 16;
+	}
+
+	void StartTransfer() override
+	{
+		m_data.assign(m_image_size, 0);
+	}
+
+	bool IsFinished() override { return true; }
+
+	uint8* GetData() override { return m_data.data(); }
+	void ReleaseData() override { m_data.clear(); m_data.shrink_to_fit(); }
+	bool SupportsAsyncWrite() override { return true; }
+
+private:
+	std::vector<uint8> m_data;
+};
+
+class LatteQueryObjectNull : public LatteQueryObject
+{
+public:
+	bool getResult(uint64& numSamplesPassed) override
+	{
+		numSamplesPassed = 0;
+		return true;
+	}
+
+	void begin() override {}
+	void end() override {}
+};
+
+NullRenderer::NullRenderer()
+{
+	m_indexBuffer.resize(8 * 1024 * 1024);
+}
+
+NullRenderer::~NullRenderer()
+{
+}
+
+NullRenderer* NullRenderer::GetInstance()
+{
+	cemu_assert_debug(g_renderer && dynamic_cast<NullRenderer*>(g_renderer.get()));
+	return (NullRenderer*)g_renderer.get();
+}
+
+void NullRenderer::Initialize()
+{
+	Renderer::Initialize();
+	cemuLog_log(LogType::Force, "Using null renderer, nothing will be displayed");
+}
+
+void NullRenderer::Shutdown()
+{
+	if (!m_statsPrinted && m_stats.numFrames > 0)
+		PrintStatistics();
+	Renderer::Shutdown();
+}
+
+void NullRenderer::SwapBuffers(bool swapTV, bool swapDRC)
+{
+	if (!swapTV)
+		return;
+	HRTick now = HighResolutionTimer::now().getTick();
+	if (m_stats.numFrames == 0)
+		m_stats.firstFrameTick = now;
+	m_stats.lastFrameTick = now;
+	m_stats.numFrames++;
+	auto frameLimit = LaunchSettings::GetHeadlessFrameLimit();
+	if (frameLimit && !m_statsPrinted && m_stats.numFrames >= *frameLimit)
+	{
+		PrintStatistics();
+		gui_requestExit();
+	}
+}
+
+void NullRenderer::PrintStatistics()
+{
+	m_statsPrinted = true;
+	auto printLine = [](const std::string& line)
+	{
+		cemuLog_log(LogType::Force, "{}", line);
+		fmt::print("{}\n", line);
+	};
+	const uint64 numFrames = std::max<uint64>(m_stats.numFrames, 1);
+	const double elapsedMs = (double)HighResolutionTimer::ticksToMicroseconds(m_stats.lastFrameTick - m_stats.firstFrameTick) / 1000.0;
+	printLine("Null renderer statistics:");
+	printLine(fmt::format("Frames: {} in {:.1f}ms ({:.2f} fps)", m_stats.numFrames, elapsedMs, elapsedMs > 0.0 ? (double)(m_stats.numFrames - 1) * 1000.0 / elapsedMs : 0.0));
+	printLine(fmt::format("Drawcalls: {} ({:.1f} per frame)", m_stats.numDraws, (double)m_stats.numDraws / numFrames));
+	printLine(fmt::format("Textures created: {} Slice uploads: {} Readbacks: {}", m_stats.numTexturesCreated, m_stats.numTextureSliceUploads, m_stats.numReadbacks));
+	printLine(fmt::format("Shaders created: {}", m_stats.numShadersCreated));
+	printLine(fmt::format("Buffer cache uploads: {}KB Index data: {}KB", m_stats.bufferCacheUploadedBytes / 1024, m_stats.indexDataBytes / 1024));
+	// average time per frame spent in each stage of the GPU thread
+	auto printTimer = [&](const char* name, LattePerfStatTimer& timer)
+	{
+		printLine(fmt::format("  {:<24} {:8.3f}ms/frame", name, (double)PPCTimer_tscToMicroseconds(timer.getTotal()) / 1000.0 / numFrames));
+	};
+	printTimer("Frame", performanceMonitor.gpuTime_frameTime);
+	printTimer("Idle", performanceMonitor.gpuTime_idleTime);
+	printTimer("Fence wait", performanceMonitor.gpuTime_fenceTime);
+	printTimer("Shader create", performanceMonitor.gpuTime_shaderCreate);
+	printTimer("Draw: Textures", performanceMonitor.gpuTime_dcStageTextures);
+	printTimer("Draw: Vertex", performanceMonitor.gpuTime_dcStageVertexMgr);
+	printTimer("Draw: Shader/Uniform", performanceMonitor.gpuTime_dcStageShaderAndUniformMgr);
+	printTimer("Draw: Index", performanceMonitor.gpuTime_dcStageIndexMgr);
+	printTimer("Draw: MRT", performanceMonitor.gpuTime_dcStageMRT);
+	printTimer("Draw: API", performanceMonitor.gpuTime_dcStageDrawcallAPI);
+	printTimer("Wait for async", performanceMonitor.gpuTime_waitForAsync);
+}
+
+LatteCachedFBO* NullRenderer::rendertarget_createCachedFBO(uint64 key)
+{
+	return new CachedFBONull(key);
+}
+
+void NullRenderer::rendertarget_deleteCachedFBO(LatteCachedFBO* fbo)
+{
+}
+
+void* NullRenderer::texture_acquireTextureUploadBuffer(uint32 size)
+{
+	if (m_textureUploadBuffer.size() < size)
+		m_textureUploadBuffer.resize(size);
+	return m_textureUploadBuffer.data();
+}
+
+TextureDecoder* NullRenderer::texture_chooseDecodedFormat(Latte::E_GX2SURFFMT format, bool isDepth, Latte::E_DIM dim, uint32 width, uint32 height)
+{
+	// decode into the same formats as the OpenGL backend so that the CPU cost of texture uploads is comparable
+	return OpenGLRenderer::GetTextureDecoder(format, isDepth, dim);
+}
+
+void NullRenderer::texture_loadSlice(LatteTexture* hostTexture, sint32 width, sint32 height, sint32 depth, void* pixelData, sint32 sliceIndex, sint32 mipIndex, uint32 compressedImageSize)
+{
+	m_stats.numTextureSliceUploads++;
+}
+
+LatteTexture* NullRenderer::texture_createTextureEx(Latte::E_DIM dim, MPTR physAddress, MPTR physMipAddress, Latte::E_GX2SURFFMT format, uint32 width, uint32 height, uint32 depth, uint32 pitch, uint32 mipLevels, uint32 swizzle, Latte::E_HWTILEMODE tileMode, bool isDepth)
+{
+	m_stats.numTexturesCreated++;
+	return new LatteTextureNull(dim, physAddress, physMipAddress, format, width, height, depth, pitch, mipLevels, swizzle, tileMode, isDepth);
+}
+
+LatteTextureReadbackInfo* NullRenderer::texture_createReadback(LatteTextureView* textureView)
+{
+	m_stats.numReadbacks++;
+	return new LatteTextureReadbackInfoNull(textureView);
+}
+
+void NullRenderer::bufferCache_init(const sint32 bufferSize)
+{
+	m_bufferCache.resize(bufferSize);
+}
+
+void NullRenderer::bufferCache_upload(uint8* buffer, sint32 size, uint32 bufferOffset)
+{
+	cemu_assert_debug((size_t)bufferOffset + size <= m_bufferCache.size());
+	memcpy(m_bufferCache.data() + bufferOffset, buffer, size);
+	m_stats.bufferCacheUploadedBytes += size;
+}
+
+void NullRenderer::bufferCache_copy(uint32 srcOffset, uint32 dstOffset, uint32 size)
+{
+	memmove(m_bufferCache.data() + dstOffset, m_bufferCache.data() + srcOffset, size);
+}
+
+RendererShader* NullRenderer::shader_create(RendererShader::ShaderType type, uint64 baseHash, uint64 auxHash, const std::string& source, bool isGameShader, bool isGfxPackShader)
+{
+	m_stats.numShadersCreated++;
+	return new RendererShaderNull(type, baseHash, auxHash, isGameShader, isGfxPackShader);
+}
+
+void NullRenderer::draw_beginSequence()
+{
+	m_drawSequenceSkip = false;
+	bool streamoutEnable = LatteGPUState.contextRegister[mmVGT_STRMOUT_EN] != 0;
+	// same CPU-side state processing as the other backends
+	LatteSHRC_UpdateActiveShaders();
+	if (LatteGPUState.activeShaderHasError)
+	{
+		m_drawSequenceSkip = true;
+		return;
+	}
+	LatteGPUState.requiresTextureBarrier = false;
+	while (true)
+	{
+		LatteGPUState.repeatTextureInitialization = false;
+		if (!LatteMRT::UpdateCurrentFBO() || (!hasValidFramebufferAttached && !streamoutEnable))
+		{
+			m_drawSequenceSkip = true;
+			return;
+		}
+		LatteTexture_updateTextures();
+		if (!LatteGPUState.repeatTextureInitialization)
+			break;
+	}
+	LatteMRT::ApplyCurrentState();
+	LatteRenderTarget_updateViewport();
+	LatteRenderTarget_updateScissorBox();
+}
+
+void NullRenderer::draw_execute(uint32 baseVertex, uint32 baseInstance, uint32 instanceCount, uint32 count, MPTR indexDataMPTR, Latte::LATTE_VGT_DMA_INDEX_TYPE::E_INDEX_TYPE indexType, bool isFirst)
+{
+	LatteGPUState.drawCallCounter++;
+	m_stats.numDraws++;
+	if (m_drawSequenceSkip)
+		return;
+	LatteStreamout_PrepareDrawcall(count, instanceCount);
+	const LattePrimitiveMode primitiveMode = static_cast<LattePrimitiveMode>(LatteGPUState.contextRegister[mmVGT_PRIMITIVE_TYPE]);
+	Renderer::INDEX_TYPE hostIndexType;
+	uint32 hostIndexCount;
+	uint32 indexMin = 0;
+	uint32 indexMax = 0;
+	uint32 indexBufferOffset = 0;
+	uint32 indexBufferIndex = 0;
+	LatteIndices_decode(memory_getPointerFromVirtualOffset(indexDataMPTR), indexType, count, primitiveMode, indexMin, indexMax, hostIndexType, hostIndexCount, indexBufferOffset, indexBufferIndex);
+	LatteBufferCache_Sync(indexMin + baseVertex, indexMax + baseVertex, baseInstance, instanceCount);
+}
+
+void NullRenderer::draw_endSequence()
+{
+	if (LatteSHRC_GetActivePixelShader())
+		LatteRenderTarget_trackUpdates();
+	LatteTextureReadback_Update();
+}
+
+void* NullRenderer::indexData_reserveIndexMemory(uint32 size, uint32& offset, uint32& bufferIndex)
+{
+	// the index data is never read, wrap around once the end of the buffer is reached
+	if (size > m_indexBuffer.size())
+		m_indexBuffer.resize(size);
+	if (m_indexBufferWriteOffset + size > m_indexBuffer.size())
+		m_indexBufferWriteOffset = 0;
+	offset = m_indexBufferWriteOffset;
+	bufferIndex = 0;
+	m_indexBufferWriteOffset += (size + 3) & ~3;
+	m_stats.indexDataBytes += size;
+	return m_indexBuffer.data() + offset;
+}
+
+LatteQueryObject* NullRenderer::occlusionQuery_create()
+{
+	return new LatteQueryObjectNull();
+}
+
+void NullRenderer::occlusionQuery_destroy(LatteQueryObject* queryObj)
+{
+	delete queryObj;
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "Cafe/HW/Latte/Renderer/Renderer.h"
+
+// Renderer backend which does not use any graphics API
+// All CPU side work (command processing, texture decoding, buffer and shader caches) runs as usual but nothing is rasterized
+// Resources only exist as host memory, queries and readbacks complete immediately. Used for headless runs and CPU profiling
+class NullRenderer : public Renderer
+{
+public:
+	NullRenderer();
+	~NullRenderer() override;
+
+	RendererAPI GetType() override { return RendererAPI::Null; }
+
+	static NullRenderer* GetInstance();
+
+	void Initialize() override;
+	void Shutdown() override;
+	bool IsPadWindowActive() override { return false; }
+
+	void ClearColorbuffer(bool padView) override {}
+	void DrawEmptyFrame(bool mainWindow) override {}
+	void SwapBuffers(bool swapTV, bool swapDRC) override;
+
+	void DrawBackbufferQuad(LatteTextureView* texView, RendererOutputShader* shader, bool useLinearTexFilter,
+		sint32 imageX, sint32 imageY, sint32 imageWidth, sint32 imageHeight,
+		bool padView, bool clearBackground) override {}
+	bool BeginFrame(bool mainWindow) override { return true; }
+
+	void Flush(bool waitIdle = false) override {}
+	void NotifyLatteCommandProcessorIdle() override {}
+
+	bool ImguiBegin(bool mainWindow) override { return false; }
+	void ImguiEnd() override {}
+	ImTextureID GenerateTexture(const std::vector<uint8>& data, const Vector2i& size) override { return nullptr; }
+	void DeleteTexture(ImTextureID id) override {}
+	void DeleteFontTextures() override {}
+
+	void AppendOverlayDebugInfo() override {}
+
+	// rendertarget
+	void renderTarget_setViewport(float x, float y, float width, float height, float nearZ, float farZ, bool halfZ = false) override {}
+	void renderTarget_setScissor(sint32 scissorX, sint32 scissorY, sint32 scissorWidth, sint32 scissorHeight) override {}
+
+	LatteCachedFBO* rendertarget_createCachedFBO(uint64 key) override;
+	void rendertarget_deleteCachedFBO(LatteCachedFBO* fbo) override;
+	void rendertarget_bindFramebufferObject(LatteCachedFBO* cfbo) override {}
+
+	// texture functions
+	void* texture_acquireTextureUploadBuffer(uint32 size) override;
+	void texture_releaseTextureUploadBuffer(uint8* mem) override {}
+
+	TextureDecoder* texture_chooseDecodedFormat(Latte::E_GX2SURFFMT format, bool isDepth, Latte::E_DIM dim, uint32 width, uint32 height) override;
+
+	void texture_clearSlice(LatteTexture* hostTexture, sint32 sliceIndex, sint32 mipIndex) override {}
+	void texture_loadSlice(LatteTexture* hostTexture, sint32 width, sint32 height, sint32 depth, void* pixelData, sint32 sliceIndex, sint32 mipIndex, uint32 compressedImageSize) override;
+	void texture_clearColorSlice(LatteTexture* hostTexture, sint32 sliceIndex, sint32 mipIndex, float r, float g, float b, float a) override {}
+	void texture_clearDepthSlice(LatteTexture* hostTexture, uint32 sliceIndex, sint32 mipIndex, bool clearDepth, bool clearStencil, float depthValue, uint32 stencilValue) override {}
+
+	LatteTexture* texture_createTextureEx(Latte::E_DIM dim, MPTR physAddress, MPTR physMipAddress, Latte::E_GX2SURFFMT format, uint32 width, uint32 height, uint32 depth, uint32 pitch, uint32 mipLevels, uint32 swizzle, Latte::E_HWTILEMODE tileMode, bool isDepth) override;
+
+	void texture_setLatteTexture(LatteTextureView* textureView, uint32 textureUnit) override {}
+	void texture_copyImageSubData(LatteTexture* src, sint32 srcMip, sint32 effectiveSrcX, sint32 effectiveSrcY, sint32 srcSlice, LatteTexture* dst, sint32 dstMip, sint32 effectiveDstX, sint32 effectiveDstY, sint32 dstSlice, sint32 effectiveCopyWidth, sint32 effectiveCopyHeight, sint32 srcDepth) override {}
+
+	LatteTextureReadbackInfo* texture_createReadback(LatteTextureView* textureView) override;
+
+	// surface copy
+	void surfaceCopy_copySurfaceWithFormatConversion(LatteTexture* sourceTexture, sint32 srcMip, sint32 srcSlice, LatteTexture* destinationTexture, sint32 dstMip, sint32 dstSlice, sint32 width, sint32 height) override {}
+
+	// buffer cache
+	void bufferCache_init(const sint32 bufferSize) override;
+	void bufferCache_upload(uint8* buffer, sint32 size, uint32 bufferOffset) override;
+	void bufferCache_copy(uint32 srcOffset, uint32 dstOffset, uint32 size) override;
+	void bufferCache_copyStreamoutToMainBuffer(uint32 srcOffset, uint32 dstOffset, uint32 size) override {}
+
+	void buffer_bindVertexBuffer(uint32 bufferIndex, uint32 offset, uint32 size) override {}
+	void buffer_bindUniformBuffer(LatteConst::ShaderType shaderType, uint32 bufferIndex, uint32 offset, uint32 size) override {}
+
+	// shader
+	RendererShader* shader_create(RendererShader::ShaderType type, uint64 baseHash, uint64 auxHash, const std::string& source, bool isGameShader, bool isGfxPackShader) override;
+
+	// streamout
+	void streamout_setupXfbBuffer(uint32 bufferIndex, sint32 ringBufferOffset, uint32 rangeAddr, uint32 rangeSize) override {}
+	void streamout_begin() override {}
+	void streamout_rendererFinishDrawcall() override {}
+
+	// core drawing logic
+	void draw_beginSequence() override;
+	void draw_execute(uint32 baseVertex, uint32 baseInstance, uint32 instanceCount, uint32 count, MPTR indexDataMPTR, Latte::LATTE_VGT_DMA_INDEX_TYPE::E_INDEX_TYPE indexType, bool isFirst) override;
+	void draw_endSequence() override;
+
+	// index
+	void* indexData_reserveIndexMemory(uint32 size, uint32& offset, uint32& bufferIndex) override;
+	void indexData_uploadIndexMemory(uint32 offset, uint32 size) override {}
+
+	// occlusion queries
+	LatteQueryObject* occlusionQuery_create() override;
+	void occlusionQuery_destroy(LatteQueryObject* queryObj) override;
+	void occlusionQuery_flush() override {}
+	void occlusionQuery_updateState() override {}
+
+	// headless mode
+	void PrintStatistics();
+
+private:
+	std::vector<uint8> m_bufferCache;
+	std::vector<uint8> m_indexBuffer;
+	uint32 m_indexBufferWriteOffset{};
+	std::vector<uint8> m_textureUploadBuffer;
+	bool m_drawSequenceSkip{};
+
+	struct
+	{
+		uint64 numFrames{};
+		uint64 numDraws{};
+		uint64 numTexturesCreated{};
+		uint64 numTextureSliceUploads{};
+		uint64 numShadersCreated{};
+		uint64 numReadbacks{};
+		uint64 bufferCacheUploadedBytes{};
+		uint64 indexDataBytes{};
+		HRTick firstFrameTick{};
+		HRTick lastFrameTick{};
+	}m_stats;
+	bool m_statsPrinted{};
+};
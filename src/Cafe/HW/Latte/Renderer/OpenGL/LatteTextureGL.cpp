@@ -154,7 +154,7 @@ void LatteTextureGL::GetOpenGLFormatInfo(bool isDepth, Latte::E_GX2SURFFMT forma
 	else if (format == Latte::E_GX2SURFFMT::BC2_UNORM || format == Latte::E_GX2SURFFMT::BC2_SRGB)
 	{
 		// todo - use OpenGL BC2 format if available
-		formatInfoOut->setFormat(GL_RGBA16F, GL_RGBA, GL_FLOAT);
+		formatInfoOut->setFormat(GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE);
 		formatInfoOut->markAsAlternativeFormat();
 		return;
 	}
@@ -181,7 +181,7 @@ void LatteTextureGL::GetOpenGLFormatInfo(bool isDepth, Latte::E_GX2SURFFMT forma
 		}
 		else
 		{
-			formatInfoOut->setFormat(GL_RG16F, GL_RG, GL_FLOAT);
+			formatInfoOut->setFormat(GL_R8, GL_RED, GL_UNSIGNED_BYTE);
 			formatInfoOut->markAsAlternativeFormat();
 			return;
 		}
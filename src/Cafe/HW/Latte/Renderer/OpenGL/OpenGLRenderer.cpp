@@ -816,6 +816,12 @@ void OpenGLRenderer::texture_releaseTextureUploadBuffer(uint8* mem)
 }
 
 TextureDecoder* OpenGLRenderer::texture_chooseDecodedFormat(Latte::E_GX2SURFFMT format, bool isDepth, Latte::E_DIM dim, uint32 width, uint32 height)
+{
+	return GetTextureDecoder(format, isDepth, dim);
+}
+
+// the decoder selection does not depend on any GL state, the null renderer uses it as well
+TextureDecoder* OpenGLRenderer::GetTextureDecoder(Latte::E_GX2SURFFMT format, bool isDepth, Latte::E_DIM dim)
 {
 	TextureDecoder* texDecoder = nullptr;
 	if (isDepth)
@@ -1195,7 +1201,7 @@ void OpenGLRenderer::texture_copyImageSubData(LatteTexture* src, sint32 srcMip,
 		if (srcGL->format == Latte::E_GX2SURFFMT::R16_G16_B16_A16_UINT && dstGL->format == Latte::E_GX2SURFFMT::BC4_UNORM)
 		{
 			cemu_assert_debug(dstGL->dim != Latte::E_DIM::DIM_2D);
-			// special case where BC4 format is replaced with R16F for array/3d-textures (since OpenGL's BC4 compression only supports 2D textures)
+			// special case where BC4 format is replaced with R8 for array/3d-textures (since OpenGL's BC4 compression only supports 2D textures)
 			texture_syncSliceSpecialBC4(srcGL, srcSlice, srcMip, dstGL, dstSlice, dstMip);
 			return;
 		}
@@ -1323,7 +1329,7 @@ void OpenGLRenderer::shader_unbind(RendererShader::ShaderType shaderType)
 	}
 }
 
-void decodeBC4Block_UNORM(uint8* blockStorage, float* rOutput);
+void decodeBC4Blocks_R8(const uint8* blockData, sint32 blockCount, uint8* output, uint32 outputPitch);
 
 void OpenGLRenderer::texture_syncSliceSpecialBC4(LatteTexture* srcTexture, sint32 srcSliceIndex, sint32 srcMipIndex, LatteTexture* dstTexture, sint32 dstSliceIndex, sint32 dstMipIndex)
 {
@@ -1339,31 +1345,22 @@ void OpenGLRenderer::texture_syncSliceSpecialBC4(LatteTexture* srcTexture, sint3
 	sint32 compressedCopyHeight = std::min(sourceTexHeight, std::max(1, destTexHeight / 4));
 
 	uint8* texelData = (uint8*)malloc(compressedCopyWidth*compressedCopyHeight * 8);
-	float* pixelRGBA16fData = (float*)malloc(destTexWidth*destTexHeight * sizeof(float) * 2);
+	// decode whole rows of blocks at once. The decoded rows are padded to a multiple of 4 pixels
+	sint32 decodedPitch = compressedCopyWidth * 4;
+	uint8* pixelR8Data = (uint8*)malloc(decodedPitch * compressedCopyHeight * 4);
 	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 	if (glGetTextureSubImage)
 		glGetTextureSubImage(srcTextureGL->glId_texture, 0, 0, 0, srcSliceIndex, compressedCopyWidth, compressedCopyHeight, 1, GL_RGBA_INTEGER, GL_UNSIGNED_SHORT, compressedCopyWidth * compressedCopyHeight * 8, texelData);
-	for (sint32 bx = 0; bx < compressedCopyWidth; bx++)
-	{
-		for (sint32 by = 0; by < compressedCopyHeight; by++)
-		{
-			float rBlock[4 * 4];
-			decodeBC4Block_UNORM(texelData + (bx + by * compressedCopyWidth) * 8, rBlock);
-			for (sint32 sy = 0; sy < std::min(4, destTexHeight - by * 4); sy++)
-			{
-				for (sint32 sx = 0; sx < std::min(4, destTexWidth - bx * 4); sx++)
-				{
-					sint32 pixelIndex = (bx * 4 + sx) + (by * 4 + sy)*destTexWidth;
-					pixelRGBA16fData[pixelIndex * 2] = rBlock[sx + sy * 4];
-					pixelRGBA16fData[pixelIndex * 2 + 1] = rBlock[sx + sy * 4];
-				}
-			}
-		}
-	}
+	for (sint32 by = 0; by < compressedCopyHeight; by++)
+		decodeBC4Blocks_R8(texelData + by * compressedCopyWidth * 8, compressedCopyWidth, pixelR8Data + by * 4 * decodedPitch, decodedPitch);
 	// upload mip
 	if (glGetTextureSubImage && glTextureSubImage3D)
-		glTextureSubImage3D(dstTextureGL->glId_texture, dstMipIndex, 0, 0, dstSliceIndex, destTexWidth, destTexHeight, 1, GL_RG, GL_FLOAT, pixelRGBA16fData);
-	free(pixelRGBA16fData);
+	{
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, decodedPitch);
+		glTextureSubImage3D(dstTextureGL->glId_texture, dstMipIndex, 0, 0, dstSliceIndex, std::min(destTexWidth, decodedPitch), std::min(destTexHeight, compressedCopyHeight * 4), 1, GL_RED, GL_UNSIGNED_BYTE, pixelR8Data);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+	}
+	free(pixelR8Data);
 	free(texelData);
 	catchOpenGLError();
 }
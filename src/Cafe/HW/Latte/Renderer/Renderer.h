@@ -33,6 +33,7 @@ enum class RendererAPI
 {
 	OpenGL,
 	Vulkan,
+	Null, // no graphics API, used in headless mode
 
 	MAX
 };
@@ -23,12 +23,13 @@ public:
 	virtual void SetUniform2fv(sint32 location, void* data, sint32 count) = 0;
 	virtual void SetUniform4iv(sint32 location, void* data, sint32 count) = 0;
 
+	static uint32 GeneratePrecompiledCacheId();
+
 protected:
 	// if isGameShader is true, then baseHash and auxHash are valid
 	RendererShader(ShaderType type, uint64 baseHash, uint64 auxHash, bool isGameShader, bool isGfxPackShader)
 		: m_type(type), m_baseHash(baseHash), m_auxHash(auxHash), m_isGameShader(isGameShader), m_isGfxPackShader(isGfxPackShader) {}
 
-	static uint32 GeneratePrecompiledCacheId();
 	static void GenerateShaderPrecompiledCacheFilename(ShaderType type, uint64 baseHash, uint64 auxHash, uint64& h1, uint64& h2);
 
 protected:
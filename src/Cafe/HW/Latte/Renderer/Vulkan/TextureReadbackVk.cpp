@@ -146,3 +146,9 @@ void LatteTextureReadbackInfoVk::ForceFinish()
 	renderer->WaitCommandBufferFinished(m_associatedCommandBufferId);
 }
 
+void LatteTextureReadbackInfoVk::ReleaseData()
+{
+	// readbacks are retired in order, everything up to the end of this one can be reused
+	const auto renderer = VulkanRenderer::GetInstance();
+	renderer->texture_releaseReadbackSpace(m_buffer_offset + m_image_size);
+}
@@ -1072,6 +1072,9 @@ void PipelineCompiler::TrackAsCached(uint64 baseHash, uint64 pipelineStateHash)
 {
 	auto& pipelineCache = VulkanPipelineStableCache::GetInstance();
 	if (pipelineCache.HasPipelineCached(baseHash, pipelineStateHash))
+	{
+		pipelineCache.RecordFirstUse(baseHash, pipelineStateHash);
 		return;
+	}
 	pipelineCache.AddCurrentStateToCache(baseHash, pipelineStateHash);
 }
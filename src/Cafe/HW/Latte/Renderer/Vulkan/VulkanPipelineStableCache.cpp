@@ -6,6 +6,7 @@
 #include "Cafe/HW/Latte/Core/LatteCachedFBO.h"
 #include "Cafe/OS/libs/gx2/GX2.h"
 #include "config/ActiveSettings.h"
+#include "config/CemuConfig.h"
 #include "util/helpers/Serializer.h"
 #include "Cafe/HW/Latte/Common/RegisterSerializer.h"
 #include "Cemu/FileCache/FileCache.h"
@@ -15,8 +16,7 @@
 
 struct
 {
-	uint32 pipelineLoadIndex;
-	uint32 pipelineMaxFileIndex;
+	uint32 pipelineLoadIndex; // index into m_loadOrder
 	
 	std::atomic_uint32_t pipelinesQueued;
 	std::atomic_uint32_t pipelinesLoaded;
@@ -29,6 +29,12 @@ VulkanPipelineStableCache& VulkanPipelineStableCache::GetInstance()
 	return g_vkPipelineStableCacheInstance;
 }
 
+// rough estimate of the memory used by a pipeline while it is queued or compiling
+static uint64 _EstimatePipelineLoadMemory(size_t fileSize)
+{
+	return sizeof(LatteContextRegister) + fileSize;
+}
+
 uint32 VulkanPipelineStableCache::BeginLoading(uint64 cacheTitleId)
 {
 	std::error_code ec;
@@ -37,13 +43,16 @@ uint32 VulkanPipelineStableCache::BeginLoading(uint64 cacheTitleId)
 	
 	// init cache loader state
 	g_vkCacheState.pipelineLoadIndex = 0;
-	g_vkCacheState.pipelineMaxFileIndex = 0;
 	g_vkCacheState.pipelinesLoaded = 0;
 	g_vkCacheState.pipelinesQueued = 0;
+	m_loadOrder.clear();
+	m_numForegroundPipelines = 0;
+	m_backgroundLoadingStop = false;
+	m_inFlightMemory = 0;
+	m_bootTick = 0;
 	
 	// start async compilation threads
 	m_compilationCount.store(0);	
-	m_compilationQueue.clear();
 
 	// get core count
 	uint32 cpuCoreCount = GetPhysicalCoreCount();
@@ -51,9 +60,14 @@ uint32 VulkanPipelineStableCache::BeginLoading(uint64 cacheTitleId)
 	if (VulkanRenderer::GetInstance()->GetDisableMultithreadedCompilation())
 		m_numCompilationThreads = 1;
 
+	std::unique_lock _lCompilation(m_compilationMutex);
+	m_compilationQueue = {};
+	m_compilationThreadStop.assign(m_numCompilationThreads, false);
+	_lCompilation.unlock();
 	for (uint32 i = 0; i < m_numCompilationThreads; i++)
 	{
-		std::thread compileThread(&VulkanPipelineStableCache::CompilerThread, this);
+		m_numRunningCompilationThreads++;
+		std::thread compileThread(&VulkanPipelineStableCache::CompilerThread, this, i);
 		compileThread.detach();
 	}
 
@@ -65,37 +79,92 @@ uint32 VulkanPipelineStableCache::BeginLoading(uint64 cacheTitleId)
 		cemuLog_log(LogType::Force, "Failed to open or create Vulkan pipeline cache file: {}", _pathToUtf8(pathCacheFile));
 		return 0;
 	}
+	s_cache->UseCompression(false);
+
+	// sort pipelines by recorded first use. Pipelines without a record were not used in any recorded session and go last
+	LoadFirstUseOrder(cacheTitleId);
+	std::vector<std::pair<uint32, sint32>> recordedPipelines; // time of first use, file index
+	std::vector<sint32> unrecordedPipelines;
+	std::unordered_map<PipelineHash, uint32, PipelineHash::HashFunc> firstUseTime;
+	sint32 maxFileIndex = s_cache->GetMaximumFileIndex();
+	for (sint32 i = 0; i < maxFileIndex; i++)
+	{
+		uint64 fileNameA, fileNameB;
+		if (!s_cache->GetFileNameByIndex(i, fileNameA, fileNameB))
+			continue;
+		auto it = m_firstUseTime.find(PipelineHash(fileNameA, fileNameB));
+		if (it != m_firstUseTime.end())
+		{
+			recordedPipelines.emplace_back(it->second, i);
+			firstUseTime.emplace(it->first, it->second);
+		}
+		else
+			unrecordedPipelines.emplace_back(i);
+	}
+	std::stable_sort(recordedPipelines.begin(), recordedPipelines.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+	// without any records (first session or prewarming disabled) everything is loaded before boot
+	const sint32 prewarmSeconds = GetConfig().pipeline_prewarm_seconds;
+	if (recordedPipelines.empty() || prewarmSeconds <= 0)
+	{
+		m_numForegroundPipelines = (uint32)(recordedPipelines.size() + unrecordedPipelines.size());
+	}
 	else
 	{
-		s_cache->UseCompression(false);
-		g_vkCacheState.pipelineMaxFileIndex = s_cache->GetMaximumFileIndex();
+		const uint32 prewarmTime = (uint32)prewarmSeconds * 1000;
+		for (auto& it : recordedPipelines)
+		{
+			if (it.first > prewarmTime)
+				break;
+			m_numForegroundPipelines++;
+		}
 	}
-	return s_cache->GetFileCount();
+	for (auto& it : recordedPipelines)
+		m_loadOrder.emplace_back(it.second);
+	m_loadOrder.insert(m_loadOrder.end(), unrecordedPipelines.begin(), unrecordedPipelines.end());
+	// drop records of pipelines which are no longer in the cache
+	std::unique_lock _l(m_firstUseMutex);
+	if (firstUseTime.size() != m_firstUseTime.size())
+		m_firstUseTimeChanged = true;
+	m_firstUseTime = std::move(firstUseTime);
+	if (m_numForegroundPipelines != m_loadOrder.size())
+		cemuLog_log(LogType::Force, "Loading {} of {} cached pipelines before boot, the remaining pipelines are compiled in the background", m_numForegroundPipelines, m_loadOrder.size());
+	return m_numForegroundPipelines;
+}
+
+bool VulkanPipelineStableCache::QueuePipelineFromCache(sint32 fileIndex)
+{
+	CompilationJob job;
+	if (!s_cache->GetFileByIndex(fileIndex, &job.fileName.h0, &job.fileName.h1, job.fileData) || job.fileData.empty())
+		return false;
+	// queue for async compilation
+	g_vkCacheState.pipelinesQueued++;
+	m_inFlightMemory += _EstimatePipelineLoadMemory(job.fileData.size());
+	std::unique_lock _l(m_compilationMutex);
+	m_compilationQueue.push(std::move(job));
+	_l.unlock();
+	m_compilationCondVar.notify_one();
+	return true;
+}
+
+size_t VulkanPipelineStableCache::GetCompilationQueueSize()
+{
+	std::unique_lock _l(m_compilationMutex);
+	return m_compilationQueue.size();
 }
 
 bool VulkanPipelineStableCache::UpdateLoading(uint32& pipelinesLoadedTotal, uint32& pipelinesMissingShaders)
 {
 	pipelinesLoadedTotal = g_vkCacheState.pipelinesLoaded;
 	pipelinesMissingShaders = 0;
-	while (g_vkCacheState.pipelineLoadIndex <= g_vkCacheState.pipelineMaxFileIndex)
+	while (g_vkCacheState.pipelineLoadIndex < m_numForegroundPipelines)
 	{
-		if (m_compilationQueue.size() >= 50)
+		if (GetCompilationQueueSize() >= 50)
 		{
 			std::this_thread::sleep_for(std::chrono::milliseconds(10));
 			return true; // queue up to 50 entries at a time
 		}
-
-		uint64 fileNameA, fileNameB;
-		std::vector<uint8> fileData;
-		if (s_cache->GetFileByIndex(g_vkCacheState.pipelineLoadIndex, &fileNameA, &fileNameB, fileData))
-		{
-			// queue for async compilation
-			g_vkCacheState.pipelinesQueued++;
-			m_compilationQueue.push(std::move(fileData));
-			g_vkCacheState.pipelineLoadIndex++;
+		if (QueuePipelineFromCache(m_loadOrder[g_vkCacheState.pipelineLoadIndex++]))
 			return true;
-		}
-		g_vkCacheState.pipelineLoadIndex++;
 	}
 	if (g_vkCacheState.pipelinesLoaded != g_vkCacheState.pipelinesQueued)
 	{
@@ -105,20 +174,74 @@ bool VulkanPipelineStableCache::UpdateLoading(uint32& pipelinesLoadedTotal, uint
 	return false; // done
 }
 
+void VulkanPipelineStableCache::SetCompilationThreadCount(uint32 threadCount)
+{
+	std::unique_lock _l(m_compilationMutex);
+	if (threadCount >= m_numCompilationThreads)
+		return;
+	m_numCompilationThreads = threadCount;
+	// stop exactly the threads with an index at or above the new count
+	for (size_t i = threadCount; i < m_compilationThreadStop.size(); i++)
+		m_compilationThreadStop[i] = true;
+	_l.unlock();
+	m_compilationCondVar.notify_all();
+}
+
 void VulkanPipelineStableCache::EndLoading()
 {
-	// shut down compilation threads
-	uint32 threadCount = m_numCompilationThreads;
-	m_numCompilationThreads = 0; // signal thread shutdown
-	for (uint32 i = 0; i < threadCount; i++)
+	m_bootTick = HighResolutionTimer::now().getTick();
+	if (s_cache && g_vkCacheState.pipelineLoadIndex < m_loadOrder.size())
 	{
-		m_compilationQueue.push({}); // push empty workload for every thread. Threads then will shutdown after checking for m_numCompilationThreads == 0
+		// compile the remaining pipelines in the background with a reduced number of threads
+		uint32 threadBudget = (uint32)std::max(GetConfig().pipeline_prewarm_threads.GetValue(), 0);
+		if (threadBudget == 0)
+			threadBudget = std::max<uint32>(m_numCompilationThreads / 2, 1);
+		SetCompilationThreadCount(threadBudget);
+		m_backgroundLoadingThread = std::thread(&VulkanPipelineStableCache::BackgroundLoadingThread, this);
+		return;
 	}
+	// shut down compilation threads
+	SetCompilationThreadCount(0);
 	// keep cache file open for writing of new pipelines
 }
 
+void VulkanPipelineStableCache::BackgroundLoadingThread()
+{
+	SetThreadName("plCacheBgLoader");
+	const uint64 memoryBudget = (uint64)std::max(GetConfig().pipeline_prewarm_memory.GetValue(), 1) * 1024 * 1024;
+	while (g_vkCacheState.pipelineLoadIndex < m_loadOrder.size() && !m_backgroundLoadingStop)
+	{
+		if (m_inFlightMemory >= memoryBudget || GetCompilationQueueSize() >= 50)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			continue;
+		}
+		QueuePipelineFromCache(m_loadOrder[g_vkCacheState.pipelineLoadIndex++]);
+	}
+	while (g_vkCacheState.pipelinesLoaded != g_vkCacheState.pipelinesQueued && !m_backgroundLoadingStop)
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	if (!m_backgroundLoadingStop)
+		cemuLog_log(LogType::Force, "Finished loading cached pipelines in the background");
+	SetCompilationThreadCount(0);
+}
+
+void VulkanPipelineStableCache::StopLoading()
+{
+	if (m_backgroundLoadingThread.joinable())
+	{
+		m_backgroundLoadingStop = true;
+		m_backgroundLoadingThread.join();
+	}
+	// wait for pipelines which are still compiling
+	SetCompilationThreadCount(0);
+	while (m_numRunningCompilationThreads != 0)
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
 void VulkanPipelineStableCache::Close()
 {
+	StopLoading();
+	SaveFirstUseOrder();
     if(s_cache)
     {
         delete s_cache;
@@ -126,6 +249,93 @@ void VulkanPipelineStableCache::Close()
     }
 }
 
+void VulkanPipelineStableCache::LoadFirstUseOrder(uint64 cacheTitleId)
+{
+	std::unique_lock _l(m_firstUseMutex);
+	m_firstUseTime.clear();
+	m_firstUseTimeChanged = false;
+	m_firstUseOrderPath = ActiveSettings::GetCachePath("shaderCache/transferable/{:016x}_vkpipeline_order.bin", cacheTitleId);
+	auto fileData = FileStream::LoadIntoMemory(m_firstUseOrderPath);
+	if (!fileData)
+		return;
+	MemStreamReader streamReader(fileData->data(), fileData->size());
+	if (streamReader.readBE<uint8>() != 1) // version
+		return;
+	uint32 count = streamReader.readBE<uint32>();
+	for (uint32 i = 0; i < count && !streamReader.hasError(); i++)
+	{
+		uint64 fileNameA = streamReader.readBE<uint64>();
+		uint64 fileNameB = streamReader.readBE<uint64>();
+		uint32 timeSinceBoot = streamReader.readBE<uint32>();
+		m_firstUseTime.emplace(PipelineHash(fileNameA, fileNameB), timeSinceBoot);
+	}
+	if (streamReader.hasError())
+	{
+		cemuLog_log(LogType::Force, "Vulkan pipeline cache order file is corrupted");
+		m_firstUseTime.clear();
+	}
+}
+
+void VulkanPipelineStableCache::SaveFirstUseOrder()
+{
+	std::unique_lock _l(m_firstUseMutex);
+	if (!m_firstUseTimeChanged || m_firstUseOrderPath.empty())
+		return;
+	MemStreamWriter memWriter(5 + m_firstUseTime.size() * 20);
+	memWriter.writeBE<uint8>(0x01); // version
+	memWriter.writeBE<uint32>((uint32)m_firstUseTime.size());
+	for (auto& it : m_firstUseTime)
+	{
+		memWriter.writeBE<uint64>(it.first.h0);
+		memWriter.writeBE<uint64>(it.first.h1);
+		memWriter.writeBE<uint32>(it.second);
+	}
+	auto blob = memWriter.getResult();
+	FileStream* fs = FileStream::createFile2(m_firstUseOrderPath);
+	if (!fs)
+	{
+		cemuLog_log(LogType::Force, "Failed to write Vulkan pipeline cache order file: {}", _pathToUtf8(m_firstUseOrderPath));
+		return;
+	}
+	fs->writeData(blob.data(), (sint32)blob.size());
+	delete fs;
+	m_firstUseTimeChanged = false;
+}
+
+uint32 VulkanPipelineStableCache::GetTimeSinceBoot() const
+{
+	if (m_bootTick == 0)
+		return 0;
+	uint64 ms = HighResolutionTimer::ticksToMicroseconds(HighResolutionTimer::now().getTick() - m_bootTick) / 1000;
+	return (uint32)std::min<uint64>(ms, 0xFFFFFFFF);
+}
+
+void VulkanPipelineStableCache::RecordFirstUse(PipelineHash fileName, uint32 timeSinceBoot)
+{
+	std::unique_lock _l(m_firstUseMutex);
+	auto it = m_firstUseTime.try_emplace(fileName, timeSinceBoot);
+	if (it.second)
+	{
+		m_firstUseTimeChanged = true;
+	}
+	else if (timeSinceBoot < it.first->second)
+	{
+		it.first->second = timeSinceBoot;
+		m_firstUseTimeChanged = true;
+	}
+}
+
+void VulkanPipelineStableCache::RecordFirstUse(uint64 baseHash, uint64 pipelineStateHash)
+{
+	m_pipelineIsCachedLock.lock();
+	auto it = m_pipelineIsCached.find(PipelineHash(baseHash, pipelineStateHash));
+	PipelineHash fileName = it != m_pipelineIsCached.end() ? it->second : PipelineHash(0, 0);
+	m_pipelineIsCachedLock.unlock();
+	if (fileName.h0 == 0 && fileName.h1 == 0)
+		return; // added in this session, recorded once it is written to the cache file
+	RecordFirstUse(fileName, GetTimeSinceBoot());
+}
+
 struct CachedPipeline
 {
 	struct ShaderHash
@@ -147,6 +357,8 @@ struct CachedPipeline
 	ShaderHash psHash;
 
 	Latte::GPUCompactedRegisterState gpuState;
+
+	uint32 firstUseTime{}; // not serialized
 };
 
 VkFormat __getColorBufferVkFormat(const uint32 index, const LatteContextRegister& lcr)
@@ -208,7 +420,7 @@ VKRObjectRenderPass* __CreateTemporaryRenderPass(const LatteDecompilerShader* pi
 	return new VKRObjectRenderPass(attachmentInfo);
 }
 
-void VulkanPipelineStableCache::LoadPipelineFromCache(std::span<uint8> fileData)
+void VulkanPipelineStableCache::LoadPipelineFromCache(std::span<uint8> fileData, PipelineHash fileName)
 {
 	static FSpinlock s_spinlockSharedInternal;
 
@@ -271,6 +483,24 @@ void VulkanPipelineStableCache::LoadPipelineFromCache(std::span<uint8> fileData)
 		return;
 	}
 	auto renderPass = __CreateTemporaryRenderPass(pixelShader, *lcr);
+	// pipelines loaded in the background may already have been compiled by the renderer during gameplay
+	uint64 pipelineBaseHash = vertexShader->baseHash;
+	uint64 pipelineStateHash = VulkanRenderer::draw_calculateGraphicsPipelineHash(vertexShader->compatibleFetchShader, vertexShader, geometryShader, pixelShader, renderPass, *lcr);
+	m_pipelineIsCachedLock.lock();
+	auto cachedIt = m_pipelineIsCached.find(PipelineHash(pipelineBaseHash, pipelineStateHash));
+	bool isAlreadyCompiled = cachedIt != m_pipelineIsCached.end();
+	if (isAlreadyCompiled)
+		cachedIt->second = fileName; // the pipeline is already in the cache file, keep its name so that its first use is recorded
+	m_pipelineIsCachedLock.unlock();
+	if (isAlreadyCompiled)
+	{
+		s_spinlockSharedInternal.lock();
+		delete lcr;
+		delete cachedPipeline;
+		VulkanRenderer::GetInstance()->ReleaseDestructibleObject(renderPass);
+		s_spinlockSharedInternal.unlock();
+		return;
+	}
 	// create pipeline info
 	m_pipelineIsCachedLock.lock();
 	PipelineInfo* pipelineInfo = new PipelineInfo(0, 0, vertexShader->compatibleFetchShader, vertexShader, pixelShader, geometryShader);
@@ -289,11 +519,9 @@ void VulkanPipelineStableCache::LoadPipelineFromCache(std::span<uint8> fileData)
 		pp.Compile(true, true, false);
 		// destroy pp early
 	}
-	// on success, calculate pipeline hash and flag as present in cache
-	uint64 pipelineBaseHash = vertexShader->baseHash;
-	uint64 pipelineStateHash = VulkanRenderer::draw_calculateGraphicsPipelineHash(vertexShader->compatibleFetchShader, vertexShader, geometryShader, pixelShader, renderPass, *lcr);
+	// on success, flag as present in cache
 	m_pipelineIsCachedLock.lock();
-	m_pipelineIsCached.emplace(pipelineBaseHash, pipelineStateHash);
+	m_pipelineIsCached.emplace(PipelineHash(pipelineBaseHash, pipelineStateHash), fileName);
 	m_pipelineIsCachedLock.unlock();
 	// clean up
 	s_spinlockSharedInternal.lock();
@@ -307,14 +535,19 @@ void VulkanPipelineStableCache::LoadPipelineFromCache(std::span<uint8> fileData)
 bool VulkanPipelineStableCache::HasPipelineCached(uint64 baseHash, uint64 pipelineStateHash)
 {
 	PipelineHash ph(baseHash, pipelineStateHash);
-	return m_pipelineIsCached.find(ph) != m_pipelineIsCached.end();
+	m_pipelineIsCachedLock.lock();
+	bool isCached = m_pipelineIsCached.find(ph) != m_pipelineIsCached.end();
+	m_pipelineIsCachedLock.unlock();
+	return isCached;
 }
 
 ConcurrentQueue<CachedPipeline*> g_pipelineCachingQueue;
 
 void VulkanPipelineStableCache::AddCurrentStateToCache(uint64 baseHash, uint64 pipelineStateHash)
 {
-	m_pipelineIsCached.emplace(baseHash, pipelineStateHash);
+	m_pipelineIsCachedLock.lock();
+	m_pipelineIsCached.emplace(PipelineHash(baseHash, pipelineStateHash), PipelineHash(0, 0));
+	m_pipelineIsCachedLock.unlock();
 	if (!m_pipelineCacheStoreThread)
 	{
 		m_pipelineCacheStoreThread = new std::thread(&VulkanPipelineStableCache::WorkerThread, this);
@@ -335,6 +568,7 @@ void VulkanPipelineStableCache::AddCurrentStateToCache(uint64 baseHash, uint64 p
 	if (ps)
 		job->psHash.set(ps->baseHash, ps->auxHash);
 	Latte::StoreGPURegisterState(LatteGPUState.contextNew, job->gpuState);
+	job->firstUseTime = GetTimeSinceBoot();
 	// queue job
 	g_pipelineCachingQueue.push(job);
 }
@@ -406,17 +640,23 @@ bool VulkanPipelineStableCache::DeserializePipeline(MemStreamReader& memReader,
 	return true;
 }
 
-int VulkanPipelineStableCache::CompilerThread()
+int VulkanPipelineStableCache::CompilerThread(uint32 threadIndex)
 {
 	SetThreadName("plCacheCompiler");
-	while (m_numCompilationThreads != 0)
+	while (true)
 	{
-		std::vector<uint8> pipelineData = m_compilationQueue.pop();
-		if(pipelineData.empty())
-			continue;
-		LoadPipelineFromCache(pipelineData);
+		std::unique_lock _l(m_compilationMutex);
+		m_compilationCondVar.wait(_l, [&] { return m_compilationThreadStop[threadIndex] || !m_compilationQueue.empty(); });
+		if (m_compilationThreadStop[threadIndex])
+			break;
+		CompilationJob job = std::move(m_compilationQueue.front());
+		m_compilationQueue.pop();
+		_l.unlock();
+		LoadPipelineFromCache(job.fileData, job.fileName);
+		m_inFlightMemory -= _EstimatePipelineLoadMemory(job.fileData.size());
 		++g_vkCacheState.pipelinesLoaded;
 	}
+	m_numRunningCompilationThreads--;
 	return 0;
 }
 
@@ -442,6 +682,7 @@ void VulkanPipelineStableCache::WorkerThread()
 		uint64 nameA = *(uint64be*)(hash + 0);
 		uint64 nameB = *(uint64be*)(hash + 8);
 		s_cache->AddFileAsync({ nameA, nameB }, blob.data(), blob.size());
+		RecordFirstUse(PipelineHash(nameA, nameB), job->firstUseTime);
 		delete job;
 	}
 }
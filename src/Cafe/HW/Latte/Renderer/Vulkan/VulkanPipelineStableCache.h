@@ -1,5 +1,7 @@
 #pragma once
 #include "util/helpers/fspinlock.h"
+#include "util/helpers/ConcurrentQueue.h"
+#include "util/highresolutiontimer/HighResolutionTimer.h"
 
 struct VulkanPipelineHash
 {
@@ -37,30 +39,67 @@ class VulkanPipelineStableCache
 public:
 	static VulkanPipelineStableCache& GetInstance();
 
-	uint32 BeginLoading(uint64 cacheTitleId); // returns count of pipelines stored in cache
+	uint32 BeginLoading(uint64 cacheTitleId); // returns count of pipelines which are loaded before boot
 	bool UpdateLoading(uint32& pipelinesLoadedTotal, uint32& pipelinesMissingShaders);
 	void EndLoading();
-	void LoadPipelineFromCache(std::span<uint8> fileData);
+	void LoadPipelineFromCache(std::span<uint8> fileData, PipelineHash fileName);
+	void StopLoading(); // stops loading pipelines in the background and waits until the compilation threads have exited
     void Close(); // called on title exit
 
 	bool HasPipelineCached(uint64 baseHash, uint64 pipelineStateHash);
 	void AddCurrentStateToCache(uint64 baseHash, uint64 pipelineStateHash);
+	void RecordFirstUse(uint64 baseHash, uint64 pipelineStateHash); // called when a cached pipeline is used for the first time in this session
 
 	// pipeline serialization for file
 	bool SerializePipeline(class MemStreamWriter& memWriter, struct CachedPipeline& cachedPipeline);
 	bool DeserializePipeline(class MemStreamReader& memReader, struct CachedPipeline& cachedPipeline);
 
 private:
-	int CompilerThread();
+	struct CompilationJob
+	{
+		PipelineHash fileName{ 0, 0 };
+		std::vector<uint8> fileData;
+	};
+
+	int CompilerThread(uint32 threadIndex);
 	void WorkerThread();
+	void BackgroundLoadingThread();
+
+	bool QueuePipelineFromCache(sint32 fileIndex);
+	size_t GetCompilationQueueSize();
+	void SetCompilationThreadCount(uint32 threadCount);
+
+	// first-use order
+	void LoadFirstUseOrder(uint64 cacheTitleId);
+	void SaveFirstUseOrder();
+	void RecordFirstUse(PipelineHash fileName, uint32 timeSinceBoot);
+	uint32 GetTimeSinceBoot() const;
 
 	std::thread* m_pipelineCacheStoreThread;
 
-	std::unordered_set<PipelineHash, PipelineHash::HashFunc> m_pipelineIsCached;
+	std::unordered_map<PipelineHash, PipelineHash, PipelineHash::HashFunc> m_pipelineIsCached; // pipeline hash -> file name in cache. File name is zero for pipelines added in this session
 	FSpinlock m_pipelineIsCachedLock;
 	class FileCache* s_cache;
 
 	std::atomic_uint32_t m_numCompilationThreads{ 0 };
-	ConcurrentQueue<std::vector<uint8>> m_compilationQueue;
+	std::atomic_uint32_t m_numRunningCompilationThreads{ 0 };
+	std::mutex m_compilationMutex;
+	std::condition_variable m_compilationCondVar;
+	std::queue<CompilationJob> m_compilationQueue;
+	std::vector<bool> m_compilationThreadStop; // indexed by compilation thread. Set to let the thread exit after its current job
 	std::atomic_uint32_t m_compilationCount;
+
+	// prewarming
+	// cached pipelines are loaded in recorded first-use order. Only those which were used shortly after boot are loaded before the title starts
+	std::vector<sint32> m_loadOrder; // file indices
+	uint32 m_numForegroundPipelines{};
+	std::thread m_backgroundLoadingThread;
+	std::atomic_bool m_backgroundLoadingStop{ false };
+	std::atomic_uint64_t m_inFlightMemory{ 0 }; // estimated memory used by queued and compiling pipelines
+	HRTick m_bootTick{};
+
+	std::mutex m_firstUseMutex;
+	std::unordered_map<PipelineHash, uint32, PipelineHash::HashFunc> m_firstUseTime; // file name -> milliseconds after boot
+	fs::path m_firstUseOrderPath;
+	bool m_firstUseTimeChanged{};
 };
\ No newline at end of file
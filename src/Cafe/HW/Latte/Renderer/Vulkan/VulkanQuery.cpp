@@ -85,8 +85,8 @@ void LatteQueryObjectVk::endFragment()
 	cemu_assert_debug(m_hasActiveFragment);
 	uint32 queryIndex = list_queryFragments.back().queryIndex;
 	vkCmdEndQuery(m_rendererVk->m_state.currentCommandBuffer, m_rendererVk->m_occlusionQueries.queryPool, queryIndex);
-
-	vkCmdCopyQueryPoolResults(m_rendererVk->m_state.currentCommandBuffer, m_rendererVk->m_occlusionQueries.queryPool, queryIndex, 1, m_rendererVk->m_occlusionQueries.bufferQueryResults, queryIndex * sizeof(uint64), 8, VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+	// the result is copied together with all other queries ended in this command buffer
+	m_rendererVk->m_occlusionQueries.list_pendingResultCopies.emplace_back(queryIndex);
 	list_queryFragments.back().m_finishCommandBuffer = m_rendererVk->GetCurrentCommandBufferId();
 	list_queryFragments.back().isFinished = true;
 	m_hasActiveFragment = false;
@@ -163,8 +163,8 @@ LatteQueryObject* VulkanRenderer::occlusionQuery_create()
 	}
 	else
 	{
-		queryObjVk = m_occlusionQueries.list_cachedQueries.front();
-		m_occlusionQueries.list_cachedQueries.erase(m_occlusionQueries.list_cachedQueries.begin()+0);
+		queryObjVk = m_occlusionQueries.list_cachedQueries.back();
+		m_occlusionQueries.list_cachedQueries.pop_back();
 	}
 	queryObjVk->queryEnded = false;
 	queryObjVk->queryEventStart = 0;
@@ -202,6 +202,28 @@ void VulkanRenderer::occlusionQuery_notifyEndCommandBuffer()
 	for (auto& it : m_occlusionQueries.list_currentlyActiveQueries)
 		if(it->m_hasActiveQuery)
 			it->endFragment();
+	occlusionQuery_copyPendingResults();
+}
+
+// copy the results of all queries ended in the current command buffer to the result buffer
+// query indices are handed out from a stack so they are mostly contiguous and only a few copy commands are needed
+void VulkanRenderer::occlusionQuery_copyPendingResults()
+{
+	auto& pendingCopies = m_occlusionQueries.list_pendingResultCopies;
+	if (pendingCopies.empty())
+		return;
+	std::sort(pendingCopies.begin(), pendingCopies.end());
+	size_t rangeStart = 0;
+	for (size_t i = 1; i <= pendingCopies.size(); i++)
+	{
+		if (i < pendingCopies.size() && pendingCopies[i] == pendingCopies[i - 1] + 1)
+			continue;
+		uint32 firstQuery = pendingCopies[rangeStart];
+		uint32 queryCount = (uint32)(i - rangeStart);
+		vkCmdCopyQueryPoolResults(m_state.currentCommandBuffer, m_occlusionQueries.queryPool, firstQuery, queryCount, m_occlusionQueries.bufferQueryResults, firstQuery * sizeof(uint64), sizeof(uint64), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+		rangeStart = i;
+	}
+	pendingCopies.clear();
 }
 
 void VulkanRenderer::occlusionQuery_notifyBeginCommandBuffer()
@@ -8,6 +8,7 @@
 #include "Cafe/HW/Latte/Core/LatteBufferCache.h"
 #include "Cafe/HW/Latte/Core/LattePerformanceMonitor.h"
 #include "Cafe/HW/Latte/Core/LatteOverlay.h"
+#include "Cafe/HW/Latte/Core/LatteFramePacing.h"
 
 #include "Cafe/HW/Latte/LegacyShaderDecompiler/LatteDecompiler.h"
 
@@ -2771,8 +2772,12 @@ void VulkanRenderer::SwapBuffer(bool mainWindow)
 		if(chainInfo.m_queueDepth >= chainInfo.m_maxQueued)
 		{
 			uint64 waitFrameId = chainInfo.m_presentId - chainInfo.m_queueDepth;
-			vkWaitForPresentKHR(m_logicalDevice, chainInfo.m_swapchain, waitFrameId, 40'000'000);
+			HRTick waitBegin = HighResolutionTimer::now().getTick();
+			VkResult waitResult = vkWaitForPresentKHR(m_logicalDevice, chainInfo.m_swapchain, waitFrameId, 40'000'000);
 			chainInfo.m_queueDepth--;
+			// the wait returns once the frame is displayed, which gives the frame pacer the display timing
+			if (mainWindow && waitResult == VK_SUCCESS)
+				LatteFramePacing_NotifyPresentWait(waitBegin, HighResolutionTimer::now().getTick());
 		}
 	}
 
@@ -3439,22 +3444,61 @@ LatteTextureReadbackInfo* VulkanRenderer::texture_createReadback(LatteTextureVie
 
 	const uint32 linearImageSize = result->GetImageSize();
 	const uint32 uploadSize = (linearImageSize == 0) ? memRequirements.size : linearImageSize;
-	const uint32 uploadAlignment = 256; // todo - use Vk optimalBufferCopyOffsetAlignment
-	m_textureReadbackBufferWriteIndex = (m_textureReadbackBufferWriteIndex + uploadAlignment - 1) & ~(uploadAlignment - 1);
-
-	if ((m_textureReadbackBufferWriteIndex + uploadSize + 256) > TEXTURE_READBACK_SIZE)
+	uint32 uploadBufferOffset;
+	while (!texture_reserveReadbackSpace(uploadSize, uploadBufferOffset))
 	{
-		m_textureReadbackBufferWriteIndex = 0;
+		// staging buffer is full, wait for the oldest readback to be retired
+		if (!LatteTextureReadback_FinishOldestTransfer())
+		{
+			cemuLog_log(LogType::Force, "Texture readback of {} bytes exceeds the size of the staging buffer", uploadSize);
+			uploadBufferOffset = 0;
+			m_textureReadbackNumActive++;
+			break;
+		}
 	}
 
-	const uint32 uploadBufferOffset = m_textureReadbackBufferWriteIndex;
-	m_textureReadbackBufferWriteIndex += uploadSize;
-
 	result->SetBuffer(m_textureReadbackBuffer, m_textureReadbackBufferPtr, uploadBufferOffset);
 
 	return result;
 }
 
+// allocate space in the readback staging buffer. Fails if the range is still used by readbacks in flight
+bool VulkanRenderer::texture_reserveReadbackSpace(uint32 size, uint32& offset)
+{
+	const uint32 uploadAlignment = 256; // todo - use Vk optimalBufferCopyOffsetAlignment
+	if (m_textureReadbackNumActive == 0)
+	{
+		// buffer is empty, restart at the beginning
+		m_textureReadbackBufferWriteIndex = 0;
+		m_textureReadbackBufferReadIndex = 0;
+	}
+	uint32 writeIndex = (m_textureReadbackBufferWriteIndex + uploadAlignment - 1) & ~(uploadAlignment - 1);
+	if (m_textureReadbackNumActive == 0 || m_textureReadbackBufferWriteIndex >= m_textureReadbackBufferReadIndex)
+	{
+		// free range extends to the end of the buffer
+		if ((writeIndex + size) > TEXTURE_READBACK_SIZE)
+		{
+			// wrap around. The range in front of the read index is free
+			if (m_textureReadbackNumActive == 0 || size >= m_textureReadbackBufferReadIndex)
+				return false;
+			writeIndex = 0;
+		}
+	}
+	else if ((writeIndex + size) >= m_textureReadbackBufferReadIndex)
+		return false;
+	offset = writeIndex;
+	m_textureReadbackBufferWriteIndex = writeIndex + size;
+	m_textureReadbackNumActive++;
+	return true;
+}
+
+void VulkanRenderer::texture_releaseReadbackSpace(uint32 endOffset)
+{
+	cemu_assert_debug(m_textureReadbackNumActive > 0);
+	m_textureReadbackBufferReadIndex = endOffset;
+	m_textureReadbackNumActive--;
+}
+
 uint32 s_vkCurrentUniqueId = 0;
 
 uint64 VulkanRenderer::GenUniqueId()
@@ -3689,6 +3733,8 @@ void VulkanRenderer::AppendOverlayDebugInfo()
 
 	ImGui::Text("BeginRP/f      %u", performanceMonitor.vk.numBeginRenderpassPerFrame.get());
 	ImGui::Text("Barriers/f     %u", performanceMonitor.vk.numDrawBarriersPerFrame.get());
+	ImGui::Text("UniformUpl/f   %u (skipped %u)", performanceMonitor.vk.numUniformUploadsPerFrame.get(), performanceMonitor.vk.numUniformUploadsSkippedPerFrame.get());
+	ImGui::Text("DS reused/f    %u", performanceMonitor.vk.numDescriptorSetsReusedPerFrame.get());
 	ImGui::Text("--- Cache info ---");
 
 	uint32 bufferCacheHeapSize = 0;
@@ -263,8 +263,23 @@ public:
 	PipelineInfo* draw_getCachedPipeline();
 
 	// pipeline state hash
+	struct PipelineStateGroupHashes
+	{
+		const LatteFetchShader* fetchShader{}; // fetch shader used for the vertex layout hash
+		uint64 vertexLayout{};
+		uint64 primitive{};
+		uint64 raster{};
+		uint64 blend{};
+		uint64 depthStencil{};
+
+		void Update(uint32 groupMask, const LatteFetchShader* fetchShader, const LatteContextRegister& lcr);
+		uint64 GetMinimalHash() const;
+		uint64 GetFullHash(const LatteDecompilerShader* vertexShader, const LatteDecompilerShader* geometryShader, const LatteDecompilerShader* pixelShader, uint64 renderPassHash) const; // renderPassHash is VKRObjectRenderPass::m_hashForPipeline
+	}m_pipelineStateHashes;
+
 	static uint64 draw_calculateMinimalGraphicsPipelineHash(const LatteFetchShader* fetchShader, const LatteContextRegister& lcr);
 	static uint64 draw_calculateGraphicsPipelineHash(const LatteFetchShader* fetchShader, const LatteDecompilerShader* vertexShader, const LatteDecompilerShader* geometryShader, const LatteDecompilerShader* pixelShader, const VKRObjectRenderPass* renderPassObj, const LatteContextRegister& lcr);
+	void draw_updatePipelineStateHashes();
 
 	// rendertarget
 	void renderTarget_setViewport(float x, float y, float width, float height, float nearZ, float farZ, bool halfZ = false) override;
@@ -293,6 +308,8 @@ public:
 
 	void texture_copyImageSubData(LatteTexture* src, sint32 srcMip, sint32 effectiveSrcX, sint32 effectiveSrcY, sint32 srcSlice, LatteTexture* dst, sint32 dstMip, sint32 effectiveDstX, sint32 effectiveDstY, sint32 dstSlice, sint32 effectiveCopyWidth, sint32 effectiveCopyHeight, sint32 srcDepth) override;
 	LatteTextureReadbackInfo* texture_createReadback(LatteTextureView* textureView) override;
+	bool texture_reserveReadbackSpace(uint32 size, uint32& offset);
+	void texture_releaseReadbackSpace(uint32 endOffset);
 
 	// surface copy
 	void surfaceCopy_copySurfaceWithFormatConversion(LatteTexture* sourceTexture, sint32 srcMip, sint32 srcSlice, LatteTexture* destinationTexture, sint32 dstMip, sint32 dstSlice, sint32 width, sint32 height) override;
@@ -566,6 +583,7 @@ private:
 	void occlusionQuery_flush() override;
 	void occlusionQuery_updateState() override;
 	void occlusionQuery_notifyEndCommandBuffer();
+	void occlusionQuery_copyPendingResults();
 	void occlusionQuery_notifyBeginCommandBuffer();
 
 private:
@@ -592,6 +610,18 @@ private:
 	uint8* m_uniformVarBufferPtr = nullptr;
 	uint32 m_uniformVarBufferWriteIndex = 0;
 	uint32 m_uniformVarBufferReadIndex = 0;
+	// uniform vars of the most recent upload per stage. If nothing changed the next draw reuses the upload
+	// reuse is limited to the same command buffer, since the ring buffer space is released once the command buffer that allocated it has finished
+	struct
+	{
+		LatteDecompilerShader* shader{};
+		uint64 shaderBaseHash{};
+		uint64 shaderAuxHash{};
+		uint32 aluConstWriteCounter{};
+		uint64 commandBufferId{};
+		uint32 bufferOffset{};
+		float data[512 * 4]{};
+	}m_uniformVarCache[VulkanRendererConst::SHADER_STAGE_INDEX_COUNT];
 
 	// transform feedback ringbuffer
 	VkBuffer m_xfbRingBuffer = VK_NULL_HANDLE;
@@ -606,6 +636,8 @@ private:
 	VkDeviceMemory m_textureReadbackBufferMemory = VK_NULL_HANDLE;
 	uint8* m_textureReadbackBufferPtr = nullptr;
 	uint32 m_textureReadbackBufferWriteIndex = 0;
+	uint32 m_textureReadbackBufferReadIndex = 0; // end of the most recently released readback. Readbacks are released in the order they were created
+	uint32 m_textureReadbackNumActive = 0;
 
 	// placeholder objects to simulate NULL buffers and textures
 	struct NullTexture
@@ -688,6 +720,7 @@ private:
 		VkDeviceMemory memoryQueryResults;
 		uint64* ptrQueryResults;
 		std::vector<uint16> list_availableQueryIndices;
+		std::vector<uint16> list_pendingResultCopies; // queries ended in the current command buffer
 	}m_occlusionQueries;
 
 	// barrier
@@ -15,53 +15,105 @@
 
 extern bool hasValidFramebufferAttached;
 
-// includes only states that may change during minimal drawcalls
-uint64 VulkanRenderer::draw_calculateMinimalGraphicsPipelineHash(const LatteFetchShader* fetchShader, const LatteContextRegister& lcr)
+// the pipeline state hash is a combination of per-group hashes (see LATTE_PIPELINE_STATE_GROUP_*)
+// during drawing the group hashes are cached and only the groups which the command processor flagged as dirty are recalculated
+void VulkanRenderer::PipelineStateGroupHashes::Update(uint32 groupMask, const LatteFetchShader* fetchShader, const LatteContextRegister& lcr)
 {
-	uint64 stateHash = 0;
-
-	// fetch shader
-	for (auto& group : fetchShader->bufferGroups)
+	uint32* ctxRegister = lcr.GetRawView();
+	if (groupMask & LATTE_PIPELINE_STATE_GROUP_VERTEX_LAYOUT)
 	{
-		uint32 bufferStride = group.getCurrentBufferStride(lcr.GetRawView());
+		uint64 stateHash = 0;
+		for (auto& group : fetchShader->bufferGroups)
+		{
+			uint32 bufferStride = group.getCurrentBufferStride(ctxRegister);
+			stateHash = std::rotl<uint64>(stateHash, 7);
+			stateHash += bufferStride * 3;
+		}
+		stateHash += fetchShader->getVkPipelineHashFragment();
+		vertexLayout = stateHash;
+		this->fetchShader = fetchShader;
+	}
+	if (groupMask & LATTE_PIPELINE_STATE_GROUP_PRIMITIVE)
+	{
+		uint64 stateHash = ctxRegister[mmVGT_PRIMITIVE_TYPE];
+		stateHash = std::rotl<uint64>(stateHash, 7);
+		stateHash += ctxRegister[mmVGT_STRMOUT_EN];
 		stateHash = std::rotl<uint64>(stateHash, 7);
-		stateHash += bufferStride * 3;
+		if (lcr.PA_CL_CLIP_CNTL.get_DX_RASTERIZATION_KILL())
+			stateHash += 0x333333;
+		primitive = stateHash;
 	}
+	if (groupMask & LATTE_PIPELINE_STATE_GROUP_RASTER)
+	{
+		uint32 polygonCtrl = lcr.PA_SU_SC_MODE_CNTL.getRawValue();
+		uint64 stateHash = polygonCtrl;
+		stateHash = std::rotl<uint64>(stateHash, 7);
+		stateHash += ctxRegister[Latte::REGADDR::PA_CL_CLIP_CNTL];
+		// polygon offset
+		if (polygonCtrl & (1 << 11))
+		{
+			// front offset enabled
+			stateHash += 0x1111;
+		}
+		raster = stateHash;
+	}
+	if (groupMask & LATTE_PIPELINE_STATE_GROUP_BLEND)
+	{
+		const auto colorControlReg = ctxRegister[Latte::REGADDR::CB_COLOR_CONTROL];
+		uint64 stateHash = colorControlReg;
+		stateHash += ctxRegister[Latte::REGADDR::CB_TARGET_MASK];
+		const uint32 blendEnableMask = (colorControlReg >> 8) & 0xFF;
+		if (blendEnableMask)
+		{
+			for (auto i = 0; i < 8; ++i)
+			{
+				if (((blendEnableMask & (1 << i))) == 0)
+					continue;
+				stateHash = std::rotl<uint64>(stateHash, 7);
+				stateHash += ctxRegister[Latte::REGADDR::CB_BLEND0_CONTROL + i];
+			}
+		}
+		blend = stateHash;
+	}
+	if (groupMask & LATTE_PIPELINE_STATE_GROUP_DEPTH_STENCIL)
+	{
+		uint64 stateHash = 0;
+		uint32 depthControl = ctxRegister[Latte::REGADDR::DB_DEPTH_CONTROL];
+		bool stencilTestEnable = depthControl & 1;
+		if (stencilTestEnable)
+		{
+			stateHash += ctxRegister[mmDB_STENCILREFMASK];
+			stateHash = std::rotl<uint64>(stateHash, 17);
+			if(depthControl & (1<<7)) // back stencil enable
+			{
+				stateHash += ctxRegister[mmDB_STENCILREFMASK_BF];
+				stateHash = std::rotl<uint64>(stateHash, 13);
+			}
+		}
+		else
+		{
+			// zero out stencil related bits (8-31)
+			depthControl &= 0xFF;
+		}
+		stateHash = std::rotl<uint64>(stateHash, 17);
+		stateHash += depthControl;
+		depthStencil = stateHash;
+	}
+}
 
-	stateHash += fetchShader->getVkPipelineHashFragment();
-	stateHash = std::rotl<uint64>(stateHash, 7);
-
-	stateHash += lcr.GetRawView()[mmVGT_PRIMITIVE_TYPE];
-	stateHash = std::rotl<uint64>(stateHash, 7);
-
-	stateHash += lcr.GetRawView()[mmVGT_STRMOUT_EN];
+// includes only states that may change during minimal drawcalls
+uint64 VulkanRenderer::PipelineStateGroupHashes::GetMinimalHash() const
+{
+	uint64 stateHash = vertexLayout;
 	stateHash = std::rotl<uint64>(stateHash, 7);
-
-	if(lcr.PA_CL_CLIP_CNTL.get_DX_RASTERIZATION_KILL())
-		stateHash += 0x333333;
-
+	stateHash += primitive;
 	return stateHash;
 }
 
-uint64 VulkanRenderer::draw_calculateGraphicsPipelineHash(const LatteFetchShader* fetchShader, const LatteDecompilerShader* vertexShader, const LatteDecompilerShader* geometryShader, const LatteDecompilerShader* pixelShader, const VKRObjectRenderPass* renderPassObj, const LatteContextRegister& lcr)
+uint64 VulkanRenderer::PipelineStateGroupHashes::GetFullHash(const LatteDecompilerShader* vertexShader, const LatteDecompilerShader* geometryShader, const LatteDecompilerShader* pixelShader, uint64 renderPassHash) const
 {
-	// note: vertexShader references a fetchShader (vertexShader->fetchShader) but it's not necessarily the one that is currently active
-	// this is because we try to separate dynamic state (mainly attribute offsets) from the actual attribute data layout and mapping (types and slots)
-	// on Vulkan this causes issues because we bake the attribute offsets, which may not match vertexShader->compatibleFetchShader, into the pipeline
-	// To avoid issues always use the active fetch shader. Not the one associated with the vertexShader object
-	// note 2:
-	// there is a secondary issue where we dont store all fetch shaders into the pipeline cache (only a single fetch shader is tied to each stored vertex shader)
-	// but we can probably trust drivers to not require pipeline recompilation if only the offsets differ
-	// An alternative would be to use VK_EXT_vertex_input_dynamic_state but it comes with minor overhead
-	// Regardless, the extension is not well supported as of writing this (July 2021, only 10% of GPUs support it on Windows. Nvidia only)
-
-	cemu_assert_debug(vertexShader->compatibleFetchShader->key == fetchShader->key); // fetch shaders must be layout compatible, but may have different offsets
-
-	uint64 stateHash;
-	stateHash = draw_calculateMinimalGraphicsPipelineHash(fetchShader, lcr);
+	uint64 stateHash = GetMinimalHash();
 	stateHash = (stateHash >> 8) + (stateHash * 0x370531ull) % 0x7F980D3BF9B4639Dull;
-	
-	uint32* ctxRegister = lcr.GetRawView();
 
 	if (vertexShader)
 		stateHash += vertexShader->baseHash;
@@ -77,62 +129,52 @@ uint64 VulkanRenderer::draw_calculateGraphicsPipelineHash(const LatteFetchShader
 		stateHash += pixelShader->baseHash + pixelShader->auxHash;
 
 	stateHash = std::rotl<uint64>(stateHash, 13);
-
-	uint32 polygonCtrl = lcr.PA_SU_SC_MODE_CNTL.getRawValue();
-	stateHash += polygonCtrl;
+	stateHash += raster;
 	stateHash = std::rotl<uint64>(stateHash, 7);
+	stateHash += blend;
+	stateHash += renderPassHash;
+	stateHash = std::rotl<uint64>(stateHash, 17);
+	stateHash += depthStencil;
+	return stateHash;
+}
 
-	stateHash += ctxRegister[Latte::REGADDR::PA_CL_CLIP_CNTL];
-	stateHash = std::rotl<uint64>(stateHash, 7);
-
-	const auto colorControlReg = ctxRegister[Latte::REGADDR::CB_COLOR_CONTROL];
-	stateHash += colorControlReg;
-
-	stateHash += ctxRegister[Latte::REGADDR::CB_TARGET_MASK];
-
-	const uint32 blendEnableMask = (colorControlReg >> 8) & 0xFF;
-	if (blendEnableMask)
-	{
-		for (auto i = 0; i < 8; ++i)
-		{
-			if (((blendEnableMask & (1 << i))) == 0)
-				continue;
-			stateHash = std::rotl<uint64>(stateHash, 7);
-			stateHash += ctxRegister[Latte::REGADDR::CB_BLEND0_CONTROL + i];
-		}
-	}
+uint64 VulkanRenderer::draw_calculateMinimalGraphicsPipelineHash(const LatteFetchShader* fetchShader, const LatteContextRegister& lcr)
+{
+	PipelineStateGroupHashes groupHashes;
+	groupHashes.Update(LATTE_PIPELINE_STATE_GROUP_VERTEX_LAYOUT | LATTE_PIPELINE_STATE_GROUP_PRIMITIVE, fetchShader, lcr);
+	return groupHashes.GetMinimalHash();
+}
 
-	stateHash += renderPassObj->m_hashForPipeline;
-	
-	uint32 depthControl = ctxRegister[Latte::REGADDR::DB_DEPTH_CONTROL];
-	bool stencilTestEnable = depthControl & 1;
-	if (stencilTestEnable)
-	{
-		stateHash += ctxRegister[mmDB_STENCILREFMASK];
-		stateHash = std::rotl<uint64>(stateHash, 17);
-		if(depthControl & (1<<7)) // back stencil enable
-		{ 
-			stateHash += ctxRegister[mmDB_STENCILREFMASK_BF];
-			stateHash = std::rotl<uint64>(stateHash, 13);
-		}
-	}
-	else
-	{
-		// zero out stencil related bits (8-31)
-		depthControl &= 0xFF;
-	}
+uint64 VulkanRenderer::draw_calculateGraphicsPipelineHash(const LatteFetchShader* fetchShader, const LatteDecompilerShader* vertexShader, const LatteDecompilerShader* geometryShader, const LatteDecompilerShader* pixelShader, const VKRObjectRenderPass* renderPassObj, const LatteContextRegister& lcr)
+{
+	// note: vertexShader references a fetchShader (vertexShader->fetchShader) but it's not necessarily the one that is currently active
+	// this is because we try to separate dynamic state (mainly attribute offsets) from the actual attribute data layout and mapping (types and slots)
+	// on Vulkan this causes issues because we bake the attribute offsets, which may not match vertexShader->compatibleFetchShader, into the pipeline
+	// To avoid issues always use the active fetch shader. Not the one associated with the vertexShader object
+	// note 2:
+	// there is a secondary issue where we dont store all fetch shaders into the pipeline cache (only a single fetch shader is tied to each stored vertex shader)
+	// but we can probably trust drivers to not require pipeline recompilation if only the offsets differ
+	// An alternative would be to use VK_EXT_vertex_input_dynamic_state but it comes with minor overhead
+	// Regardless, the extension is not well supported as of writing this (July 2021, only 10% of GPUs support it on Windows. Nvidia only)
 
-	stateHash = std::rotl<uint64>(stateHash, 17);
-	stateHash += depthControl;
+	cemu_assert_debug(vertexShader->compatibleFetchShader->key == fetchShader->key); // fetch shaders must be layout compatible, but may have different offsets
 
-	// polygon offset
-	if (polygonCtrl & (1 << 11))
-	{
-		// front offset enabled
-		stateHash += 0x1111;
-	}
+	PipelineStateGroupHashes groupHashes;
+	groupHashes.Update(LATTE_PIPELINE_STATE_GROUP_ALL, fetchShader, lcr);
+	return groupHashes.GetFullHash(vertexShader, geometryShader, pixelShader, renderPassObj->m_hashForPipeline);
+}
 
-	return stateHash;
+// pick up register writes since the last drawcall
+void VulkanRenderer::draw_updatePipelineStateHashes()
+{
+	const LatteFetchShader* fetchShader = LatteSHRC_GetActiveFetchShader();
+	uint32 dirtyMask = LatteGPUState.pipelineStateDirtyMask;
+	if (fetchShader != m_pipelineStateHashes.fetchShader)
+		dirtyMask |= LATTE_PIPELINE_STATE_GROUP_VERTEX_LAYOUT;
+	if (dirtyMask == 0)
+		return;
+	m_pipelineStateHashes.Update(dirtyMask, fetchShader, LatteGPUState.contextNew);
+	LatteGPUState.pipelineStateDirtyMask = 0;
 }
 
 void VulkanRenderer::draw_debugPipelineHashState()
@@ -153,7 +195,8 @@ PipelineInfo* VulkanRenderer::draw_getCachedPipeline()
 	const auto pixelShader = LatteSHRC_GetActivePixelShader();
 	auto cachedFboVk = (CachedFBOVk*)m_state.activeFBO;
 
-	const uint64 stateHash = draw_calculateGraphicsPipelineHash(fetchShader, vertexShader, geometryShader, pixelShader, cachedFboVk->GetRenderPassObj(), LatteGPUState.contextNew);
+	const uint64 stateHash = m_pipelineStateHashes.GetFullHash(vertexShader, geometryShader, pixelShader, cachedFboVk->GetRenderPassObj()->m_hashForPipeline);
+	cemu_assert_debug(stateHash == draw_calculateGraphicsPipelineHash(fetchShader, vertexShader, geometryShader, pixelShader, cachedFboVk->GetRenderPassObj(), LatteGPUState.contextNew));
 
 	const auto innerit = it->second.find(stateHash);
 	if (innerit == it->second.cend())
@@ -282,8 +325,8 @@ PipelineInfo* VulkanRenderer::draw_createGraphicsPipeline(uint32 indexCount)
 	const auto pixelShader = LatteSHRC_GetActivePixelShader();
 	auto cachedFboVk = (CachedFBOVk*)m_state.activeFBO;
 
-	uint64 minimalStateHash = draw_calculateMinimalGraphicsPipelineHash(fetchShader, LatteGPUState.contextNew);
-	uint64 pipelineHash = draw_calculateGraphicsPipelineHash(fetchShader, vertexShader, geometryShader, pixelShader, cachedFboVk->GetRenderPassObj(), LatteGPUState.contextNew);
+	uint64 minimalStateHash = m_pipelineStateHashes.GetMinimalHash();
+	uint64 pipelineHash = m_pipelineStateHashes.GetFullHash(vertexShader, geometryShader, pixelShader, cachedFboVk->GetRenderPassObj()->m_hashForPipeline);
 
 	// create PipelineInfo
 	auto vkFBO = (CachedFBOVk*)(VulkanRenderer::GetInstance()->m_state.activeFBO);
@@ -371,24 +414,41 @@ void VulkanRenderer::indexData_uploadIndexMemory(uint32 offset, uint32 size)
 	// does nothing since the index buffer memory is coherent
 }
 
-float s_vkUniformData[512 * 4];
+float s_vkUniformData[512 * 4]; // scratch buffer for remapped uniforms
 
 void VulkanRenderer::uniformData_updateUniformVars(uint32 shaderStageIndex, LatteDecompilerShader* shader)
 {
-	auto GET_UNIFORM_DATA_PTR = [](size_t index) { return s_vkUniformData + (index / 4); };
+	auto& cache = m_uniformVarCache[shaderStageIndex];
+	float* uniformData = cache.data;
+	auto GET_UNIFORM_DATA_PTR = [uniformData](size_t index) { return uniformData + (index / 4); };
+
+	// the data of the previous upload is only overwritten where it changed, any difference requires a new upload
+	bool isDirty = false;
+	auto updateUniformData = [&](sint32 location, const void* data, size_t size)
+	{
+		void* dst = GET_UNIFORM_DATA_PTR(location);
+		if (memcmp(dst, data, size) == 0)
+			return;
+		memcpy(dst, data, size);
+		isDirty = true;
+	};
 
 	sint32 shaderAluConst;
+	uint32 aluConstWriteCounter;
 
 	switch (shader->shaderType)
 	{
 	case LatteConst::ShaderType::Vertex:
 		shaderAluConst = 0x400;
+		aluConstWriteCounter = LatteGPUState.aluConstWriteCounterVS;
 		break;
 	case LatteConst::ShaderType::Pixel:
 		shaderAluConst = 0;
+		aluConstWriteCounter = LatteGPUState.aluConstWriteCounterPS;
 		break;
 	case LatteConst::ShaderType::Geometry:
 		shaderAluConst = 0; // geometry shader has no ALU const
+		aluConstWriteCounter = LatteGPUState.aluConstWriteCounterPS;
 		break;
 	default:
 		UNREACHABLE;
@@ -396,18 +456,28 @@ void VulkanRenderer::uniformData_updateUniformVars(uint32 shaderStageIndex, Latt
 
 	if (shader->resourceMapping.uniformVarsBufferBindingPoint >= 0)
 	{
+		// a different shader uses a different layout
+		bool shaderChanged = cache.shader != shader || cache.shaderBaseHash != shader->baseHash || cache.shaderAuxHash != shader->auxHash;
+		if (shaderChanged)
+		{
+			cache.shader = shader;
+			cache.shaderBaseHash = shader->baseHash;
+			cache.shaderAuxHash = shader->auxHash;
+			isDirty = true;
+		}
 		if (shader->uniform.list_ufTexRescale.empty() == false)
 		{
 			for (auto& entry : shader->uniform.list_ufTexRescale)
 			{
 				float* xyScale = LatteTexture_getEffectiveTextureScale(shader->shaderType, entry.texUnit);
 				memcpy(entry.currentValue, xyScale, sizeof(float) * 2);
-				memcpy(GET_UNIFORM_DATA_PTR(entry.uniformLocation), xyScale, sizeof(float) * 2);
+				updateUniformData(entry.uniformLocation, xyScale, sizeof(float) * 2);
 			}
 		}
 		if (shader->uniform.loc_alphaTestRef >= 0)
 		{
-			*GET_UNIFORM_DATA_PTR(shader->uniform.loc_alphaTestRef) = LatteGPUState.contextNew.SX_ALPHA_REF.get_ALPHA_TEST_REF();
+			float alphaTestRef = LatteGPUState.contextNew.SX_ALPHA_REF.get_ALPHA_TEST_REF();
+			updateUniformData(shader->uniform.loc_alphaTestRef, &alphaTestRef, sizeof(float));
 		}
 		if (shader->uniform.loc_pointSize >= 0)
 		{
@@ -415,41 +485,57 @@ void VulkanRenderer::uniformData_updateUniformVars(uint32 shaderStageIndex, Latt
 			float pointWidth = (float)pointSizeReg.get_WIDTH() / 8.0f;
 			if (pointWidth == 0.0f)
 				pointWidth = 1.0f / 8.0f; // minimum size
-			*GET_UNIFORM_DATA_PTR(shader->uniform.loc_pointSize) = pointWidth;
+			updateUniformData(shader->uniform.loc_pointSize, &pointWidth, sizeof(float));
 		}
 		if (shader->uniform.loc_remapped >= 0)
 		{
-			LatteBufferCache_LoadRemappedUniforms(shader, GET_UNIFORM_DATA_PTR(shader->uniform.loc_remapped));
+			LatteBufferCache_LoadRemappedUniforms(shader, s_vkUniformData);
+			updateUniformData(shader->uniform.loc_remapped, s_vkUniformData, shader->list_remappedUniformEntries.size() * 16);
 		}
 		if (shader->uniform.loc_uniformRegister >= 0)
 		{
-			uint32* uniformRegData = (uint32*)(LatteGPUState.contextRegister + mmSQ_ALU_CONSTANT0_0 + shaderAluConst);
-			memcpy(GET_UNIFORM_DATA_PTR(shader->uniform.loc_uniformRegister), uniformRegData, shader->uniform.count_uniformRegister * 16);
+			// uniform registers are only compared if the command processor wrote to them since the last upload
+			if (shaderChanged || cache.aluConstWriteCounter != aluConstWriteCounter)
+			{
+				uint32* uniformRegData = (uint32*)(LatteGPUState.contextRegister + mmSQ_ALU_CONSTANT0_0 + shaderAluConst);
+				updateUniformData(shader->uniform.loc_uniformRegister, uniformRegData, shader->uniform.count_uniformRegister * 16);
+			}
 		}
+		cache.aluConstWriteCounter = aluConstWriteCounter;
 		if (shader->uniform.loc_windowSpaceToClipSpaceTransform >= 0)
 		{
 			sint32 viewportWidth;
 			sint32 viewportHeight;
 			LatteRenderTarget_GetCurrentVirtualViewportSize(&viewportWidth, &viewportHeight); // always call after _updateViewport()
-			float* v = GET_UNIFORM_DATA_PTR(shader->uniform.loc_windowSpaceToClipSpaceTransform);
+			float v[2];
 			v[0] = 2.0f / (float)viewportWidth;
 			v[1] = 2.0f / (float)viewportHeight;
+			updateUniformData(shader->uniform.loc_windowSpaceToClipSpaceTransform, v, sizeof(v));
 		}
 		if (shader->uniform.loc_fragCoordScale >= 0)
 		{
-			LatteMRT::GetCurrentFragCoordScale(GET_UNIFORM_DATA_PTR(shader->uniform.loc_fragCoordScale));
+			float coordScale[4];
+			LatteMRT::GetCurrentFragCoordScale(coordScale);
+			updateUniformData(shader->uniform.loc_fragCoordScale, coordScale, sizeof(coordScale));
 		}
 		if (shader->uniform.loc_verticesPerInstance >= 0)
 		{
-			*(int*)GET_UNIFORM_DATA_PTR(shader->uniform.loc_verticesPerInstance) = m_streamoutState.verticesPerInstance;
+			updateUniformData(shader->uniform.loc_verticesPerInstance, &m_streamoutState.verticesPerInstance, sizeof(sint32));
 			for (sint32 b = 0; b < LATTE_NUM_STREAMOUT_BUFFER; b++)
 			{
 				if (shader->uniform.loc_streamoutBufferBase[b] >= 0)
 				{
-					*(uint32*)GET_UNIFORM_DATA_PTR(shader->uniform.loc_streamoutBufferBase[b]) = m_streamoutState.buffer[b].ringBufferOffset;
+					uint32 bufferBase = m_streamoutState.buffer[b].ringBufferOffset;
+					updateUniformData(shader->uniform.loc_streamoutBufferBase[b], &bufferBase, sizeof(uint32));
 				}
 			}
 		}
+		if (!isDirty && cache.commandBufferId == GetCurrentCommandBufferId())
+		{
+			dynamicOffsetInfo.uniformVarBufferOffset[shaderStageIndex] = cache.bufferOffset;
+			performanceMonitor.vk.numUniformUploadsSkippedPerFrame.increment();
+			return;
+		}
 		// upload
 		const uint32 bufferAlignmentM1 = std::max(m_featureControl.limits.minUniformBufferOffsetAlignment, m_featureControl.limits.nonCoherentAtomSize) - 1;
 		const uint32 uniformSize = (shader->uniform.uniformRangeSize + bufferAlignmentM1) & ~bufferAlignmentM1;
@@ -496,10 +582,13 @@ void VulkanRenderer::uniformData_updateUniformVars(uint32 shaderStageIndex, Latt
 		});
 
 		const uint32 uniformOffset = m_uniformVarBufferWriteIndex;
-		memcpy(m_uniformVarBufferPtr + uniformOffset, s_vkUniformData, shader->uniform.uniformRangeSize);
+		memcpy(m_uniformVarBufferPtr + uniformOffset, uniformData, shader->uniform.uniformRangeSize);
 		m_uniformVarBufferWriteIndex += uniformSize;
 		// update dynamic offset
 		dynamicOffsetInfo.uniformVarBufferOffset[shaderStageIndex] = uniformOffset;
+		cache.bufferOffset = uniformOffset;
+		cache.commandBufferId = GetCurrentCommandBufferId();
+		performanceMonitor.vk.numUniformUploadsPerFrame.increment();
 		// flush if not coherent
 		if (!m_uniformVarBufferMemoryIsCoherent)
 		{
@@ -600,7 +689,10 @@ VkDescriptorSetInfo* VulkanRenderer::draw_getOrCreateDescriptorSet(PipelineInfo*
 	{
 		const auto it = pipeline_info->vertex_ds_cache.find(stateHash);
 		if (it != pipeline_info->vertex_ds_cache.cend())
+		{
+			performanceMonitor.vk.numDescriptorSetsReusedPerFrame.increment();
 			return it->second;
+		}
 		descriptor_set_layout = pipeline_info->m_vkrObjPipeline->vertexDSL;
 		break;
 	}
@@ -608,7 +700,10 @@ VkDescriptorSetInfo* VulkanRenderer::draw_getOrCreateDescriptorSet(PipelineInfo*
 	{
 		const auto it = pipeline_info->pixel_ds_cache.find(stateHash);
 		if (it != pipeline_info->pixel_ds_cache.cend())
+		{
+			performanceMonitor.vk.numDescriptorSetsReusedPerFrame.increment();
 			return it->second;
+		}
 		descriptor_set_layout = pipeline_info->m_vkrObjPipeline->pixelDSL;
 		break;
 	}
@@ -616,7 +711,10 @@ VkDescriptorSetInfo* VulkanRenderer::draw_getOrCreateDescriptorSet(PipelineInfo*
 	{
 		const auto it = pipeline_info->geometry_ds_cache.find(stateHash);
 		if (it != pipeline_info->geometry_ds_cache.cend())
+		{
+			performanceMonitor.vk.numDescriptorSetsReusedPerFrame.increment();
 			return it->second;
+		}
 		descriptor_set_layout = pipeline_info->m_vkrObjPipeline->geometryDSL;
 		break;
 	}
@@ -1399,12 +1497,19 @@ void VulkanRenderer::draw_execute(uint32 baseVertex, uint32 baseInstance, uint32
 	LatteDecompilerShader* pixelShader = LatteSHRC_GetActivePixelShader();
 	LatteDecompilerShader* geometryShader = LatteSHRC_GetActiveGeometryShader();
 
-	if (vertexShader)
-		uniformData_updateUniformVars(VulkanRendererConst::SHADER_STAGE_INDEX_VERTEX, vertexShader);
-	if (pixelShader)
-		uniformData_updateUniformVars(VulkanRendererConst::SHADER_STAGE_INDEX_FRAGMENT, pixelShader);
-	if (geometryShader)
-		uniformData_updateUniformVars(VulkanRendererConst::SHADER_STAGE_INDEX_GEOMETRY, geometryShader);
+	// reused uploads are only valid within the command buffer they were made in
+	// if waiting for ring buffer space submitted the current command buffer then all stages are uploaded again
+	uint64 uniformCmdBufferId;
+	do
+	{
+		uniformCmdBufferId = GetCurrentCommandBufferId();
+		if (vertexShader)
+			uniformData_updateUniformVars(VulkanRendererConst::SHADER_STAGE_INDEX_VERTEX, vertexShader);
+		if (pixelShader)
+			uniformData_updateUniformVars(VulkanRendererConst::SHADER_STAGE_INDEX_FRAGMENT, pixelShader);
+		if (geometryShader)
+			uniformData_updateUniformVars(VulkanRendererConst::SHADER_STAGE_INDEX_GEOMETRY, geometryShader);
+	} while (uniformCmdBufferId != GetCurrentCommandBufferId());
 	// store where the read pointer should go after command buffer execution
 	m_cmdBufferUniformRingbufIndices[m_commandBufferIndex] = m_uniformVarBufferWriteIndex;
 
@@ -1463,6 +1568,7 @@ void VulkanRenderer::draw_execute(uint32 baseVertex, uint32 baseInstance, uint32
 
 	PipelineInfo* pipeline_info;
 
+	draw_updatePipelineStateHashes();
 	if (!isFirst)
 	{
 		if (m_state.activePipelineInfo->minimalStateHash != draw_calculateMinimalGraphicsPipelineHash(vertexShader->compatibleFetchShader, LatteGPUState.contextNew))
@@ -19,6 +19,10 @@ public:
 		return m_buffer_ptr + m_buffer_offset;
 	}
 
+	void ReleaseData() override;
+
+	bool SupportsAsyncWrite() override { return true; }
+
 	uint32 GetImageSize() const
 	{
 		return m_image_size;
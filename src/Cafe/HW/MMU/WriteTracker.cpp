@@ -0,0 +1,381 @@
+#include "Cafe/HW/MMU/MMU.h"
+#include "Cafe/HW/MMU/WriteTracker.h"
+#include "util/MemMapper/MemMapper.h"
+#include "util/helpers/fspinlock.h"
+
+#define WT_HOT_STREAK_THRESHOLD	(8)		// pages which fault on this many consecutive frames are considered hot
+#define WT_HOT_DURATION			(64)	// number of frames a hot page stays unprotected
+
+namespace WriteTracker
+{
+	enum class PAGE_STATE : uint8
+	{
+		UNTRACKED = 0,
+		PROTECTED = 1, // write protected, no writes since the protection was armed
+		WRITTEN = 2, // protection was removed by a write fault
+		HOT = 3, // written too frequently, left unprotected until hotUntilEpoch
+	};
+
+	struct PageInfo
+	{
+		uint64 stamp; // value of s_stampCounter when the page was last written (or when tracking started)
+		uint32 lastFaultEpoch;
+		uint32 hotUntilEpoch;
+		uint16 refCount;
+		uint16 hostWriteCount; // number of host writes in progress, the page is not protected while this is non-zero
+		PAGE_STATE state;
+		uint8 faultStreak;
+	};
+
+	static bool s_isEnabled{false};
+	static PageInfo* s_pageTable{nullptr};
+	static size_t s_pageTableSize{0};
+	static uint32 s_pageShift{12};
+	static uint32 s_pageSize{0x1000};
+	static FSpinlock s_lock;
+	static std::atomic<uint64> s_stampCounter{1};
+	static std::atomic<uint32> s_epoch{1};
+
+	static uint64 _NextStamp()
+	{
+		return s_stampCounter.fetch_add(1, std::memory_order_acq_rel) + 1;
+	}
+
+	static PAGE_STATE _GetState(const PageInfo& page)
+	{
+		return std::atomic_ref<const PAGE_STATE>(page.state).load(std::memory_order_acquire);
+	}
+
+	static void _SetState(PageInfo& page, PAGE_STATE state)
+	{
+		std::atomic_ref<PAGE_STATE>(page.state).store(state, std::memory_order_release);
+	}
+
+	static uint64 _GetStamp(const PageInfo& page)
+	{
+		return std::atomic_ref<const uint64>(page.stamp).load(std::memory_order_acquire);
+	}
+
+	static void _SetStamp(PageInfo& page, uint64 stamp)
+	{
+		std::atomic_ref<uint64>(page.stamp).store(stamp, std::memory_order_release);
+	}
+
+	static void _SetProtection(uint32 firstPage, uint32 pageCount, bool writeProtected)
+	{
+		void* ptr = memory_base + ((size_t)firstPage << s_pageShift);
+		size_t size = (size_t)pageCount << s_pageShift;
+		if (!MemMapper::SetPageProtection(ptr, size, writeProtected ? MemMapper::PAGE_PERMISSION::P_READ : MemMapper::PAGE_PERMISSION::P_RW))
+			cemuLog_log(LogType::Force, "WriteTracker: Failed to change protection of 0x{:08x}-0x{:08x}", (uint32)((size_t)firstPage << s_pageShift), (uint32)(((size_t)firstPage + pageCount) << s_pageShift));
+	}
+
+	// collects consecutive pages which need a protection change so they can be updated with a single call
+	class ProtectionBatch
+	{
+	public:
+		ProtectionBatch(bool writeProtected) : m_writeProtected(writeProtected) {}
+		~ProtectionBatch() { Flush(); }
+
+		void Add(uint32 pageIndex)
+		{
+			if (m_count != 0 && pageIndex == m_first + m_count)
+			{
+				m_count++;
+				return;
+			}
+			Flush();
+			m_first = pageIndex;
+			m_count = 1;
+		}
+
+		void Flush()
+		{
+			if (m_count == 0)
+				return;
+			_SetProtection(m_first, m_count, m_writeProtected);
+			m_count = 0;
+		}
+
+	private:
+		bool m_writeProtected;
+		uint32 m_first{0};
+		uint32 m_count{0};
+	};
+
+	static void _GetPageRange(MPTR physAddr, uint32 size, uint32& firstPage, uint32& endPage)
+	{
+		firstPage = physAddr >> s_pageShift;
+		endPage = (uint32)(((uint64)physAddr + size + s_pageSize - 1) >> s_pageShift);
+	}
+
+	void Enable()
+	{
+		if (s_isEnabled)
+			return;
+		size_t pageSize = MemMapper::GetPageSize();
+		cemu_assert_debug(std::has_single_bit(pageSize));
+		s_pageSize = (uint32)pageSize;
+		s_pageShift = std::countr_zero(pageSize);
+		s_pageTableSize = ((0x100000000ull >> s_pageShift) * sizeof(PageInfo) + pageSize - 1) & ~(pageSize - 1);
+		// pages of the table are only committed once touched
+		s_pageTable = (PageInfo*)MemMapper::AllocateMemory(nullptr, s_pageTableSize, MemMapper::PAGE_PERMISSION::P_RW);
+		if (!s_pageTable)
+		{
+			cemuLog_log(LogType::Force, "WriteTracker: Failed to allocate page table");
+			return;
+		}
+		s_isEnabled = true;
+	}
+
+	void Disable()
+	{
+		if (!s_isEnabled)
+			return;
+		std::unique_lock _l(s_lock);
+		// drop protection of any remaining pages
+		ProtectionBatch batch(false);
+		for (uint32 i = 0; i < (uint32)(0x100000000ull >> s_pageShift); i++)
+		{
+			PAGE_STATE state = _GetState(s_pageTable[i]);
+			if (state == PAGE_STATE::PROTECTED)
+				batch.Add(i);
+		}
+		batch.Flush();
+		s_isEnabled = false;
+		MemMapper::FreeMemory(s_pageTable, s_pageTableSize);
+		s_pageTable = nullptr;
+	}
+
+	bool IsEnabled()
+	{
+		return s_isEnabled;
+	}
+
+	void RegisterRange(MPTR physAddr, uint32 size)
+	{
+		if (!s_isEnabled || size == 0)
+			return;
+		uint32 firstPage, endPage;
+		_GetPageRange(physAddr, size, firstPage, endPage);
+		// only track memory which is mapped for its entire page range, other ranges are always reported as modified
+		if (!memory_isAddressRangeAccessible(memory_physicalToVirtual(firstPage << s_pageShift), (endPage - firstPage) << s_pageShift))
+			return;
+		std::unique_lock _l(s_lock);
+		ProtectionBatch batch(true);
+		for (uint32 i = firstPage; i < endPage; i++)
+		{
+			PageInfo& page = s_pageTable[i];
+			if (page.refCount == 0xFFFF)
+			{
+				cemu_assert_debug(false);
+				continue;
+			}
+			page.refCount++;
+			if (page.refCount != 1)
+				continue;
+			_SetStamp(page, _NextStamp());
+			page.faultStreak = 0;
+			page.lastFaultEpoch = 0;
+			if (page.hostWriteCount != 0)
+			{
+				// a host write is in progress, protection is armed by the first BeginSync() after it finished
+				_SetState(page, PAGE_STATE::WRITTEN);
+				continue;
+			}
+			batch.Add(i);
+			_SetState(page, PAGE_STATE::PROTECTED);
+		}
+	}
+
+	void UnregisterRange(MPTR physAddr, uint32 size)
+	{
+		if (!s_isEnabled || size == 0)
+			return;
+		uint32 firstPage, endPage;
+		_GetPageRange(physAddr, size, firstPage, endPage);
+		if (!memory_isAddressRangeAccessible(memory_physicalToVirtual(firstPage << s_pageShift), (endPage - firstPage) << s_pageShift))
+			return;
+		std::unique_lock _l(s_lock);
+		ProtectionBatch batch(false);
+		for (uint32 i = firstPage; i < endPage; i++)
+		{
+			PageInfo& page = s_pageTable[i];
+			if (page.refCount == 0)
+			{
+				cemu_assert_debug(false);
+				continue;
+			}
+			page.refCount--;
+			if (page.refCount != 0)
+				continue;
+			if (_GetState(page) == PAGE_STATE::PROTECTED)
+				batch.Add(i);
+			_SetState(page, PAGE_STATE::UNTRACKED);
+		}
+	}
+
+	uint64 BeginSync(MPTR physAddr, uint32 size)
+	{
+		if (!s_isEnabled)
+			return 0;
+		uint32 firstPage, endPage;
+		_GetPageRange(physAddr, size, firstPage, endPage);
+		uint32 epoch = s_epoch.load(std::memory_order_relaxed);
+		std::unique_lock _l(s_lock);
+		// protection must be active before the caller reads the memory, writes which happen afterwards will fault and update the stamp
+		ProtectionBatch batch(true);
+		for (uint32 i = firstPage; i < endPage; i++)
+		{
+			PageInfo& page = s_pageTable[i];
+			if (page.hostWriteCount != 0)
+				continue; // keep unprotected until the host write finished
+			PAGE_STATE state = _GetState(page);
+			if (state == PAGE_STATE::WRITTEN)
+			{
+				if (page.faultStreak >= WT_HOT_STREAK_THRESHOLD)
+				{
+					// written on every frame, stop protecting it for a while
+					page.hotUntilEpoch = epoch + WT_HOT_DURATION;
+					page.faultStreak = 0;
+					_SetState(page, PAGE_STATE::HOT);
+					continue;
+				}
+				batch.Add(i);
+				_SetState(page, PAGE_STATE::PROTECTED);
+			}
+			else if (state == PAGE_STATE::HOT)
+			{
+				if ((sint32)(epoch - page.hotUntilEpoch) < 0)
+					continue;
+				// writes while hot were not tracked
+				_SetStamp(page, _NextStamp());
+				batch.Add(i);
+				_SetState(page, PAGE_STATE::PROTECTED);
+			}
+		}
+		batch.Flush();
+		return _NextStamp();
+	}
+
+	bool WasModified(MPTR physAddr, uint32 size, uint64 syncStamp)
+	{
+		if (!s_isEnabled || syncStamp == 0)
+			return true;
+		uint32 firstPage, endPage;
+		_GetPageRange(physAddr, size, firstPage, endPage);
+		for (uint32 i = firstPage; i < endPage; i++)
+		{
+			const PageInfo& page = s_pageTable[i];
+			PAGE_STATE state = _GetState(page);
+			if (state == PAGE_STATE::UNTRACKED || state == PAGE_STATE::HOT)
+				return true;
+			if (_GetStamp(page) > syncStamp)
+				return true;
+		}
+		return false;
+	}
+
+	bool SyncRange(MPTR physAddr, uint32 size, uint64& syncStamp)
+	{
+		uint64 newStamp = BeginSync(physAddr, size);
+		bool isModified = WasModified(physAddr, size, syncStamp);
+		syncStamp = newStamp;
+		return isModified;
+	}
+
+	void AdvanceEpoch()
+	{
+		s_epoch.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// marks the page as written and removes its write protection. Expects s_lock to be held
+	static void _UnprotectPage(uint32 pageIndex)
+	{
+		PageInfo& page = s_pageTable[pageIndex];
+		uint32 epoch = s_epoch.load(std::memory_order_relaxed);
+		if (page.lastFaultEpoch != epoch)
+		{
+			if (page.lastFaultEpoch + 1 == epoch && page.faultStreak < 0xFF)
+				page.faultStreak++;
+			else if (page.lastFaultEpoch + 1 != epoch)
+				page.faultStreak = 1;
+			page.lastFaultEpoch = epoch;
+		}
+		_SetStamp(page, _NextStamp());
+		_SetProtection(pageIndex, 1, false);
+		_SetState(page, PAGE_STATE::WRITTEN);
+	}
+
+	// returns false if the host memory range is not within guest memory
+	static bool _GetHostWritePageRange(void* hostPtr, size_t size, uint32& firstPage, uint32& endPage)
+	{
+		uint8* ptr = (uint8*)hostPtr;
+		if (ptr < memory_base || ptr >= memory_base + 0x100000000ull)
+			return false;
+		size_t offset = ptr - memory_base;
+		size = std::min<size_t>(size, 0x100000000ull - offset);
+		firstPage = (uint32)(offset >> s_pageShift);
+		endPage = (uint32)((offset + size + s_pageSize - 1) >> s_pageShift);
+		return true;
+	}
+
+	void BeginHostWrite(void* hostPtr, size_t size)
+	{
+		if (!s_isEnabled || size == 0)
+			return;
+		uint32 firstPage, endPage;
+		if (!_GetHostWritePageRange(hostPtr, size, firstPage, endPage))
+			return;
+		std::unique_lock _l(s_lock);
+		for (uint32 i = firstPage; i < endPage; i++)
+		{
+			PageInfo& page = s_pageTable[i];
+			cemu_assert_debug(page.hostWriteCount != 0xFFFF);
+			page.hostWriteCount++;
+			if (_GetState(page) == PAGE_STATE::PROTECTED)
+				_UnprotectPage(i);
+		}
+	}
+
+	void EndHostWrite(void* hostPtr, size_t size)
+	{
+		if (!s_isEnabled || size == 0)
+			return;
+		uint32 firstPage, endPage;
+		if (!_GetHostWritePageRange(hostPtr, size, firstPage, endPage))
+			return;
+		std::unique_lock _l(s_lock);
+		for (uint32 i = firstPage; i < endPage; i++)
+		{
+			PageInfo& page = s_pageTable[i];
+			if (page.hostWriteCount == 0)
+			{
+				cemu_assert_debug(false);
+				continue;
+			}
+			page.hostWriteCount--;
+			// the data changed after the stamp set by BeginHostWrite()
+			if (_GetState(page) != PAGE_STATE::UNTRACKED)
+				_SetStamp(page, _NextStamp());
+		}
+	}
+
+	bool HandleAccessViolation(void* hostAddr)
+	{
+		if (!s_isEnabled)
+			return false;
+		uint8* ptr = (uint8*)hostAddr;
+		if (ptr < memory_base || ptr >= memory_base + 0x100000000ull)
+			return false;
+		uint32 pageIndex = (uint32)((size_t)(ptr - memory_base) >> s_pageShift);
+		std::unique_lock _l(s_lock);
+		PAGE_STATE state = _GetState(s_pageTable[pageIndex]);
+		if (state == PAGE_STATE::PROTECTED)
+		{
+			_UnprotectPage(pageIndex);
+			return true;
+		}
+		// another thread may have removed the protection in the meantime
+		return state == PAGE_STATE::WRITTEN || state == PAGE_STATE::HOT;
+	}
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+/*
+ * Page protection based tracking of CPU writes to guest memory which backs GPU resources (textures, cached buffers)
+ * Registered pages are write-protected. The first write to a page faults, the fault handler flags the page as written and removes the protection
+ * Consumers call BeginSync() to re-arm the protection of their range and then query WasModified() with the stamp from their previous sync
+ * Pages which are written on almost every frame are left unprotected for a while to avoid excessive faults, these always count as modified
+ */
+namespace WriteTracker
+{
+	void Enable();
+	void Disable(); // all registrations must be released before calling this
+	bool IsEnabled();
+
+	void RegisterRange(MPTR physAddr, uint32 size);
+	void UnregisterRange(MPTR physAddr, uint32 size);
+
+	// re-arm write protection for the range and return a new sync stamp
+	uint64 BeginSync(MPTR physAddr, uint32 size);
+	// returns true if the memory at physAddr may have been written after BeginSync() returned syncStamp. Always true if not tracked
+	bool WasModified(MPTR physAddr, uint32 size, uint64 syncStamp);
+	// BeginSync() + WasModified() with the previous stamp, updates syncStamp
+	bool SyncRange(MPTR physAddr, uint32 size, uint64& syncStamp);
+
+	// called once per frame, used to detect frequently written pages
+	void AdvanceEpoch();
+
+	// host code which writes to guest memory through the OS (file reads, sockets) needs to wrap the write in BeginHostWrite() and EndHostWrite()
+	// since the kernel returns an error instead of raising a fault for write-protected buffers
+	// the pages stay unprotected until the matching EndHostWrite(), which also marks them as written
+	void BeginHostWrite(void* hostPtr, size_t size);
+	void EndHostWrite(void* hostPtr, size_t size);
+
+	// called from the platform exception handler on access violations. Returns true if the fault was caused by write tracking and execution can resume
+	bool HandleAccessViolation(void* hostAddr);
+};
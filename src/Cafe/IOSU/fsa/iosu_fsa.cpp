@@ -8,6 +8,7 @@
 #include "Cafe/HW/Latte/Core/LatteBufferCache.h" // also remove this dependency
 
 #include "Cafe/HW/MMU/MMU.h"
+#include "Cafe/HW/MMU/WriteTracker.h"
 
 using namespace iosu::kernel;
 
@@ -469,7 +470,9 @@ namespace iosu
 			if ((flags & FSA_CMD_FLAG_SET_POS) != 0)
 				fsc_setFileSeek(fscFile, filePos);
 			// todo: File permissions
+			WriteTracker::BeginHostWrite(destPtr, bytesToRead);
 			uint32 bytesSuccessfullyRead = fsc_readFile(fscFile, destPtr, bytesToRead);
+			WriteTracker::EndHostWrite(destPtr, bytesToRead);
 			if (transferElementSize == 0)
 				return FSA_RESULT::OK;
 
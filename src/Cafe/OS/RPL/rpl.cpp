@@ -12,6 +12,8 @@
 #include <zlib.h>
 
 #include "util/crypto/crc32.h"
+#include "util/helpers/helpers.h"
+#include "util/highresolutiontimer/HighResolutionTimer.h"
 #include "config/ActiveSettings.h"
 #include "Cafe/OS/libs/coreinit/coreinit_DynLoad.h"
 #include "gui/guiWrapper.h"
@@ -324,6 +326,109 @@ public:
 	std::vector<uint8> sectionData;
 };
 
+// inflate a zlib stream of known uncompressed size. Does not touch any loader state so it can be called from worker threads
+bool _RPLLoader_InflateData(const uint8* compressedData, uint32 compressedSize, uint8* uncompressedData, uint32 uncompressedSize)
+{
+	z_stream strm;
+	strm.zalloc = Z_NULL;
+	strm.zfree = Z_NULL;
+	strm.opaque = Z_NULL;
+	if (inflateInit(&strm) != Z_OK)
+		return false;
+	strm.avail_in = compressedSize;
+	strm.next_in = (Bytef*)compressedData;
+	strm.avail_out = uncompressedSize;
+	strm.next_out = uncompressedData;
+	int ret = inflate(&strm, Z_FULL_FLUSH);
+	inflateEnd(&strm);
+	return (ret == Z_OK || ret == Z_STREAM_END) && strm.avail_in == 0 && strm.avail_out == 0;
+}
+
+// worker threads for _RPLLoader_ParallelFor. They are started on first use and kept for the rest of the session
+static struct
+{
+	std::mutex parallelForMutex; // held for the whole duration of a parallel loop
+	std::mutex mutex;
+	std::condition_variable workAvailable;
+	std::condition_variable workDone;
+	bool isInitialized{};
+	uint32 numWorkers{};
+	// current loop
+	const std::function<void(size_t)>* job{};
+	size_t jobCount{};
+	std::atomic<size_t> nextJobIndex{};
+	uint32 loopIndex{}; // incremented for every loop, workers wait for it to change
+	bool isLoopActive{}; // workers can only join the current loop while set
+	uint32 numBusyWorkers{};
+}s_rplWorkerPool;
+
+static void _RPLLoader_RunParallelJobs()
+{
+	while (true)
+	{
+		size_t jobIndex = s_rplWorkerPool.nextJobIndex.fetch_add(1);
+		if (jobIndex >= s_rplWorkerPool.jobCount)
+			break;
+		(*s_rplWorkerPool.job)(jobIndex);
+	}
+}
+
+static void _RPLLoader_WorkerThread()
+{
+	SetThreadName("RPLLoaderWorker");
+	std::unique_lock _l(s_rplWorkerPool.mutex);
+	uint32 lastLoopIndex = s_rplWorkerPool.loopIndex;
+	while (true)
+	{
+		s_rplWorkerPool.workAvailable.wait(_l, [&] { return s_rplWorkerPool.loopIndex != lastLoopIndex; });
+		lastLoopIndex = s_rplWorkerPool.loopIndex;
+		if (!s_rplWorkerPool.isLoopActive)
+			continue; // woke up too late, all jobs have been taken already
+		s_rplWorkerPool.numBusyWorkers++;
+		_l.unlock();
+		_RPLLoader_RunParallelJobs();
+		_l.lock();
+		s_rplWorkerPool.numBusyWorkers--;
+		if (s_rplWorkerPool.numBusyWorkers == 0)
+			s_rplWorkerPool.workDone.notify_all();
+	}
+}
+
+// runs job(0) ... job(jobCount-1) on the worker threads and the calling thread and waits for all of them to finish
+void _RPLLoader_ParallelFor(size_t jobCount, const std::function<void(size_t)>& job)
+{
+	std::unique_lock _lLoop(s_rplWorkerPool.parallelForMutex);
+	if (!s_rplWorkerPool.isInitialized)
+	{
+		s_rplWorkerPool.isInitialized = true;
+		s_rplWorkerPool.numWorkers = std::min<uint32>(std::thread::hardware_concurrency(), 8);
+		if (s_rplWorkerPool.numWorkers > 0)
+			s_rplWorkerPool.numWorkers--; // the calling thread also runs jobs
+		for (uint32 i = 0; i < s_rplWorkerPool.numWorkers; i++)
+			std::thread(_RPLLoader_WorkerThread).detach();
+	}
+	if (jobCount <= 1 || s_rplWorkerPool.numWorkers == 0)
+	{
+		for (size_t i = 0; i < jobCount; i++)
+			job(i);
+		return;
+	}
+	std::unique_lock _l(s_rplWorkerPool.mutex);
+	s_rplWorkerPool.job = &job;
+	s_rplWorkerPool.jobCount = jobCount;
+	s_rplWorkerPool.nextJobIndex = 0;
+	s_rplWorkerPool.loopIndex++;
+	s_rplWorkerPool.isLoopActive = true;
+	_l.unlock();
+	s_rplWorkerPool.workAvailable.notify_all();
+	_RPLLoader_RunParallelJobs();
+	// all jobs have been started, wait for the workers which are still running one
+	_l.lock();
+	s_rplWorkerPool.isLoopActive = false;
+	s_rplWorkerPool.workDone.wait(_l, [] { return s_rplWorkerPool.numBusyWorkers == 0; });
+	s_rplWorkerPool.job = nullptr;
+}
+
 rplSectionEntryNew_t* RPLLoader_GetSection(RPLModule* rplLoaderContext, sint32 sectionIndex)
 {
 	sint32 sectionCount = rplLoaderContext->rplHeader.sectionTableEntryCount;
@@ -381,28 +486,13 @@ RPLUncompressedSection* RPLLoader_LoadUncompressedSection(RPLModule* rplLoaderCo
 			delete uSection;
 			return nullptr;
 		}
-		int ret;
-		z_stream strm;
-		strm.zalloc = Z_NULL;
-		strm.zfree = Z_NULL;
-		strm.opaque = Z_NULL;
-		ret = inflateInit(&strm);
-		if (ret == Z_OK)
+		uSection->sectionData.resize(uncompressedSize);
+		if (!_RPLLoader_InflateData(rplLoaderContext->RPLRawData.data() + (uint32)section->fileOffset + 4, (uint32)section->sectionSize - 4, uSection->sectionData.data(), uncompressedSize))
 		{
-			strm.avail_in = (uint32)section->sectionSize - 4;
-			strm.next_in = rplLoaderContext->RPLRawData.data() + (uint32)section->fileOffset + 4;
-			strm.avail_out = uncompressedSize;
-			uSection->sectionData.resize(uncompressedSize);
-			strm.next_out = uSection->sectionData.data();
-			ret = inflate(&strm, Z_FULL_FLUSH);
-			inflateEnd(&strm);
-			if ((ret != Z_OK && ret != Z_STREAM_END) || strm.avail_in != 0 || strm.avail_out != 0)
-			{
-				cemuLog_log(LogType::Force, "RPLLoader: Error while inflating data for section {}", sectionIndex);
-				rplLoaderContext->hasError = true;
-				delete uSection;
-				return nullptr;
-			}
+			cemuLog_log(LogType::Force, "RPLLoader: Error while inflating data for section {}", sectionIndex);
+			rplLoaderContext->hasError = true;
+			delete uSection;
+			return nullptr;
 		}
 	}
 	else
@@ -415,11 +505,15 @@ RPLUncompressedSection* RPLLoader_LoadUncompressedSection(RPLModule* rplLoaderCo
 	return uSection;
 }
 
-bool RPLLoader_LoadSingleSection(RPLModule* rplLoaderContext, sint32 sectionIndex, RPLMappingRegion* regionMappingInfo, MPTR mappedAddress)
+// if uncompressedSection is set it is used instead of extracting the section again. Ownership is passed to this function
+bool RPLLoader_LoadSingleSection(RPLModule* rplLoaderContext, sint32 sectionIndex, RPLMappingRegion* regionMappingInfo, MPTR mappedAddress, RPLUncompressedSection* uncompressedSection = nullptr)
 {
 	rplSectionEntryNew_t* section = RPLLoader_GetSection(rplLoaderContext, sectionIndex);
 	if (section == nullptr)
+	{
+		delete uncompressedSection;
 		return false;
+	}
 
 	uint32 mappingOffset = (uint32)section->virtualAddress - (uint32)regionMappingInfo->baseAddress;
 	if (mappingOffset >= 0x10000000)
@@ -432,7 +526,8 @@ bool RPLLoader_LoadSingleSection(RPLModule* rplLoaderContext, sint32 sectionInde
 	rplLoaderContext->debugSectionLoadMask[sectionIndex] = true;
 
 	// extract section
-	RPLUncompressedSection* uncompressedSection = RPLLoader_LoadUncompressedSection(rplLoaderContext, sectionIndex);
+	if (!uncompressedSection)
+		uncompressedSection = RPLLoader_LoadUncompressedSection(rplLoaderContext, sectionIndex);
 	if (uncompressedSection == nullptr)
 	{
 		rplLoaderContext->hasError = true;
@@ -454,6 +549,127 @@ bool RPLLoader_LoadSingleSection(RPLModule* rplLoaderContext, sint32 sectionInde
 	delete uncompressedSection;
 	return true;
 }
+void _buildExportIndex(std::unordered_map<std::string_view, uint32>& exportIndex, rplExportTableEntry_t* exportDataPtr, uint32 exportCount)
+{
+	exportIndex.clear();
+	if (!exportDataPtr)
+		return;
+	exportIndex.reserve(exportCount);
+	char* exportNameData = (char*)((uint8*)exportDataPtr - 8);
+	for (uint32 f = 0; f < exportCount; f++)
+	{
+		char* name = exportNameData + (uint32)exportDataPtr[f].nameOffset;
+		exportIndex.emplace(name, f); // on duplicate names the first entry wins, same as a linear search
+	}
+}
+
+// index the export tables by name so that imports resolve without scanning them
+void RPLLoader_BuildExportIndex(RPLModule* rplLoaderContext)
+{
+	_buildExportIndex(rplLoaderContext->exportFIndex, rplLoaderContext->exportFDataPtr, rplLoaderContext->exportFCount);
+	_buildExportIndex(rplLoaderContext->exportDIndex, rplLoaderContext->exportDDataPtr, rplLoaderContext->exportDCount);
+}
+
+// returns false if the module has no export with the given name
+bool RPLLoader_LookupExport(RPLModule* rplLoaderContext, bool isData, const char* exportName, uint32& exportAddressOut)
+{
+	auto& exportIndex = isData ? rplLoaderContext->exportDIndex : rplLoaderContext->exportFIndex;
+	auto it = exportIndex.find(exportName);
+	if (it == exportIndex.end())
+		return false;
+	rplExportTableEntry_t* exportDataPtr = isData ? rplLoaderContext->exportDDataPtr : rplLoaderContext->exportFDataPtr;
+	exportAddressOut = exportDataPtr[it->second].virtualOffset;
+	return true;
+}
+
+// inflate all compressed sections which get mapped into the data, loaderinfo or text region
+// sections which fail any check are left as nullptr so that RPLLoader_LoadUncompressedSection reports the error later
+std::vector<RPLUncompressedSection*> RPLLoader_InflateSectionsParallel(RPLModule* rplLoaderContext)
+{
+	sint32 sectionCount = rplLoaderContext->rplHeader.sectionTableEntryCount;
+	std::vector<RPLUncompressedSection*> inflatedSections(sectionCount, nullptr);
+	std::vector<sint32> compressedSectionIndices;
+	for (sint32 i = 0; i < sectionCount; i++)
+	{
+		rplSectionEntryNew_t* section = rplLoaderContext->sectionTablePtr + i;
+		uint32 sectionType = section->type;
+		uint32 sectionFlags = section->flags;
+		if (section->sectionSize < 4 || sectionType == 0x8)
+			continue;
+		if (sectionType == SHT_RPL_CRCS || sectionType == SHT_RPL_FILEINFO)
+			continue;
+		if ((sectionFlags & 2) == 0 || (sectionFlags & SHF_RPL_COMPRESSED) == 0)
+			continue;
+		if (rplLoaderContext->sectionAddressTable2[i].ptr != nullptr)
+			continue;
+		if (!RPLLoader_CheckBounds(rplLoaderContext, section->fileOffset, section->sectionSize))
+			continue;
+		compressedSectionIndices.emplace_back(i);
+	}
+	_RPLLoader_ParallelFor(compressedSectionIndices.size(), [&](size_t jobIndex)
+	{
+		sint32 sectionIndex = compressedSectionIndices[jobIndex];
+		rplSectionEntryNew_t* section = rplLoaderContext->sectionTablePtr + sectionIndex;
+		const uint8* compressedData = rplLoaderContext->RPLRawData.data() + (uint32)section->fileOffset;
+		uint32 uncompressedSize = *(uint32be*)compressedData;
+		if (uncompressedSize >= 1*1024*1024*1024)
+			return;
+		RPLUncompressedSection* uSection = new RPLUncompressedSection();
+		uSection->sectionData.resize(uncompressedSize);
+		if (!_RPLLoader_InflateData(compressedData + 4, (uint32)section->sectionSize - 4, uSection->sectionData.data(), uncompressedSize))
+		{
+			delete uSection;
+			return;
+		}
+		inflatedSections[sectionIndex] = uSection;
+	});
+	return inflatedSections;
+}
+
+// inflate all compressed SHT_RELA sections into sectionData_inflatedRelocs. Must be called after the temp region has been mapped
+bool RPLLoader_InflateRelocSections(RPLModule* rplLoaderContext)
+{
+	sint32 sectionCount = rplLoaderContext->rplHeader.sectionTableEntryCount;
+	rplLoaderContext->sectionData_inflatedRelocs.clear();
+	rplLoaderContext->sectionData_inflatedRelocs.resize(sectionCount);
+	std::vector<sint32> compressedRelocSectionIndices;
+	for (sint32 i = 0; i < sectionCount; i++)
+	{
+		rplSectionEntryNew_t* section = rplLoaderContext->sectionTablePtr + i;
+		if ((uint32)section->type != SHT_RELA || ((uint32)section->flags & SHF_RPL_COMPRESSED) == 0)
+			continue;
+		if (rplLoaderContext->sectionAddressTable2[i].ptr == nullptr || (uint32)section->sectionSize < 4)
+		{
+			cemuLog_log(LogType::Force, "RPLLoader: Compressed relocation section {} is invalid", i);
+			return false;
+		}
+		uint32 uncompressedSize = *(uint32be*)rplLoaderContext->sectionAddressTable2[i].ptr;
+		if (uncompressedSize >= 1*1024*1024*1024) // sections bigger than 1GB not allowed
+		{
+			cemuLog_log(LogType::Force, "RPLLoader: Uncompressed data of section {} is too large", i);
+			return false;
+		}
+		rplLoaderContext->sectionData_inflatedRelocs[i].resize(uncompressedSize);
+		compressedRelocSectionIndices.emplace_back(i);
+	}
+	std::vector<uint8> inflateSuccess(compressedRelocSectionIndices.size(), 0);
+	_RPLLoader_ParallelFor(compressedRelocSectionIndices.size(), [&](size_t jobIndex)
+	{
+		sint32 sectionIndex = compressedRelocSectionIndices[jobIndex];
+		rplSectionEntryNew_t* section = rplLoaderContext->sectionTablePtr + sectionIndex;
+		const uint8* relocRawData = (const uint8*)rplLoaderContext->sectionAddressTable2[sectionIndex].ptr;
+		std::vector<uint8>& relocData = rplLoaderContext->sectionData_inflatedRelocs[sectionIndex];
+		inflateSuccess[jobIndex] = _RPLLoader_InflateData(relocRawData + 4, (uint32)section->sectionSize - 4, relocData.data(), (uint32)relocData.size()) ? 1 : 0;
+	});
+	for (size_t i = 0; i < compressedRelocSectionIndices.size(); i++)
+	{
+		if (inflateSuccess[i])
+			continue;
+		cemuLog_log(LogType::Force, "RPLLoader: Error while inflating data for section {}", compressedRelocSectionIndices[i]);
+		return false;
+	}
+	return true;
+}
 
 bool RPLLoader_LoadSections(sint32 aProcId, RPLModule* rplLoaderContext)
 {
@@ -535,6 +751,9 @@ bool RPLLoader_LoadSections(sint32 aProcId, RPLModule* rplLoaderContext)
 	rplLoaderContext->regionSize_loaderInfo = regionLoaderinfoSize;
 	rplLoaderContext->regionSize_text = regionTextSize;
 
+	// inflate compressed sections on worker threads. Mapping them into memory below stays sequential so the layout does not change
+	std::vector<RPLUncompressedSection*> inflatedSections = RPLLoader_InflateSectionsParallel(rplLoaderContext);
+
 	// load data sections
 	for (sint32 i = 0; i < (sint32)rplLoaderContext->rplHeader.sectionTableEntryCount; i++)
 	{
@@ -550,7 +769,7 @@ bool RPLLoader_LoadSections(sint32 aProcId, RPLModule* rplLoaderContext)
 		if ((sectionFlags & 1) == 0)
 			continue;
 
-		RPLLoader_LoadSingleSection(rplLoaderContext, i, regionMappingTable.region + RPL_MAPPING_REGION_DATA, rplLoaderContext->regionMappingBase_data);
+		RPLLoader_LoadSingleSection(rplLoaderContext, i, regionMappingTable.region + RPL_MAPPING_REGION_DATA, rplLoaderContext->regionMappingBase_data, std::exchange(inflatedSections[i], nullptr));
 	}
 	// load loaderinfo sections
 	for (sint32 i = 0; i < (sint32)rplLoaderContext->rplHeader.sectionTableEntryCount; i++)
@@ -568,7 +787,7 @@ bool RPLLoader_LoadSections(sint32 aProcId, RPLModule* rplLoaderContext)
 			continue;
 		bool readRaw = false;
 
-		RPLLoader_LoadSingleSection(rplLoaderContext, i, regionMappingTable.region + RPL_MAPPING_REGION_LOADERINFO, rplLoaderContext->regionMappingBase_loaderInfo);
+		RPLLoader_LoadSingleSection(rplLoaderContext, i, regionMappingTable.region + RPL_MAPPING_REGION_LOADERINFO, rplLoaderContext->regionMappingBase_loaderInfo, std::exchange(inflatedSections[i], nullptr));
 
 		if (sectionType == SHT_RPL_EXPORTS)
 		{
@@ -585,6 +804,7 @@ bool RPLLoader_LoadSections(sint32 aProcId, RPLModule* rplLoaderContext)
 			}
 		}
 	}
+	RPLLoader_BuildExportIndex(rplLoaderContext);
 	// load text sections
 	uint32 textSectionMappedBase = rplLoaderContext->regionMappingBase_text.GetMPTR() + (uint32)rplLoaderContext->fileInfo.trampolineAdjustment; // leave some space for trampolines before the code section begins
 	for (sint32 i = 0; i < (sint32)rplLoaderContext->rplHeader.sectionTableEntryCount; i++)
@@ -609,8 +829,11 @@ bool RPLLoader_LoadSections(sint32 aProcId, RPLModule* rplLoaderContext)
 			cemu_assert_debug(false);
 		}
 
-		RPLLoader_LoadSingleSection(rplLoaderContext, i, regionMappingTable.region + RPL_MAPPING_REGION_TEXT, textSectionMappedBase);
+		RPLLoader_LoadSingleSection(rplLoaderContext, i, regionMappingTable.region + RPL_MAPPING_REGION_TEXT, textSectionMappedBase, std::exchange(inflatedSections[i], nullptr));
 	}
+	// release inflated sections which were not mapped
+	for (auto& it : inflatedSections)
+		delete it;
 	// load temp region sections
 	uint32 tempRegionSize = regionMappingTable.region[RPL_MAPPING_REGION_TEMP].endAddress - regionMappingTable.region[RPL_MAPPING_REGION_TEMP].baseAddress;
 	uint8* tempRegionPtr;
@@ -659,6 +882,9 @@ bool RPLLoader_LoadSections(sint32 aProcId, RPLModule* rplLoaderContext)
 		delete fs;
 	}
 	*/
+	// relocations are applied when the module is linked, inflate them now so that a corrupted section fails the load
+	if (!RPLLoader_InflateRelocSections(rplLoaderContext))
+		rplLoaderContext->hasError = true;
 	return true;
 }
 
@@ -681,14 +907,26 @@ struct RPLSharedImportTracking
 
 static_assert(sizeof(RPLFileSymtabEntry) == 0x10, "rplSymtabEntry_t has invalid size");
 
-typedef struct
+struct MappedFunctionImportKey
 {
 	uint64 hash1;
 	uint64 hash2;
-	uint32 address;
-}mappedFunctionImport_t;
 
-std::vector<mappedFunctionImport_t> list_mappedFunctionImports = std::vector<mappedFunctionImport_t>();
+	bool operator==(const MappedFunctionImportKey& other) const
+	{
+		return hash1 == other.hash1 && hash2 == other.hash2;
+	}
+};
+
+struct MappedFunctionImportKeyHasher
+{
+	size_t operator()(const MappedFunctionImportKey& key) const
+	{
+		return (size_t)(key.hash1 ^ std::rotl<uint64>(key.hash2 * 0x9E3779B97F4A7C15ULL, 31));
+	}
+};
+
+std::unordered_map<MappedFunctionImportKey, uint32, MappedFunctionImportKeyHasher> s_mappedFunctionImports;
 
 void _calculateMappedImportNameHash(const char* rplName, const char* funcName, uint64* h1Out, uint64* h2Out)
 {
@@ -739,13 +977,10 @@ uint32 rpl_mapHLEImport(RPLModule* rplLoaderContext, const char* rplName, const
 	uint64 mappedImportHash2;
 	_calculateMappedImportNameHash(rplName, funcName, &mappedImportHash1, &mappedImportHash2);
 	// find already mapped name
-	for (auto& importItr : list_mappedFunctionImports)
-	{
-		if (importItr.hash1 == mappedImportHash1 && importItr.hash2 == mappedImportHash2)
-		{
-			return importItr.address;
-		}
-	}
+	MappedFunctionImportKey importKey{ mappedImportHash1, mappedImportHash2 };
+	auto importItr = s_mappedFunctionImports.find(importKey);
+	if (importItr != s_mappedFunctionImports.end())
+		return importItr->second;
 	// copy lib file name and cut off .rpl from libName if present
 	char libName[512];
 	strcpy_s(libName, rplName);
@@ -767,11 +1002,7 @@ uint32 rpl_mapHLEImport(RPLModule* rplLoaderContext, const char* rplName, const
 		uint32 opcode = (1 << 26) | functionIndex;
 		memory_write<uint32>(codeAddr, opcode);
 		// register mapped import
-		mappedFunctionImport_t newImport;
-		newImport.hash1 = mappedImportHash1;
-		newImport.hash2 = mappedImportHash2;
-		newImport.address = codeAddr;
-		list_mappedFunctionImports.push_back(newImport);
+		s_mappedFunctionImports.emplace(importKey, codeAddr);
 		// remember in symbol storage for debugger
 		rplSymbolStorage_store(libName, funcName, codeAddr);
 		return codeAddr;
@@ -802,11 +1033,7 @@ uint32 rpl_mapHLEImport(RPLModule* rplLoaderContext, const char* rplName, const
 	// align address to 4 byte boundary
 	currentAddress = (currentAddress + 3)&~3;
 	// register mapped import
-	mappedFunctionImport_t newImport;
-	newImport.hash1 = mappedImportHash1;
-	newImport.hash2 = mappedImportHash2;
-	newImport.address = codeStart;
-	list_mappedFunctionImports.push_back(newImport);
+	s_mappedFunctionImports.emplace(importKey, codeStart);
 	// remember in symbol storage for debugger
 	rplSymbolStorage_store(libName, funcName, codeStart);
 	// return address of code start
@@ -820,18 +1047,9 @@ MPTR RPLLoader_FindRPLExport(RPLModule* rplLoaderContext, const char* symbolName
 		cemu_assert_debug(false);
 		// todo - look in DDataPtr
 	}
-	if (rplLoaderContext->exportFDataPtr)
-	{
-		char* exportNameData = (char*)((uint8*)rplLoaderContext->exportFDataPtr - 8);
-		for (uint32 f = 0; f < rplLoaderContext->exportFCount; f++)
-		{
-			char* name = exportNameData + (uint32)rplLoaderContext->exportFDataPtr[f].nameOffset;
-			if (strcmp(name, symbolName) == 0)
-			{
-				return (uint32)rplLoaderContext->exportFDataPtr[f].virtualOffset;
-			}
-		}
-	}
+	uint32 exportAddress;
+	if (RPLLoader_LookupExport(rplLoaderContext, false, symbolName, exportAddress))
+		return exportAddress;
 	return MPTR_NULL;
 }
 
@@ -858,34 +1076,9 @@ MPTR _findHLEExport(RPLModule* rplLoaderContext, RPLSharedImportTracking* shared
 
 uint32 RPLLoader_FindModuleExport(RPLModule* rplLoaderContext, bool isData, const char* exportName)
 {
-	if (isData == false)
-	{
-		// find function export
-		char* exportNameData = (char*)((uint8*)rplLoaderContext->exportFDataPtr - 8);
-		for (uint32 f = 0; f < rplLoaderContext->exportFCount; f++)
-		{
-			char* name = exportNameData + (uint32)rplLoaderContext->exportFDataPtr[f].nameOffset;
-			if (strcmp(name, exportName) == 0)
-			{
-				uint32 exportAddress = rplLoaderContext->exportFDataPtr[f].virtualOffset;
-				return exportAddress;
-			}
-		}
-	}
-	else
-	{
-		// find data export
-		char* exportNameData = (char*)((uint8*)rplLoaderContext->exportDDataPtr - 8);
-		for (uint32 f = 0; f < rplLoaderContext->exportDCount; f++)
-		{
-			char* name = exportNameData + (uint32)rplLoaderContext->exportDDataPtr[f].nameOffset;
-			if (strcmp(name, exportName) == 0)
-			{
-				uint32 exportAddress = rplLoaderContext->exportDDataPtr[f].virtualOffset;
-				return exportAddress;
-			}
-		}
-	}
+	uint32 exportAddress;
+	if (RPLLoader_LookupExport(rplLoaderContext, isData, exportName, exportAddress))
+		return exportAddress;
 	return 0;
 }
 
@@ -973,39 +1166,11 @@ bool RPLLoader_FixImportSymbols(RPLModule* rplLoaderContext, sint32 symtabSectio
 				uint32 nameOffset = sym->ukn00;
 				char* symbolName = (char*)strtabData + nameOffset;
 
-				bool foundExport = false;
-				if ((rplLoaderContext->sectionTablePtr[symSectionIndex].flags & 0x4) != 0)
-				{
-					// find function export
-					char* exportNameData = (char*)((uint8*)ctxExportModule->exportFDataPtr - 8);
-					for (uint32 f = 0; f < ctxExportModule->exportFCount; f++)
-					{
-						char* name = exportNameData + (uint32)ctxExportModule->exportFDataPtr[f].nameOffset;
-						if (strcmp(name, symbolName) == 0)
-						{
-							uint32 exportAddress = ctxExportModule->exportFDataPtr[f].virtualOffset;
-							sym->symbolAddress = exportAddress;
-							foundExport = true;
-							break;
-						}
-					}
-				}
-				else
-				{
-					// find data export
-					char* exportNameData = (char*)((uint8*)ctxExportModule->exportDDataPtr - 8);
-					for (uint32 f = 0; f < ctxExportModule->exportDCount; f++)
-					{
-						char* name = exportNameData + (uint32)ctxExportModule->exportDDataPtr[f].nameOffset;
-						if (strcmp(name, symbolName) == 0)
-						{
-							uint32 exportAddress = ctxExportModule->exportDDataPtr[f].virtualOffset;
-							sym->symbolAddress = exportAddress;
-							foundExport = true;
-							break;
-						}
-					}
-				}
+				bool isFunctionExport = (rplLoaderContext->sectionTablePtr[symSectionIndex].flags & 0x4) != 0;
+				uint32 exportAddress;
+				bool foundExport = RPLLoader_LookupExport(ctxExportModule, !isFunctionExport, symbolName, exportAddress);
+				if (foundExport)
+					sym->symbolAddress = exportAddress;
 				if (foundExport == false)
 				{
 #ifdef CEMU_DEBUG_ASSERT
@@ -1013,18 +1178,8 @@ bool RPLLoader_FixImportSymbols(RPLModule* rplLoaderContext, sint32 symtabSectio
 					{
 						cemuLog_logDebug(LogType::Force, "export not found - force lookup in function exports");
 						// workaround - force look up export in function exports
-						char* exportNameData = (char*)((uint8*)ctxExportModule->exportFDataPtr - 8);
-						for (uint32 f = 0; f < ctxExportModule->exportFCount; f++)
-						{
-							char* name = exportNameData + (uint32)ctxExportModule->exportFDataPtr[f].nameOffset;
-							if (strcmp(name, symbolName) == 0)
-							{
-								uint32 exportAddress = ctxExportModule->exportFDataPtr[f].virtualOffset;
-								sym->symbolAddress = exportAddress;
-								foundExport = true;
-								break;
-							}
-						}
+						if (RPLLoader_LookupExport(ctxExportModule, false, symbolName, exportAddress))
+							sym->symbolAddress = exportAddress;
 					}
 #endif
 					continue;
@@ -1223,7 +1378,8 @@ bool RPLLoader_ApplySingleReloc(RPLModule* rplLoaderContext, uint32 uknR3, uint8
 	return true;
 }
 
-bool RPLLoader_ApplyRelocs(RPLModule* rplLoaderContext, sint32 relaSectionIndex, rplSectionEntryNew_t* section, uint32 linkMode)
+// for compressed reloc sections inflatedRelocData holds the data inflated by RPLLoader_InflateRelocSections()
+bool RPLLoader_ApplyRelocs(RPLModule* rplLoaderContext, sint32 relaSectionIndex, rplSectionEntryNew_t* section, uint32 linkMode, std::span<uint8> inflatedRelocData)
 {
 	uint32 relocTargetSectionIndex = section->relocTargetSectionIndex;
 	if (relocTargetSectionIndex >= (uint32)rplLoaderContext->rplHeader.sectionTableEntryCount)
@@ -1242,33 +1398,13 @@ bool RPLLoader_ApplyRelocs(RPLModule* rplLoaderContext, sint32 relaSectionIndex,
 	uint32 symbolCount = symtabSectionSize / symbolEntrySize;
 	cemu_assert(symbolCount >= 2);
 	uint8* symtabData = (uint8*)rplLoaderContext->sectionAddressTable2[symtabSectionIndex].ptr;
-	// decompress reloc section if needed
+	// get reloc data
 	uint8* relocData;
 	uint32 relocSize;
 	if ((uint32)(section->flags) & SHF_RPL_COMPRESSED)
 	{
-		uint8* relocRawData = (uint8*)rplLoaderContext->sectionAddressTable2[relaSectionIndex].ptr;
-		uint32 relocUncompressedSize = *(uint32be*)relocRawData;
-		relocData = (uint8*)malloc(relocUncompressedSize);
-		relocSize = relocUncompressedSize;
-		// decompress
-		int ret;
-		z_stream strm;
-		strm.zalloc = Z_NULL;
-		strm.zfree = Z_NULL;
-		strm.opaque = Z_NULL;
-		ret = inflateInit(&strm);
-		if (ret == Z_OK)
-		{
-			strm.avail_in = (uint32)section->sectionSize - 4;
-			strm.next_in = relocRawData + 4;
-			strm.avail_out = relocUncompressedSize;
-			strm.next_out = relocData;
-			ret = inflate(&strm, Z_FULL_FLUSH);
-			cemu_assert_debug(ret == Z_OK || ret == Z_STREAM_END);
-			cemu_assert_debug(strm.avail_in == 0 && strm.avail_out == 0);
-			inflateEnd(&strm);
-		}
+		relocData = inflatedRelocData.data();
+		relocSize = (uint32)inflatedRelocData.size();
 	}
 	else
 	{
@@ -1348,9 +1484,6 @@ bool RPLLoader_ApplyRelocs(RPLModule* rplLoaderContext, sint32 relaSectionIndex,
 		// next reloc
 		reloc++;
 	}
-
-	if ((uint32)(section->flags) & SHF_RPL_COMPRESSED)
-		free(relocData);
 	return true;
 }
 
@@ -1367,13 +1500,17 @@ bool RPLLoader_HandleRelocs(RPLModule* rplLoaderContext, std::span<RPLSharedImpo
 	}
 
 	// apply relocs again after we have fixed the import section
+	// compressed reloc sections were already inflated on worker threads when the module was loaded
+	// applying stays sequential since relocations can allocate trampolines and the trampoline layout must not depend on thread timing
+	auto& inflatedRelocs = rplLoaderContext->sectionData_inflatedRelocs;
 	for (sint32 i = 0; i < (sint32)rplLoaderContext->rplHeader.sectionTableEntryCount; i++)
 	{
 		rplSectionEntryNew_t* section = rplLoaderContext->sectionTablePtr + i;
 		uint32 sectionType = section->type;
 		if (sectionType != SHT_RELA)
 			continue;
-		RPLLoader_ApplyRelocs(rplLoaderContext, i, section, linkMode);
+		cemu_assert_debug((size_t)i < inflatedRelocs.size());
+		RPLLoader_ApplyRelocs(rplLoaderContext, i, section, linkMode, (size_t)i < inflatedRelocs.size() ? std::span<uint8>(inflatedRelocs[i]) : std::span<uint8>());
 	}
 	return true;
 }
@@ -1582,6 +1719,8 @@ RPLModule* RPLLoader_LoadFromMemory(uint8* rplData, sint32 size, char* name)
 {
 	char moduleName[RPL_MODULE_NAME_LENGTH];
 	_RPLLoader_ExtractModuleNameFromPath(moduleName, name);
+	BenchmarkTimer loadTimer;
+	loadTimer.Start();
 	RPLModule* rpl = nullptr;
 	if (RPLLoader_ProcessHeaders({ moduleName }, rplData, size, &rpl) == false)
 	{
@@ -1664,6 +1803,9 @@ RPLModule* RPLLoader_LoadFromMemory(uint8* rplData, sint32 size, char* name)
 
 	// update entrypoint
 	RPLLoader_UpdateEntrypoint(rpl);
+
+	loadTimer.Stop();
+	cemuLog_log(LogType::RPLLoader, "RPLLoader: Loaded {} in {:.2f}ms", rpl->moduleName2, loadTimer.GetElapsedMilliseconds());
 	return rpl;
 }
 
@@ -1855,13 +1997,19 @@ void RPLLoader_FixModuleTLSIndex(RPLModule* rplLoaderContext)
 
 void RPLLoader_Link()
 {
+	BenchmarkTimer linkTimer;
+	linkTimer.Start();
+	sint32 linkedModuleCount = 0;
 	// calculate TLS index
 	for (sint32 i = 0; i < rplModuleCount; i++)
 	{
 		if (rplModuleList[i]->isLinked)
 			continue;
 		RPLLoader_FixModuleTLSIndex(rplModuleList[i]);
+		linkedModuleCount++;
 	}
+	if (linkedModuleCount == 0)
+		return;
 	// resolve relocs
 	for (sint32 i = 0; i < rplModuleCount; i++)
 	{
@@ -1877,9 +2025,12 @@ void RPLLoader_Link()
 		RPLLoader_LinkSingleModule(rplModuleList[i], true);
 		RPLLoader_LoadDebugSymbols(rplModuleList[i]);
 		rplModuleList[i]->isLinked = true; // mark as linked
+		rplModuleList[i]->sectionData_inflatedRelocs = {};
 		GraphicPack2::NotifyModuleLoaded(rplModuleList[i]);
 		debuggerWindow_notifyModuleLoaded(rplModuleList[i]);
 	}
+	linkTimer.Stop();
+	cemuLog_log(LogType::Force, "RPLLoader: Linked {} module(s) in {:.2f}ms", linkedModuleCount, linkTimer.GetElapsedMilliseconds());
 }
 
 uint32 RPLLoader_GetModuleEntrypoint(RPLModule* rplLoaderContext)
@@ -2386,7 +2537,7 @@ void RPLLoader_ResetState()
 	rplSymbolStorage_unloadAll();
 	// free all code imports
 	g_heapTrampolineArea.releaseAll();
-	list_mappedFunctionImports.clear();
+	s_mappedFunctionImports.clear();
 	g_map_callableExports.clear();
 	rplLoader_applicationHasMemoryControl = false;
 	rplLoader_maxCodeAddress = 0;
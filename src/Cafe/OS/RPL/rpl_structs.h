@@ -163,6 +163,9 @@ struct RPLModule
 	rplExportTableEntry_t* exportDDataPtr;
 	uint32 exportFCount;
 	rplExportTableEntry_t* exportFDataPtr;
+	// maps export names to their index in the export table
+	std::unordered_map<std::string_view, uint32> exportDIndex;
+	std::unordered_map<std::string_view, uint32> exportFIndex;
 
 	std::string moduleName2;
 	
@@ -183,6 +186,7 @@ struct RPLModule
 	// section data
 	std::vector<uint8> sectionData_fileInfo;
 	std::vector<uint8> sectionData_crc;
+	std::vector<std::vector<uint8>> sectionData_inflatedRelocs; // compressed SHT_RELA sections, indexed by section. Released after linking
 
 	// parsed FILEINFO
 	struct 
@@ -32,30 +32,39 @@
 #include "Cafe/OS/libs/camera/camera.h"
 #include "../libs/swkbd/swkbd.h"
 
+// lookup key formed from the library and function name hashes
+struct osExportKey_t
+{
+	uint64 libHash;
+	uint64 funcHash;
+
+	bool operator==(const osExportKey_t& other) const
+	{
+		return libHash == other.libHash && funcHash == other.funcHash;
+	}
+};
+
+struct osExportKeyHasher_t
+{
+	size_t operator()(const osExportKey_t& key) const
+	{
+		uint64 h = key.libHash * 0x9E3779B97F4A7C15ULL;
+		h ^= key.funcHash + 0x7F4A7C159E3779B9ULL + (h << 6) + (h >> 2);
+		return (size_t)h;
+	}
+};
+
 struct osFunctionEntry_t
 {
-	uint32 libHashA;
-	uint32 libHashB;
-	uint32 funcHashA;
-	uint32 funcHashB;
 	std::string name;
 	HLEIDX hleFunc;
 
-	osFunctionEntry_t(uint32 libHashA, uint32 libHashB, uint32 funcHashA, uint32 funcHashB, std::string_view name, HLEIDX hleFunc) :
-		libHashA(libHashA), libHashB(libHashB), funcHashA(funcHashA), funcHashB(funcHashB), name(name), hleFunc(hleFunc) {};
+	osFunctionEntry_t(std::string_view name, HLEIDX hleFunc) : name(name), hleFunc(hleFunc) {};
 };
 
-typedef struct
-{
-	uint32 libHashA;
-	uint32 libHashB;
-	uint32 funcHashA;
-	uint32 funcHashB;
-	uint32 vPtr;
-}osPointerEntry_t;
-
-std::vector<osFunctionEntry_t>* s_osFunctionTable;
-std::vector<osPointerEntry_t> osDataTable;
+// both tables are looked up once per imported symbol during RPL linking, so they are hash indexed instead of scanned
+std::unordered_map<osExportKey_t, osFunctionEntry_t, osExportKeyHasher_t>* s_osFunctionTable;
+std::unordered_map<osExportKey_t, uint32, osExportKeyHasher_t> osDataTable;
 
 void osLib_generateHashFromName(const char* name, uint32* hashA, uint32* hashB)
 {
@@ -77,29 +86,32 @@ void osLib_generateHashFromName(const char* name, uint32* hashA, uint32* hashB)
 	*hashB = h2;
 }
 
-void osLib_addFunctionInternal(const char* libraryName, const char* functionName, void(*osFunction)(PPCInterpreter_t* hCPU))
+osExportKey_t osLib_generateExportKey(const char* libraryName, const char* functionName)
 {
-	if (!s_osFunctionTable)
-		s_osFunctionTable = new std::vector<osFunctionEntry_t>(); // replace with static allocation + constinit once we have C++20 available
-	// calculate hash
 	uint32 libHashA, libHashB;
 	uint32 funcHashA, funcHashB;
 	osLib_generateHashFromName(libraryName, &libHashA, &libHashB);
 	osLib_generateHashFromName(functionName, &funcHashA, &funcHashB);
+	osExportKey_t key;
+	key.libHash = ((uint64)libHashA << 32) | (uint64)libHashB;
+	key.funcHash = ((uint64)funcHashA << 32) | (uint64)funcHashB;
+	return key;
+}
+
+void osLib_addFunctionInternal(const char* libraryName, const char* functionName, void(*osFunction)(PPCInterpreter_t* hCPU))
+{
+	if (!s_osFunctionTable)
+		s_osFunctionTable = new std::unordered_map<osExportKey_t, osFunctionEntry_t, osExportKeyHasher_t>(); // replace with static allocation + constinit once we have C++20 available
+	osExportKey_t key = osLib_generateExportKey(libraryName, functionName);
 	std::string hleName = fmt::format("{}.{}", libraryName, functionName);
 	// if entry already exists, update it
-	for (auto& it : *s_osFunctionTable)
+	auto it = s_osFunctionTable->find(key);
+	if (it != s_osFunctionTable->end())
 	{
-		if (it.libHashA == libHashA &&
-			it.libHashB == libHashB &&
-			it.funcHashA == funcHashA &&
-			it.funcHashB == funcHashB)
-		{
-			it.hleFunc = PPCInterpreter_registerHLECall(osFunction, hleName);
-			return;
-		}
+		it->second.hleFunc = PPCInterpreter_registerHLECall(osFunction, hleName);
+		return;
 	}
-	s_osFunctionTable->emplace_back(libHashA, libHashB, funcHashA, funcHashB, hleName, PPCInterpreter_registerHLECall(osFunction, hleName));
+	s_osFunctionTable->emplace(key, osFunctionEntry_t(hleName, PPCInterpreter_registerHLECall(osFunction, hleName)));
 }
 
 extern "C" DLLEXPORT void osLib_registerHLEFunction(const char* libraryName, const char* functionName, void(*osFunction)(PPCInterpreter_t * hCPU))
@@ -109,69 +121,26 @@ extern "C" DLLEXPORT void osLib_registerHLEFunction(const char* libraryName, con
 
 sint32 osLib_getFunctionIndex(const char* libraryName, const char* functionName)
 {
-	uint32 libHashA, libHashB;
-	uint32 funcHashA, funcHashB;
-	osLib_generateHashFromName(libraryName, &libHashA, &libHashB);
-	osLib_generateHashFromName(functionName, &funcHashA, &funcHashB);
-	for (auto& it : *s_osFunctionTable)
-	{
-		if (it.libHashA == libHashA &&
-			it.libHashB == libHashB &&
-			it.funcHashA == funcHashA &&
-			it.funcHashB == funcHashB)
-		{
-			return it.hleFunc;
-		}
-	}
-	return -1;
+	if (!s_osFunctionTable)
+		return -1;
+	auto it = s_osFunctionTable->find(osLib_generateExportKey(libraryName, functionName));
+	if (it == s_osFunctionTable->end())
+		return -1;
+	return it->second.hleFunc;
 }
 
 void osLib_addVirtualPointer(const char* libraryName, const char* functionName, uint32 vPtr)
 {
-	// calculate hash
-	uint32 libHashA, libHashB;
-	uint32 funcHashA, funcHashB;
-	osLib_generateHashFromName(libraryName, &libHashA, &libHashB);
-	osLib_generateHashFromName(functionName, &funcHashA, &funcHashB);
-	// if entry already exists, update it
-	for (auto& it : osDataTable)
-	{
-		if (it.libHashA == libHashA &&
-			it.libHashB == libHashB &&
-			it.funcHashA == funcHashA &&
-			it.funcHashB == funcHashB)
-		{
-			it.vPtr = vPtr;
-			return;
-		}
-	}
-	// add entry
-	auto writeIndex = osDataTable.size();
-	osDataTable.resize(osDataTable.size() + 1);
-	osDataTable[writeIndex].libHashA = libHashA;
-	osDataTable[writeIndex].libHashB = libHashB;
-	osDataTable[writeIndex].funcHashA = funcHashA;
-	osDataTable[writeIndex].funcHashB = funcHashB;
-	osDataTable[writeIndex].vPtr = vPtr;
+	// add entry or update existing one
+	osDataTable.insert_or_assign(osLib_generateExportKey(libraryName, functionName), vPtr);
 }
 
 uint32 osLib_getPointer(const char* libraryName, const char* functionName)
 {
-	uint32 libHashA, libHashB;
-	uint32 funcHashA, funcHashB;
-	osLib_generateHashFromName(libraryName, &libHashA, &libHashB);
-	osLib_generateHashFromName(functionName, &funcHashA, &funcHashB);
-	for (auto& it : osDataTable)
-	{
-		if (it.libHashA == libHashA &&
-			it.libHashB == libHashB &&
-			it.funcHashA == funcHashA &&
-			it.funcHashB == funcHashB)
-		{
-			return it.vPtr;
-		}
-	}
-	return 0xFFFFFFFF;
+	auto it = osDataTable.find(osLib_generateExportKey(libraryName, functionName));
+	if (it == osDataTable.end())
+		return 0xFFFFFFFF;
+	return it->second;
 }
 
 void osLib_returnFromFunction(PPCInterpreter_t* hCPU, uint32 returnValue)
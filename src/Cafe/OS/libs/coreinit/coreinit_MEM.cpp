@@ -628,6 +628,8 @@ namespace coreinit
         memset(&g_list1, 0, sizeof(g_list1));
         memset(&g_list2, 0, sizeof(g_list2));
         memset(&g_list3, 0, sizeof(g_list3));
+
+        MEMResetExpHeapFreeBlockIndices();
     }
 
 	void InitializeMEM()
@@ -30,6 +30,206 @@ namespace coreinit
 #define MBLOCK_GET_MEMORY(__mblock__) ((uintptr_t)__mblock__ + sizeof(MBlock2_t))
 #define MBLOCK_GET_END(__mblock__) ((uintptr_t)__mblock__ + sizeof(MBlock2_t) + (uint32)__mblock__->dataSize)
 
+	// returns true if an allocation of the given size fits into the free block when allocating from the head
+	bool _MEMExpHeap_FitsFromHead(MBlock2_t* freeBlock, uint32 size, uint32 alignment, uintptr_t& blockMemStartOut)
+	{
+		const uintptr_t alignmentMinusOne = alignment - 1;
+		const uintptr_t blockMemory = MBLOCK_GET_MEMORY(freeBlock);
+		const uintptr_t alignedBlockMemory = (blockMemory + alignmentMinusOne) & ~alignmentMinusOne;
+		const uint32 dataSize = (uint32)freeBlock->dataSize;
+		if (dataSize < alignedBlockMemory - blockMemory + size)
+			return false;
+		blockMemStartOut = alignedBlockMemory;
+		return true;
+	}
+
+	// returns true if an allocation of the given size fits into the free block when allocating from the tail
+	bool _MEMExpHeap_FitsFromTail(MBlock2_t* freeBlock, uint32 size, uint32 alignment, uintptr_t& blockMemStartOut)
+	{
+		const uintptr_t alignmentMinusOne = alignment - 1;
+		const uintptr_t blockMemory = MBLOCK_GET_MEMORY(freeBlock);
+		const uint32 dataSize = (uint32)freeBlock->dataSize;
+		const uintptr_t alignedEndBlockMemory = (blockMemory + dataSize - size) & ~alignmentMinusOne;
+		if (alignedEndBlockMemory < blockMemory)
+			return false;
+		blockMemStartOut = alignedEndBlockMemory;
+		return true;
+	}
+
+	/*
+	 * Host-side index of the free blocks of an expanded heap
+	 * The guest-visible free chain (sorted by address) remains the authoritative layout. The index mirrors every insertion and removal on the free chain and is only used to speed up the search for a suitable free block
+	 * Lookups return exactly the block the linear search over the free chain would return:
+	 * - First-fit: Blocks are binned by the highest set bit of their size. Each bin is sorted by address, so only the first few entries of each bin which can hold the allocation need to be inspected
+	 * - Best-fit (MEM_EXPHEAP_ALLOC_MODE_NEAR): Blocks are sorted by (size, address)
+	 * Additionally all free blocks are kept sorted by address so that freeing memory does not need to walk the chain to find the neighbouring free blocks
+	 * With CEMU_DEBUG_ASSERT every lookup is compared against the linear search (_MEMExpHeap_FindFreeBlockFromHeadLinear/_MEMExpHeap_FindFreeBlockFromTailLinear)
+	 */
+	class ExpHeapFreeBlockIndex
+	{
+		static constexpr size_t NUM_BINS = 32;
+
+	public:
+		void Add(MBlock2_t* freeBlock)
+		{
+			std::unique_lock _l(m_mutex);
+			const uint32 blockAddr = memory_getVirtualOffsetFromPointer(freeBlock);
+			const uint32 dataSize = freeBlock->dataSize;
+			m_bySize.emplace(dataSize, blockAddr);
+			m_byAddress[GetBinIndex(dataSize)].emplace(blockAddr);
+			m_allBlocks.emplace(blockAddr);
+		}
+
+		void Remove(MBlock2_t* freeBlock)
+		{
+			std::unique_lock _l(m_mutex);
+			const uint32 blockAddr = memory_getVirtualOffsetFromPointer(freeBlock);
+			const uint32 dataSize = freeBlock->dataSize;
+			m_bySize.erase({ dataSize, blockAddr });
+			m_byAddress[GetBinIndex(dataSize)].erase(blockAddr);
+			m_allBlocks.erase(blockAddr);
+		}
+
+		// returns the free block with the lowest address that is equal or greater than addr
+		MBlock2_t* FindFirstAtOrAfter(uintptr_t addr)
+		{
+			std::unique_lock _l(m_mutex);
+			auto it = m_allBlocks.lower_bound(memory_getVirtualOffsetFromPointer((void*)addr));
+			if (it == m_allBlocks.end())
+				return nullptr;
+			return (MBlock2_t*)memory_getPointerFromVirtualOffset(*it);
+		}
+
+		MBlock2_t* FindFromHead(uint32 size, uint32 alignment, bool searchForFirstEntry, uintptr_t& blockMemStartOut)
+		{
+			std::unique_lock _l(m_mutex);
+			uintptr_t blockMemStart;
+			if (!searchForFirstEntry)
+			{
+				// smallest block that fits, lowest address wins on equal size
+				for (auto it = m_bySize.lower_bound({ size, 0 }); it != m_bySize.end(); ++it)
+				{
+					MBlock2_t* block = (MBlock2_t*)memory_getPointerFromVirtualOffset(it->second);
+					if (_MEMExpHeap_FitsFromHead(block, size, alignment, blockMemStart))
+					{
+						blockMemStartOut = blockMemStart;
+						return block;
+					}
+				}
+				return nullptr;
+			}
+			// lowest address that fits
+			MBlock2_t* foundBlock = nullptr;
+			uint32 foundAddr = 0xFFFFFFFF;
+			for (size_t bin = GetBinIndex(size); bin < NUM_BINS; bin++)
+			{
+				for (uint32 blockAddr : m_byAddress[bin])
+				{
+					if (blockAddr >= foundAddr)
+						break;
+					MBlock2_t* block = (MBlock2_t*)memory_getPointerFromVirtualOffset(blockAddr);
+					if (_MEMExpHeap_FitsFromHead(block, size, alignment, blockMemStart))
+					{
+						foundBlock = block;
+						foundAddr = blockAddr;
+						blockMemStartOut = blockMemStart;
+						break;
+					}
+				}
+			}
+			return foundBlock;
+		}
+
+		MBlock2_t* FindFromTail(uint32 size, uint32 alignment, bool searchForFirstEntry, uintptr_t& blockMemStartOut)
+		{
+			std::unique_lock _l(m_mutex);
+			uintptr_t blockMemStart;
+			MBlock2_t* foundBlock = nullptr;
+			if (!searchForFirstEntry)
+			{
+				// smallest block that fits, highest address wins on equal size
+				uint32 foundSize = 0;
+				for (auto it = m_bySize.lower_bound({ size, 0 }); it != m_bySize.end(); ++it)
+				{
+					if (foundBlock && it->first != foundSize)
+						break;
+					MBlock2_t* block = (MBlock2_t*)memory_getPointerFromVirtualOffset(it->second);
+					if (_MEMExpHeap_FitsFromTail(block, size, alignment, blockMemStart))
+					{
+						foundBlock = block;
+						foundSize = it->first;
+						blockMemStartOut = blockMemStart;
+					}
+				}
+				return foundBlock;
+			}
+			// highest address that fits
+			uint32 foundAddr = 0;
+			for (size_t bin = GetBinIndex(size); bin < NUM_BINS; bin++)
+			{
+				for (auto it = m_byAddress[bin].rbegin(); it != m_byAddress[bin].rend(); ++it)
+				{
+					const uint32 blockAddr = *it;
+					if (foundBlock && blockAddr <= foundAddr)
+						break;
+					MBlock2_t* block = (MBlock2_t*)memory_getPointerFromVirtualOffset(blockAddr);
+					if (_MEMExpHeap_FitsFromTail(block, size, alignment, blockMemStart))
+					{
+						foundBlock = block;
+						foundAddr = blockAddr;
+						blockMemStartOut = blockMemStart;
+						break;
+					}
+				}
+			}
+			return foundBlock;
+		}
+
+	private:
+		static size_t GetBinIndex(uint32 size)
+		{
+			return size == 0 ? 0 : (size_t)(std::bit_width(size) - 1);
+		}
+
+		std::mutex m_mutex;
+		std::set<std::pair<uint32, uint32>> m_bySize; // (dataSize, block address)
+		std::array<std::set<uint32>, NUM_BINS> m_byAddress; // block addresses, binned by size
+		std::set<uint32> m_allBlocks; // all block addresses
+	};
+
+	std::shared_mutex s_expHeapIndexMutex; // lookups happen on every alloc/free, heaps are rarely created or destroyed
+	std::unordered_map<MEMExpHeapHead2*, std::unique_ptr<ExpHeapFreeBlockIndex>> s_expHeapIndex;
+
+	ExpHeapFreeBlockIndex* _MEMExpHeap_GetFreeBlockIndex(MEMExpHeapHead2* heap)
+	{
+		std::shared_lock _l(s_expHeapIndexMutex);
+		auto it = s_expHeapIndex.find(heap);
+		if (it == s_expHeapIndex.end())
+			return nullptr;
+		return it->second.get();
+	}
+
+	ExpHeapFreeBlockIndex* _MEMExpHeap_CreateFreeBlockIndex(MEMExpHeapHead2* heap)
+	{
+		std::unique_lock _l(s_expHeapIndexMutex);
+		auto& index = s_expHeapIndex[heap];
+		index = std::make_unique<ExpHeapFreeBlockIndex>();
+		return index.get();
+	}
+
+	void _MEMExpHeap_DestroyFreeBlockIndex(MEMExpHeapHead2* heap)
+	{
+		std::unique_lock _l(s_expHeapIndexMutex);
+		s_expHeapIndex.erase(heap);
+	}
+
+	// heaps of the previous title are never destroyed, drop their indices when coreinit is reset
+	void MEMResetExpHeapFreeBlockIndices()
+	{
+		std::unique_lock _l(s_expHeapIndexMutex);
+		s_expHeapIndex.clear();
+	}
+
 #pragma region internal
 	MBlock2_t* _MEMExpHeap_InitMBlock(ExpMemBlockRegion* region, uint16 typeCode)
 	{
@@ -163,6 +363,23 @@ namespace coreinit
 		return newBlock;
 	}
 
+	// same as _MEMExpHeap_RemoveMBlock and _MEMExpHeap_InsertMBlock but also keeps the free block index up to date. Must be used for all changes to the free chain
+	void* _MEMExpHeap_RemoveFreeMBlock(MBlockChain2_t* freeChain, MBlock2_t* block)
+	{
+		ExpHeapFreeBlockIndex* index = _MEMExpHeap_GetFreeBlockIndex(EXP_HEAP_GET_FROM_FREE_BLOCKCHAIN(freeChain));
+		if (index)
+			index->Remove(block);
+		return _MEMExpHeap_RemoveMBlock(freeChain, block);
+	}
+
+	MBlock2_t* _MEMExpHeap_InsertFreeMBlock(MBlockChain2_t* freeChain, MBlock2_t* newBlock, MBlock2_t* prevBlock)
+	{
+		ExpHeapFreeBlockIndex* index = _MEMExpHeap_GetFreeBlockIndex(EXP_HEAP_GET_FROM_FREE_BLOCKCHAIN(freeChain));
+		if (index)
+			index->Add(newBlock);
+		return _MEMExpHeap_InsertMBlock(freeChain, newBlock, prevBlock);
+	}
+
 	bool _MEMExpHeap_RecycleRegion(MBlockChain2_t* blockChain, ExpMemBlockRegion* region)
 	{
 		ExpMemBlockRegion newRegion;
@@ -171,6 +388,13 @@ namespace coreinit
 
 		MEMPTR<MBlock2_t> prev;
 		MEMPTR<MBlock2_t> find = blockChain->headMBlock;
+		ExpHeapFreeBlockIndex* index = _MEMExpHeap_GetFreeBlockIndex(EXP_HEAP_GET_FROM_FREE_BLOCKCHAIN(blockChain));
+		if (index)
+		{
+			// skip directly to the first free block after the region
+			find = index->FindFirstAtOrAfter(region->start);
+			prev = find ? find->prevBlock : blockChain->tailMBlock;
+		}
 		while (find)
 		{
 			MBlock2_t* findMBlock = find.GetPtr();
@@ -180,7 +404,7 @@ namespace coreinit
 				if (blockAddr == region->end)
 				{
 					newRegion.end = MBLOCK_GET_END(findMBlock);
-					_MEMExpHeap_RemoveMBlock(blockChain, findMBlock);
+					_MEMExpHeap_RemoveFreeMBlock(blockChain, findMBlock);
 
 					MEMExpHeapHead2* heap = EXP_HEAP_GET_FROM_FREE_BLOCKCHAIN(blockChain);
 					uint8 options = heap->flags;
@@ -204,7 +428,7 @@ namespace coreinit
 			if (MBLOCK_GET_END(prevMBlock) == region->start)
 			{
 				newRegion.start = (uintptr_t)prevMBlock;
-				prev = (MBlock2_t*)_MEMExpHeap_RemoveMBlock(blockChain, prevMBlock);
+				prev = (MBlock2_t*)_MEMExpHeap_RemoveFreeMBlock(blockChain, prevMBlock);
 			}
 		}
 
@@ -220,7 +444,7 @@ namespace coreinit
 		}
 
 		MBlock2_t* newBlock = _MEMExpHeap_InitMBlock(&newRegion, MBLOCK_TYPE_FREE);
-		_MEMExpHeap_InsertMBlock(blockChain, newBlock, prev.GetPtr());
+		_MEMExpHeap_InsertFreeMBlock(blockChain, newBlock, prev.GetPtr());
 		return true;
 	}
 
@@ -234,12 +458,12 @@ void* _MEMExpHeap_AllocUsedBlockFromFreeBlock(MBlockChain2_t* blockChain, MBlock
 	ExpMemBlockRegion newRegion = {blockMemStart + size, freeRegion.end};
 	freeRegion.end = blockMemStart - sizeof(MBlock2_t);
 
-	MBlock2_t* prevBlock = (MBlock2_t*)_MEMExpHeap_RemoveMBlock(blockChain, freeBlock);
+	MBlock2_t* prevBlock = (MBlock2_t*)_MEMExpHeap_RemoveFreeMBlock(blockChain, freeBlock);
 
 	if ((freeRegion.end - freeRegion.start) >= 0x18 && (direction != MEMExpHeapAllocDirection::HEAD || HAS_FLAG(heap->expHeapHead.fields, MEM_EXPHEAP_USE_ALIGN_MARGIN)))
 	{
 		MBlock2_t* newBlock = _MEMExpHeap_InitMBlock(&freeRegion, MBLOCK_TYPE_FREE);
-		prevBlock = _MEMExpHeap_InsertMBlock(blockChain, newBlock, prevBlock);
+		prevBlock = _MEMExpHeap_InsertFreeMBlock(blockChain, newBlock, prevBlock);
 	}
 	else
 		freeRegion.end = freeRegion.start;
@@ -247,7 +471,7 @@ void* _MEMExpHeap_AllocUsedBlockFromFreeBlock(MBlockChain2_t* blockChain, MBlock
 	if ((newRegion.end - newRegion.start) >= 0x18 && (direction != MEMExpHeapAllocDirection::TAIL || HAS_FLAG(heap->expHeapHead.fields, MEM_EXPHEAP_USE_ALIGN_MARGIN)))
 	{
 		MBlock2_t* newBlock = _MEMExpHeap_InitMBlock(&newRegion, MBLOCK_TYPE_FREE);
-		prevBlock = _MEMExpHeap_InsertMBlock(blockChain, newBlock, prevBlock);
+		prevBlock = _MEMExpHeap_InsertFreeMBlock(blockChain, newBlock, prevBlock);
 	}
 	else
 		newRegion.start = newRegion.end;
@@ -282,32 +506,25 @@ void* _MEMExpHeap_AllocUsedBlockFromFreeBlock(MBlockChain2_t* blockChain, MBlock
 	return (void*)blockMemStart;
 }
 
-void* _MEMExpHeap_AllocFromTail(MEMHeapHandle heap, uint32 size, int alignment)
+MBlock2_t* _MEMExpHeap_FindFreeBlockFromTailLinear(MEMExpHeapHead2* expHeap, uint32 size, int alignment, uintptr_t& blockMemStartOut)
 {
-	MEMExpHeapHead2* expHeap = (MEMExpHeapHead2*)heap;
-
 	const bool searchForFirstEntry = (expHeap->expHeapHead.fields&1) == MEM_EXPHEAP_ALLOC_MODE_FIRST;
-	const int alignmentMinusOne = alignment - 1;
 
 	MBlock2_t* freeBlock = nullptr;
-	uintptr_t blockMemStart = 0;
 	uint32 foundSize = -1;
 
 	for (MBlock2_t* findBlock = expHeap->expHeapHead.chainFreeBlocks.tailMBlock.GetPtr(); findBlock != nullptr; findBlock = findBlock->prevBlock.GetPtr())
 	{
-		const uintptr_t blockMemory = MBLOCK_GET_MEMORY(findBlock);
-
 		const uint32 dataSize = (uint32)findBlock->dataSize;
-		const uintptr_t alignedEndBlockMemory = (blockMemory + dataSize - size) & ~alignmentMinusOne;
-		
-		if (alignedEndBlockMemory < blockMemory)
+		uintptr_t alignedEndBlockMemory;
+		if (!_MEMExpHeap_FitsFromTail(findBlock, size, alignment, alignedEndBlockMemory))
 			continue;
 
 		if (foundSize <= dataSize)
 			continue;
 
 		freeBlock = findBlock;
-		blockMemStart = alignedEndBlockMemory;
+		blockMemStartOut = alignedEndBlockMemory;
 		foundSize = dataSize;
 
 		if (searchForFirstEntry)
@@ -316,39 +533,28 @@ void* _MEMExpHeap_AllocFromTail(MEMHeapHandle heap, uint32 size, int alignment)
 		if (foundSize == size)
 			break;
 	}
-
-	void* mem = nullptr;
-	if (freeBlock)
-		mem = _MEMExpHeap_AllocUsedBlockFromFreeBlock(&expHeap->expHeapHead.chainFreeBlocks, freeBlock, blockMemStart, size, coreinit::MEMExpHeapAllocDirection::TAIL);
-
-	return mem;
+	return freeBlock;
 }
 
-void* _MEMExpHeap_AllocFromHead(MEMHeapHandle heap, uint32 size, int alignment)
+MBlock2_t* _MEMExpHeap_FindFreeBlockFromHeadLinear(MEMExpHeapHead2* expHeap, uint32 size, int alignment, uintptr_t& blockMemStartOut)
 {
-	MEMExpHeapHead2* expHeap = (MEMExpHeapHead2*)heap;
-
 	const bool searchForFirstEntry = (expHeap->expHeapHead.fields&1) == MEM_EXPHEAP_ALLOC_MODE_FIRST;
-	const int alignmentMinusOne = alignment - 1;
 
 	MBlock2_t* freeBlock = nullptr;
-	uintptr_t blockMemStart = 0;
 	uint32 foundSize = -1;
 
 	for (MBlock2_t* findBlock = expHeap->expHeapHead.chainFreeBlocks.headMBlock.GetPtr(); findBlock != nullptr; findBlock = findBlock->nextBlock.GetPtr())
 	{
-		const uintptr_t blockMemory = MBLOCK_GET_MEMORY(findBlock);
-		const uintptr_t alignedBlockMemory = (blockMemory + alignmentMinusOne) & ~alignmentMinusOne;
 		const uint32 dataSize = (uint32)findBlock->dataSize;
-
-		if (dataSize < alignedBlockMemory - blockMemory + size)
+		uintptr_t alignedBlockMemory;
+		if (!_MEMExpHeap_FitsFromHead(findBlock, size, alignment, alignedBlockMemory))
 			continue;
 
 		if (foundSize <= dataSize)
 			continue;
 
 		freeBlock = findBlock;
-		blockMemStart = alignedBlockMemory;
+		blockMemStartOut = alignedBlockMemory;
 		foundSize = dataSize;
 
 		if (searchForFirstEntry)
@@ -357,6 +563,55 @@ void* _MEMExpHeap_AllocFromHead(MEMHeapHandle heap, uint32 size, int alignment)
 		if (foundSize == size)
 			break;
 	}
+	return freeBlock;
+}
+
+void* _MEMExpHeap_AllocFromTail(MEMHeapHandle heap, uint32 size, int alignment)
+{
+	MEMExpHeapHead2* expHeap = (MEMExpHeapHead2*)heap;
+
+	const bool searchForFirstEntry = (expHeap->expHeapHead.fields&1) == MEM_EXPHEAP_ALLOC_MODE_FIRST;
+
+	MBlock2_t* freeBlock;
+	uintptr_t blockMemStart = 0;
+	ExpHeapFreeBlockIndex* index = _MEMExpHeap_GetFreeBlockIndex(expHeap);
+	if (index)
+	{
+		freeBlock = index->FindFromTail(size, alignment, searchForFirstEntry, blockMemStart);
+#ifdef CEMU_DEBUG_ASSERT
+		uintptr_t blockMemStartLinear = 0;
+		cemu_assert_debug(_MEMExpHeap_FindFreeBlockFromTailLinear(expHeap, size, alignment, blockMemStartLinear) == freeBlock && blockMemStartLinear == blockMemStart);
+#endif
+	}
+	else
+		freeBlock = _MEMExpHeap_FindFreeBlockFromTailLinear(expHeap, size, alignment, blockMemStart);
+
+	void* mem = nullptr;
+	if (freeBlock)
+		mem = _MEMExpHeap_AllocUsedBlockFromFreeBlock(&expHeap->expHeapHead.chainFreeBlocks, freeBlock, blockMemStart, size, coreinit::MEMExpHeapAllocDirection::TAIL);
+
+	return mem;
+}
+
+void* _MEMExpHeap_AllocFromHead(MEMHeapHandle heap, uint32 size, int alignment)
+{
+	MEMExpHeapHead2* expHeap = (MEMExpHeapHead2*)heap;
+
+	const bool searchForFirstEntry = (expHeap->expHeapHead.fields&1) == MEM_EXPHEAP_ALLOC_MODE_FIRST;
+
+	MBlock2_t* freeBlock;
+	uintptr_t blockMemStart = 0;
+	ExpHeapFreeBlockIndex* index = _MEMExpHeap_GetFreeBlockIndex(expHeap);
+	if (index)
+	{
+		freeBlock = index->FindFromHead(size, alignment, searchForFirstEntry, blockMemStart);
+#ifdef CEMU_DEBUG_ASSERT
+		uintptr_t blockMemStartLinear = 0;
+		cemu_assert_debug(_MEMExpHeap_FindFreeBlockFromHeadLinear(expHeap, size, alignment, blockMemStartLinear) == freeBlock && blockMemStartLinear == blockMemStart);
+#endif
+	}
+	else
+		freeBlock = _MEMExpHeap_FindFreeBlockFromHeadLinear(expHeap, size, alignment, blockMemStart);
 
 	void* mem = nullptr;
 	if (freeBlock)
@@ -387,6 +642,9 @@ MEMHeapHandle _MEMExpHeap_InitHeap(void* startAddress, void* endAddress, uint32
 	header->expHeapHead.groupID = 0;
 	header->expHeapHead.fields = 0;
 
+	ExpHeapFreeBlockIndex* index = _MEMExpHeap_CreateFreeBlockIndex(header);
+	index->Add(mBlock);
+
 	return (MEMHeapHandle)header;
 }
 
@@ -441,6 +699,7 @@ void* MEMDestroyExpHeap(MEMHeapHandle heap)
 	IsValidExpHeapHandle_(heap);
 	MEMBaseDestroyHeap(heap);
 	MEMHeapTable_Remove(heap);
+	_MEMExpHeap_DestroyFreeBlockIndex((MEMExpHeapHead2*)heap);
 	return heap;
 }
 
@@ -546,7 +805,7 @@ uint32 MEMAdjustExpHeap(MEMHeapHandle heap)
 		uintptr_t heapEnd = (uintptr_t)heap->heapEnd.GetPtr();
 		if (blockMemEnd == heapEnd)
 		{
-			_MEMExpHeap_RemoveMBlock(&expHeap->expHeapHead.chainFreeBlocks, tail);
+			_MEMExpHeap_RemoveFreeMBlock(&expHeap->expHeapHead.chainFreeBlocks, tail);
 
 			uint32 removedBlockSize = sizeof(MBlock2_t) + (uint32)tail->dataSize;
 			uintptr_t newHeapEnd = heapEnd - removedBlockSize;
@@ -594,6 +853,9 @@ uint32 MEMResizeForMBlockExpHeap(MEMHeapHandle heap, void* memBlock, uint32 size
 		{
 			MEMPTR<MBlock2_t> free = expHeap->expHeapHead.chainFreeBlocks.headMBlock;
 			const uintptr_t blockEndAddr = MBLOCK_GET_END(mBlock);
+			ExpHeapFreeBlockIndex* index = _MEMExpHeap_GetFreeBlockIndex(expHeap);
+			if (index)
+				free = index->FindFirstAtOrAfter(blockEndAddr);
 			while (free)
 			{
 				MBlock2_t* freeBlock = free.GetPtr();
@@ -608,7 +870,7 @@ uint32 MEMResizeForMBlockExpHeap(MEMHeapHandle heap, void* memBlock, uint32 size
 
 					ExpMemBlockRegion region;
 					_MEMExpHeap_GetRegionOfMBlock(&region, freeBlock);
-					MBlock2_t* prevBlock = (MBlock2_t*)_MEMExpHeap_RemoveMBlock(&expHeap->expHeapHead.chainFreeBlocks, freeBlock);
+					MBlock2_t* prevBlock = (MBlock2_t*)_MEMExpHeap_RemoveFreeMBlock(&expHeap->expHeapHead.chainFreeBlocks, freeBlock);
 
 					uintptr_t oldStart = region.start;
 					region.start = (uintptr_t)memBlock + size;
@@ -620,7 +882,7 @@ uint32 MEMResizeForMBlockExpHeap(MEMHeapHandle heap, void* memBlock, uint32 size
 					if (region.end - region.start >= sizeof(MBlock2_t))
 					{
 						MBlock2_t* newBlock = _MEMExpHeap_InitMBlock(&region, MBLOCK_TYPE_FREE);
-						_MEMExpHeap_InsertMBlock(&expHeap->expHeapHead.chainFreeBlocks, newBlock, prevBlock);
+						_MEMExpHeap_InsertFreeMBlock(&expHeap->expHeapHead.chainFreeBlocks, newBlock, prevBlock);
 					}
 
 					if (HAS_FLAG(heap->flags, MEM_HEAP_OPTION_CLEAR))
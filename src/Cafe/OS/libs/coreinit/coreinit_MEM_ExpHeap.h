@@ -49,4 +49,6 @@ namespace coreinit
 	void* MEMAllocFromExpHeapEx(MEMHeapHandle heap, uint32 size, sint32 alignment);
 	void MEMFreeToExpHeap(MEMHeapHandle heap, void* mem);
 	uint32 MEMGetAllocatableSizeForExpHeapEx(MEMHeapHandle heap, sint32 alignment);
+
+	void MEMResetExpHeapFreeBlockIndices();
 }
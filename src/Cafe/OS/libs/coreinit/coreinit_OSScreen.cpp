@@ -98,6 +98,7 @@ namespace coreinit
 		cemu_assert(screenIndex < 2);
 		cemuLog_logDebug(LogType::Force, "OSScreenFlipBuffersEx {}", screenIndex);
 		LatteGPUState.osScreen.screen[screenIndex].flipRequestCount++;
+		LatteCP_NotifyNewCommands();
 		_updateCurrentDrawScreen(screenIndex);
 		osLib_returnFromFunction(hCPU, 0);
 	}
@@ -350,6 +350,7 @@ void _GX2SubmitToTCL()
 	gx2WriteGather_submitU32AsBE(pm4HeaderType3(IT_HLE_SET_CB_RETIREMENT_TIMESTAMP, 2));
 	gx2WriteGather_submitU32AsBE((uint32)(commandBufferTimestamp>>32ULL));
 	gx2WriteGather_submitU32AsBE((uint32)(commandBufferTimestamp&0xFFFFFFFFULL));
+	LatteCP_NotifyNewCommands();
 }
 
 uint32 _GX2GetUnflushedBytes(uint32 coreIndex)
@@ -5,7 +5,11 @@
 #include "Cafe/HW/Latte/ISA/LatteReg.h"
 #include "Cafe/HW/Latte/Core/Latte.h"
 #include "Cafe/HW/Latte/LatteAddrLib/LatteAddrLib.h"
+#include "Cafe/HW/Latte/Core/LatteTextureLoader.h"
+#include "Cafe/HW/Latte/LatteAddrLib/AddrLibFastDecode.h"
+#include "Common/cpu_features.h"
 #include "util/highresolutiontimer/HighResolutionTimer.h"
+#include <random>
 
 namespace GX2
 {
@@ -413,6 +417,116 @@ namespace GX2
 		assert_dbg();
 	}
 
+	// decode a random surface with the optimized loops (SIMD micro tile kernels where available) and compare against per-pixel address calculation
+	bool _TestAddrLib_FastDecodeSurface(TextureDecoder* decoder, Latte::E_HWTILEMODE tileMode, uint32 bpp, uint32 width, uint32 height, double& fastMs, double& referenceMs)
+	{
+		uint32 bytesPerElement = bpp / 8;
+		LatteTextureLoaderCtx ctx{};
+		ctx.width = width;
+		ctx.height = height;
+		ctx.stepX = 1;
+		ctx.stepY = 1;
+		ctx.bpp = bpp;
+		ctx.tileMode = tileMode;
+		ctx.pitch = (width + 63) & ~63;
+		ctx.surfaceInfoHeight = (height + 63) & ~63;
+		ctx.surfaceInfoDepth = 1;
+		LatteAddrLib::SetupCachedSurfaceAddrInfo(&ctx.computeAddrInfo, 0, 0, bpp, ctx.pitch, ctx.surfaceInfoHeight, 1, 1, tileMode, false, 0, 0);
+		// macro tiles can extend past pitch*height, add some headroom
+		std::vector<uint8> inputData(ctx.pitch * ctx.surfaceInfoHeight * bytesPerElement * 2);
+		std::mt19937 rng(bpp * 31 + (uint32)tileMode);
+		for (auto& it : inputData)
+			it = (uint8)rng();
+		ctx.inputData = inputData.data();
+		ctx.decodedTexelCountX = decoder->getTexelCountX(&ctx);
+		ctx.decodedTexelCountY = decoder->getTexelCountY(&ctx);
+		ctx.decodeBeginY = 0;
+		ctx.decodeEndY = height;
+		std::vector<uint8> fastOutput(decoder->calculateImageSize(&ctx));
+		std::vector<uint8> referenceOutput(fastOutput.size());
+
+		BenchmarkTimer timer;
+		timer.Start();
+		decoder->decode(&ctx, fastOutput.data());
+		timer.Stop();
+		fastMs += timer.GetElapsedMilliseconds();
+
+		timer.Start();
+		for (uint32 y = 0; y < height; y++)
+		{
+			for (uint32 x = 0; x < width; x++)
+				memcpy(referenceOutput.data() + (y * ctx.decodedTexelCountX + x) * bytesPerElement, LatteTextureLoader_GetInput(&ctx, x, y), bytesPerElement);
+		}
+		timer.Stop();
+		referenceMs += timer.GetElapsedMilliseconds();
+		if (fastOutput != referenceOutput)
+			return false;
+
+		// the decoder only uses the best kernel for this CPU, check the other micro tile kernels against the reference too
+		uint32 fullTileWidth = width & ~7;
+		uint32 fullTileHeight = height & ~7;
+		uint32 outputPitch = ctx.decodedTexelCountX * bytesPerElement;
+		for (bool useAVX2 : { false, true })
+		{
+			if (useAVX2 && !g_CPUFeatures.x86.avx2)
+				continue;
+			AddrLibFastDecode_MicroTileDetileFunc detileFunc = AddrLibFastDecode_GetMicroTileDetileFunc(&ctx.computeAddrInfo, bytesPerElement, useAVX2);
+			if (!detileFunc)
+				continue;
+			std::fill(fastOutput.begin(), fastOutput.end(), 0);
+			optimizedDecodeLoop_tm04_numSamples1_8x8_kernel(&ctx, fastOutput.data(), fullTileWidth, 0, fullTileHeight, bytesPerElement, detileFunc);
+			for (uint32 y = 0; y < fullTileHeight; y++)
+			{
+				if (memcmp(fastOutput.data() + y * outputPitch, referenceOutput.data() + y * outputPitch, fullTileWidth * bytesPerElement) != 0)
+				{
+					fmt::print("AddrLib micro tile kernel mismatch: bpp {} {}x{} avx2 {}\n", bpp, width, height, useAVX2);
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	// returns false if any optimized decode differs from the reference
+	bool _TestAddrLib_FastDecode()
+	{
+		std::vector<std::pair<TextureDecoder*, uint32>> decoderList = {
+			{ TextureDecoder_R8::getInstance(), 8 },
+			{ TextureDecoder_R16_UNORM::getInstance(), 16 },
+			{ TextureDecoder_R8_G8_B8_A8::getInstance(), 32 },
+			{ TextureDecoder_R16_G16_B16_A16_FLOAT::getInstance(), 64 },
+			{ TextureDecoder_R32_G32_B32_A32_FLOAT::getInstance(), 128 },
+		};
+		std::vector<Latte::E_HWTILEMODE> tilemodeList = {
+			Latte::E_HWTILEMODE::TM_LINEAR_ALIGNED,
+			Latte::E_HWTILEMODE::TM_1D_TILED_THIN1,
+			Latte::E_HWTILEMODE::TM_2D_TILED_THIN1,
+			Latte::E_HWTILEMODE::TM_2D_TILED_THIN2,
+			Latte::E_HWTILEMODE::TM_2B_TILED_THIN1,
+		};
+		std::vector<std::pair<uint32, uint32>> resList = { {1024, 1024}, {1280, 720}, {333, 77}, {8, 8}, {5, 3} };
+
+		bool success = true;
+		for (auto& [decoder, bpp] : decoderList)
+		{
+			for (auto tileMode : tilemodeList)
+			{
+				double fastMs = 0.0;
+				double referenceMs = 0.0;
+				for (auto& [width, height] : resList)
+				{
+					if (!_TestAddrLib_FastDecodeSurface(decoder, tileMode, bpp, width, height, fastMs, referenceMs))
+					{
+						fmt::print("AddrLib fast decode mismatch: bpp {} tileMode {} {}x{}\n", bpp, (uint32)tileMode, width, height);
+						success = false;
+					}
+				}
+				fmt::print("AddrLib fast decode bpp {:3} tileMode {:2}: {:.2f}ms (per-pixel reference {:.2f}ms)\n", bpp, (uint32)tileMode, fastMs, referenceMs);
+			}
+		}
+		return success;
+	}
+
 	void _test_AddrLib()
 	{
 		return;
@@ -2,6 +2,7 @@
 #include "Cafe/HW/Latte/Core/LatteDraw.h"
 #include "Cafe/OS/common/OSCommon.h"
 #include "Cafe/HW/Latte/Core/LattePM4.h"
+#include "Cafe/HW/Latte/Core/LattePerformanceMonitor.h"
 #include "Cafe/OS/libs/coreinit/coreinit.h"
 #include "Cafe/OS/libs/coreinit/coreinit_Thread.h"
 #include "Cafe/HW/Latte/ISA/RegDefines.h"
@@ -14,31 +15,75 @@ extern uint8* gxRingBufferReadPtr;
 
 GX2WriteGatherPipeState gx2WriteGatherPipe = { 0 };
 
+static void _GX2WriteGather_insertWrapAroundMark(uint32 coreIndex)
+{
+	uint32be* writePtr = (uint32be*)gx2WriteGatherPipe.writeGatherPtrGxBuffer[coreIndex];
+	writePtr[0] = pm4HeaderType3(IT_HLE_FIFO_WRAP_AROUND, 1);
+	writePtr[1] = 0; // empty word since we can't send commands with zero data words
+	gx2WriteGather_commit(coreIndex, writePtr + 2);
+	gx2WriteGatherPipe.writeGatherPtrGxBuffer[coreIndex] = gx2WriteGatherPipe.gxRingBuffer;
+	LatteCP_NotifyNewCommands();
+}
+
+uint32be* gx2WriteGather_reserve(uint32 coreIndex, uint32 numWords)
+{
+	uint8** writePtr = gx2WriteGatherPipe.writeGatherPtrWrite[coreIndex];
+	if (writePtr == nullptr)
+		return nullptr;
+	if (writePtr == &gx2WriteGatherPipe.writeGatherPtrGxBuffer[coreIndex])
+	{
+		// GX2WriteGather_checkAndInsertWrapAroundMark() usually restarts the ring long before the end is reached, but large packets (e.g. copied display lists) are not allowed to overflow it either
+		uint32 writeDistance = (uint32)(*writePtr - gx2WriteGatherPipe.gxRingBuffer);
+		if (writeDistance + (numWords + 2) * sizeof(uint32be) > GX2_COMMAND_RING_BUFFER_SIZE)
+			_GX2WriteGather_insertWrapAroundMark(coreIndex);
+	}
+	auto& perfCycle = performanceMonitor.cycle[performanceMonitor.cycleIndex];
+	perfCycle.gx2CmdWords += numWords;
+	perfCycle.gx2CmdWrites++;
+	return (uint32be*)*writePtr;
+}
+
 void gx2WriteGather_submitU32AsBE(uint32 v)
 {
 	uint32 coreIndex = PPCInterpreter_getCoreIndex(PPCInterpreter_getCurrentInstance());
-	if (gx2WriteGatherPipe.writeGatherPtrWrite[coreIndex] == NULL)
+	uint32be* writePtr = gx2WriteGather_reserve(coreIndex, 1);
+	if (writePtr == nullptr)
 		return;
-	*(uint32*)(*gx2WriteGatherPipe.writeGatherPtrWrite[coreIndex]) = _swapEndianU32(v);
-	(*gx2WriteGatherPipe.writeGatherPtrWrite[coreIndex]) += 4;
+	*writePtr = v;
+	gx2WriteGather_commit(coreIndex, writePtr + 1);
 }
 
 void gx2WriteGather_submitU32AsLE(uint32 v)
 {
 	uint32 coreIndex = PPCInterpreter_getCoreIndex(PPCInterpreter_getCurrentInstance());
-	if (gx2WriteGatherPipe.writeGatherPtrWrite[coreIndex] == NULL)
+	uint32be* writePtr = gx2WriteGather_reserve(coreIndex, 1);
+	if (writePtr == nullptr)
 		return;
-	*(uint32*)(*gx2WriteGatherPipe.writeGatherPtrWrite[coreIndex]) = v;
-	(*gx2WriteGatherPipe.writeGatherPtrWrite[coreIndex]) += 4;
+	*(uint32*)writePtr = v;
+	gx2WriteGather_commit(coreIndex, writePtr + 1);
 }
 
+// copies words which are already big-endian
 void gx2WriteGather_submitU32AsLEArray(uint32* v, uint32 numValues)
 {
 	uint32 coreIndex = PPCInterpreter_getCoreIndex(PPCInterpreter_getCurrentInstance());
-	if (gx2WriteGatherPipe.writeGatherPtrWrite[coreIndex] == NULL)
+	uint32be* writePtr = gx2WriteGather_reserve(coreIndex, numValues);
+	if (writePtr == nullptr)
 		return;
-	memcpy_dwords((*gx2WriteGatherPipe.writeGatherPtrWrite[coreIndex]), v, numValues);
-	(*gx2WriteGatherPipe.writeGatherPtrWrite[coreIndex]) += 4 * numValues;
+	memcpy_dwords(writePtr, v, numValues);
+	gx2WriteGather_commit(coreIndex, writePtr + numValues);
+}
+
+void gx2WriteGather_submitPacketWithData(uint32 pm4Header, uint32 firstWord, const uint32be* data, uint32 numDataWords)
+{
+	uint32 coreIndex = PPCInterpreter_getCoreIndex(PPCInterpreter_getCurrentInstance());
+	uint32be* writePtr = gx2WriteGather_reserve(coreIndex, 2 + numDataWords);
+	if (writePtr == nullptr)
+		return;
+	writePtr[0] = pm4Header;
+	writePtr[1] = firstWord;
+	memcpy_dwords(writePtr + 2, data, numDataWords);
+	gx2WriteGather_commit(coreIndex, writePtr + 2 + numDataWords);
 }
 
 namespace GX2
@@ -171,11 +216,7 @@ namespace GX2
 			return;
 		uint32 writeDistance = GX2WriteGather_getFifoWriteDistance(coreIndex);
 		if (writeDistance >= (GX2_COMMAND_RING_BUFFER_SIZE * 3 / 5))
-		{
-			gx2WriteGather_submitU32AsBE(pm4HeaderType3(IT_HLE_FIFO_WRAP_AROUND, 1));
-			gx2WriteGather_submitU32AsBE(0); // empty word since we can't send commands with zero data words
-			gx2WriteGatherPipe.writeGatherPtrGxBuffer[coreIndex] = gx2WriteGatherPipe.gxRingBuffer;
-		}
+			_GX2WriteGather_insertWrapAroundMark(coreIndex);
 	}
 
 	void GX2BeginDisplayList(MEMPTR<void> displayListAddr, uint32 size)
@@ -205,6 +246,7 @@ namespace GX2
 			0, // high address bits
 			size / 4);
 		GX2::GX2WriteGather_checkAndInsertWrapAroundMark();
+		LatteCP_NotifyNewCommands();
 	}
 
 	void GX2DirectCallDisplayList(void* addr, uint32 size)
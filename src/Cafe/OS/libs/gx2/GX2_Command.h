@@ -17,17 +17,40 @@ extern GX2WriteGatherPipeState gx2WriteGatherPipe;
 
 void GX2ReserveCmdSpace(uint32 reservedFreeSpaceInU32); // move to GX2 namespace eventually
 
+uint32 PPCInterpreter_getCurrentCoreIndex();
+
+// bulk submission
+// reserves numWords in the current write target (GX2 ring buffer or display list) of the core and returns a pointer to the contiguous span
+// returns nullptr if the core has no write target. The written words become visible to the command processor with gx2WriteGather_commit()
+// a reserved span never crosses the end of the ring buffer, so wrap-around is handled once per packet
+uint32be* gx2WriteGather_reserve(uint32 coreIndex, uint32 numWords);
+
+inline uint32be* gx2WriteGather_reserve(uint32 numWords)
+{
+	return gx2WriteGather_reserve(PPCInterpreter_getCurrentCoreIndex(), numWords);
+}
+
+inline void gx2WriteGather_commit(uint32 coreIndex, uint32be* writeEnd)
+{
+	std::atomic_ref<uint8*>(*gx2WriteGatherPipe.writeGatherPtrWrite[coreIndex]).store((uint8*)writeEnd, std::memory_order_release);
+}
+
+inline void gx2WriteGather_commit(uint32be* writeEnd)
+{
+	gx2WriteGather_commit(PPCInterpreter_getCurrentCoreIndex(), writeEnd);
+}
+
 void gx2WriteGather_submitU32AsBE(uint32 v);
 void gx2WriteGather_submitU32AsLE(uint32 v);
 void gx2WriteGather_submitU32AsLEArray(uint32* v, uint32 numValues);
-
-uint32 PPCInterpreter_getCurrentCoreIndex();
+// type 3 packet made of the header, one leading data word (usually the register offset) and a block of big-endian words copied as-is
+void gx2WriteGather_submitPacketWithData(uint32 pm4Header, uint32 firstWord, const uint32be* data, uint32 numDataWords);
 
 // gx2WriteGather_submit functions
 template <typename ...Targs>
 inline void gx2WriteGather_submit_(uint32 coreIndex, uint32be* writePtr)
 {
-	(*gx2WriteGatherPipe.writeGatherPtrWrite[coreIndex]) = (uint8*)writePtr;
+	gx2WriteGather_commit(coreIndex, writePtr);
 }
 
 template <typename T, typename ...Targs>
@@ -75,10 +98,9 @@ template <typename ...Targs>
 inline void gx2WriteGather_submit(Targs... args)
 {
 	uint32 coreIndex = PPCInterpreter_getCurrentCoreIndex();
-	if (gx2WriteGatherPipe.writeGatherPtrWrite[coreIndex] == nullptr)
+	uint32be* writePtr = gx2WriteGather_reserve(coreIndex, sizeof...(Targs));
+	if (writePtr == nullptr)
 		return;
-
-	uint32be* writePtr = (uint32be*)(*gx2WriteGatherPipe.writeGatherPtrWrite[coreIndex]);
 	gx2WriteGather_submit_(coreIndex, writePtr, std::forward<Targs>(args)...);
 }
 
@@ -185,14 +185,19 @@ void _GX2Context_WriteCmdDisableStateShadowing()
 void _GX2Context_cmdLoad(void* gx2ukn, uint32 pm4Header, MPTR physAddrRegArea, uint32 waitForIdle, uint32 numRegOffsetEntries, GX2RegLoadPktEntry_t* regOffsetEntries)
 {
 	GX2ReserveCmdSpace(3 + numRegOffsetEntries*2);
-	gx2WriteGather_submitU32AsBE(pm4Header);
-	gx2WriteGather_submitU32AsBE(physAddrRegArea);
-	gx2WriteGather_submitU32AsBE(waitForIdle);
+	uint32 coreIndex = PPCInterpreter_getCurrentCoreIndex();
+	uint32be* cmd = gx2WriteGather_reserve(coreIndex, 3 + numRegOffsetEntries*2);
+	if (cmd == nullptr)
+		return;
+	cmd[0] = pm4Header;
+	cmd[1] = physAddrRegArea;
+	cmd[2] = waitForIdle;
 	for(uint32 i=0; i<numRegOffsetEntries; i++)
 	{
-		gx2WriteGather_submitU32AsBE(regOffsetEntries[i].regOffset); // regOffset
-		gx2WriteGather_submitU32AsBE(regOffsetEntries[i].regCount); // regCount
+		cmd[3 + i*2 + 0] = regOffsetEntries[i].regOffset;
+		cmd[3 + i*2 + 1] = regOffsetEntries[i].regCount;
 	}
+	gx2WriteGather_commit(coreIndex, cmd + 3 + numRegOffsetEntries*2);
 }
 
 #define __cmdStateLoad(__gx2State, __pm4Command, __regArea, __waitForIdle, __regLoadPktEntries) _GX2Context_cmdLoad(NULL, pm4HeaderType3(__pm4Command, 2+sizeof(__regLoadPktEntries)/sizeof(__regLoadPktEntries[0])*2), memory_virtualToPhysical(memory_getVirtualOffsetFromPointer(__regArea)), __waitForIdle, sizeof(__regLoadPktEntries)/sizeof(__regLoadPktEntries[0]), __regLoadPktEntries)
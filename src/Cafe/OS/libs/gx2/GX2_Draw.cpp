@@ -141,40 +141,42 @@ namespace GX2
 			return;
 		}
 
-		// set base vertex
-		gx2WriteGather_submitU32AsBE(pm4HeaderType3(IT_SET_CTL_CONST, 2));
-		gx2WriteGather_submitU32AsBE(0);
-		gx2WriteGather_submitU32AsBE(baseVertex);
-		// set primitive mode
-		gx2WriteGather_submitU32AsBE(pm4HeaderType3(IT_SET_CONFIG_REG, 2));
-		gx2WriteGather_submitU32AsBE(Latte::REGADDR::VGT_PRIMITIVE_TYPE - 0x2000);
-		gx2WriteGather_submitU32AsBE((uint32)primitiveMode);
-		// set index type
-		gx2WriteGather_submitU32AsBE(pm4HeaderType3(IT_INDEX_TYPE, 1));
-		gx2WriteGather_submitU32AsBE((uint32)indexType);
-		// set number of instances
-		gx2WriteGather_submitU32AsBE(pm4HeaderType3(IT_NUM_INSTANCES, 1));
-		gx2WriteGather_submitU32AsBE((uint32)numInstances);
+		gx2WriteGather_submit(
+			// set base vertex
+			pm4HeaderType3(IT_SET_CTL_CONST, 2), 0,
+			baseVertex,
+			// set primitive mode
+			pm4HeaderType3(IT_SET_CONFIG_REG, 2), Latte::REGADDR::VGT_PRIMITIVE_TYPE - 0x2000,
+			(uint32)primitiveMode,
+			// set index type
+			pm4HeaderType3(IT_INDEX_TYPE, 1),
+			(uint32)indexType,
+			// set number of instances
+			pm4HeaderType3(IT_NUM_INSTANCES, 1),
+			numInstances);
 		// request indexed draw with indices embedded into command buffer
-		gx2WriteGather_submitU32AsBE(pm4HeaderType3(IT_DRAW_INDEX_IMMD, 2 + numIndexU32s) | 0x00000001);
-		gx2WriteGather_submitU32AsBE(count);
-		gx2WriteGather_submitU32AsBE(0); // ukn
-		if (use32BitIndices)
+		uint32 coreIndex = PPCInterpreter_getCurrentCoreIndex();
+		uint32be* cmd = gx2WriteGather_reserve(coreIndex, 3 + numIndexU32s);
+		if (cmd)
 		{
-			for (uint32 i = 0; i < numIndexU32s; i++)
+			cmd[0] = pm4HeaderType3(IT_DRAW_INDEX_IMMD, 2 + numIndexU32s) | 0x00000001;
+			cmd[1] = count;
+			cmd[2] = 0; // ukn
+			if (use32BitIndices)
 			{
-				gx2WriteGather_submitU32AsLE(indexDataU32[i]);
+				memcpy_dwords(cmd + 3, indexDataU32, numIndexU32s);
 			}
-		}
-		else
-		{
-			for (uint32 i = 0; i < numIndexU32s; i++)
+			else
 			{
-				uint32 indexPair = indexDataU32[i];
-				// swap index pair
-				indexPair = (indexPair >> 16) | (indexPair << 16);
-				gx2WriteGather_submitU32AsLE(indexPair);
+				uint32* indexOutput = (uint32*)(cmd + 3);
+				for (uint32 i = 0; i < numIndexU32s; i++)
+				{
+					uint32 indexPair = indexDataU32[i];
+					// swap index pair
+					indexOutput[i] = (indexPair >> 16) | (indexPair << 16);
+				}
 			}
+			gx2WriteGather_commit(coreIndex, cmd + 3 + numIndexU32s);
 		}
 
 		GX2::GX2WriteGather_checkAndInsertWrapAroundMark();
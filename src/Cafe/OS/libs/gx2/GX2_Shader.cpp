@@ -363,10 +363,7 @@ namespace GX2
 
 			uint32 numOutputIds = vertexShader->regs.vsOutIdTableSize;
 			numOutputIds = std::min<uint32>(numOutputIds, 0xA);
-			gx2WriteGather_submitU32AsBE(pm4HeaderType3(IT_SET_CONTEXT_REG, 1+numOutputIds));
-			gx2WriteGather_submitU32AsBE(Latte::REGADDR::SPI_VS_OUT_ID_0-0xA000);
-			for(uint32 i=0; i<numOutputIds; i++)
-				gx2WriteGather_submitU32AsBE(vertexShader->regs.LATTE_SPI_VS_OUT_ID_N[i].value().getRawValue());
+			gx2WriteGather_submitPacketWithData(pm4HeaderType3(IT_SET_CONTEXT_REG, 1+numOutputIds), Latte::REGADDR::SPI_VS_OUT_ID_0-0xA000, (uint32be*)vertexShader->regs.LATTE_SPI_VS_OUT_ID_N, numOutputIds);
 
 			// todo: SQ_PGM_CF_OFFSET_VS
 			// todo: VGT_STRMOUT_BUFFER_EN
@@ -408,11 +405,9 @@ namespace GX2
 			}
 			else
 			{
-				uint32* vsSemanticTable = (uint32*)vertexShader->regs.SQ_VTX_SEMANTIC_N;
+				uint32be* vsSemanticTable = (uint32be*)vertexShader->regs.SQ_VTX_SEMANTIC_N;
 				vsSemanticTableSize = std::min<uint32>(vsSemanticTableSize, 32);
-				gx2WriteGather_submitU32AsBE(pm4HeaderType3(IT_SET_CONTEXT_REG, 1+vsSemanticTableSize));
-				gx2WriteGather_submitU32AsBE(Latte::REGADDR::SQ_VTX_SEMANTIC_0-0xA000);
-				gx2WriteGather_submitU32AsLEArray(vsSemanticTable, vsSemanticTableSize);
+				gx2WriteGather_submitPacketWithData(pm4HeaderType3(IT_SET_CONTEXT_REG, 1+vsSemanticTableSize), Latte::REGADDR::SQ_VTX_SEMANTIC_0-0xA000, vsSemanticTable, vsSemanticTableSize);
 			}
 		}
 	}
@@ -434,8 +429,7 @@ namespace GX2
 			sizeInU32s &= ~3;
 		}
 		GX2ReserveCmdSpace(2 + sizeInU32s);
-		gx2WriteGather_submit(pm4HeaderType3(IT_SET_ALU_CONST, 1 + sizeInU32s), offsetRegBase + aluRegisterOffset);
-		gx2WriteGather_submitU32AsLEArray((uint32*)dataWords, sizeInU32s);
+		gx2WriteGather_submitPacketWithData(pm4HeaderType3(IT_SET_ALU_CONST, 1 + sizeInU32s), offsetRegBase + aluRegisterOffset, dataWords, sizeInU32s);
 	}
 
 	void GX2SetVertexUniformReg(uint32 offset, uint32 sizeInU32s, uint32be* values)
@@ -47,13 +47,7 @@ void gx2Export_GX2SetPixelShader(PPCInterpreter_t* hCPU)
 	uint32 numInputs = _swapEndianU32(pixelShader->regs[4]);
 	if( numInputs > 0x20 )
 		numInputs = 0x20;
-	gx2WriteGather_submitU32AsBE(pm4HeaderType3(IT_SET_CONTEXT_REG, 1+numInputs));
-	gx2WriteGather_submitU32AsBE(mmSPI_PS_INPUT_CNTL_0-0xA000);
-	for(uint32 i=0; i<numInputs; i++)
-	{
-		uint32 inputData = _swapEndianU32(pixelShader->regs[5+i]);
-		gx2WriteGather_submitU32AsBE(inputData);
-	}
+	gx2WriteGather_submitPacketWithData(pm4HeaderType3(IT_SET_CONTEXT_REG, 1+numInputs), mmSPI_PS_INPUT_CNTL_0-0xA000, (uint32be*)(pixelShader->regs+5), numInputs);
 
 	gx2WriteGather_submit(
 		/* mmCB_SHADER_MASK */
@@ -184,12 +178,7 @@ void gx2Export_GX2SetGeometryShader(PPCInterpreter_t* hCPU)
 	numOutputIds = std::min<uint32>(numOutputIds, 0xA);
 	if( numOutputIds != 0 )
 	{
-		gx2WriteGather_submitU32AsBE(pm4HeaderType3(IT_SET_CONTEXT_REG, 1+numOutputIds));
-		gx2WriteGather_submitU32AsBE(mmSPI_VS_OUT_ID_0-0xA000);
-		for(uint32 i=0; i<numOutputIds; i++)
-		{
-			gx2WriteGather_submitU32AsBE(_swapEndianU32(geometryShader->regs[8+i]));
-		}
+		gx2WriteGather_submitPacketWithData(pm4HeaderType3(IT_SET_CONTEXT_REG, 1+numOutputIds), mmSPI_VS_OUT_ID_0-0xA000, (uint32be*)(geometryShader->regs+8), numOutputIds);
 	}
 
 	// output config
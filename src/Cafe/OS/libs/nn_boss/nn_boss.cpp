@@ -8,6 +8,7 @@
 #include "config/ActiveSettings.h"
 #include "Cafe/CafeSystem.h"
 #include "Cafe/Filesystem/fsc.h"
+#include "Cafe/HW/MMU/WriteTracker.h"
 
 namespace nn
 {
@@ -1534,7 +1535,9 @@ bossBufferVector->buffer = (uint8*)bossRequest;
 			}
 			// read
 			fsc_setFileSeek(fscStorageFile, (uint32)_swapEndianU64(nsData->readIndex));
+			WriteTracker::BeginHostWrite(buffer, std::max(readBytes, 0));
 			fsc_readFile(fscStorageFile, buffer, readBytes);
+			WriteTracker::EndHostWrite(buffer, std::max(readBytes, 0));
 			nsData->readIndex = _swapEndianU64((sint32)_swapEndianU64(nsData->readIndex) + readBytes);
 
 			// close file
@@ -5,6 +5,7 @@
 #include "Cafe/OS/libs/coreinit/coreinit_Time.h"
 
 #include "Common/socket.h"
+#include "Cafe/HW/MMU/WriteTracker.h"
 
 #if BOOST_OS_UNIX
 
@@ -1080,8 +1081,10 @@ void nsysnetExport_recv(PPCInterpreter_t* hCPU)
 		}
 		_setSocketSendRecvNonBlockingMode(vs->s, requestIsNonBlocking);
 	}
-	// receive
+	// receive. The host socket writes directly into guest memory
+	WriteTracker::BeginHostWrite(msg, std::max(len, 0));
 	sint32 hr = recv(vs->s, msg, len, hostFlags);
+	WriteTracker::EndHostWrite(msg, std::max(len, 0));
 	_translateError(hr <= 0 ? -1 : 0, GETLASTERR);
 	if (requestIsNonBlocking != vs->isNonBlocking)
 		_setSocketSendRecvNonBlockingMode(vs->s, vs->isNonBlocking);
@@ -1652,9 +1655,11 @@ void nsysnetExport_recvfrom(PPCInterpreter_t* hCPU)
 			}
 			if (FD_ISSET(vs->s, &fd_read))
 			{
-				// data available
+				// data available. The host socket writes directly into guest memory
+				WriteTracker::BeginHostWrite(msg, std::max(len, 0));
 				r = recvfrom(vs->s, msg, len, hostFlags, &fromAddrHost, &fromLenHost);
 				wsaError = GETLASTERR;
+				WriteTracker::EndHostWrite(msg, std::max(len, 0));
 				if (r < 0)
 					cemu_assert_debug(false);
 				cemuLog_logDebug(LogType::Force, "recvfrom returned {} bytes", r);
@@ -1694,8 +1699,10 @@ void nsysnetExport_recvfrom(PPCInterpreter_t* hCPU)
 		_setSocketSendRecvNonBlockingMode(vs->s, true);
 		while (true)
 		{
+			WriteTracker::BeginHostWrite(msg, std::max(len, 0));
 			r = recvfrom(vs->s, msg, len, hostFlags, &fromAddrHost, &fromLenHost);
 			wsaError = GETLASTERR;
+			WriteTracker::EndHostWrite(msg, std::max(len, 0));
 			if (r < 0)
 			{
 				if (wsaError != WSAEWOULDBLOCK)
@@ -1807,9 +1814,11 @@ void nsysnetExport_recvfrom_ex(PPCInterpreter_t* hCPU)
 			}
 			if (FD_ISSET(vs->s, &fd_read))
 			{
-				// data available
+				// data available. The host socket writes directly into guest memory
+				WriteTracker::BeginHostWrite(msg, std::max(len, 0));
 				r = recvfrom(vs->s, msg, len, hostFlags, &fromAddrHost, &fromLenHost);
 				wsaError = GETLASTERR;
+				WriteTracker::EndHostWrite(msg, std::max(len, 0));
 				if (r < 0)
 				{
 					cemu_assert_debug(false);
@@ -505,21 +505,25 @@ void FileCache::AddFileAsync(const FileName& name, const uint8* fileData, sint32
 	FileCacheAsyncWriter.AddJob(this, name, fileData, fileSize);
 }
 
-bool FileCache::_getFileDataInternal(const FileTableEntry* entry, std::vector<uint8>& dataOut)
+// reads the stored data of an entry. Caller must hold the mutex
+void FileCache::_getRawFileDataInternal(const FileTableEntry* entry, std::vector<uint8>& rawDataOut, bool& isCompressedOut)
 {
-	std::vector<uint8> rawData(entry->fileSize);
-
+	rawDataOut.resize(entry->fileSize);
 	fileStream->SetPosition(this->dataOffset + entry->fileOffset);
-	fileStream->readData(rawData.data(), entry->fileSize);
+	fileStream->readData(rawDataOut.data(), entry->fileSize);
+	isCompressedOut = (entry->flags&FileTableEntry::FLAG_COMPRESSED) != 0;
+}
 
-	if ((entry->flags&FileTableEntry::FLAG_COMPRESSED) == 0)
+// turns the stored data into the file data. Does not access the cache, so the mutex is not held while decompressing
+bool _decodeRawFileData(std::vector<uint8>& rawData, bool isCompressed, std::vector<uint8>& dataOut)
+{
+	if (!isCompressed)
 	{
 		// uncompressed
 		std::swap(rawData, dataOut);
 		return true;
 	}
 	// decompress
-	sint32 uncompressedSize = 0;
 	if (!_uncompressFileData(rawData.data(), rawData.size(), dataOut))
 	{
 		dataOut.clear();
@@ -530,6 +534,8 @@ bool FileCache::_getFileDataInternal(const FileTableEntry* entry, std::vector<ui
 
 bool FileCache::GetFile(const FileName&& name, std::vector<uint8>& dataOut)
 {
+	std::vector<uint8> rawData;
+	bool isCompressed = false;
 	std::unique_lock lock(this->mutex);
 	FileTableEntry* entry = this->fileTableEntries;
 	FileTableEntry* entryLast = this->fileTableEntries+this->fileTableEntryCount;
@@ -537,7 +543,9 @@ bool FileCache::GetFile(const FileName&& name, std::vector<uint8>& dataOut)
 	{
 		if( entry->name1 == name.name1 && entry->name2 == name.name2 )
 		{
-			return _getFileDataInternal(entry, dataOut);
+			_getRawFileDataInternal(entry, rawData, isCompressed);
+			lock.unlock();
+			return _decodeRawFileData(rawData, isCompressed, dataOut);
 		}
 		entry++;
 	}
@@ -547,25 +555,43 @@ bool FileCache::GetFile(const FileName&& name, std::vector<uint8>& dataOut)
 
 bool FileCache::GetFileByIndex(sint32 index, uint64* name1, uint64* name2, std::vector<uint8>& dataOut)
 {
+	std::vector<uint8> rawData;
+	bool isCompressed = false;
+	std::unique_lock lock(this->mutex);
 	if (index < 0 || index >= this->fileTableEntryCount)
 		return false;
-	FileTableEntry* entry = this->fileTableEntries + index;
 	if (this->fileTableEntries == nullptr)
 	{
 		cemuLog_log(LogType::Force, "GetFileByIndex() fileTable is NULL");
 		return false;
 	}
+	FileTableEntry* entry = this->fileTableEntries + index;
 	if (entry->name1 == FILECACHE_FILETABLE_FREE_NAME && entry->name2 == FILECACHE_FILETABLE_FREE_NAME)
 		return false;
 	if (entry->name1 == FILECACHE_FILETABLE_NAME1 && entry->name2 == FILECACHE_FILETABLE_NAME2)
 		return false;
-
-	std::unique_lock lock(this->mutex);
 	if(name1)
 		*name1 = entry->name1;
 	if(name2)
 		*name2 = entry->name2;
-	return _getFileDataInternal(entry, dataOut);
+	_getRawFileDataInternal(entry, rawData, isCompressed);
+	lock.unlock();
+	return _decodeRawFileData(rawData, isCompressed, dataOut);
+}
+
+bool FileCache::GetFileNameByIndex(sint32 index, uint64& name1, uint64& name2)
+{
+	std::unique_lock lock(this->mutex);
+	if (index < 0 || index >= this->fileTableEntryCount || this->fileTableEntries == nullptr)
+		return false;
+	FileTableEntry* entry = this->fileTableEntries + index;
+	if (entry->name1 == FILECACHE_FILETABLE_FREE_NAME && entry->name2 == FILECACHE_FILETABLE_FREE_NAME)
+		return false;
+	if (entry->name1 == FILECACHE_FILETABLE_NAME1 && entry->name2 == FILECACHE_FILETABLE_NAME2)
+		return false;
+	name1 = entry->name1;
+	name2 = entry->name2;
+	return true;
 }
 
 bool FileCache::HasFile(const FileName&& name)
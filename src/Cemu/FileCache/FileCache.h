@@ -46,6 +46,7 @@ public:
 	bool DeleteFile(const FileName&& name);
 	bool GetFile(const FileName&& name, std::vector<uint8>& dataOut);
 	bool GetFileByIndex(sint32 index, uint64* name1, uint64* name2, std::vector<uint8>& dataOut);
+	bool GetFileNameByIndex(sint32 index, uint64& name1, uint64& name2);
 	bool HasFile(const FileName&& name);
 
 	sint32 GetFileCount();
@@ -78,7 +79,7 @@ private:
 
 	void fileCache_updateFiletable(sint32 extraEntriesToAllocate);
 	void _addFileInternal(uint64 name1, uint64 name2, const uint8* fileData, sint32 fileSize, bool noCompression);
-	bool _getFileDataInternal(const FileTableEntry* entry, std::vector<uint8>& dataOut);
+	void _getRawFileDataInternal(const FileTableEntry* entry, std::vector<uint8>& rawDataOut, bool& isCompressedOut);
 
 	class FileStream* fileStream{};
 	uint64 dataOffset{};
@@ -55,6 +55,7 @@ const std::map<LogType, std::string> g_logging_window_mapping
 	{LogType::NFC,                "NFC"},
 	{LogType::NTAG,               "NTAG"},
 	{LogType::Patches,            "Graphic pack patches"},
+	{LogType::RPLLoader,          "RPL loader"},
 	{LogType::TextureCache,       "Texture cache"},
 	{LogType::TextureReadback,    "Texture readback"},
 	{LogType::OpenGLLogging,      "OpenGL debug output"},
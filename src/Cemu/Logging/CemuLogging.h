@@ -21,6 +21,7 @@ enum class LogType : sint32
 	TextureCache = 11, // texture cache warnings and info
 	VulkanValidation = 12, // Vulkan validation layer
 	Patches = 14,
+	RPLLoader = 27, // module load timings
 	CoreinitMem = 8, // coreinit memory functions
 	CoreinitMP = 15,
 	CoreinitThread = 16,
@@ -8,6 +8,7 @@
 
 #include "Cafe/HW/Espresso/Debugger/GDBStub.h"
 #include "Cafe/HW/Espresso/Debugger/GDBBreakpoints.h"
+#include "Cafe/HW/MMU/WriteTracker.h"
 
 #if BOOST_OS_LINUX
 #include "ELFSymbolTable.h"
@@ -74,6 +75,10 @@ void handlerDumpingSignal(int sig, siginfo_t *info, void *context)
 	}
 #endif
 
+	// write to a page protected by the GPU memory write tracker
+	if ((sig == SIGSEGV || sig == SIGBUS) && WriteTracker::HandleAccessViolation(info->si_addr))
+		return;
+
     if(!CrashLog_Create())
         return; // give up if crashlog was already created
 
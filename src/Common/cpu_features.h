@@ -2,10 +2,12 @@
 #ifdef __GNUC__
 #define ATTRIBUTE_AVX2 __attribute__((target("avx2")))
 #define ATTRIBUTE_SSE41 __attribute__((target("sse4.1")))
+#define ATTRIBUTE_SSSE3 __attribute__((target("ssse3")))
 #define ATTRIBUTE_AESNI __attribute__((target("aes")))
 #else
 #define ATTRIBUTE_AVX2
 #define ATTRIBUTE_SSE41
+#define ATTRIBUTE_SSSE3
 #define ATTRIBUTE_AESNI
 #endif
 
@@ -23,6 +25,7 @@ public:
 		bool sse4_1{ false };
 		bool avx{ false };
 		bool avx2{ false };
+		bool avx512f{ false }; // only set if the OS saves the AVX-512 register state
 		bool lzcnt{ false };
 		bool movbe{ false };
 		bool bmi2{ false };
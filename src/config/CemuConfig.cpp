@@ -219,6 +219,13 @@ void CemuConfig::Load(XMLConfigParser& parser)
 	downscale_filter = graphic.get("DownscaleFilter", kLinearFilter);
 	fullscreen_scaling = graphic.get("FullscreenScaling", kKeepAspectRatio);
 	async_compile = graphic.get("AsyncCompile", async_compile);
+	gpu_write_tracking = graphic.get("GPUMemoryWriteTracking", false);
+	frame_pacing_mode = graphic.get("FramePacingMode", 0);
+	occlusion_query_latency = graphic.get("OcclusionQueryLatency", false);
+	shader_cache_decompiled = graphic.get("DecompiledShaderCache", false);
+	pipeline_prewarm_seconds = graphic.get("PipelinePrewarmSeconds", 60);
+	pipeline_prewarm_threads = graphic.get("PipelinePrewarmThreads", 0);
+	pipeline_prewarm_memory = graphic.get("PipelinePrewarmMemory", 256);
 	vk_accurate_barriers = graphic.get("vkAccurateBarriers", true); // this used to be "VulkanAccurateBarriers" but because we changed the default to true in 1.27.1 the option name had to be changed
 
 	auto overlay_node = graphic.get("Overlay");
@@ -233,6 +240,7 @@ void CemuConfig::Load(XMLConfigParser& parser)
 		overlay.cpu_per_core_usage = overlay_node.get("CPUPerCoreUsage", false);
 		overlay.ram_usage = overlay_node.get("RAMUsage", false);
 		overlay.vram_usage = overlay_node.get("VRAMUsage", false);
+		overlay.frame_pacing = overlay_node.get("FramePacing", false);
 		overlay.debug = overlay_node.get("Debug", false);
 
 		notification.controller_profiles = overlay_node.get("ControllerProfiles", true);
@@ -476,6 +484,13 @@ void CemuConfig::Save(XMLConfigParser& parser)
 	graphic.set("FullscreenScaling", fullscreen_scaling);
 	graphic.set("AsyncCompile", async_compile.GetValue());
 	graphic.set("vkAccurateBarriers", vk_accurate_barriers);
+	graphic.set("GPUMemoryWriteTracking", gpu_write_tracking);
+	graphic.set("FramePacingMode", frame_pacing_mode);
+	graphic.set("OcclusionQueryLatency", occlusion_query_latency);
+	graphic.set("DecompiledShaderCache", shader_cache_decompiled);
+	graphic.set("PipelinePrewarmSeconds", pipeline_prewarm_seconds);
+	graphic.set("PipelinePrewarmThreads", pipeline_prewarm_threads);
+	graphic.set("PipelinePrewarmMemory", pipeline_prewarm_memory);
 
 	auto overlay_node = graphic.set("Overlay");
 	overlay_node.set("Position", overlay.position);
@@ -487,6 +502,7 @@ void CemuConfig::Save(XMLConfigParser& parser)
 	overlay_node.set("CPUPerCoreUsage", overlay.cpu_per_core_usage);
 	overlay_node.set("RAMUsage", overlay.ram_usage);
 	overlay_node.set("VRAMUsage", overlay.vram_usage);
+	overlay_node.set("FramePacing", overlay.frame_pacing);
 	overlay_node.set("Debug", overlay.debug);
 
 	auto notification_node = graphic.set("Notification");
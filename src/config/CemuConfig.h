@@ -445,6 +445,14 @@ struct CemuConfig
 	ConfigValue<bool> async_compile{ true };
 
 	ConfigValue<bool> vk_accurate_barriers{ true };
+	ConfigValue<bool> gpu_write_tracking{ false }; // detect guest writes to GPU resources via page protection instead of hashing
+	ConfigValue<sint32> frame_pacing_mode{ 0 }; // 0 = off, 1 = align guest vsync to the display, 2 = low latency (see FramePacingMode)
+	ConfigValue<bool> occlusion_query_latency{ false }; // GPU syncs don't wait for occlusion queries, pending queries report the previous result of the same query instead
+	ConfigValue<bool> shader_cache_decompiled{ false }; // store decompiler output next to the precompiled shader cache so loading can skip decompilation
+	// Vulkan pipeline cache prewarming. Pipelines which were first used later than pipeline_prewarm_seconds after boot are compiled in the background
+	ConfigValue<sint32> pipeline_prewarm_seconds{ 60 }; // 0 compiles all cached pipelines before boot
+	ConfigValue<sint32> pipeline_prewarm_threads{ 0 }; // threads used for background compilation, 0 = half of the loading threads
+	ConfigValue<sint32> pipeline_prewarm_memory{ 256 }; // memory budget in MB for pipelines which are queued or compiling in the background
 
 	struct
 	{
@@ -457,6 +465,7 @@ struct CemuConfig
 		bool cpu_per_core_usage = false;
 		bool ram_usage = false;
 		bool vram_usage = false;
+		bool frame_pacing = false;
 		bool debug = false;
 	} overlay{};
 
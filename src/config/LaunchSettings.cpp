@@ -16,6 +16,12 @@
 
 void requireConsole();
 
+// developer tools, implemented in src/tools/
+void ToolLatteCPBenchmark();
+void ToolPipelineHashBenchmark();
+void ToolZirShaderOptimizerStats();
+void ToolTextureDecoderTest();
+
 bool LaunchSettings::HandleCommandline(const wchar_t* lpCmdLine)
 {
 	#if BOOST_OS_WINDOWS
@@ -69,12 +75,17 @@ bool LaunchSettings::HandleCommandline(const std::vector<std::wstring>& args)
 		("account,a", po::value<std::string>(), "Persistent id of account")
 
 		("force-interpreter", po::value<bool>()->implicit_value(true), "Force interpreter CPU emulation, disables recompiler")
-		("enable-gdbstub", po::value<bool>()->implicit_value(true), "Enable GDB stub to debug executables inside Cemu using an external debugger");
+		("enable-gdbstub", po::value<bool>()->implicit_value(true), "Enable GDB stub to debug executables inside Cemu using an external debugger")
+
+		("headless", po::value<bool>()->implicit_value(true), "Run the game without a window using the null renderer. Nothing is rendered")
+		("frames", po::value<uint32>(), "Exit after this many frames and print statistics. Only used in headless mode")
+		("capture-frames", po::value<uint32>(), "Record the GPU command stream of this many frames after the game started. Captures are stored as .lcap files in dump/capture and can be loaded like a game");
 
 	po::options_description hidden{ "Hidden options" };
 	hidden.add_options()
 		("nsight", po::value<bool>()->implicit_value(true), "NSight debugging options")
-		("legacy", po::value<bool>()->implicit_value(true), "Intel legacy graphic mode");
+		("legacy", po::value<bool>()->implicit_value(true), "Intel legacy graphic mode")
+		("tool", po::value<std::string>(), "Run a developer tool and exit. Available tools: cp-benchmark, pipeline-hash-benchmark, zir-stats, texture-decoder-test");
 
 	po::options_description extractor{ "Extractor tool" };
 	extractor.add_options()
@@ -177,6 +188,29 @@ bool LaunchSettings::HandleCommandline(const std::vector<std::wstring>& args)
 		if (vm.count("enable-gdbstub"))
 			s_enable_gdbstub = vm["enable-gdbstub"].as<bool>();
 
+		if (vm.count("headless"))
+			s_headless_mode = vm["headless"].as<bool>();
+
+		if (vm.count("frames"))
+			s_headless_frame_limit = vm["frames"].as<uint32>();
+
+		if (vm.count("capture-frames"))
+			s_capture_frame_count = vm["capture-frames"].as<uint32>();
+
+		if (s_headless_mode && !s_load_game_file && !s_load_title_id)
+		{
+			requireConsole();
+			std::cout << "--headless requires a game to be specified with --game or --title-id" << std::endl;
+			return false;
+		}
+
+		if (vm.count("tool"))
+		{
+			requireConsole();
+			RunTool(vm["tool"].as<std::string>());
+			return false; // exit in main
+		}
+
 		std::wstring extract_path, log_path;
 		std::string output_path;
 		if (vm.count("extract"))
@@ -209,6 +243,20 @@ bool LaunchSettings::HandleCommandline(const std::vector<std::wstring>& args)
 	
 }
 
+void LaunchSettings::RunTool(std::string_view toolName)
+{
+	if (toolName == "cp-benchmark")
+		ToolLatteCPBenchmark();
+	else if (toolName == "pipeline-hash-benchmark")
+		ToolPipelineHashBenchmark();
+	else if (toolName == "zir-stats")
+		ToolZirShaderOptimizerStats();
+	else if (toolName == "texture-decoder-test")
+		ToolTextureDecoderTest();
+	else
+		std::cout << fmt::format("Unknown tool \"{}\"", toolName) << std::endl;
+}
+
 bool LaunchSettings::ExtractorTool(std::wstring_view wud_path, std::string_view output_path, std::wstring_view log_path)
 {
 	// extracting requires path of file
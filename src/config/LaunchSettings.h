@@ -27,6 +27,10 @@ public:
 
 	static bool ForceInterpreter() { return s_force_interpreter; };
 
+	static bool HeadlessModeEnabled() { return s_headless_mode; }
+	static std::optional<uint32> GetHeadlessFrameLimit() { return s_headless_frame_limit; }
+	static std::optional<uint32> GetCaptureFrameCount() { return s_capture_frame_count; }
+
 	static std::optional<uint32> GetPersistentId() { return s_persistent_id; }
 
 private:
@@ -41,9 +45,14 @@ private:
 	inline static bool s_nsight_mode = false;
 
 	inline static bool s_force_interpreter = false;
+
+	inline static bool s_headless_mode = false;
+	inline static std::optional<uint32> s_headless_frame_limit{};
+	inline static std::optional<uint32> s_capture_frame_count{};
 	
 	inline static std::optional<uint32> s_persistent_id{};
 
+	static void RunTool(std::string_view toolName);
 	static bool ExtractorTool(std::wstring_view wud_path, std::string_view output_path, std::wstring_view log_path);
 };
 
@@ -320,7 +320,8 @@ bool CemuApp::OnInit()
 	g_window_info.app_active = true;
 
 	SetTopWindow(m_mainFrame);
-	m_mainFrame->Show();
+	if (!LaunchSettings::HeadlessModeEnabled())
+		m_mainFrame->Show();
 
 #if BOOST_OS_LINUX && HAS_WAYLAND
 	if (wxWlIsWaylandWindow(m_mainFrame))
@@ -12,6 +12,8 @@
 #include "audio/audioDebuggerWindow.h"
 #include "gui/canvas/OpenGLCanvas.h"
 #include "gui/canvas/VulkanCanvas.h"
+#include "Cafe/HW/Latte/Renderer/Null/NullRenderer.h"
+#include "Cafe/HW/Latte/Core/LatteCapture.h"
 #include "Cafe/OS/libs/nfc/nfc.h"
 #include "Cafe/OS/libs/swkbd/swkbd.h"
 #include "gui/debugger/DebuggerWindow2.h"
@@ -146,6 +148,7 @@ enum
 	MAINFRAME_MENU_ID_DEBUG_DUMP_RAM,
 	MAINFRAME_MENU_ID_DEBUG_DUMP_FST,
 	MAINFRAME_MENU_ID_DEBUG_DUMP_CURL_REQUESTS,
+	MAINFRAME_MENU_ID_DEBUG_DUMP_GPU_CAPTURE,
 	// help
 	MAINFRAME_MENU_ID_HELP_ABOUT = 21700,
 	MAINFRAME_MENU_ID_HELP_UPDATE,
@@ -213,6 +216,7 @@ EVT_MENU(MAINFRAME_MENU_ID_DEBUG_AUDIO_AUX_ONLY, MainWindow::OnDebugSetting)
 EVT_MENU(MAINFRAME_MENU_ID_DEBUG_VK_ACCURATE_BARRIERS, MainWindow::OnDebugSetting)
 EVT_MENU(MAINFRAME_MENU_ID_DEBUG_DUMP_RAM, MainWindow::OnDebugSetting)
 EVT_MENU(MAINFRAME_MENU_ID_DEBUG_DUMP_FST, MainWindow::OnDebugSetting)
+EVT_MENU(MAINFRAME_MENU_ID_DEBUG_DUMP_GPU_CAPTURE, MainWindow::OnDebugSetting)
 // debug -> View ...
 EVT_MENU(MAINFRAME_MENU_ID_DEBUG_VIEW_LOGGING_WINDOW, MainWindow::OnLoggingWindow)
 EVT_MENU(MAINFRAME_MENU_ID_DEBUG_TOGGLE_GDB_STUB, MainWindow::OnGDBStubToggle)
@@ -509,7 +513,18 @@ bool MainWindow::FileLoad(const fs::path launchPath, wxLaunchGameEvent::INITIATE
 		// title is invalid, if it's an RPX/ELF we can launch it directly
 		// otherwise it's an error
 		CafeTitleFileType fileType = DetermineCafeSystemFileType(launchPath);
-		if (fileType == CafeTitleFileType::RPX || fileType == CafeTitleFileType::ELF)
+		if (boost::iequals(_pathToUtf8(launchPath.extension()), ".lcap"))
+		{
+			// GPU command stream capture
+			if (CafeSystem::PrepareForegroundTitleFromCapture(launchPath) != CafeSystem::STATUS_CODE::SUCCESS)
+			{
+				wxString t = _("Failed to load GPU capture. Path: ");
+				t.append(_pathToUtf8(launchPath));
+				wxMessageBox(t, _("Error"), wxOK | wxCENTRE | wxICON_ERROR);
+				return false;
+			}
+		}
+		else if (fileType == CafeTitleFileType::RPX || fileType == CafeTitleFileType::ELF)
 		{
 			CafeSystem::STATUS_CODE r = CafeSystem::PrepareForegroundTitleFromStandaloneRPX(launchPath);
 			if (r != CafeSystem::STATUS_CODE::SUCCESS)
@@ -630,6 +645,7 @@ void MainWindow::OnFileMenu(wxCommandEvent& event)
 			"|{}|*.wua"
 			"|{}|*.wuhb"
 			"|{}|*.rpx;*.elf"
+			"|{}|*.lcap"
 			"|{}|*",
 			_("All Wii U files (*.wud, *.wux, *.wua, *.wuhb, *.iso, *.rpx, *.elf)"),
 			_("Wii U image (*.wud, *.wux, *.iso, *.wad)"),
@@ -637,6 +653,7 @@ void MainWindow::OnFileMenu(wxCommandEvent& event)
 			_("Wii U archive (*.wua)"),
 			_("Wii U homebrew bundle (*.wuhb)"),
 			_("Wii U executable (*.rpx, *.elf)"),
+			_("GPU capture (*.lcap)"),
 			_("All files (*.*)")
 		);
 		
@@ -1010,6 +1027,11 @@ void MainWindow::OnDebugSetting(wxCommandEvent& event)
 		ActiveSettings::EnableAudioOnlyAux(event.IsChecked());
 	else if (event.GetId() == MAINFRAME_MENU_ID_DEBUG_DUMP_RAM)
 		memory_createDump();
+	else if (event.GetId() == MAINFRAME_MENU_ID_DEBUG_DUMP_GPU_CAPTURE)
+	{
+		if (CafeSystem::IsTitleRunning())
+			LatteCapture_Request(LaunchSettings::GetCaptureFrameCount().value_or(10));
+	}
 	else if (event.GetId() == MAINFRAME_MENU_ID_DEBUG_DUMP_FST)
 	{
 		/*	int msgBoxAnswer = wxMessageBox(_("All files from the currently running game will be dumped to /dump/<gamefolder>. This process can take a few minutes."),
@@ -1297,7 +1319,9 @@ void MainWindow::LoadSettings()
 		g_window_info.pad_maximized = config.pad_maximized;
 	}
 
-	this->TogglePadView();
+	// the null renderer only supports a single output
+	if (!LaunchSettings::HeadlessModeEnabled())
+		this->TogglePadView();
 
 	if(m_game_list)
 		m_game_list->LoadConfig();
@@ -1565,7 +1589,13 @@ void MainWindow::CreateCanvas()
     this->GetSizer()->Add(m_game_panel, 1, wxEXPAND, 0, nullptr);
 
     // create canvas
-    if (ActiveSettings::GetGraphicsAPI() == kVulkan)
+	if (LaunchSettings::HeadlessModeEnabled())
+	{
+		// nothing is presented in headless mode, the canvas only exists to receive input events
+		g_renderer = std::make_unique<NullRenderer>();
+		m_render_canvas = new wxWindow(m_game_panel, wxID_ANY, wxDefaultPosition, wxSize(1280, 720), wxWANTS_CHARS);
+	}
+	else if (ActiveSettings::GetGraphicsAPI() == kVulkan)
 		m_render_canvas = new VulkanCanvas(m_game_panel, wxSize(1280, 720), true);
 	else
 		m_render_canvas = GLCanvas_Create(m_game_panel, wxSize(1280, 720), true);
@@ -2222,6 +2252,7 @@ void MainWindow::RecreateMenu()
 	debugLoggingMenu->AppendSubMenu(logCosModulesMenu, _("&CafeOS modules logging"));
 	debugLoggingMenu->AppendSeparator();
 	debugLoggingMenu->AppendCheckItem(MAINFRAME_MENU_ID_DEBUG_LOGGING0 + stdx::to_underlying(LogType::Patches), _("&Graphic pack patches"), wxEmptyString)->Check(cemuLog_isLoggingEnabled(LogType::Patches));
+	debugLoggingMenu->AppendCheckItem(MAINFRAME_MENU_ID_DEBUG_LOGGING0 + stdx::to_underlying(LogType::RPLLoader), _("&RPL loader"), wxEmptyString)->Check(cemuLog_isLoggingEnabled(LogType::RPLLoader));
 	debugLoggingMenu->AppendCheckItem(MAINFRAME_MENU_ID_DEBUG_LOGGING0 + stdx::to_underlying(LogType::TextureCache), _("&Texture cache warnings"), wxEmptyString)->Check(cemuLog_isLoggingEnabled(LogType::TextureCache));
 	debugLoggingMenu->AppendCheckItem(MAINFRAME_MENU_ID_DEBUG_LOGGING0 + stdx::to_underlying(LogType::TextureReadback), _("&Texture readback"), wxEmptyString)->Check(cemuLog_isLoggingEnabled(LogType::TextureReadback));
 	debugLoggingMenu->AppendSeparator();
@@ -2266,6 +2297,7 @@ void MainWindow::RecreateMenu()
 	debugMenu->Append(MAINFRAME_MENU_ID_DEBUG_VIEW_AUDIO_DEBUGGER, _("&View audio debugger"));
 	debugMenu->Append(MAINFRAME_MENU_ID_DEBUG_VIEW_TEXTURE_RELATIONS, _("&View texture cache info"));
 	debugMenu->Append(MAINFRAME_MENU_ID_DEBUG_DUMP_RAM, _("&Dump current RAM"));
+	debugMenu->Append(MAINFRAME_MENU_ID_DEBUG_DUMP_GPU_CAPTURE, _("&Capture GPU command stream"));
 	// debugMenu->Append(MAINFRAME_MENU_ID_DEBUG_DUMP_FST, _("&Dump WUD filesystem"))->Enable(false);
 
 	m_menuBar->Append(debugMenu, _("&Debug"));
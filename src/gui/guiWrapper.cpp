@@ -85,6 +85,9 @@ void gui_updateWindowTitles(bool isIdle, bool isLoading, double fps)
 		case RendererAPI::Vulkan: 
 			renderer = "[Vulkan]";
 			break;
+		case RendererAPI::Null:
+			renderer = "[Null]";
+			break;
 		default: ;
 		}			
 	}
@@ -262,6 +265,13 @@ void gui_notifyGameExited()
 		g_mainFrame->RestoreSettingsAfterGameExited();
 }
 
+void gui_requestExit()
+{
+	std::shared_lock lock(g_mutex);
+	if (g_mainFrame)
+		g_mainFrame->CallAfter([]() { g_mainFrame->Close(true); });
+}
+
 bool gui_isFullScreen()
 {
 	return g_window_info.is_fullscreen;
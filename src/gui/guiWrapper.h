@@ -137,6 +137,7 @@ bool gui_isKeyDown(PlatformKeyCodes key);
 
 void gui_notifyGameLoaded();
 void gui_notifyGameExited();
+void gui_requestExit(); // close the main window from any thread
 
 bool gui_isFullScreen();
 
@@ -0,0 +1,51 @@
+#include "Cafe/HW/Latte/Core/Latte.h"
+#include "Cafe/HW/Latte/Core/LatteCapture.h"
+#include "util/highresolutiontimer/HighResolutionTimer.h"
+#include <regex>
+
+// Micro-benchmark for the register write path of the command processor
+// Replays the command streams of GPU captures (.lcap files recorded to dump/capture/) and measures the time spent applying their register writes
+
+#define LATTE_CP_BENCHMARK_ITERATIONS	(200)
+
+static void BenchmarkCaptureFile(const fs::path& path)
+{
+	uint64 titleId;
+	std::vector<uint32be> cmdBuffer;
+	bool isLoaded = LatteCaptureReplay_Open(path, titleId) && LatteCaptureReplay_ExtractCommandStream(cmdBuffer);
+	LatteCaptureReplay_Stop();
+	if (!isLoaded || cmdBuffer.empty())
+	{
+		printf("Failed to load %s\n", _pathToUtf8(path).c_str());
+		return;
+	}
+	uint32 sizeInDWords = (uint32)cmdBuffer.size();
+	// warm up
+	uint32 numPackets = LatteCP_ReplayRegisterWrites(cmdBuffer.data(), sizeInDWords);
+	HRTick startTime = HighResolutionTimer::now().getTick();
+	for (uint32 i = 0; i < LATTE_CP_BENCHMARK_ITERATIONS; i++)
+		LatteCP_ReplayRegisterWrites(cmdBuffer.data(), sizeInDWords);
+	HRTick endTime = HighResolutionTimer::now().getTick();
+	double totalTime = HighResolutionTimer::getTimeDiff(startTime, endTime);
+	double timePerIteration = totalTime / (double)LATTE_CP_BENCHMARK_ITERATIONS;
+	double nsPerPacket = numPackets ? (timePerIteration * 1000000000.0 / (double)numPackets) : 0.0;
+	double mbPerSecond = totalTime > 0.0 ? ((double)sizeInDWords * 4.0 * LATTE_CP_BENCHMARK_ITERATIONS / totalTime / (1024.0 * 1024.0)) : 0.0;
+	printf("%s: %u register packets, %.3fms per replay, %.1fns per packet, %.1f MB/s\n", _pathToUtf8(path.filename()).c_str(), numPackets, timePerIteration * 1000.0, nsPerPacket, mbPerSecond);
+}
+
+void ToolLatteCPBenchmark()
+{
+	const fs::path capturePath = "dump/capture/";
+	if (!fs::exists(capturePath))
+	{
+		printf("No GPU captures found in dump/capture/\n");
+		return;
+	}
+	for (auto& it : fs::directory_iterator(capturePath))
+	{
+		if (!it.is_regular_file())
+			continue;
+		if (std::regex_match(_pathToUtf8(it.path().filename()), std::regex(".*\\.lcap")))
+			BenchmarkCaptureFile(it.path());
+	}
+}
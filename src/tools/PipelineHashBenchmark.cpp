@@ -0,0 +1,123 @@
+#include "Cafe/HW/Latte/Core/Latte.h"
+#include "Cafe/HW/Latte/Core/FetchShader.h"
+#include "Cafe/HW/Latte/ISA/RegDefines.h"
+#include "Cafe/HW/Latte/ISA/LatteReg.h"
+#include "Cafe/HW/Latte/LegacyShaderDecompiler/LatteDecompiler.h"
+#include "Cafe/HW/Latte/Renderer/Vulkan/VulkanRenderer.h"
+#include "util/highresolutiontimer/HighResolutionTimer.h"
+#include <cinttypes>
+
+// CPU-only micro-benchmark for the Vulkan graphics pipeline hash which is calculated before every draw
+// Compares recalculating all register groups (what every draw did before the group hashes were cached) against updating only the dirty groups
+// Also measures the dirty tracking which the command processor does for every register write packet
+
+#define PIPELINE_HASH_BENCHMARK_ITERATIONS	(4000000)
+#define PIPELINE_HASH_BENCHMARK_RUNS		(15)
+
+void LatteCP_notifyPipelineStateWrite(uint32 registerStartIndex, uint32 registerEndIndex);
+
+// returns the fastest of several runs in nanoseconds per iteration
+template<typename TFunc>
+static double _BenchmarkBestOf(TFunc benchmarkFunc)
+{
+	double bestTime = std::numeric_limits<double>::max();
+	for (uint32 run = 0; run < PIPELINE_HASH_BENCHMARK_RUNS; run++)
+	{
+		HRTick startTime = HighResolutionTimer::now().getTick();
+		uint32 iterationCount = benchmarkFunc();
+		HRTick endTime = HighResolutionTimer::now().getTick();
+		bestTime = std::min(bestTime, HighResolutionTimer::getTimeDiff(startTime, endTime) * 1000000000.0 / (double)iterationCount);
+	}
+	return bestTime;
+}
+
+void ToolPipelineHashBenchmark()
+{
+	// typical register state: three vertex buffers, blending on the first color buffer, depth and stencil test enabled
+	auto lcr = std::make_unique<LatteContextRegister>();
+	uint32* ctxRegister = lcr->GetRawView();
+	const uint32 bufferStrides[3] = { 12, 32, 16 };
+	for (uint32 i = 0; i < 3; i++)
+		ctxRegister[mmSQ_VTX_ATTRIBUTE_BLOCK_START + i * 7 + 2] = bufferStrides[i] << 11;
+	ctxRegister[mmVGT_PRIMITIVE_TYPE] = 4;
+	ctxRegister[Latte::REGADDR::PA_SU_SC_MODE_CNTL] = 0x244;
+	ctxRegister[Latte::REGADDR::PA_CL_CLIP_CNTL] = 0x10000;
+	ctxRegister[Latte::REGADDR::CB_COLOR_CONTROL] = 0x00CC0100;
+	ctxRegister[Latte::REGADDR::CB_TARGET_MASK] = 0xF;
+	ctxRegister[Latte::REGADDR::CB_BLEND0_CONTROL] = 0x00010501;
+	ctxRegister[Latte::REGADDR::DB_DEPTH_CONTROL] = 0x00000777;
+	ctxRegister[mmDB_STENCILREFMASK] = 0xFF00FF;
+
+	LatteFetchShader fetchShader;
+	for (uint32 i = 0; i < 3; i++)
+	{
+		LatteParsedFetchShaderBufferGroup_t bufferGroup{};
+		bufferGroup.attributeBufferIndex = i;
+		fetchShader.bufferGroups.emplace_back(bufferGroup);
+	}
+	fetchShader.vkPipelineHashFragment = 0x1234567890ABCDEFull;
+	LatteDecompilerShader vertexShader(LatteConst::ShaderType::Vertex);
+	vertexShader.baseHash = 0x1111222233334444ull;
+	LatteDecompilerShader pixelShader(LatteConst::ShaderType::Pixel);
+	pixelShader.baseHash = 0x5555666677778888ull;
+	pixelShader.auxHash = 0x99;
+	const uint64 renderPassHash = 0xABCDEF0123456789ull;
+
+	uint64 hashSum = 0;
+	double fullTime = _BenchmarkBestOf([&]()
+	{
+		for (uint32 i = 0; i < PIPELINE_HASH_BENCHMARK_ITERATIONS; i++)
+		{
+			VulkanRenderer::PipelineStateGroupHashes groupHashes;
+			groupHashes.Update(LATTE_PIPELINE_STATE_GROUP_ALL, &fetchShader, *lcr);
+			hashSum += groupHashes.GetFullHash(&vertexShader, nullptr, &pixelShader, renderPassHash);
+		}
+		return PIPELINE_HASH_BENCHMARK_ITERATIONS;
+	});
+	printf("Full recalculation: %.2fns per draw\n", fullTime);
+
+	struct
+	{
+		const char* name;
+		uint32 dirtyMask;
+	}scenarioList[] = {
+		{ "no group dirty", 0 },
+		{ "vertex layout dirty", LATTE_PIPELINE_STATE_GROUP_VERTEX_LAYOUT },
+		{ "vertex layout, blend and depth/stencil dirty", LATTE_PIPELINE_STATE_GROUP_VERTEX_LAYOUT | LATTE_PIPELINE_STATE_GROUP_BLEND | LATTE_PIPELINE_STATE_GROUP_DEPTH_STENCIL },
+		{ "all groups dirty", LATTE_PIPELINE_STATE_GROUP_ALL },
+	};
+	VulkanRenderer::PipelineStateGroupHashes cachedHashes;
+	cachedHashes.Update(LATTE_PIPELINE_STATE_GROUP_ALL, &fetchShader, *lcr);
+	for (auto& scenario : scenarioList)
+	{
+		double cachedTime = _BenchmarkBestOf([&]()
+		{
+			for (uint32 i = 0; i < PIPELINE_HASH_BENCHMARK_ITERATIONS; i++)
+			{
+				if (scenario.dirtyMask)
+					cachedHashes.Update(scenario.dirtyMask, &fetchShader, *lcr);
+				hashSum += cachedHashes.GetFullHash(&vertexShader, nullptr, &pixelShader, renderPassHash);
+			}
+			return PIPELINE_HASH_BENCHMARK_ITERATIONS;
+		});
+		printf("Cached group hashes, %s: %.2fns per draw\n", scenario.name, cachedTime);
+	}
+
+	// a mix of register write packets as they appear between two draws. Only some of them touch registers of a pipeline state group
+	const std::pair<uint32, uint32> packetList[] = {
+		{ mmSQ_TEX_RESOURCE_WORD0, 7 }, { mmSQ_TEX_RESOURCE_WORD0 + 7, 7 }, { mmSQ_PGM_START_PS, 4 }, { mmSQ_PGM_START_VS, 4 },
+		{ mmSQ_VTX_ATTRIBUTE_BLOCK_START, 7 }, { Latte::REGADDR::CB_BLEND0_CONTROL, 1 }, { Latte::REGADDR::DB_DEPTH_CONTROL, 1 }, { mmVGT_PRIMITIVE_TYPE, 1 },
+	};
+	double trackingTime = _BenchmarkBestOf([&]()
+	{
+		for (uint32 i = 0; i < PIPELINE_HASH_BENCHMARK_ITERATIONS / 8; i++)
+		{
+			for (auto& [registerIndex, registerCount] : packetList)
+				LatteCP_notifyPipelineStateWrite(registerIndex, registerIndex + registerCount);
+		}
+		return (uint32)(PIPELINE_HASH_BENCHMARK_ITERATIONS / 8 * std::size(packetList));
+	});
+	LatteGPUState.pipelineStateDirtyMask = 0;
+	printf("Dirty tracking: %.2fns per register write packet\n", trackingTime);
+	printf("(checksum %016" PRIx64 ")\n", hashSum);
+}
@@ -0,0 +1,15 @@
+#include "Cafe/HW/Latte/Core/LatteTextureLoader.h"
+
+// Compares the optimized texture decode paths against the per-pixel reference implementations and reports their timings
+
+namespace GX2
+{
+	bool _TestAddrLib_FastDecode();
+}
+
+void ToolTextureDecoderTest()
+{
+	bool success = GX2::_TestAddrLib_FastDecode();
+	success = LatteTextureLoader_TestBCnDecoders() && success;
+	printf(success ? "All texture decoder tests passed\n" : "Texture decoder tests FAILED\n");
+}
@@ -0,0 +1,162 @@
+#include "Cemu/FileCache/FileCache.h"
+#include "Cafe/HW/Latte/Core/LatteShader.h"
+#include "Cafe/HW/Latte/Core/FetchShader.h"
+#include "Cafe/HW/Latte/ISA/RegDefines.h"
+#include "Cafe/HW/Latte/ISA/LatteReg.h"
+#include "Cafe/HW/Latte/Common/RegisterSerializer.h"
+#include "Cafe/HW/Latte/Common/ShaderSerializer.h"
+#include "Cafe/HW/Latte/Transcompiler/LatteTC.h"
+#include "util/helpers/Serializer.h"
+#include "util/helpers/StringBuf.h"
+#include "util/Zir/EmitterGLSL/ZpIREmitGLSL.h"
+#include "util/Zir/Core/ZirUtility.h"
+#include <regex>
+#include <cinttypes>
+
+// Offline tool which runs the vertex shaders stored in the transferable shader caches through the Zir IR generator
+// and reports the IR size and length of the emitted GLSL with and without the optimization passes
+// Only shaders which are supported by the IR generator (LatteTCGenIR) can be processed
+
+struct ZirShaderStats
+{
+	uint32 numInstructions{};
+	uint32 glslLength{};
+};
+
+static uint32 _ZirCountInstructions(ZpIR::ZpIRFunction* irFunction)
+{
+	uint32 count = 0;
+	for (auto& block : irFunction->m_basicBlocks)
+	{
+		for (ZpIR::IR::__InsBase* ins = block->m_instructionFirst; ins; ins = ins->next)
+			count++;
+	}
+	return count;
+}
+
+static void _ZirFreeFunction(ZpIR::ZpIRFunction* irFunction)
+{
+	for (auto& block : irFunction->m_basicBlocks)
+	{
+		ZpIR::IR::__InsBase* ins = block->m_instructionFirst;
+		while (ins)
+		{
+			ZpIR::IR::__InsBase* next = ins->next;
+			ZpIR::ZpIRCmdUtil::deleteInstruction(ins);
+			ins = next;
+		}
+		delete block;
+	}
+	delete irFunction;
+}
+
+static ZirShaderStats _ZirGenerateShader(LatteFetchShader* fetchShader, const uint32* contextRegisters, const std::vector<uint8>& programData, bool optimize)
+{
+	ZirShaderStats stats;
+	LatteTCGenIR genIR;
+	genIR.setVertexShaderContext(fetchShader, contextRegisters + mmSQ_VTX_SEMANTIC_0);
+	ZpIR::ZpIRFunction* irObj = genIR.transcompileLatteToIR(programData.data(), (uint32)programData.size(), LatteTCGenIR::VERTEX);
+	if (optimize)
+	{
+		ZirPass::PassManager passManager(irObj);
+		passManager.addOptimizationPasses();
+		passManager.run();
+	}
+	stats.numInstructions = _ZirCountInstructions(irObj);
+	ZirPass::RegisterAllocatorForGLSL ra(irObj);
+	ra.applyPass();
+	StringBuf glslSourceBuffer(64 * 1024);
+	ZirEmitter::GLSL emitter;
+	emitter.Emit(irObj, &glslSourceBuffer);
+	stats.glslLength = glslSourceBuffer.getLen();
+	_ZirFreeFunction(irObj);
+	return stats;
+}
+
+static bool _ZirProcessVertexShaderEntry(MemStreamReader& streamReader, ZirShaderStats& statsBefore, ZirShaderStats& statsAfter)
+{
+	uint8 versionAndType = streamReader.readBE<uint8>();
+	if (versionAndType != 1) // version 1, vertex shader
+		return false;
+	streamReader.readBE<uint64>(); // base hash
+	streamReader.readBE<uint64>(); // aux hash
+	streamReader.readBE<uint8>(); // uses geometry shader
+	Latte::GPUCompactedRegisterState regState;
+	if (!Latte::DeserializeRegisterState(regState, streamReader))
+		return false;
+	auto lcr = std::make_unique<LatteContextRegister>();
+	Latte::LoadGPURegisterState(*lcr, regState);
+	std::vector<uint8> fetchShaderData;
+	if (!Latte::DeserializeShaderProgram(fetchShaderData, streamReader))
+		return false;
+	std::vector<uint8> vertexShaderData;
+	if (!Latte::DeserializeShaderProgram(vertexShaderData, streamReader))
+		return false;
+	if (streamReader.hasError() || !streamReader.isEndOfStream())
+		return false;
+	LatteShader_UpdatePSInputs(lcr->GetRawView());
+	LatteFetchShader::CacheHash fsHash = LatteFetchShader::CalculateCacheHash((uint32*)fetchShaderData.data(), fetchShaderData.size());
+	LatteFetchShader* fetchShader = LatteShaderRecompiler_createFetchShader(fsHash, lcr->GetRawView(), (uint32*)fetchShaderData.data(), fetchShaderData.size());
+	statsBefore = _ZirGenerateShader(fetchShader, lcr->GetRawView(), vertexShaderData, false);
+	statsAfter = _ZirGenerateShader(fetchShader, lcr->GetRawView(), vertexShaderData, true);
+	return true;
+}
+
+static void _ZirShaderStatsForCacheFile(std::string fileName)
+{
+	uint64 titleId = 0;
+	if (sscanf(fileName.c_str(), "%" SCNx64, &titleId) != 1)
+		return;
+	const std::string path = "shaderCache/transferable/" + fileName;
+	FileCache* cache = FileCache::Open(boost::nowide::widen(path));
+	if (!cache)
+	{
+		printf("Failed to open cache file %s\n", fileName.c_str());
+		return;
+	}
+	ZirShaderStats totalBefore, totalAfter;
+	uint32 numShaders = 0;
+	for (sint32 i = 0; i < cache->GetFileCount(); i++)
+	{
+		uint64 name1, name2;
+		std::vector<uint8> fileData;
+		if (!cache->GetFileByIndex(i, &name1, &name2, fileData) || fileData.empty())
+			continue;
+		MemStreamReader streamReader(fileData.data(), (sint32)fileData.size());
+		ZirShaderStats before, after;
+		if (!_ZirProcessVertexShaderEntry(streamReader, before, after))
+			continue;
+		totalBefore.numInstructions += before.numInstructions;
+		totalBefore.glslLength += before.glslLength;
+		totalAfter.numInstructions += after.numInstructions;
+		totalAfter.glslLength += after.glslLength;
+		numShaders++;
+	}
+	delete cache;
+	if (numShaders == 0)
+	{
+		printf("%016" PRIx64 ": No vertex shaders\n", titleId);
+		return;
+	}
+	printf("%016" PRIx64 ": %u vertex shaders\n", titleId, numShaders);
+	printf("  IR instructions: %u -> %u\n", totalBefore.numInstructions, totalAfter.numInstructions);
+	printf("  GLSL length:     %u -> %u\n", totalBefore.glslLength, totalAfter.glslLength);
+}
+
+void ToolZirShaderOptimizerStats()
+{
+	if (!fs::exists("shaderCache/transferable/"))
+	{
+		printf("No shader caches found in shaderCache/transferable/\n");
+		return;
+	}
+	const std::regex shaderCacheRegex("[0-9a-fA-F]{16}(?:_shaders.bin)");
+	for (auto& it : fs::directory_iterator("shaderCache/transferable/"))
+	{
+		if (!it.is_regular_file())
+			continue;
+		const std::string fileName = it.path().filename().string();
+		if (std::regex_match(fileName, shaderCacheRegex))
+			_ZirShaderStatsForCacheFile(fileName);
+	}
+}
@@ -63,4 +63,9 @@ namespace MemMapper
 			munmap(baseAddr, size);
 	}
 
+	bool SetPageProtection(void* baseAddr, size_t size, PAGE_PERMISSION permissionFlags)
+	{
+		return mprotect(baseAddr, size, GetProt(permissionFlags)) == 0;
+	}
+
 };
@@ -60,4 +60,10 @@ namespace MemMapper
 			VirtualFree(baseAddr, size, MEM_RELEASE);
 	}
 
+	bool SetPageProtection(void* baseAddr, size_t size, PAGE_PERMISSION permissionFlags)
+	{
+		DWORD oldProtection;
+		return VirtualProtect(baseAddr, size, GetPageProtection(permissionFlags), &oldProtection) != 0;
+	}
+
 };
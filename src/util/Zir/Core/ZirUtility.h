@@ -68,6 +68,45 @@ namespace ZpIR
 			}
 		}
 
+		// calls funcRegRead for every register or constant operand which is read and replaces it with the returned value
+		template<typename TFuncRegRead>
+		static void rewriteReadRegs(IR::__InsBase* instruction, TFuncRegRead funcRegRead)
+		{
+			if (auto ins = IR::InsRR::getIfForm(instruction))
+			{
+				ins->rB = funcRegRead(ins->rB);
+			}
+			else if (auto ins = IR::InsRRR::getIfForm(instruction))
+			{
+				ins->rB = funcRegRead(ins->rB);
+				ins->rC = funcRegRead(ins->rC);
+			}
+			else if (auto ins = IR::InsEXPORT::getIfForm(instruction))
+			{
+				for (uint16 i = 0; i < ins->count; i++)
+					ins->regArray[i] = funcRegRead(ins->regArray[i]);
+			}
+			else if (IR::InsIMPORT::getIfForm(instruction) == nullptr)
+			{
+				cemu_assert_unimplemented();
+			}
+		}
+
+		// instructions have no virtual destructor, delete them via their actual type
+		static void deleteInstruction(IR::__InsBase* instruction)
+		{
+			if (auto ins = IR::InsRR::getIfForm(instruction))
+				delete ins;
+			else if (auto ins = IR::InsRRR::getIfForm(instruction))
+				delete ins;
+			else if (auto ins = IR::InsIMPORT::getIfForm(instruction))
+				delete ins;
+			else if (auto ins = IR::InsEXPORT::getIfForm(instruction))
+				delete ins;
+			else
+				cemu_assert_unimplemented();
+		}
+
 		static void replaceRegisters(IR::__InsBase& ins, std::unordered_map<IRReg, IRReg>& translationTable)
 		{
 			cemu_assert_unimplemented();
@@ -7,6 +7,7 @@ namespace ZirPass
 	{
 	public:
 		ZpIRPass(ZpIR::ZpIRFunction* irFunction) : m_irFunction(irFunction) { };
+		virtual ~ZpIRPass() = default;
 
 		virtual void applyPass() = 0;
 
@@ -14,6 +15,97 @@ namespace ZirPass
 		ZpIR::ZpIRFunction* m_irFunction;
 	};
 
+	/*
+	 * Optimization passes
+	 * These work on virtual registers and have to run before register allocation
+	 * All of them are local to a basic block. Registers listed in the exports of a block are read by other blocks and are never replaced or removed
+	 * Passes only redirect reads. Instructions which become unused are removed by DeadCodeElimination
+	 */
+
+	// reads of a register which was assigned by MOV from a register or constant of the same type are replaced with the source
+	class CopyPropagation : public ZpIRPass
+	{
+	public:
+		CopyPropagation(ZpIR::ZpIRFunction* irFunction) : ZpIRPass(irFunction) {};
+
+		void applyPass() override;
+
+	private:
+		void applyToBlock(ZpIR::ZpIRBasicBlock& block);
+	};
+
+	// evaluates instructions where all operands are constants and simplifies trivial operations (x+0, x-0, x*1, x/1)
+	class ConstantFolding : public ZpIRPass
+	{
+	public:
+		ConstantFolding(ZpIR::ZpIRFunction* irFunction) : ZpIRPass(irFunction) {};
+
+		void applyPass() override;
+
+	private:
+		void applyToBlock(ZpIR::ZpIRBasicBlock& block);
+		std::optional<ZpIR::IRReg> foldRR(ZpIR::ZpIRBasicBlock& block, ZpIR::IR::InsRR* ins);
+		std::optional<ZpIR::IRReg> foldRRR(ZpIR::ZpIRBasicBlock& block, ZpIR::IR::InsRRR* ins);
+	};
+
+	// reads of a register which holds the same value as an earlier instruction with identical opcode, type and operands are replaced with the earlier result
+	class CommonSubexpressionElimination : public ZpIRPass
+	{
+	public:
+		CommonSubexpressionElimination(ZpIR::ZpIRFunction* irFunction) : ZpIRPass(irFunction) {};
+
+		void applyPass() override;
+
+	private:
+		void applyToBlock(ZpIR::ZpIRBasicBlock& block);
+	};
+
+	// removes instructions which only write registers that are never read. EXPORT instructions are shader outputs and always kept
+	class DeadCodeElimination : public ZpIRPass
+	{
+	public:
+		DeadCodeElimination(ZpIR::ZpIRFunction* irFunction) : ZpIRPass(irFunction) {};
+
+		void applyPass() override;
+
+	private:
+		void applyToBlock(ZpIR::ZpIRBasicBlock& block);
+	};
+
+	// runs a list of passes in the order they were added
+	class PassManager
+	{
+	public:
+		PassManager(ZpIR::ZpIRFunction* irFunction) : m_irFunction(irFunction) {};
+
+		template<typename TPass>
+		PassManager& addPass()
+		{
+			m_passes.emplace_back(std::make_unique<TPass>(m_irFunction));
+			return *this;
+		}
+
+		// the default optimization pipeline
+		PassManager& addOptimizationPasses()
+		{
+			addPass<CopyPropagation>();
+			addPass<ConstantFolding>();
+			addPass<CommonSubexpressionElimination>();
+			addPass<DeadCodeElimination>();
+			return *this;
+		}
+
+		void run()
+		{
+			for (auto& pass : m_passes)
+				pass->applyPass();
+		}
+
+	private:
+		ZpIR::ZpIRFunction* m_irFunction;
+		std::vector<std::unique_ptr<ZpIRPass>> m_passes;
+	};
+
 	struct RALivenessRange_t
 	{
 		RALivenessRange_t(struct RABlock_t* block, ZpIR::IRReg irReg, sint32 start, sint32 end, ZpIR::DataType irDataType);
@@ -0,0 +1,381 @@
+#include "util/Zir/Core/IR.h"
+#include "util/Zir/Core/ZirUtility.h"
+#include "util/Zir/Core/ZpIRPasses.h"
+
+namespace ZirPass
+{
+	using namespace ZpIR;
+
+	// tracks which register reads of a basic block are redirected to another register or constant
+	class BlockRegisterRemap
+	{
+	public:
+		BlockRegisterRemap(ZpIRBasicBlock& block) : m_remap(block.m_regs.size()), m_isExported(block.m_regs.size())
+		{
+			for (size_t i = 0; i < m_remap.size(); i++)
+				m_remap[i] = (IRReg)i;
+			for (auto& itr : block.m_exports)
+			{
+				if (isRegVar(itr.reg))
+					m_isExported[getRegIndex(itr.reg)] = true;
+			}
+		}
+
+		// exported registers are read by other blocks and must keep their value
+		bool canReplace(IRReg reg) const
+		{
+			return isRegVar(reg) && !m_isExported[getRegIndex(reg)];
+		}
+
+		void replace(IRReg reg, IRReg replacement)
+		{
+			cemu_assert_debug(canReplace(reg));
+			m_remap[getRegIndex(reg)] = get(replacement);
+		}
+
+		IRReg get(IRReg reg) const
+		{
+			if (isConstVar(reg))
+				return reg;
+			return m_remap[getRegIndex(reg)];
+		}
+
+		void rewriteReads(IR::__InsBase* instruction)
+		{
+			ZpIRCmdUtil::rewriteReadRegs(instruction, [this](IRReg reg) { return get(reg); });
+		}
+
+	private:
+		std::vector<IRReg> m_remap;
+		std::vector<bool> m_isExported;
+	};
+
+	static bool _IsFoldableType(DataType type)
+	{
+		return type == DataType::U32 || type == DataType::S32 || type == DataType::F32;
+	}
+
+	/* CopyPropagation */
+
+	void CopyPropagation::applyPass()
+	{
+		cemu_assert_debug(!m_irFunction->state.registersAllocated);
+		for (auto& itr : m_irFunction->m_basicBlocks)
+			applyToBlock(*itr);
+	}
+
+	void CopyPropagation::applyToBlock(ZpIRBasicBlock& block)
+	{
+		BlockRegisterRemap remap(block);
+		for (IR::__InsBase* instruction = block.m_instructionFirst; instruction; instruction = instruction->next)
+		{
+			remap.rewriteReads(instruction);
+			auto ins = IR::InsRR::getIfForm(instruction);
+			if (!ins || ins->opcode != IR::OpCode::MOV)
+				continue;
+			if (!remap.canReplace(ins->rA) || block.getRegType(ins->rA) != block.getRegType(ins->rB))
+				continue;
+			remap.replace(ins->rA, ins->rB);
+		}
+	}
+
+	/* ConstantFolding */
+
+	void ConstantFolding::applyPass()
+	{
+		cemu_assert_debug(!m_irFunction->state.registersAllocated);
+		for (auto& itr : m_irFunction->m_basicBlocks)
+			applyToBlock(*itr);
+	}
+
+	void ConstantFolding::applyToBlock(ZpIRBasicBlock& block)
+	{
+		BlockRegisterRemap remap(block);
+		for (IR::__InsBase* instruction = block.m_instructionFirst; instruction; instruction = instruction->next)
+		{
+			remap.rewriteReads(instruction);
+			std::optional<IRReg> result;
+			IRReg resultReg;
+			if (auto ins = IR::InsRR::getIfForm(instruction))
+			{
+				resultReg = ins->rA;
+				if (remap.canReplace(resultReg))
+					result = foldRR(block, ins);
+			}
+			else if (auto ins = IR::InsRRR::getIfForm(instruction))
+			{
+				resultReg = ins->rA;
+				if (remap.canReplace(resultReg))
+					result = foldRRR(block, ins);
+			}
+			if (result)
+				remap.replace(resultReg, *result);
+		}
+	}
+
+	std::optional<IRReg> ConstantFolding::foldRR(ZpIRBasicBlock& block, IR::InsRR* ins)
+	{
+		IRRegConstDef* src = block.getConstant(ins->rB);
+		if (!src || block.m_consts.size() >= 0x7FFF)
+			return std::nullopt;
+		DataType srcType = src->type;
+		DataType dstType = block.getRegType(ins->rA);
+		if (!_IsFoldableType(srcType) || !_IsFoldableType(dstType))
+			return std::nullopt;
+		switch (ins->opcode)
+		{
+		case IR::OpCode::MOV:
+			// constants which became available after copy propagation ran
+			if (srcType != dstType)
+				return std::nullopt;
+			return ins->rB;
+		case IR::OpCode::BITCAST:
+			return block.createTypedConstant(src->value_u32, dstType);
+		case IR::OpCode::SWAP_ENDIAN:
+			if (srcType != dstType)
+				return std::nullopt;
+			return block.createTypedConstant(_swapEndianU32(src->value_u32), dstType);
+		case IR::OpCode::CONVERT_INT_TO_FLOAT:
+			if (dstType != DataType::F32)
+				return std::nullopt;
+			if (srcType == DataType::U32)
+				return block.createConstantF32((f32)src->value_u32);
+			if (srcType == DataType::S32)
+				return block.createConstantF32((f32)src->value_s32);
+			return std::nullopt;
+		case IR::OpCode::CONVERT_FLOAT_TO_INT:
+		{
+			if (srcType != DataType::F32)
+				return std::nullopt;
+			// conversion of values which are out of range is undefined in GLSL, leave these to the driver
+			f32 v = std::trunc(src->value_f32);
+			if (dstType == DataType::S32 && v >= -2147483648.0f && v < 2147483648.0f)
+				return block.createTypedConstant((uint32)(sint32)v, DataType::S32);
+			if (dstType == DataType::U32 && v >= 0.0f && v < 4294967296.0f)
+				return block.createTypedConstant((uint32)v, DataType::U32);
+			return std::nullopt;
+		}
+		default:
+			break;
+		}
+		return std::nullopt;
+	}
+
+	std::optional<IRReg> ConstantFolding::foldRRR(ZpIRBasicBlock& block, IR::InsRRR* ins)
+	{
+		DataType type = block.getRegType(ins->rA);
+		if (!_IsFoldableType(type))
+			return std::nullopt;
+		IRRegConstDef* constB = block.getConstant(ins->rB);
+		IRRegConstDef* constC = block.getConstant(ins->rC);
+		if (constB && constB->type != type)
+			return std::nullopt;
+		if (constC && constC->type != type)
+			return std::nullopt;
+		auto isOne = [type](IRRegConstDef* c) { return c && (type == DataType::F32 ? c->value_f32 == 1.0f : c->value_u32 == 1); };
+		auto isIntZero = [type](IRRegConstDef* c) { return c && type != DataType::F32 && c->value_u32 == 0; };
+		if (!constB || !constC)
+		{
+			// trivial operations. x+0.0 is not simplified since it turns -0.0 into +0.0
+			IRReg regB = ins->rB;
+			IRReg regC = ins->rC;
+			if (block.getRegType(regB) != type || block.getRegType(regC) != type)
+				return std::nullopt;
+			switch (ins->opcode)
+			{
+			case IR::OpCode::ADD:
+				if (isIntZero(constB))
+					return regC;
+				if (isIntZero(constC))
+					return regB;
+				break;
+			case IR::OpCode::SUB:
+				if (isIntZero(constC))
+					return regB;
+				break;
+			case IR::OpCode::MUL:
+				if (isOne(constB))
+					return regC;
+				if (isOne(constC))
+					return regB;
+				break;
+			case IR::OpCode::DIV:
+				if (isOne(constC))
+					return regB;
+				break;
+			default:
+				break;
+			}
+			return std::nullopt;
+		}
+		if (block.m_consts.size() >= 0x7FFF)
+			return std::nullopt;
+		if (type == DataType::F32)
+		{
+			f32 b = constB->value_f32;
+			f32 c = constC->value_f32;
+			f32 r;
+			switch (ins->opcode)
+			{
+			case IR::OpCode::ADD:
+				r = b + c;
+				break;
+			case IR::OpCode::SUB:
+				r = b - c;
+				break;
+			case IR::OpCode::MUL:
+				r = b * c;
+				break;
+			case IR::OpCode::DIV:
+				if (c == 0.0f)
+					return std::nullopt; // undefined in GLSL
+				r = b / c;
+				break;
+			default:
+				return std::nullopt;
+			}
+			// inf and NaN have no literal representation in the emitted shader source and their behavior is undefined in GLSL
+			if (!std::isfinite(r))
+				return std::nullopt;
+			return block.createConstantF32(r);
+		}
+		// integer arithmetic wraps around, signed and unsigned only differ for division
+		uint32 b = constB->value_u32;
+		uint32 c = constC->value_u32;
+		uint32 r;
+		switch (ins->opcode)
+		{
+		case IR::OpCode::ADD:
+			r = b + c;
+			break;
+		case IR::OpCode::SUB:
+			r = b - c;
+			break;
+		case IR::OpCode::MUL:
+			r = b * c;
+			break;
+		case IR::OpCode::DIV:
+			if (c == 0)
+				return std::nullopt; // undefined
+			if (type == DataType::S32)
+			{
+				if ((sint32)b == std::numeric_limits<sint32>::min() && (sint32)c == -1)
+					return std::nullopt;
+				r = (uint32)((sint32)b / (sint32)c);
+			}
+			else
+				r = b / c;
+			break;
+		default:
+			return std::nullopt;
+		}
+		return block.createTypedConstant(r, type);
+	}
+
+	/* CommonSubexpressionElimination */
+
+	void CommonSubexpressionElimination::applyPass()
+	{
+		cemu_assert_debug(!m_irFunction->state.registersAllocated);
+		for (auto& itr : m_irFunction->m_basicBlocks)
+			applyToBlock(*itr);
+	}
+
+	void CommonSubexpressionElimination::applyToBlock(ZpIRBasicBlock& block)
+	{
+		BlockRegisterRemap remap(block);
+		// all instructions are side effect free and registers are only assigned once, so an expression is identified by opcode, result type and operands
+		std::unordered_map<uint64, IRReg> expressions;
+		std::unordered_map<LocationSymbolName, IRReg> imports;
+		for (IR::__InsBase* instruction = block.m_instructionFirst; instruction; instruction = instruction->next)
+		{
+			remap.rewriteReads(instruction);
+			if (auto ins = IR::InsRR::getIfForm(instruction))
+			{
+				if (!remap.canReplace(ins->rA))
+					continue;
+				uint64 key = (uint64)ins->opcode | ((uint64)block.getRegType(ins->rA) << 8) | ((uint64)ins->rB << 16) | ((uint64)IR::OpForm::RR << 48);
+				auto it = expressions.try_emplace(key, ins->rA);
+				if (!it.second)
+					remap.replace(ins->rA, it.first->second);
+			}
+			else if (auto ins = IR::InsRRR::getIfForm(instruction))
+			{
+				if (!remap.canReplace(ins->rA))
+					continue;
+				IRReg opB = ins->rB;
+				IRReg opC = ins->rC;
+				if ((ins->opcode == IR::OpCode::ADD || ins->opcode == IR::OpCode::MUL) && opB > opC)
+					std::swap(opB, opC); // commutative
+				uint64 key = (uint64)ins->opcode | ((uint64)block.getRegType(ins->rA) << 8) | ((uint64)opB << 16) | ((uint64)opC << 32) | ((uint64)IR::OpForm::RRR << 48);
+				auto it = expressions.try_emplace(key, ins->rA);
+				if (!it.second)
+					remap.replace(ins->rA, it.first->second);
+			}
+			else if (auto ins = IR::InsIMPORT::getIfForm(instruction))
+			{
+				if (ins->count != 1 || !remap.canReplace(ins->regArray[0]))
+					continue;
+				IRReg reg = ins->regArray[0];
+				auto it = imports.try_emplace(ins->importSymbol, reg);
+				if (!it.second && block.getRegType(it.first->second) == block.getRegType(reg))
+					remap.replace(reg, it.first->second);
+			}
+		}
+	}
+
+	/* DeadCodeElimination */
+
+	void DeadCodeElimination::applyPass()
+	{
+		cemu_assert_debug(!m_irFunction->state.registersAllocated);
+		for (auto& itr : m_irFunction->m_basicBlocks)
+			applyToBlock(*itr);
+	}
+
+	void DeadCodeElimination::applyToBlock(ZpIRBasicBlock& block)
+	{
+		std::vector<IR::__InsBase*> instructions;
+		for (IR::__InsBase* instruction = block.m_instructionFirst; instruction; instruction = instruction->next)
+			instructions.emplace_back(instruction);
+		std::vector<bool> isRead(block.m_regs.size());
+		for (auto& itr : block.m_exports)
+		{
+			if (isRegVar(itr.reg))
+				isRead[getRegIndex(itr.reg)] = true;
+		}
+		// walk backwards so that the operands of removed instructions can be removed too
+		std::vector<bool> isDead(instructions.size());
+		for (size_t i = instructions.size(); i-- > 0;)
+		{
+			IR::__InsBase* instruction = instructions[i];
+			bool hasSideEffects = IR::InsEXPORT::getIfForm(instruction) != nullptr;
+			bool writesLiveReg = false;
+			ZpIRCmdUtil::forEachAccessedReg(block, instruction, [](IRReg readReg) {}, [&](IRReg writtenReg)
+			{
+				if (isRead[getRegIndex(writtenReg)])
+					writesLiveReg = true;
+			});
+			if (!hasSideEffects && !writesLiveReg)
+			{
+				isDead[i] = true;
+				continue;
+			}
+			ZpIRCmdUtil::forEachAccessedReg(block, instruction, [&](IRReg readReg)
+			{
+				isRead[getRegIndex(readReg)] = true;
+			}, [](IRReg writtenReg) {});
+		}
+		// relink the remaining instructions
+		block.m_instructionFirst = nullptr;
+		block.m_instructionLast = nullptr;
+		for (size_t i = 0; i < instructions.size(); i++)
+		{
+			if (isDead[i])
+				ZpIRCmdUtil::deleteInstruction(instructions[i]);
+			else
+				block.appendInstruction(instructions[i]);
+		}
+	}
+
+}